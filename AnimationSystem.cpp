@@ -0,0 +1,971 @@
+///////////////////////////////////////////////////////////////////////////////
+// animationsystem.cpp
+// ===================
+// play keyframed animation clips on the scene object transformations - the
+// clips are stored compressed and sampled in SIMD batches
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "AnimationSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define ANIMATION_USE_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define ANIMATION_USE_NEON
+#endif
+
+// declaration of global variables
+namespace
+{
+	const float DEGREES_TO_RADIANS = 3.14159265358979f / 180.0f;
+	const float RADIANS_TO_DEGREES = 180.0f / 3.14159265358979f;
+	// the range of the three smallest components of a unit quaternion
+	const float QUATERNION_COMPONENT_LIMIT = 0.707106781f;
+	const float QUANTIZED_MAXIMUM = 65535.0f;
+
+	// the number of transforms sampled by one kernel call
+	const int SAMPLE_BATCH = 4;
+	// the blended values of a transform - position xyz, rotation
+	// quaternion xyzw and scale xyz
+	const int SAMPLE_COMPONENTS = 10;
+	const int POSITION_COMPONENT = 0;
+	const int ROTATION_COMPONENT = 3;
+	const int SCALE_COMPONENT = 7;
+
+	/***********************************************************
+	 *  ComponentChannel()
+	 *
+	 *  This function is used for finding the channel that a
+	 *  blended component belongs to.
+	 ***********************************************************/
+	inline int ComponentChannel(int component)
+	{
+		if (component < ROTATION_COMPONENT)
+		{
+			return(CHANNEL_POSITION);
+		}
+		return((component < SCALE_COMPONENT) ? CHANNEL_ROTATION : CHANNEL_SCALE);
+	}
+
+	// the keys of one batch, one row of lanes per component
+	struct SAMPLE_BUFFERS
+	{
+		// the quantized values of the keys on both sides of the
+		// sample - position xyz, three rotation components, scale xyz
+		alignas(16) float quantizedA[9][SAMPLE_BATCH];
+		alignas(16) float quantizedB[9][SAMPLE_BATCH];
+		// the track ranges expanding the position and scale values
+		alignas(16) float minimum[6][SAMPLE_BATCH];
+		alignas(16) float step[6][SAMPLE_BATCH];
+		// the index of the left out rotation component of each key
+		alignas(16) float largestA[SAMPLE_BATCH];
+		alignas(16) float largestB[SAMPLE_BATCH];
+		// the blend between the keys of each channel
+		alignas(16) float blend[CHANNEL_COUNT][SAMPLE_BATCH];
+		alignas(16) float keyA[SAMPLE_COMPONENTS][SAMPLE_BATCH];
+		alignas(16) float keyB[SAMPLE_COMPONENTS][SAMPLE_BATCH];
+		alignas(16) float result[SAMPLE_COMPONENTS][SAMPLE_BATCH];
+	};
+
+	/***********************************************************
+	 *  EulerToQuaternion()
+	 *
+	 *  This function is used for converting XYZ rotations in
+	 *  degrees to the quaternion of rotZ * rotY * rotX, which
+	 *  is the order used by SetTransformations().
+	 ***********************************************************/
+	glm::vec4 EulerToQuaternion(float XrotationDegrees, float YrotationDegrees, float ZrotationDegrees)
+	{
+		float halfX = XrotationDegrees * DEGREES_TO_RADIANS * 0.5f;
+		float halfY = YrotationDegrees * DEGREES_TO_RADIANS * 0.5f;
+		float halfZ = ZrotationDegrees * DEGREES_TO_RADIANS * 0.5f;
+		float cx = cosf(halfX), sx = sinf(halfX);
+		float cy = cosf(halfY), sy = sinf(halfY);
+		float cz = cosf(halfZ), sz = sinf(halfZ);
+
+		return(glm::vec4(
+			sx * cy * cz - cx * sy * sz,
+			cx * sy * cz + sx * cy * sz,
+			cx * cy * sz - sx * sy * cz,
+			cx * cy * cz + sx * sy * sz));
+	}
+
+	/***********************************************************
+	 *  QuaternionToEuler()
+	 *
+	 *  This function is used for converting a unit quaternion
+	 *  back to the XYZ rotations in radians of the transform
+	 *  store.
+	 ***********************************************************/
+	void QuaternionToEuler(float x, float y, float z, float w, float& rotationX, float& rotationY, float& rotationZ)
+	{
+		float sinY = 2.0f * (w * y - x * z);
+
+		if (fabsf(sinY) >= 0.99999f)
+		{
+			// looking straight along the Y axis only the difference
+			// of the X and Z rotations is defined, so it is all put
+			// into the X rotation
+			rotationY = copysignf(1.5707963f, sinY);
+			rotationX = 2.0f * atan2f(x, w);
+			rotationZ = 0.0f;
+			return;
+		}
+
+		rotationX = atan2f(2.0f * (w * x + y * z), 1.0f - 2.0f * (x * x + y * y));
+		rotationY = asinf(sinY);
+		rotationZ = atan2f(2.0f * (w * z + x * y), 1.0f - 2.0f * (y * y + z * z));
+	}
+
+	/***********************************************************
+	 *  NlerpQuaternion()
+	 *
+	 *  This function is used for blending two quaternions along
+	 *  the shorter arc, used while reducing the rotation keys.
+	 ***********************************************************/
+	glm::vec4 NlerpQuaternion(const glm::vec4& keyA, const glm::vec4& keyB, float blend)
+	{
+		glm::vec4 target = keyB;
+		if (glm::dot(keyA, keyB) < 0.0f)
+		{
+			target = -keyB;
+		}
+
+		return(glm::normalize(keyA + (target - keyA) * blend));
+	}
+
+	/***********************************************************
+	 *  ExpandBatch()
+	 *
+	 *  This function is used for expanding the quantized keys
+	 *  of a batch.  The left out rotation component is rebuilt
+	 *  from the unit length and moved into place with masks,
+	 *  since every lane may leave out a different component.
+	 ***********************************************************/
+	void ExpandBatch(SAMPLE_BUFFERS& buffers)
+	{
+		const float rotationStep = (2.0f * QUATERNION_COMPONENT_LIMIT) / QUANTIZED_MAXIMUM;
+		float (*quantized[2])[SAMPLE_BATCH] = { buffers.quantizedA, buffers.quantizedB };
+		float (*keys[2])[SAMPLE_BATCH] = { buffers.keyA, buffers.keyB };
+		const float* largest[2] = { buffers.largestA, buffers.largestB };
+
+		for (int side = 0; side < 2; side++)
+		{
+#if defined(ANIMATION_USE_SSE2)
+			for (int c = 0; c < 3; c++)
+			{
+				_mm_store_ps(keys[side][POSITION_COMPONENT + c], _mm_add_ps(_mm_load_ps(buffers.minimum[c]),
+					_mm_mul_ps(_mm_load_ps(quantized[side][c]), _mm_load_ps(buffers.step[c]))));
+				_mm_store_ps(keys[side][SCALE_COMPONENT + c], _mm_add_ps(_mm_load_ps(buffers.minimum[3 + c]),
+					_mm_mul_ps(_mm_load_ps(quantized[side][6 + c]), _mm_load_ps(buffers.step[3 + c]))));
+			}
+
+			__m128 stored[3];
+			__m128 lengthSquared = _mm_setzero_ps();
+			for (int c = 0; c < 3; c++)
+			{
+				stored[c] = _mm_sub_ps(_mm_mul_ps(_mm_load_ps(quantized[side][3 + c]), _mm_set1_ps(rotationStep)),
+					_mm_set1_ps(QUATERNION_COMPONENT_LIMIT));
+				lengthSquared = _mm_add_ps(lengthSquared, _mm_mul_ps(stored[c], stored[c]));
+			}
+			__m128 rebuilt = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.0f), lengthSquared), _mm_setzero_ps()));
+
+			// the stored components fill the slots around the left out one
+			__m128 index = _mm_load_ps(largest[side]);
+			__m128 isX = _mm_cmpeq_ps(index, _mm_set1_ps(0.0f));
+			__m128 isY = _mm_cmpeq_ps(index, _mm_set1_ps(1.0f));
+			__m128 isZ = _mm_cmpeq_ps(index, _mm_set1_ps(2.0f));
+			__m128 isW = _mm_cmpeq_ps(index, _mm_set1_ps(3.0f));
+			__m128 beforeZ = _mm_or_ps(isX, isY);
+
+			__m128 x = _mm_or_ps(_mm_and_ps(isX, rebuilt), _mm_andnot_ps(isX, stored[0]));
+			__m128 y = _mm_or_ps(_mm_and_ps(isX, stored[0]),
+				_mm_or_ps(_mm_and_ps(isY, rebuilt), _mm_andnot_ps(beforeZ, stored[1])));
+			__m128 z = _mm_or_ps(_mm_and_ps(beforeZ, stored[1]),
+				_mm_or_ps(_mm_and_ps(isZ, rebuilt), _mm_and_ps(isW, stored[2])));
+			__m128 w = _mm_or_ps(_mm_and_ps(isW, rebuilt), _mm_andnot_ps(isW, stored[2]));
+
+			_mm_store_ps(keys[side][ROTATION_COMPONENT + 0], x);
+			_mm_store_ps(keys[side][ROTATION_COMPONENT + 1], y);
+			_mm_store_ps(keys[side][ROTATION_COMPONENT + 2], z);
+			_mm_store_ps(keys[side][ROTATION_COMPONENT + 3], w);
+#elif defined(ANIMATION_USE_NEON)
+			for (int c = 0; c < 3; c++)
+			{
+				vst1q_f32(keys[side][POSITION_COMPONENT + c], vmlaq_f32(vld1q_f32(buffers.minimum[c]),
+					vld1q_f32(quantized[side][c]), vld1q_f32(buffers.step[c])));
+				vst1q_f32(keys[side][SCALE_COMPONENT + c], vmlaq_f32(vld1q_f32(buffers.minimum[3 + c]),
+					vld1q_f32(quantized[side][6 + c]), vld1q_f32(buffers.step[3 + c])));
+			}
+
+			float32x4_t stored[3];
+			float32x4_t lengthSquared = vdupq_n_f32(0.0f);
+			for (int c = 0; c < 3; c++)
+			{
+				stored[c] = vsubq_f32(vmulq_n_f32(vld1q_f32(quantized[side][3 + c]), rotationStep),
+					vdupq_n_f32(QUATERNION_COMPONENT_LIMIT));
+				lengthSquared = vmlaq_f32(lengthSquared, stored[c], stored[c]);
+			}
+			float32x4_t rebuilt = vsqrtq_f32(vmaxq_f32(vsubq_f32(vdupq_n_f32(1.0f), lengthSquared), vdupq_n_f32(0.0f)));
+
+			// the stored components fill the slots around the left out one
+			float32x4_t index = vld1q_f32(largest[side]);
+			uint32x4_t isX = vceqq_f32(index, vdupq_n_f32(0.0f));
+			uint32x4_t isY = vceqq_f32(index, vdupq_n_f32(1.0f));
+			uint32x4_t isZ = vceqq_f32(index, vdupq_n_f32(2.0f));
+			uint32x4_t isW = vceqq_f32(index, vdupq_n_f32(3.0f));
+			uint32x4_t beforeZ = vorrq_u32(isX, isY);
+
+			vst1q_f32(keys[side][ROTATION_COMPONENT + 0], vbslq_f32(isX, rebuilt, stored[0]));
+			vst1q_f32(keys[side][ROTATION_COMPONENT + 1], vbslq_f32(isX, stored[0], vbslq_f32(isY, rebuilt, stored[1])));
+			vst1q_f32(keys[side][ROTATION_COMPONENT + 2], vbslq_f32(beforeZ, stored[1], vbslq_f32(isZ, rebuilt, stored[2])));
+			vst1q_f32(keys[side][ROTATION_COMPONENT + 3], vbslq_f32(isW, rebuilt, stored[2]));
+#else
+			for (int lane = 0; lane < SAMPLE_BATCH; lane++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					keys[side][POSITION_COMPONENT + c][lane] = buffers.minimum[c][lane] + quantized[side][c][lane] * buffers.step[c][lane];
+					keys[side][SCALE_COMPONENT + c][lane] = buffers.minimum[3 + c][lane] + quantized[side][6 + c][lane] * buffers.step[3 + c][lane];
+				}
+
+				int leftOut = (int)largest[side][lane];
+				int value = 0;
+				float lengthSquared = 0.0f;
+				for (int c = 0; c < 4; c++)
+				{
+					if (c != leftOut)
+					{
+						float component = quantized[side][3 + value][lane] * rotationStep - QUATERNION_COMPONENT_LIMIT;
+						keys[side][ROTATION_COMPONENT + c][lane] = component;
+						lengthSquared += component * component;
+						value++;
+					}
+				}
+				keys[side][ROTATION_COMPONENT + leftOut][lane] = sqrtf(std::max(1.0f - lengthSquared, 0.0f));
+			}
+#endif
+		}
+	}
+
+	/***********************************************************
+	 *  BlendBatch()
+	 *
+	 *  This function is used for blending the key buffers of a
+	 *  batch - positions and scales are interpolated linearly
+	 *  and the quaternions are normalized after the blend.
+	 ***********************************************************/
+	void BlendBatch(SAMPLE_BUFFERS& buffers)
+	{
+#if defined(ANIMATION_USE_SSE2)
+		// flip the second quaternion onto the shorter arc
+		__m128 dot = _mm_setzero_ps();
+		for (int c = ROTATION_COMPONENT; c < ROTATION_COMPONENT + 4; c++)
+		{
+			dot = _mm_add_ps(dot, _mm_mul_ps(_mm_load_ps(buffers.keyA[c]), _mm_load_ps(buffers.keyB[c])));
+		}
+		__m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+		for (int c = ROTATION_COMPONENT; c < ROTATION_COMPONENT + 4; c++)
+		{
+			_mm_store_ps(buffers.keyB[c], _mm_xor_ps(_mm_load_ps(buffers.keyB[c]), flip));
+		}
+
+		for (int c = 0; c < SAMPLE_COMPONENTS; c++)
+		{
+			__m128 keyA = _mm_load_ps(buffers.keyA[c]);
+			__m128 keyB = _mm_load_ps(buffers.keyB[c]);
+			__m128 blend = _mm_load_ps(buffers.blend[ComponentChannel(c)]);
+			_mm_store_ps(buffers.result[c], _mm_add_ps(keyA, _mm_mul_ps(_mm_sub_ps(keyB, keyA), blend)));
+		}
+
+		__m128 lengthSquared = _mm_setzero_ps();
+		for (int c = ROTATION_COMPONENT; c < ROTATION_COMPONENT + 4; c++)
+		{
+			__m128 value = _mm_load_ps(buffers.result[c]);
+			lengthSquared = _mm_add_ps(lengthSquared, _mm_mul_ps(value, value));
+		}
+		__m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSquared));
+		for (int c = ROTATION_COMPONENT; c < ROTATION_COMPONENT + 4; c++)
+		{
+			_mm_store_ps(buffers.result[c], _mm_mul_ps(_mm_load_ps(buffers.result[c]), inverseLength));
+		}
+#elif defined(ANIMATION_USE_NEON)
+		// flip the second quaternion onto the shorter arc
+		float32x4_t dot = vdupq_n_f32(0.0f);
+		for (int c = ROTATION_COMPONENT; c < ROTATION_COMPONENT + 4; c++)
+		{
+			dot = vmlaq_f32(dot, vld1q_f32(buffers.keyA[c]), vld1q_f32(buffers.keyB[c]));
+		}
+		uint32x4_t flip = vandq_u32(vcltq_f32(dot, vdupq_n_f32(0.0f)), vdupq_n_u32(0x80000000u));
+		for (int c = ROTATION_COMPONENT; c < ROTATION_COMPONENT + 4; c++)
+		{
+			vst1q_f32(buffers.keyB[c], vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vld1q_f32(buffers.keyB[c])), flip)));
+		}
+
+		for (int c = 0; c < SAMPLE_COMPONENTS; c++)
+		{
+			float32x4_t keyA = vld1q_f32(buffers.keyA[c]);
+			float32x4_t keyB = vld1q_f32(buffers.keyB[c]);
+			float32x4_t blend = vld1q_f32(buffers.blend[ComponentChannel(c)]);
+			vst1q_f32(buffers.result[c], vmlaq_f32(keyA, vsubq_f32(keyB, keyA), blend));
+		}
+
+		float32x4_t lengthSquared = vdupq_n_f32(0.0f);
+		for (int c = ROTATION_COMPONENT; c < ROTATION_COMPONENT + 4; c++)
+		{
+			float32x4_t value = vld1q_f32(buffers.result[c]);
+			lengthSquared = vmlaq_f32(lengthSquared, value, value);
+		}
+		float32x4_t inverseLength = vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(lengthSquared));
+		for (int c = ROTATION_COMPONENT; c < ROTATION_COMPONENT + 4; c++)
+		{
+			vst1q_f32(buffers.result[c], vmulq_f32(vld1q_f32(buffers.result[c]), inverseLength));
+		}
+#else
+		for (int lane = 0; lane < SAMPLE_BATCH; lane++)
+		{
+			float dot = 0.0f;
+			for (int c = ROTATION_COMPONENT; c < ROTATION_COMPONENT + 4; c++)
+			{
+				dot += buffers.keyA[c][lane] * buffers.keyB[c][lane];
+			}
+			if (dot < 0.0f)
+			{
+				for (int c = ROTATION_COMPONENT; c < ROTATION_COMPONENT + 4; c++)
+				{
+					buffers.keyB[c][lane] = -buffers.keyB[c][lane];
+				}
+			}
+
+			for (int c = 0; c < SAMPLE_COMPONENTS; c++)
+			{
+				buffers.result[c][lane] = buffers.keyA[c][lane] +
+					(buffers.keyB[c][lane] - buffers.keyA[c][lane]) * buffers.blend[ComponentChannel(c)][lane];
+			}
+
+			float lengthSquared = 0.0f;
+			for (int c = ROTATION_COMPONENT; c < ROTATION_COMPONENT + 4; c++)
+			{
+				lengthSquared += buffers.result[c][lane] * buffers.result[c][lane];
+			}
+			float inverseLength = 1.0f / sqrtf(lengthSquared);
+			for (int c = ROTATION_COMPONENT; c < ROTATION_COMPONENT + 4; c++)
+			{
+				buffers.result[c][lane] *= inverseLength;
+			}
+		}
+#endif
+	}
+}
+
+/***********************************************************
+ *  AnimationClip()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+AnimationClip::AnimationClip(float duration)
+{
+	m_duration = (duration > 0.0f) ? duration : 1.0f;
+	m_bCompressed = false;
+}
+
+/***********************************************************
+ *  AddPositionKey()
+ *
+ *  This method is used for adding an authored position key.
+ ***********************************************************/
+void AnimationClip::AddPositionKey(float time, glm::vec3 positionXYZ)
+{
+	AUTHORED_KEY key;
+	key.time = time;
+	key.value = glm::vec4(positionXYZ, 0.0f);
+	m_authoredKeys[CHANNEL_POSITION].push_back(key);
+}
+
+/***********************************************************
+ *  AddRotationKey()
+ *
+ *  This method is used for adding an authored rotation key.
+ ***********************************************************/
+void AnimationClip::AddRotationKey(float time, float XrotationDegrees, float YrotationDegrees, float ZrotationDegrees)
+{
+	AUTHORED_KEY key;
+	key.time = time;
+	key.value = EulerToQuaternion(XrotationDegrees, YrotationDegrees, ZrotationDegrees);
+	m_authoredKeys[CHANNEL_ROTATION].push_back(key);
+}
+
+/***********************************************************
+ *  AddScaleKey()
+ *
+ *  This method is used for adding an authored scale key.
+ ***********************************************************/
+void AnimationClip::AddScaleKey(float time, glm::vec3 scaleXYZ)
+{
+	AUTHORED_KEY key;
+	key.time = time;
+	key.value = glm::vec4(scaleXYZ, 0.0f);
+	m_authoredKeys[CHANNEL_SCALE].push_back(key);
+}
+
+/***********************************************************
+ *  HasChannel()
+ *
+ *  This method is used for checking whether the clip has
+ *  keys for the passed in channel.
+ ***********************************************************/
+bool AnimationClip::HasChannel(int channel) const
+{
+	if (m_bCompressed)
+	{
+		return(m_tracks[channel].times.size() > 0);
+	}
+	return(m_authoredKeys[channel].size() > 0);
+}
+
+/***********************************************************
+ *  GetKeyCount()
+ *
+ *  This method is used for getting the number of keys of
+ *  the passed in channel.
+ ***********************************************************/
+int AnimationClip::GetKeyCount(int channel) const
+{
+	if (m_bCompressed)
+	{
+		return((int)m_tracks[channel].times.size());
+	}
+	return((int)m_authoredKeys[channel].size());
+}
+
+/***********************************************************
+ *  GetCompressedSize()
+ *
+ *  This method is used for getting the number of bytes of
+ *  key data kept by the compressed clip.
+ ***********************************************************/
+int AnimationClip::GetCompressedSize() const
+{
+	int size = 0;
+
+	for (int channel = 0; channel < CHANNEL_COUNT; channel++)
+	{
+		size += (int)(m_tracks[channel].times.size() * sizeof(uint16_t));
+		size += (int)(m_tracks[channel].values.size() * sizeof(uint16_t));
+		size += (int)(m_tracks[channel].largestComponent.size() * sizeof(uint8_t));
+	}
+
+	return(size);
+}
+
+/***********************************************************
+ *  ReduceKeys()
+ *
+ *  This method is used for selecting the keys to keep.
+ *  Starting from the last kept key, the segment is grown
+ *  for as long as every skipped key is reproduced by the
+ *  interpolation within the tolerance.
+ ***********************************************************/
+void AnimationClip::ReduceKeys(int channel, float tolerance, std::vector<int>& keptKeys) const
+{
+	const std::vector<AUTHORED_KEY>& keys = m_authoredKeys[channel];
+	int keyCount = (int)keys.size();
+
+	keptKeys.clear();
+	if (keyCount == 0)
+	{
+		return;
+	}
+
+	keptKeys.push_back(0);
+	int anchor = 0;
+	for (int end = 2; end < keyCount; end++)
+	{
+		bool bWithinTolerance = true;
+		float segmentLength = keys[end].time - keys[anchor].time;
+
+		for (int skipped = anchor + 1; (skipped < end) && bWithinTolerance; skipped++)
+		{
+			float blend = (segmentLength > 0.0f) ? (keys[skipped].time - keys[anchor].time) / segmentLength : 0.0f;
+			float error = 0.0f;
+
+			if (channel == CHANNEL_ROTATION)
+			{
+				glm::vec4 interpolated = NlerpQuaternion(keys[anchor].value, keys[end].value, blend);
+				float cosHalfAngle = std::min(fabsf(glm::dot(interpolated, keys[skipped].value)), 1.0f);
+				error = 2.0f * acosf(cosHalfAngle) * RADIANS_TO_DEGREES;
+			}
+			else
+			{
+				glm::vec4 interpolated = keys[anchor].value + (keys[end].value - keys[anchor].value) * blend;
+				glm::vec4 difference = interpolated - keys[skipped].value;
+				error = std::max(fabsf(difference.x), std::max(fabsf(difference.y), fabsf(difference.z)));
+			}
+
+			bWithinTolerance = (error <= tolerance);
+		}
+
+		// the previous key ends the longest segment that fits
+		if (bWithinTolerance == false)
+		{
+			anchor = end - 1;
+			keptKeys.push_back(anchor);
+		}
+	}
+
+	if (keyCount > 1)
+	{
+		keptKeys.push_back(keyCount - 1);
+	}
+}
+
+/***********************************************************
+ *  QuantizeTrack()
+ *
+ *  This method is used for storing the kept keys of a
+ *  channel as 16 bit values.
+ ***********************************************************/
+void AnimationClip::QuantizeTrack(int channel, const std::vector<int>& keptKeys)
+{
+	const std::vector<AUTHORED_KEY>& keys = m_authoredKeys[channel];
+	COMPRESSED_TRACK& track = m_tracks[channel];
+
+	track.times.clear();
+	track.values.clear();
+	track.largestComponent.clear();
+	track.minimum = glm::vec3(0.0f);
+	track.extent = glm::vec3(0.0f);
+
+	if (keptKeys.size() == 0)
+	{
+		return;
+	}
+
+	if (channel != CHANNEL_ROTATION)
+	{
+		glm::vec3 minimum = glm::vec3(keys[keptKeys[0]].value);
+		glm::vec3 maximum = minimum;
+		for (size_t i = 1; i < keptKeys.size(); i++)
+		{
+			minimum = glm::min(minimum, glm::vec3(keys[keptKeys[i]].value));
+			maximum = glm::max(maximum, glm::vec3(keys[keptKeys[i]].value));
+		}
+		track.minimum = minimum;
+		track.extent = maximum - minimum;
+	}
+
+	for (size_t i = 0; i < keptKeys.size(); i++)
+	{
+		const AUTHORED_KEY& key = keys[keptKeys[i]];
+		float time = std::min(std::max(key.time / m_duration, 0.0f), 1.0f);
+		track.times.push_back((uint16_t)(time * QUANTIZED_MAXIMUM + 0.5f));
+
+		if (channel == CHANNEL_ROTATION)
+		{
+			// the largest component is rebuilt from the unit length,
+			// and is kept positive since -q is the same rotation
+			glm::vec4 rotation = glm::normalize(key.value);
+			int largest = 0;
+			for (int c = 1; c < 4; c++)
+			{
+				if (fabsf(rotation[c]) > fabsf(rotation[largest]))
+				{
+					largest = c;
+				}
+			}
+			if (rotation[largest] < 0.0f)
+			{
+				rotation = -rotation;
+			}
+
+			track.largestComponent.push_back((uint8_t)largest);
+			for (int c = 0; c < 4; c++)
+			{
+				if (c != largest)
+				{
+					float normalized = (rotation[c] + QUATERNION_COMPONENT_LIMIT) / (2.0f * QUATERNION_COMPONENT_LIMIT);
+					normalized = std::min(std::max(normalized, 0.0f), 1.0f);
+					track.values.push_back((uint16_t)(normalized * QUANTIZED_MAXIMUM + 0.5f));
+				}
+			}
+		}
+		else
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				float normalized = (track.extent[c] > 0.0f) ? (key.value[c] - track.minimum[c]) / track.extent[c] : 0.0f;
+				track.values.push_back((uint16_t)(normalized * QUANTIZED_MAXIMUM + 0.5f));
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  Compress()
+ *
+ *  This method is used for building the compressed tracks
+ *  from the authored keys.  The authored keys are released
+ *  afterwards, since only the compressed tracks are sampled.
+ ***********************************************************/
+int AnimationClip::Compress(float positionTolerance, float rotationToleranceDegrees, float scaleTolerance)
+{
+	const float tolerances[CHANNEL_COUNT] = { positionTolerance, rotationToleranceDegrees, scaleTolerance };
+	std::vector<int> keptKeys;
+	int keptCount = 0;
+
+	for (int channel = 0; channel < CHANNEL_COUNT; channel++)
+	{
+		// the keys may have been added in any order
+		std::stable_sort(m_authoredKeys[channel].begin(), m_authoredKeys[channel].end(),
+			[](const AUTHORED_KEY& a, const AUTHORED_KEY& b) { return(a.time < b.time); });
+
+		ReduceKeys(channel, tolerances[channel], keptKeys);
+		QuantizeTrack(channel, keptKeys);
+		keptCount += (int)keptKeys.size();
+
+		m_authoredKeys[channel].clear();
+		m_authoredKeys[channel].shrink_to_fit();
+	}
+	m_bCompressed = true;
+
+	return(keptCount);
+}
+
+/***********************************************************
+ *  FindKey()
+ *
+ *  This method is used for finding the key before the
+ *  passed in time.  Playback moves forward in small steps,
+ *  so the search continues from the cursor of the previous
+ *  sample and restarts when the clip loops.
+ ***********************************************************/
+int AnimationClip::FindKey(int channel, float time, int& cursor, float& blend) const
+{
+	const std::vector<uint16_t>& times = m_tracks[channel].times;
+	int keyCount = (int)times.size();
+
+	blend = 0.0f;
+	if (keyCount < 2)
+	{
+		cursor = 0;
+		return(0);
+	}
+
+	float quantizedTime = std::min(std::max(time / m_duration, 0.0f), 1.0f) * QUANTIZED_MAXIMUM;
+
+	if ((cursor < 0) || (cursor > keyCount - 2) || (times[cursor] > quantizedTime))
+	{
+		cursor = 0;
+	}
+	while ((cursor < keyCount - 2) && (times[cursor + 1] <= quantizedTime))
+	{
+		cursor++;
+	}
+
+	float segmentStart = times[cursor];
+	float segmentLength = (float)times[cursor + 1] - segmentStart;
+	if (segmentLength > 0.0f)
+	{
+		blend = std::min(std::max((quantizedTime - segmentStart) / segmentLength, 0.0f), 1.0f);
+	}
+
+	return(cursor);
+}
+
+/***********************************************************
+ *  AnimationSystem()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+AnimationSystem::AnimationSystem(TransformStore* pTransformStore)
+{
+	m_pTransformStore = pTransformStore;
+	m_bActiveListDirty = false;
+}
+
+/***********************************************************
+ *  ~AnimationSystem()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+AnimationSystem::~AnimationSystem()
+{
+	for (size_t i = 0; i < m_clips.size(); i++)
+	{
+		delete m_clips[i];
+	}
+	m_clips.clear();
+	m_bindings.clear();
+	m_activeBindings.clear();
+	m_pTransformStore = NULL;
+}
+
+/***********************************************************
+ *  AddClip()
+ *
+ *  This method is used for adding a clip to the system.
+ *  Clips that were not compressed yet are compressed with
+ *  tolerances below what is visible in the scene.
+ ***********************************************************/
+int AnimationSystem::AddClip(AnimationClip* pClip)
+{
+	if (NULL == pClip)
+	{
+		return(-1);
+	}
+
+	if (pClip->IsCompressed() == false)
+	{
+		pClip->Compress(0.001f, 0.1f, 0.001f);
+	}
+
+	m_clips.push_back(pClip);
+	return((int)m_clips.size() - 1);
+}
+
+/***********************************************************
+ *  BindClip()
+ *
+ *  This method is used for playing a clip on a transform.
+ ***********************************************************/
+int AnimationSystem::BindClip(int clip, int transform, float timeOffset, float speed, bool bLoop)
+{
+	if ((clip < 0) || (clip >= (int)m_clips.size()) ||
+		(NULL == m_pTransformStore) ||
+		(transform < 0) || (transform >= m_pTransformStore->GetTransformCount()))
+	{
+		return(-1);
+	}
+
+	ANIMATION_BINDING binding;
+	binding.clip = clip;
+	binding.transform = transform;
+	binding.timeOffset = timeOffset;
+	binding.speed = speed;
+	binding.bLoop = bLoop;
+	binding.bActive = true;
+	for (int channel = 0; channel < CHANNEL_COUNT; channel++)
+	{
+		binding.cursor[channel] = 0;
+	}
+
+	m_bindings.push_back(binding);
+	m_bActiveListDirty = true;
+
+	return((int)m_bindings.size() - 1);
+}
+
+/***********************************************************
+ *  SetBindingActive()
+ *
+ *  This method is used for pausing and resuming a binding -
+ *  a paused transform keeps its last sampled pose.
+ ***********************************************************/
+void AnimationSystem::SetBindingActive(int binding, bool bActive)
+{
+	if ((binding >= 0) && (binding < (int)m_bindings.size()) &&
+		(m_bindings[binding].bActive != bActive))
+	{
+		m_bindings[binding].bActive = bActive;
+		m_bActiveListDirty = true;
+	}
+}
+
+/***********************************************************
+ *  IsTransformAnimated()
+ *
+ *  This method is used for checking whether any clip is
+ *  bound to the passed in transform.
+ ***********************************************************/
+bool AnimationSystem::IsTransformAnimated(int transform) const
+{
+	for (size_t i = 0; i < m_bindings.size(); i++)
+	{
+		if (m_bindings[i].transform == transform)
+		{
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
+/***********************************************************
+ *  SampleBatch()
+ *
+ *  This method is used for sampling up to four bindings.
+ *  The keys are decoded into the lanes of the key buffers,
+ *  blended together, and scattered into the store arrays.
+ ***********************************************************/
+void AnimationSystem::SampleBatch(const int* bindings, int count, float time)
+{
+	SAMPLE_BUFFERS buffers;
+
+	for (int lane = 0; lane < SAMPLE_BATCH; lane++)
+	{
+		// unused lanes repeat the first binding of the batch
+		ANIMATION_BINDING& binding = m_bindings[bindings[(lane < count) ? lane : 0]];
+		const AnimationClip* pClip = m_clips[binding.clip];
+
+		float clipTime = (time - binding.timeOffset) * binding.speed;
+		if (binding.bLoop)
+		{
+			clipTime = fmodf(clipTime, pClip->GetDuration());
+			if (clipTime < 0.0f)
+			{
+				clipTime += pClip->GetDuration();
+			}
+		}
+
+		// gather the quantized keys on both sides of the sample - a
+		// channel without keys expands to zero and is not written
+		for (int channel = 0; channel < CHANNEL_COUNT; channel++)
+		{
+			const uint16_t* valuesA = NULL;
+			const uint16_t* valuesB = NULL;
+			int largestA = 3;
+			int largestB = 3;
+			float blend = 0.0f;
+
+			if (pClip->HasChannel(channel))
+			{
+				int key = pClip->FindKey(channel, clipTime, binding.cursor[channel], blend);
+				int nextKey = std::min(key + 1, pClip->GetKeyCount(channel) - 1);
+				valuesA = pClip->GetKeyValues(channel, key);
+				valuesB = pClip->GetKeyValues(channel, nextKey);
+				if (channel == CHANNEL_ROTATION)
+				{
+					largestA = pClip->GetLargestComponent(key);
+					largestB = pClip->GetLargestComponent(nextKey);
+				}
+			}
+
+			int row = channel * 3;
+			for (int c = 0; c < 3; c++)
+			{
+				buffers.quantizedA[row + c][lane] = (NULL != valuesA) ? (float)valuesA[c] : 0.0f;
+				buffers.quantizedB[row + c][lane] = (NULL != valuesB) ? (float)valuesB[c] : 0.0f;
+			}
+			buffers.blend[channel][lane] = blend;
+
+			if (channel == CHANNEL_ROTATION)
+			{
+				buffers.largestA[lane] = (float)largestA;
+				buffers.largestB[lane] = (float)largestB;
+			}
+			else
+			{
+				int rangeRow = (channel == CHANNEL_POSITION) ? 0 : 3;
+				glm::vec3 minimum = pClip->GetTrackMinimum(channel);
+				glm::vec3 extent = pClip->GetTrackExtent(channel);
+				for (int c = 0; c < 3; c++)
+				{
+					buffers.minimum[rangeRow + c][lane] = minimum[c];
+					buffers.step[rangeRow + c][lane] = extent[c] / QUANTIZED_MAXIMUM;
+				}
+			}
+		}
+	}
+
+	ExpandBatch(buffers);
+	BlendBatch(buffers);
+
+	double* position[3];
+	float* rotation[3];
+	float* scale[3];
+	for (int axis = 0; axis < 3; axis++)
+	{
+		position[axis] = m_pTransformStore->GetPositionArray(axis);
+		rotation[axis] = m_pTransformStore->GetRotationArray(axis);
+		scale[axis] = m_pTransformStore->GetScaleArray(axis);
+	}
+
+	// write the blended poses into the store - the channels that
+	// a clip does not animate keep the values of the transform
+	for (int lane = 0; lane < count; lane++)
+	{
+		const ANIMATION_BINDING& binding = m_bindings[bindings[lane]];
+		const AnimationClip* pClip = m_clips[binding.clip];
+		int transform = binding.transform;
+
+		if (pClip->HasChannel(CHANNEL_POSITION))
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				position[axis][transform] = buffers.result[POSITION_COMPONENT + axis][lane];
+			}
+		}
+		if (pClip->HasChannel(CHANNEL_ROTATION))
+		{
+			QuaternionToEuler(
+				buffers.result[ROTATION_COMPONENT + 0][lane],
+				buffers.result[ROTATION_COMPONENT + 1][lane],
+				buffers.result[ROTATION_COMPONENT + 2][lane],
+				buffers.result[ROTATION_COMPONENT + 3][lane],
+				rotation[0][transform],
+				rotation[1][transform],
+				rotation[2][transform]);
+		}
+		if (pClip->HasChannel(CHANNEL_SCALE))
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				scale[axis][transform] = buffers.result[SCALE_COMPONENT + axis][lane];
+			}
+		}
+		m_pTransformStore->MarkRangeDirty(transform, 1);
+	}
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for sampling every active binding.
+ ***********************************************************/
+int AnimationSystem::Update(float time)
+{
+	if ((NULL == m_pTransformStore) || (m_bindings.size() == 0))
+	{
+		return(0);
+	}
+
+	if (m_bActiveListDirty)
+	{
+		m_activeBindings.clear();
+		for (size_t i = 0; i < m_bindings.size(); i++)
+		{
+			if (m_bindings[i].bActive)
+			{
+				m_activeBindings.push_back((int)i);
+			}
+		}
+
+		// group the bindings by clip, and by transform within a
+		// clip so that the store arrays are written in order
+		std::sort(m_activeBindings.begin(), m_activeBindings.end(),
+			[this](int a, int b)
+			{
+				if (m_bindings[a].clip != m_bindings[b].clip)
+				{
+					return(m_bindings[a].clip < m_bindings[b].clip);
+				}
+				return(m_bindings[a].transform < m_bindings[b].transform);
+			});
+		m_bActiveListDirty = false;
+	}
+
+	int activeCount = (int)m_activeBindings.size();
+	for (int first = 0; first < activeCount; first += SAMPLE_BATCH)
+	{
+		SampleBatch(&m_activeBindings[first], std::min(SAMPLE_BATCH, activeCount - first), time);
+	}
+
+	return(activeCount);
+}
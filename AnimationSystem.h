@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////
+// animationsystem.h
+// =================
+// play keyframed animation clips on the scene object transformations - the
+// clips are stored compressed and sampled in SIMD batches
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "TransformStore.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// the parts of a transformation that a clip can animate
+enum ANIMATION_CHANNEL
+{
+	CHANNEL_POSITION = 0,
+	CHANNEL_ROTATION,
+	CHANNEL_SCALE,
+	CHANNEL_COUNT
+};
+
+/***********************************************************
+ *  AnimationClip
+ *
+ *  This class holds the keys of one animation.  The keys
+ *  are authored at full precision, then Compress() drops
+ *  every key that the interpolation of its neighbours
+ *  reproduces within a tolerance and quantizes the rest to
+ *  16 bits - positions and scales relative to the range of
+ *  their track, and rotations as quaternions with the
+ *  largest component left out.
+ ***********************************************************/
+class AnimationClip
+{
+public:
+	AnimationClip(float duration);
+
+	// add the authored keys - the rotations are passed in degrees
+	// like SetTransformations() and stored as quaternions
+	void AddPositionKey(float time, glm::vec3 positionXYZ);
+	void AddRotationKey(float time, float XrotationDegrees, float YrotationDegrees, float ZrotationDegrees);
+	void AddScaleKey(float time, glm::vec3 scaleXYZ);
+
+	// reduce and quantize the authored keys - the tolerances are in
+	// world units and degrees, and the number of kept keys is returned
+	int Compress(float positionTolerance, float rotationToleranceDegrees, float scaleTolerance);
+
+	// find the key before the passed in clip time, starting the
+	// search from the cursor of the previous sample - the blend
+	// towards the following key is returned in blend
+	int FindKey(int channel, float time, int& cursor, float& blend) const;
+
+	// the quantized keys, expanded by the animation system
+	const uint16_t* GetKeyValues(int channel, int key) const { return(&m_tracks[channel].values[key * 3]); }
+	int GetLargestComponent(int key) const { return(m_tracks[CHANNEL_ROTATION].largestComponent[key]); }
+	glm::vec3 GetTrackMinimum(int channel) const { return(m_tracks[channel].minimum); }
+	glm::vec3 GetTrackExtent(int channel) const { return(m_tracks[channel].extent); }
+
+	bool IsCompressed() const { return(m_bCompressed); }
+	bool HasChannel(int channel) const;
+	float GetDuration() const { return(m_duration); }
+	int GetKeyCount(int channel) const;
+	// the number of bytes taken by the compressed keys
+	int GetCompressedSize() const;
+
+private:
+	struct AUTHORED_KEY
+	{
+		float time;
+		glm::vec4 value;
+	};
+
+	struct COMPRESSED_TRACK
+	{
+		// the key times as fractions of the clip duration
+		std::vector<uint16_t> times;
+		// three quantized components for each key
+		std::vector<uint16_t> values;
+		// the index of the left out component of each rotation key
+		std::vector<uint8_t> largestComponent;
+		glm::vec3 minimum;
+		glm::vec3 extent;
+	};
+
+	void ReduceKeys(int channel, float tolerance, std::vector<int>& keptKeys) const;
+	void QuantizeTrack(int channel, const std::vector<int>& keptKeys);
+
+	float m_duration;
+	std::vector<AUTHORED_KEY> m_authoredKeys[CHANNEL_COUNT];
+	COMPRESSED_TRACK m_tracks[CHANNEL_COUNT];
+	bool m_bCompressed;
+};
+
+/***********************************************************
+ *  AnimationSystem
+ *
+ *  This class binds clips to transforms of the transform
+ *  store.  Every update the bound clips are sampled four
+ *  transforms at a time - the quantized keys are gathered
+ *  into small structure of arrays buffers, expanded and
+ *  blended with SIMD, and the results are written straight
+ *  into the store arrays.
+ ***********************************************************/
+class AnimationSystem
+{
+public:
+	AnimationSystem(TransformStore* pTransformStore);
+	~AnimationSystem();
+
+	// add a compressed clip - the system takes ownership of it
+	int AddClip(AnimationClip* pClip);
+	// play a clip on a transform and return the binding handle
+	int BindClip(int clip, int transform, float timeOffset = 0.0f, float speed = 1.0f, bool bLoop = true);
+	void SetBindingActive(int binding, bool bActive);
+	// true when a clip is bound to the transform, even when paused
+	bool IsTransformAnimated(int transform) const;
+
+	// sample every active binding at the passed in time in seconds
+	// and return the number of animated transforms
+	int Update(float time);
+
+	int GetBindingCount() const { return((int)m_bindings.size()); }
+	int GetBindingTransform(int binding) const { return(m_bindings[binding].transform); }
+	bool IsBindingActive(int binding) const { return(m_bindings[binding].bActive); }
+
+private:
+	struct ANIMATION_BINDING
+	{
+		int clip;
+		int transform;
+		float timeOffset;
+		float speed;
+		bool bLoop;
+		bool bActive;
+		// the key searched from on the next sample of each channel
+		int cursor[CHANNEL_COUNT];
+	};
+
+	void SampleBatch(const int* bindings, int count, float time);
+
+	TransformStore* m_pTransformStore;
+	std::vector<AnimationClip*> m_clips;
+	std::vector<ANIMATION_BINDING> m_bindings;
+	// the active binding indices grouped by clip, so that the same
+	// compressed keys are decoded back to back
+	std::vector<int> m_activeBindings;
+	bool m_bActiveListDirty;
+};
@@ -0,0 +1,481 @@
+///////////////////////////////////////////////////////////////////////////////
+// batchrenderer.cpp
+// =================
+// render a list of camera poses into image files without showing a window
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "BatchRenderer.h"
+#include "ImageWriter.h"
+#include "RenderOrigin.h"
+#include "RenderSettings.h"
+#include "ViewLayout.h"
+#include "WorldStreamer.h"
+#include "Logger.h"
+
+#include "GLFW/glfw3.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+// GLM Math Header inclusions
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/transform.hpp>
+
+// declaration of global variables
+namespace
+{
+	// the pixel buffers the poses are copied into - a buffer is
+	// mapped again once this many later poses have been drawn
+	const int READBACK_SLOTS = 3;
+	// the reflection probe is captured one face per frame, so the
+	// first pose is drawn this many times before any image is kept
+	const int WARMUP_FRAMES = 8;
+	// the longest wait for the streamed rooms around a pose
+	const int MAX_SETTLE_MILLISECONDS = 5000;
+	// the scene is drawn at the same time for every pose, so the
+	// animated lights and objects match between the images
+	const double POSE_SCENE_TIME = 0.0;
+	// the progress is printed every time this many poses are drawn
+	const int PROGRESS_INTERVAL = 100;
+}
+
+/***********************************************************
+ *  BatchRenderer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+BatchRenderer::BatchRenderer(ShaderManager* pShaderManager, SceneManager* pSceneManager)
+{
+	m_pShaderManager = pShaderManager;
+	m_pSceneManager = pSceneManager;
+	m_pThreadPool = new ThreadPool();
+	m_width = 0;
+	m_height = 0;
+	m_framebuffer = 0;
+	m_colorBuffer = 0;
+	m_depthBuffer = 0;
+	m_writtenCount.store(0);
+}
+
+/***********************************************************
+ *  ~BatchRenderer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+BatchRenderer::~BatchRenderer()
+{
+	// the workers finish writing the queued images first
+	if (NULL != m_pThreadPool)
+	{
+		delete m_pThreadPool;
+		m_pThreadPool = NULL;
+	}
+	DestroyTarget();
+	m_pShaderManager = NULL;
+	m_pSceneManager = NULL;
+}
+
+/***********************************************************
+ *  GetDefaultSettings()
+ *
+ *  This method is used for getting the settings of a run
+ *  that renders full HD images in a single process.
+ ***********************************************************/
+BATCH_SETTINGS BatchRenderer::GetDefaultSettings()
+{
+	BATCH_SETTINGS settings;
+	settings.poseFile = NULL;
+	settings.width = 1920;
+	settings.height = 1080;
+	settings.shardIndex = 0;
+	settings.shardCount = 1;
+
+	return(settings);
+}
+
+/***********************************************************
+ *  ParseArguments()
+ *
+ *  This method is used for reading the batch options from
+ *  the command line.  Options that are not batch options
+ *  are left for the other parsers.
+ ***********************************************************/
+bool BatchRenderer::ParseArguments(int argc, char* argv[], BATCH_SETTINGS& settings)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--batch") == 0) && (i + 1 < argc))
+		{
+			settings.poseFile = argv[++i];
+		}
+		else if ((strcmp(argv[i], "--batch-size") == 0) && (i + 1 < argc))
+		{
+			int width = 0, height = 0;
+			if ((sscanf(argv[++i], "%dx%d", &width, &height) != 2) ||
+				(width < 1) || (height < 1))
+			{
+				LOG_ERROR("the image size must be given as WxH, like 1920x1080");
+				return(false);
+			}
+			settings.width = width;
+			settings.height = height;
+		}
+		else if ((strcmp(argv[i], "--batch-shard") == 0) && (i + 1 < argc))
+		{
+			int shardIndex = 0, shardCount = 0;
+			if ((sscanf(argv[++i], "%d/%d", &shardIndex, &shardCount) != 2) ||
+				(shardCount < 1) || (shardIndex < 0) || (shardIndex >= shardCount))
+			{
+				LOG_ERROR("the shard must be given as I/N with I below N, like 0/4");
+				return(false);
+			}
+			settings.shardIndex = shardIndex;
+			settings.shardCount = shardCount;
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  LoadPoses()
+ *
+ *  This method is used for reading the poses rendered by
+ *  this process.  Empty lines and lines starting with # are
+ *  skipped, and the remaining lines are counted for the
+ *  shards in the order they appear in the file.
+ ***********************************************************/
+bool BatchRenderer::LoadPoses(const BATCH_SETTINGS& settings)
+{
+	m_poses.clear();
+	m_width = settings.width;
+	m_height = settings.height;
+	if (NULL == settings.poseFile)
+	{
+		return(false);
+	}
+
+	std::ifstream file(settings.poseFile);
+	if (!file)
+	{
+		LOG_ERROR("Could not read the camera poses from %s", settings.poseFile);
+		return(false);
+	}
+
+	std::string line;
+	int lineNumber = 0;
+	int poseIndex = 0;
+	while (std::getline(file, line))
+	{
+		lineNumber++;
+		size_t first = line.find_first_not_of(" \t\r");
+		if ((first == std::string::npos) || (line[first] == '#'))
+		{
+			continue;
+		}
+
+		BATCH_POSE pose;
+		std::istringstream fields(line);
+		fields >> pose.position.x >> pose.position.y >> pose.position.z
+			>> pose.target.x >> pose.target.y >> pose.target.z
+			>> pose.fieldOfView;
+		std::getline(fields >> std::ws, pose.path);
+		while ((pose.path.size() > 0) && ((pose.path.back() == '\r') || (pose.path.back() == ' ')))
+		{
+			pose.path.pop_back();
+		}
+		if ((fields.fail() == true) || (pose.path.size() == 0) ||
+			(pose.fieldOfView <= 0.0f) || (pose.fieldOfView >= 180.0f))
+		{
+			LOG_ERROR("Line %d of %s is not a camera pose", lineNumber, settings.poseFile);
+			return(false);
+		}
+
+		if (poseIndex % settings.shardCount == settings.shardIndex)
+		{
+			m_poses.push_back(pose);
+		}
+		poseIndex++;
+	}
+
+	LOG_INFO("Rendering %zu of %d camera poses at %d x %d", m_poses.size(), poseIndex, m_width, m_height);
+
+	return(true);
+}
+
+/***********************************************************
+ *  CreateTarget()
+ *
+ *  This method is used for allocating the offscreen target
+ *  the poses are drawn into, and the pixel buffers of the
+ *  readback ring.  The color is kept in half floats, so the
+ *  EXR images keep the values past one, and the PNG images
+ *  are clamped as they are read back.
+ ***********************************************************/
+bool BatchRenderer::CreateTarget()
+{
+	glGenFramebuffers(1, &m_framebuffer);
+	glGenRenderbuffers(1, &m_colorBuffer);
+	glGenRenderbuffers(1, &m_depthBuffer);
+
+	glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA16F, m_width, m_height);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, m_width, m_height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		LOG_ERROR("Batch framebuffer is incomplete: 0x%x", status);
+		return(false);
+	}
+
+	// every buffer holds a half float image, which is the larger
+	// of the two formats
+	GLsizeiptr bufferBytes = (GLsizeiptr)m_width * m_height * 3 * sizeof(GLushort);
+	m_slots.resize(READBACK_SLOTS);
+	for (int i = 0; i < READBACK_SLOTS; i++)
+	{
+		glGenBuffers(1, &m_slots[i].pixelBuffer);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, m_slots[i].pixelBuffer);
+		glBufferData(GL_PIXEL_PACK_BUFFER, bufferBytes, NULL, GL_STREAM_READ);
+		m_slots[i].fence = 0;
+		m_slots[i].pose = -1;
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	return(true);
+}
+
+/***********************************************************
+ *  DestroyTarget()
+ *
+ *  This method is used for freeing the OpenGL memory of
+ *  the target and the readback ring.
+ ***********************************************************/
+void BatchRenderer::DestroyTarget()
+{
+	for (size_t i = 0; i < m_slots.size(); i++)
+	{
+		if (m_slots[i].fence != 0)
+		{
+			glDeleteSync(m_slots[i].fence);
+		}
+		if (m_slots[i].pixelBuffer != 0)
+		{
+			glDeleteBuffers(1, &m_slots[i].pixelBuffer);
+		}
+	}
+	m_slots.clear();
+
+	if (m_framebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		m_framebuffer = 0;
+	}
+	if (m_colorBuffer != 0)
+	{
+		glDeleteRenderbuffers(1, &m_colorBuffer);
+		m_colorBuffer = 0;
+	}
+	if (m_depthBuffer != 0)
+	{
+		glDeleteRenderbuffers(1, &m_depthBuffer);
+		m_depthBuffer = 0;
+	}
+}
+
+/***********************************************************
+ *  RenderPose()
+ *
+ *  This method is used for drawing the scene from a pose
+ *  into the target.  The render origin is moved onto the
+ *  camera, and the streamed rooms around it are loaded
+ *  before the scene is drawn, so the images do not depend
+ *  on the poses drawn before them.
+ ***********************************************************/
+void BatchRenderer::RenderPose(const BATCH_POSE& pose)
+{
+	glfwSetTime(POSE_SCENE_TIME);
+	RenderOrigin::Set(pose.position);
+
+	WorldStreamer* pStreamer = WorldStreamer::GetScene();
+	if (NULL != pStreamer)
+	{
+		glm::vec3 cameraPosition = glm::vec3(pose.position);
+		for (int waited = 0; waited < MAX_SETTLE_MILLISECONDS; waited++)
+		{
+			pStreamer->Update(cameraPosition);
+			if (pStreamer->IsSettled() == true)
+			{
+				break;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	VIEW_SETTINGS view;
+	view.viewport[0] = 0;
+	view.viewport[1] = 0;
+	view.viewport[2] = m_width;
+	view.viewport[3] = m_height;
+	view.position = glm::vec3(0.0f);
+	view.view = glm::lookAt(view.position, RenderOrigin::ToRender(pose.target), glm::vec3(0.0f, 1.0f, 0.0f));
+	// the clip planes match the perspective view of the window
+	view.projection = glm::perspective(glm::radians(pose.fieldOfView),
+		(GLfloat)m_width / (GLfloat)m_height, RenderSettings::Get().nearPlane, RenderSettings::Get().farPlane);
+	view.framebuffer = m_framebuffer;
+	view.cullingView = 0;
+	ViewLayout::SetViews(&view, 1);
+
+	ViewLayout::ApplyView(0, m_pShaderManager);
+	m_pSceneManager->RenderScene();
+}
+
+/***********************************************************
+ *  CollectSlot()
+ *
+ *  This method is used for mapping a pixel buffer once its
+ *  copy has finished, and handing the pixels to the thread
+ *  pool to be written.  The copy was queued a few poses
+ *  earlier, so it has normally finished by now.  The number
+ *  of images waiting for a worker is kept small, so the
+ *  copies do not pile up in memory when writing them is
+ *  slower than drawing.
+ ***********************************************************/
+void BatchRenderer::CollectSlot(READBACK_SLOT& slot)
+{
+	GLenum status = GL_TIMEOUT_EXPIRED;
+	while (status == GL_TIMEOUT_EXPIRED)
+	{
+		status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+	}
+	glDeleteSync(slot.fence);
+	slot.fence = 0;
+
+	const BATCH_POSE& pose = m_poses[slot.pose];
+	slot.pose = -1;
+	if (status == GL_WAIT_FAILED)
+	{
+		LOG_ERROR("The image %s could not be read back", pose.path.c_str());
+		return;
+	}
+
+	bool bExr = ImageWriter::IsExrFile(pose.path.c_str());
+	size_t byteCount = (size_t)m_width * m_height * 3 * (bExr ? sizeof(GLushort) : sizeof(GLubyte));
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pixelBuffer);
+	const uint8_t* pMapped = (const uint8_t*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, byteCount, GL_MAP_READ_BIT);
+	if (NULL == pMapped)
+	{
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		LOG_ERROR("The image %s could not be mapped", pose.path.c_str());
+		return;
+	}
+	std::shared_ptr<std::vector<uint8_t>> pPixels = std::make_shared<std::vector<uint8_t>>(pMapped, pMapped + byteCount);
+	glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	int maxPendingImages = 2 * m_pThreadPool->GetWorkerCount();
+	while (m_pThreadPool->GetPendingCount() >= maxPendingImages)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	std::string path = pose.path;
+	int width = m_width;
+	int height = m_height;
+	m_pThreadPool->Enqueue([this, pPixels, path, width, height, bExr]()
+	{
+		bool bWritten = bExr ?
+			ImageWriter::WriteExr(path.c_str(), width, height, (const uint16_t*)pPixels->data()) :
+			ImageWriter::WritePng(path.c_str(), width, height, pPixels->data());
+		if (bWritten == true)
+		{
+			m_writtenCount++;
+		}
+	});
+}
+
+/***********************************************************
+ *  Run()
+ *
+ *  This method is used for rendering every pose into its
+ *  image.  Each pose is copied into the next buffer of the
+ *  ring, after the buffer's previous copy is collected.
+ ***********************************************************/
+int BatchRenderer::Run()
+{
+	if ((m_poses.size() == 0) || (NULL == m_pSceneManager))
+	{
+		return(0);
+	}
+	if (CreateTarget() == false)
+	{
+		return(0);
+	}
+
+	glEnable(GL_DEPTH_TEST);
+	for (int frame = 0; frame < WARMUP_FRAMES; frame++)
+	{
+		RenderPose(m_poses[0]);
+	}
+
+	for (int pose = 0; pose < (int)m_poses.size(); pose++)
+	{
+		READBACK_SLOT& slot = m_slots[pose % READBACK_SLOTS];
+		if (slot.pose >= 0)
+		{
+			CollectSlot(slot);
+		}
+
+		RenderPose(m_poses[pose]);
+
+		// the copy into the pixel buffer only queues the transfer,
+		// and the fence tells when it has finished
+		bool bExr = ImageWriter::IsExrFile(m_poses[pose].path.c_str());
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
+		glReadBuffer(GL_COLOR_ATTACHMENT0);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pixelBuffer);
+		glReadPixels(0, 0, m_width, m_height, GL_RGB, bExr ? GL_HALF_FLOAT : GL_UNSIGNED_BYTE, 0);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		slot.pose = pose;
+
+		if ((pose + 1) % PROGRESS_INTERVAL == 0)
+		{
+			LOG_INFO("Rendered %d of %zu poses", pose + 1, m_poses.size());
+		}
+	}
+
+	// collect the copies still in the ring, oldest first
+	for (int pose = (int)m_poses.size() - READBACK_SLOTS; pose < (int)m_poses.size(); pose++)
+	{
+		if ((pose >= 0) && (m_slots[pose % READBACK_SLOTS].pose == pose))
+		{
+			CollectSlot(m_slots[pose % READBACK_SLOTS]);
+		}
+	}
+	m_pThreadPool->WaitForIdle();
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	int writtenCount = m_writtenCount.load();
+	LOG_INFO("Wrote %d of %zu images", writtenCount, m_poses.size());
+
+	return(writtenCount);
+}
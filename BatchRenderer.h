@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// batchrenderer.h
+// ===============
+// render a list of camera poses into image files without showing a window
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "SceneManager.h"
+#include "ShaderManager.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// the settings of a batch run
+struct BATCH_SETTINGS
+{
+	// the file of camera poses, or NULL when the scene is shown in
+	// the window instead
+	const char* poseFile;
+	// the size of every image in pixels
+	int width;
+	int height;
+	// the process renders every pose whose index leaves this
+	// remainder when divided by the shard count, so several
+	// processes can split one pose file
+	int shardIndex;
+	int shardCount;
+};
+
+/***********************************************************
+ *  BatchRenderer
+ *
+ *  This class renders the scene once for every line of a
+ *  pose file, which holds the world position of the camera,
+ *  the point it looks at, the vertical field of view in
+ *  degrees and the image file to write:
+ *
+ *      x y z  targetX targetY targetZ  fov  path
+ *
+ *  Every pose is drawn into an offscreen target and copied
+ *  into one of a ring of pixel buffers behind a fence, so
+ *  the next poses are drawn while the copy is in flight.
+ *  A buffer is only mapped when the ring comes around to it
+ *  again, and the pixels are handed to the thread pool to
+ *  be written as PNG, or as half float EXR when the path
+ *  ends with .exr.  Drawing stays on the GL thread, so the
+ *  poses are split across processes with the shard options
+ *  to use more cores for it.
+ ***********************************************************/
+class BatchRenderer
+{
+public:
+	BatchRenderer(ShaderManager* pShaderManager, SceneManager* pSceneManager);
+	// waits for the images still being written
+	~BatchRenderer();
+
+	// read the poses of this process from the pose file
+	bool LoadPoses(const BATCH_SETTINGS& settings);
+	// render every pose and write its image - the number of images
+	// written is returned
+	int Run();
+	int GetPoseCount() const { return((int)m_poses.size()); }
+
+	// no pose file, 1920 x 1080 images and a single shard
+	static BATCH_SETTINGS GetDefaultSettings();
+	// read the --batch FILE, --batch-size WxH and --batch-shard I/N
+	// command line options
+	static bool ParseArguments(int argc, char* argv[], BATCH_SETTINGS& settings);
+
+private:
+	// one camera pose and the image it is written to
+	struct BATCH_POSE
+	{
+		glm::dvec3 position;
+		glm::dvec3 target;
+		float fieldOfView;
+		std::string path;
+	};
+
+	// a pixel buffer of the readback ring and the pose copied into it
+	struct READBACK_SLOT
+	{
+		GLuint pixelBuffer;
+		GLsync fence;
+		int pose;
+	};
+
+	bool CreateTarget();
+	void DestroyTarget();
+	void RenderPose(const BATCH_POSE& pose);
+	void CollectSlot(READBACK_SLOT& slot);
+
+	ShaderManager* m_pShaderManager;
+	SceneManager* m_pSceneManager;
+	ThreadPool* m_pThreadPool;
+
+	std::vector<BATCH_POSE> m_poses;
+	int m_width;
+	int m_height;
+
+	// the target the poses are drawn into
+	GLuint m_framebuffer;
+	GLuint m_colorBuffer;
+	GLuint m_depthBuffer;
+	std::vector<READBACK_SLOT> m_slots;
+
+	// counted by the workers as the images are written
+	std::atomic<int> m_writtenCount;
+};
@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////
+// cameracollider.cpp
+// ==================
+// keep the fly camera out of the scene objects by sweeping a sphere around it
+// and sliding it along the surfaces it touches
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CameraCollider.h"
+#include "SpatialQuery.h"
+
+#include <algorithm>
+
+// declaration of global variables
+namespace
+{
+	// a move into a corner slides along each of its faces once
+	const int MAX_SLIDES = 3;
+	// the camera stops this far short of a surface, so the next
+	// sweep does not start touching it
+	const float CONTACT_SKIN = 0.01f;
+	// moves shorter than this are dropped
+	const float MINIMUM_MOVE = 0.0001f;
+}
+
+/***********************************************************
+ *  CameraCollider()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+CameraCollider::CameraCollider(float radius)
+{
+	m_radius = radius;
+	m_bEnabled = true;
+}
+
+/***********************************************************
+ *  Move()
+ *
+ *  This method is used for moving the camera sphere from
+ *  the start toward the target.  Each sweep moves up to the
+ *  first object touched, and the part of the move into the
+ *  touched face is removed before sweeping the rest.
+ ***********************************************************/
+glm::vec3 CameraCollider::Move(SpatialQuery* pQuery, glm::vec3 start, glm::vec3 target) const
+{
+	if ((NULL == pQuery) || (m_bEnabled == false))
+	{
+		return(target);
+	}
+
+	glm::vec3 position = start;
+	for (int slide = 0; slide < MAX_SLIDES; slide++)
+	{
+		glm::vec3 move = target - position;
+		float length = glm::length(move);
+		if (length < MINIMUM_MOVE)
+		{
+			return(position);
+		}
+
+		SpatialQuery::QUERY_SWEEP sweep;
+		sweep.origin = position;
+		sweep.direction = move / length;
+		sweep.maxDistance = length;
+		sweep.radius = m_radius;
+
+		SpatialQuery::QUERY_HIT hit;
+		pQuery->SweepSpheres(&sweep, 1, &hit);
+		if (hit.objectId < 0)
+		{
+			return(target);
+		}
+
+		position += sweep.direction * std::max(hit.distance - CONTACT_SKIN, 0.0f);
+
+		// slide the rest of the move along the touched face
+		glm::vec3 remaining = target - position;
+		float into = glm::dot(remaining, hit.normal);
+		if (into < 0.0f)
+		{
+			remaining -= hit.normal * into;
+		}
+		target = position + remaining;
+	}
+
+	return(position);
+}
@@ -0,0 +1,47 @@
+///////////////////////////////////////////////////////////////////////////////
+// cameracollider.h
+// ================
+// keep the fly camera out of the scene objects by sweeping a sphere around it
+// and sliding it along the surfaces it touches
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+class SpatialQuery;
+
+/***********************************************************
+ *  CameraCollider
+ *
+ *  This class moves the camera from where it was to where
+ *  the keyboard moved it, as a sphere swept through the
+ *  static scene objects.  When the sphere touches an object
+ *  it stops just short of it, and the rest of the move is
+ *  slid along the face that was touched, so the camera
+ *  glides along walls and floors instead of stopping.  The
+ *  sweep never skips over thin objects, however large the
+ *  step of a slow frame is.
+ ***********************************************************/
+class CameraCollider
+{
+public:
+	// the default radius keeps the near plane of the camera out of
+	// the objects
+	CameraCollider(float radius = 0.5f);
+
+	// the position reached when moving from the start toward the
+	// target, both in render space
+	glm::vec3 Move(SpatialQuery* pQuery, glm::vec3 start, glm::vec3 target) const;
+
+	void SetEnabled(bool bEnabled) { m_bEnabled = bEnabled; }
+	bool IsEnabled() const { return(m_bEnabled); }
+	float GetRadius() const { return(m_radius); }
+
+private:
+	float m_radius;
+	bool m_bEnabled;
+};
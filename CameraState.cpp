@@ -0,0 +1,203 @@
+///////////////////////////////////////////////////////////////////////////////
+// camerastate.cpp
+// ===============
+// keep the matrices of a camera with a version number, so the shaders and
+// the culling only see new values when the camera has changed
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CameraState.h"
+
+// declaration of global variables
+namespace
+{
+	const char* g_ViewName = "view";
+	const char* g_ProjectionName = "projection";
+	const char* g_ViewPositionName = "viewPosition";
+
+	// the last version handed out to any camera - zero is never
+	// handed out, so it stands for no camera
+	unsigned int g_LastVersion = 0;
+
+	// the camera version held by each shader the cameras have been
+	// uploaded into
+	const int MAX_SHADERS = 8;
+	struct UPLOADED_CAMERA
+	{
+		ShaderManager* pShaderManager;
+		unsigned int version;
+	};
+	UPLOADED_CAMERA g_Uploaded[MAX_SHADERS] = {};
+
+	const CameraState* g_pCurrentCamera = nullptr;
+}
+
+/***********************************************************
+ *  CameraState()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+CameraState::CameraState()
+{
+	m_view = glm::mat4(1.0f);
+	m_projection = glm::mat4(1.0f);
+	m_position = glm::vec3(0.0f);
+	m_viewProjection = glm::mat4(1.0f);
+	m_viewProjectionVersion = 0;
+	Changed();
+}
+
+/***********************************************************
+ *  Changed()
+ *
+ *  This method is used for giving the camera a new version
+ *  number after its matrices or position changed.
+ ***********************************************************/
+void CameraState::Changed()
+{
+	g_LastVersion++;
+	if (g_LastVersion == 0)
+	{
+		g_LastVersion++;
+	}
+	m_version = g_LastVersion;
+}
+
+/***********************************************************
+ *  SetView()
+ *
+ *  This method is used for setting the view matrix and the
+ *  render space position of the camera.
+ ***********************************************************/
+void CameraState::SetView(const glm::mat4& view, glm::vec3 position)
+{
+	if ((view != m_view) || (position != m_position))
+	{
+		m_view = view;
+		m_position = position;
+		Changed();
+	}
+}
+
+/***********************************************************
+ *  SetProjection()
+ *
+ *  This method is used for setting the projection matrix
+ *  of the camera.
+ ***********************************************************/
+void CameraState::SetProjection(const glm::mat4& projection)
+{
+	if (projection != m_projection)
+	{
+		m_projection = projection;
+		Changed();
+	}
+}
+
+/***********************************************************
+ *  GetViewProjection()
+ *
+ *  This method is used for getting the projection matrix
+ *  times the view matrix, which is only computed again
+ *  after the camera changed.
+ ***********************************************************/
+const glm::mat4& CameraState::GetViewProjection() const
+{
+	if (m_viewProjectionVersion != m_version)
+	{
+		m_viewProjection = m_projection * m_view;
+		m_viewProjectionVersion = m_version;
+	}
+	return(m_viewProjection);
+}
+
+/***********************************************************
+ *  Upload()
+ *
+ *  This method is used for setting the camera into the
+ *  uniforms of a shader, unless the shader already holds
+ *  this version of the camera.  The shader must be the
+ *  program in use.
+ ***********************************************************/
+bool CameraState::Upload(ShaderManager* pShaderManager) const
+{
+	if (NULL == pShaderManager)
+	{
+		return(false);
+	}
+
+	// find the slot of the shader, or a free one - when all of the
+	// slots are taken the camera is uploaded every time
+	UPLOADED_CAMERA* pUploaded = NULL;
+	for (int i = 0; i < MAX_SHADERS; i++)
+	{
+		if (g_Uploaded[i].pShaderManager == pShaderManager)
+		{
+			pUploaded = &g_Uploaded[i];
+			break;
+		}
+		if ((NULL == pUploaded) && (g_Uploaded[i].pShaderManager == NULL))
+		{
+			pUploaded = &g_Uploaded[i];
+		}
+	}
+	if ((NULL != pUploaded) && (pUploaded->pShaderManager == pShaderManager) &&
+		(pUploaded->version == m_version))
+	{
+		return(false);
+	}
+
+	pShaderManager->setMat4Value(g_ViewName, m_view);
+	pShaderManager->setMat4Value(g_ProjectionName, m_projection);
+	pShaderManager->setVec3Value(g_ViewPositionName, m_position);
+
+	if (NULL != pUploaded)
+	{
+		pUploaded->pShaderManager = pShaderManager;
+		pUploaded->version = m_version;
+	}
+	return(true);
+}
+
+/***********************************************************
+ *  ForgetShader()
+ *
+ *  This method is used for removing a shader that is about
+ *  to be deleted, so a new shader allocated at the same
+ *  address is not taken for it.
+ ***********************************************************/
+void CameraState::ForgetShader(ShaderManager* pShaderManager)
+{
+	for (int i = 0; i < MAX_SHADERS; i++)
+	{
+		if (g_Uploaded[i].pShaderManager == pShaderManager)
+		{
+			g_Uploaded[i].pShaderManager = NULL;
+			g_Uploaded[i].version = 0;
+		}
+	}
+}
+
+/***********************************************************
+ *  GetCurrent()
+ *
+ *  This method is used for getting the camera the scene is
+ *  being rendered with.
+ ***********************************************************/
+const CameraState* CameraState::GetCurrent()
+{
+	return(g_pCurrentCamera);
+}
+
+/***********************************************************
+ *  SetCurrent()
+ *
+ *  This method is used for setting the camera the scene is
+ *  being rendered with.
+ ***********************************************************/
+void CameraState::SetCurrent(const CameraState* pCamera)
+{
+	g_pCurrentCamera = pCamera;
+}
@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////////
+// camerastate.h
+// =============
+// keep the matrices of a camera with a version number, so the shaders and
+// the culling only see new values when the camera has changed
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  CameraState
+ *
+ *  This class keeps the view and projection matrices and
+ *  the position of a camera in render space.  Setting them
+ *  to new values gives the camera a new version number,
+ *  and setting the values it already has changes nothing.
+ *  The combined view projection matrix is computed on the
+ *  first request after a change, and a camera is only
+ *  uploaded into a shader that does not hold its current
+ *  version yet, so a camera that stands still costs
+ *  nothing on later frames.  The camera the scene is being
+ *  rendered with is the current camera, which the culling,
+ *  the particles and the picker read instead of reading the
+ *  uniforms back from the scene shader.
+ ***********************************************************/
+class CameraState
+{
+public:
+	CameraState();
+
+	void SetView(const glm::mat4& view, glm::vec3 position);
+	void SetProjection(const glm::mat4& projection);
+
+	// changes with every change of the matrices or the position,
+	// and is never the same for two cameras
+	unsigned int GetVersion() const { return(m_version); }
+	const glm::mat4& GetView() const { return(m_view); }
+	const glm::mat4& GetProjection() const { return(m_projection); }
+	glm::vec3 GetPosition() const { return(m_position); }
+	const glm::mat4& GetViewProjection() const;
+
+	// set the matrices and the position into a shader that does
+	// not hold this version of the camera - true is returned when
+	// the uniforms were set
+	bool Upload(ShaderManager* pShaderManager) const;
+	// forget what a shader holds, before it is deleted
+	static void ForgetShader(ShaderManager* pShaderManager);
+
+	// the camera the scene is being rendered with
+	static const CameraState* GetCurrent();
+	static void SetCurrent(const CameraState* pCamera);
+
+private:
+	void Changed();
+
+	glm::mat4 m_view;
+	glm::mat4 m_projection;
+	glm::vec3 m_position;
+	unsigned int m_version;
+
+	// the view projection matrix, and the version it was computed for
+	mutable glm::mat4 m_viewProjection;
+	mutable unsigned int m_viewProjectionVersion;
+};
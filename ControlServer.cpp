@@ -0,0 +1,1213 @@
+///////////////////////////////////////////////////////////////////////////////
+// controlserver.cpp
+// =================
+// take commands from automation scripts over a local socket and stream the
+// frame stats back to them
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ControlServer.h"
+#include "ImageWriter.h"
+#include "FrameMetrics.h"
+#include "RoomReplicator.h"
+#include "Logger.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+
+// declaration of global variables
+namespace
+{
+	// the connections waiting to be accepted
+	const int LISTEN_BACKLOG = 4;
+	// a client writing a longer line than this is disconnected
+	const size_t MAX_LINE_BYTES = 64 * 1024;
+	// the stats are not queued for a client that has this much
+	// output it has not read yet, and a client whose replies would
+	// go past it is disconnected
+	const size_t MAX_CLIENT_OUTPUT_BYTES = 1024 * 1024;
+	// the commands waiting for the render thread, past which new
+	// commands are refused
+	const size_t MAX_PENDING_COMMANDS = 256;
+	// the directory the screenshots are written into, which only
+	// the user of the application can open
+	const char* const SCREENSHOT_DIRECTORY = "screenshots";
+	// the client of the messages sent to every client taking stats
+	const int STATS_CLIENTS = -1;
+
+	ControlServer* g_pActiveServer = nullptr;
+
+	// the values of a command line, which is a flat object of
+	// strings, numbers, booleans and arrays of numbers
+	enum JSON_TYPE
+	{
+		JSON_NULL = 0,
+		JSON_BOOL,
+		JSON_NUMBER,
+		JSON_STRING,
+		JSON_ARRAY
+	};
+
+	struct JSON_VALUE
+	{
+		JSON_TYPE type;
+		bool bValue;
+		double number;
+		std::string text;
+		std::vector<double> numbers;
+		// the value as it was written, for echoing the command id
+		std::string raw;
+	};
+
+	typedef std::map<std::string, JSON_VALUE> JSON_OBJECT;
+
+	/***********************************************************
+	 *  SkipSpace()
+	 *
+	 *  This function is used for stepping over white space.
+	 ***********************************************************/
+	void SkipSpace(const std::string& line, size_t& i)
+	{
+		while ((i < line.size()) && ((line[i] == ' ') || (line[i] == '\t') || (line[i] == '\r')))
+		{
+			i++;
+		}
+	}
+
+	/***********************************************************
+	 *  ParseString()
+	 *
+	 *  This function is used for reading a quoted string.
+	 *  Escaped characters past ASCII are replaced with '?'.
+	 ***********************************************************/
+	bool ParseString(const std::string& line, size_t& i, std::string& text)
+	{
+		if ((i >= line.size()) || (line[i] != '"'))
+		{
+			return(false);
+		}
+		i++;
+
+		while ((i < line.size()) && (line[i] != '"'))
+		{
+			char c = line[i++];
+			if (c == '\\')
+			{
+				if (i >= line.size())
+				{
+					return(false);
+				}
+				c = line[i++];
+				if (c == 'n')
+				{
+					c = '\n';
+				}
+				else if (c == 't')
+				{
+					c = '\t';
+				}
+				else if (c == 'r')
+				{
+					c = '\r';
+				}
+				else if (c == 'b')
+				{
+					c = '\b';
+				}
+				else if (c == 'f')
+				{
+					c = '\f';
+				}
+				else if (c == 'u')
+				{
+					if (i + 4 > line.size())
+					{
+						return(false);
+					}
+					unsigned long code = strtoul(line.substr(i, 4).c_str(), NULL, 16);
+					c = (code < 0x80) ? (char)code : '?';
+					i += 4;
+				}
+			}
+			text.push_back(c);
+		}
+		if (i >= line.size())
+		{
+			return(false);
+		}
+		i++;
+
+		return(true);
+	}
+
+	/***********************************************************
+	 *  ParseNumber()
+	 *
+	 *  This function is used for reading a number.  NaN, the
+	 *  infinities and numbers too large for a double are not
+	 *  JSON numbers and are rejected.
+	 ***********************************************************/
+	bool ParseNumber(const std::string& line, size_t& i, double& number)
+	{
+		const char* pStart = line.c_str() + i;
+		char* pEnd = NULL;
+		number = strtod(pStart, &pEnd);
+		if ((pEnd == pStart) || (std::isfinite(number) == false))
+		{
+			return(false);
+		}
+		i += pEnd - pStart;
+
+		return(true);
+	}
+
+	/***********************************************************
+	 *  ParseValue()
+	 *
+	 *  This function is used for reading a value of a field.
+	 *  Nested objects and arrays of anything but numbers are
+	 *  not taken by any command, so they are rejected.
+	 ***********************************************************/
+	bool ParseValue(const std::string& line, size_t& i, JSON_VALUE& value)
+	{
+		SkipSpace(line, i);
+		size_t start = i;
+		value.type = JSON_NULL;
+		value.bValue = false;
+		value.number = 0.0;
+		if (i >= line.size())
+		{
+			return(false);
+		}
+
+		if (line[i] == '"')
+		{
+			value.type = JSON_STRING;
+			if (ParseString(line, i, value.text) == false)
+			{
+				return(false);
+			}
+		}
+		else if (line[i] == '[')
+		{
+			value.type = JSON_ARRAY;
+			i++;
+			SkipSpace(line, i);
+			if ((i < line.size()) && (line[i] == ']'))
+			{
+				i++;
+			}
+			else
+			{
+				while (true)
+				{
+					double number = 0.0;
+					SkipSpace(line, i);
+					if (ParseNumber(line, i, number) == false)
+					{
+						return(false);
+					}
+					value.numbers.push_back(number);
+					SkipSpace(line, i);
+					if ((i < line.size()) && (line[i] == ','))
+					{
+						i++;
+						continue;
+					}
+					if ((i < line.size()) && (line[i] == ']'))
+					{
+						i++;
+						break;
+					}
+					return(false);
+				}
+			}
+		}
+		else if (line.compare(i, 4, "true") == 0)
+		{
+			value.type = JSON_BOOL;
+			value.bValue = true;
+			i += 4;
+		}
+		else if (line.compare(i, 5, "false") == 0)
+		{
+			value.type = JSON_BOOL;
+			i += 5;
+		}
+		else if (line.compare(i, 4, "null") == 0)
+		{
+			i += 4;
+		}
+		else
+		{
+			value.type = JSON_NUMBER;
+			if (ParseNumber(line, i, value.number) == false)
+			{
+				return(false);
+			}
+		}
+		value.raw = line.substr(start, i - start);
+
+		return(true);
+	}
+
+	/***********************************************************
+	 *  ParseObject()
+	 *
+	 *  This function is used for reading a command line into
+	 *  its fields.
+	 ***********************************************************/
+	bool ParseObject(const std::string& line, JSON_OBJECT& object)
+	{
+		size_t i = 0;
+		SkipSpace(line, i);
+		if ((i >= line.size()) || (line[i] != '{'))
+		{
+			return(false);
+		}
+		i++;
+		SkipSpace(line, i);
+
+		if ((i < line.size()) && (line[i] == '}'))
+		{
+			i++;
+		}
+		else
+		{
+			while (true)
+			{
+				std::string key;
+				JSON_VALUE value;
+				SkipSpace(line, i);
+				if (ParseString(line, i, key) == false)
+				{
+					return(false);
+				}
+				SkipSpace(line, i);
+				if ((i >= line.size()) || (line[i] != ':'))
+				{
+					return(false);
+				}
+				i++;
+				if (ParseValue(line, i, value) == false)
+				{
+					return(false);
+				}
+				object[key] = value;
+
+				SkipSpace(line, i);
+				if ((i < line.size()) && (line[i] == ','))
+				{
+					i++;
+					continue;
+				}
+				if ((i < line.size()) && (line[i] == '}'))
+				{
+					i++;
+					break;
+				}
+				return(false);
+			}
+		}
+
+		SkipSpace(line, i);
+		return(i == line.size());
+	}
+
+	/***********************************************************
+	 *  QuoteString()
+	 *
+	 *  This function is used for writing a string as a JSON
+	 *  string.
+	 ***********************************************************/
+	std::string QuoteString(const std::string& text)
+	{
+		std::string quoted = "\"";
+		for (size_t i = 0; i < text.size(); i++)
+		{
+			char c = text[i];
+			if ((c == '"') || (c == '\\'))
+			{
+				quoted.push_back('\\');
+				quoted.push_back(c);
+			}
+			else if ((unsigned char)c < 0x20)
+			{
+				char escaped[8];
+				snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned int)(unsigned char)c);
+				quoted += escaped;
+			}
+			else
+			{
+				quoted.push_back(c);
+			}
+		}
+		quoted.push_back('"');
+
+		return(quoted);
+	}
+
+	/***********************************************************
+	 *  ReplyText()
+	 *
+	 *  This function is used for writing the reply line of a
+	 *  command.
+	 ***********************************************************/
+	std::string ReplyText(const std::string& id, bool bSucceeded, const char* error)
+	{
+		std::string text = "{";
+		if (id.size() > 0)
+		{
+			text += "\"id\":" + id + ",";
+		}
+		text += bSucceeded ? "\"ok\":true" : "\"ok\":false";
+		if ((bSucceeded == false) && (NULL != error))
+		{
+			text += ",\"error\":" + QuoteString(error);
+		}
+		text += "}\n";
+
+		return(text);
+	}
+
+	/***********************************************************
+	 *  GetVector()
+	 *
+	 *  This function is used for reading a field holding an
+	 *  array of three numbers.
+	 ***********************************************************/
+	bool GetVector(const JSON_OBJECT& object, const char* key, double* pValues)
+	{
+		JSON_OBJECT::const_iterator field = object.find(key);
+		if ((field == object.end()) || (field->second.type != JSON_ARRAY) || (field->second.numbers.size() != 3))
+		{
+			return(false);
+		}
+		for (int i = 0; i < 3; i++)
+		{
+			pValues[i] = field->second.numbers[i];
+		}
+
+		return(true);
+	}
+
+	/***********************************************************
+	 *  IsFileName()
+	 *
+	 *  This function is used for checking that a name given by
+	 *  a client is a plain file name, which cannot reach out of
+	 *  the directory it is put under.
+	 ***********************************************************/
+	bool IsFileName(const std::string& name)
+	{
+		if ((name.size() == 0) || (name.size() > 255) || (name[0] == '.'))
+		{
+			return(false);
+		}
+		for (size_t i = 0; i < name.size(); i++)
+		{
+			if ((name[i] == '/') || (name[i] == '\\') || ((unsigned char)name[i] < 0x20))
+			{
+				return(false);
+			}
+		}
+
+		return(true);
+	}
+
+	/***********************************************************
+	 *  FindField()
+	 *
+	 *  This function is used for getting a field of the passed
+	 *  in type, or NULL when it is missing or of another type.
+	 ***********************************************************/
+	const JSON_VALUE* FindField(const JSON_OBJECT& object, const char* key, JSON_TYPE type)
+	{
+		JSON_OBJECT::const_iterator field = object.find(key);
+		if ((field == object.end()) || (field->second.type != type))
+		{
+			return(NULL);
+		}
+
+		return(&field->second);
+	}
+}
+
+/***********************************************************
+ *  ControlServer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ControlServer::ControlServer()
+{
+	m_listenSocket = -1;
+	m_wakePipe[0] = -1;
+	m_wakePipe[1] = -1;
+	m_bStopping = false;
+	m_nextClientId = 1;
+	// one worker writes the screenshots in the order they were taken
+	m_pWriterPool = new ThreadPool(1);
+}
+
+/***********************************************************
+ *  ~ControlServer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ControlServer::~ControlServer()
+{
+	if (this == g_pActiveServer)
+	{
+		g_pActiveServer = NULL;
+	}
+
+	// the screenshots being written are answered before the
+	// clients are closed
+	if (NULL != m_pWriterPool)
+	{
+		delete m_pWriterPool;
+		m_pWriterPool = NULL;
+	}
+	Stop();
+}
+
+/***********************************************************
+ *  GetActive()
+ *
+ *  This method is used for getting the server of the
+ *  application, which is NULL when it was not started.
+ ***********************************************************/
+ControlServer* ControlServer::GetActive()
+{
+	return(g_pActiveServer);
+}
+
+/***********************************************************
+ *  SetActive()
+ *
+ *  This method is used for setting the server of the
+ *  application.
+ ***********************************************************/
+void ControlServer::SetActive(ControlServer* pServer)
+{
+	g_pActiveServer = pServer;
+}
+
+/***********************************************************
+ *  ParseArguments()
+ *
+ *  This method is used for reading the socket the server
+ *  listens on from the command line, which is left NULL
+ *  when the option is not given.
+ ***********************************************************/
+bool ControlServer::ParseArguments(int argc, char* argv[], const char*& socketPath)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--control") == 0) && (i + 1 < argc))
+		{
+			socketPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--control") == 0)
+		{
+			LOG_ERROR("the control socket must be given as --control PATH");
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  Start()
+ *
+ *  This method is used for listening on the socket file and
+ *  starting the server thread.  A socket file left by an
+ *  earlier run is replaced, but no other kind of file is.
+ *  The socket is created without any permissions for other
+ *  users, since a client can quit the application, load
+ *  large scenes and write screenshots as its user.
+ ***********************************************************/
+bool ControlServer::Start(const char* socketPath)
+{
+	if ((IsRunning() == true) || (NULL == socketPath))
+	{
+		return(false);
+	}
+
+#ifdef _WIN32
+	LOG_ERROR("The control socket needs Unix domain sockets");
+	return(false);
+#else
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (strlen(socketPath) >= sizeof(address.sun_path))
+	{
+		LOG_ERROR("The control socket path is too long: %s", socketPath);
+		return(false);
+	}
+	strcpy(address.sun_path, socketPath);
+
+	struct stat status;
+	if ((stat(socketPath, &status) == 0) && S_ISSOCK(status.st_mode))
+	{
+		unlink(socketPath);
+	}
+
+	if ((mkdir(SCREENSHOT_DIRECTORY, 0700) != 0) && (errno != EEXIST))
+	{
+		LOG_ERROR("Could not create the screenshot directory %s", SCREENSHOT_DIRECTORY);
+		return(false);
+	}
+
+	// the mask covers the window between creating the socket file
+	// and changing its mode
+	int listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	bool bBound = false;
+	if (listenSocket >= 0)
+	{
+		mode_t previousMask = umask(0077);
+		bBound = (bind(listenSocket, (const sockaddr*)&address, sizeof(address)) == 0) &&
+			(chmod(socketPath, S_IRUSR | S_IWUSR) == 0);
+		umask(previousMask);
+	}
+	if ((bBound == false) ||
+		(listen(listenSocket, LISTEN_BACKLOG) != 0) ||
+		(pipe(m_wakePipe) != 0))
+	{
+		LOG_ERROR("Could not listen for control commands on %s", socketPath);
+		if (listenSocket >= 0)
+		{
+			close(listenSocket);
+		}
+		return(false);
+	}
+	fcntl(listenSocket, F_SETFL, O_NONBLOCK);
+	fcntl(m_wakePipe[0], F_SETFL, O_NONBLOCK);
+	fcntl(m_wakePipe[1], F_SETFL, O_NONBLOCK);
+
+	// a client that goes away fails the writes instead of ending
+	// the application
+	signal(SIGPIPE, SIG_IGN);
+
+	m_socketPath = socketPath;
+	m_listenSocket = listenSocket;
+	m_bStopping = false;
+	m_serverThread = std::thread(&ControlServer::ServerLoop, this);
+
+	LOG_INFO("Listening for control commands on %s", socketPath);
+
+	return(true);
+#endif
+}
+
+/***********************************************************
+ *  Stop()
+ *
+ *  This method is used for stopping the server thread and
+ *  closing the socket.  The commands not applied yet and
+ *  the screenshots still being copied are dropped.
+ ***********************************************************/
+void ControlServer::Stop()
+{
+	if (IsRunning() == false)
+	{
+		return;
+	}
+
+#ifndef _WIN32
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStopping = true;
+		Wake();
+	}
+	m_serverThread.join();
+
+	close(m_listenSocket);
+	unlink(m_socketPath.c_str());
+	m_listenSocket = -1;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		close(m_wakePipe[0]);
+		close(m_wakePipe[1]);
+		m_wakePipe[0] = -1;
+		m_wakePipe[1] = -1;
+		m_commands.clear();
+		m_outgoing.clear();
+	}
+#endif
+
+	for (size_t i = 0; i < m_screenshots.size(); i++)
+	{
+		glDeleteSync(m_screenshots[i].fence);
+		glDeleteBuffers(1, &m_screenshots[i].pixelBuffer);
+	}
+	m_screenshots.clear();
+}
+
+/***********************************************************
+ *  Wake()
+ *
+ *  This method is used for waking the server thread from
+ *  its wait - it must be called with the mutex held.
+ ***********************************************************/
+void ControlServer::Wake()
+{
+#ifndef _WIN32
+	if (m_wakePipe[1] >= 0)
+	{
+		char signal = 1;
+		// a full pipe already wakes the thread, so a failed write
+		// can be ignored
+		if (write(m_wakePipe[1], &signal, 1) < 0)
+		{
+			return;
+		}
+	}
+#endif
+}
+
+/***********************************************************
+ *  Send()
+ *
+ *  This method is used for queueing a message for the
+ *  server thread to write.
+ ***********************************************************/
+void ControlServer::Send(int client, const std::string& text)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if ((m_bStopping == true) || (m_listenSocket < 0))
+	{
+		return;
+	}
+
+	OUTGOING_MESSAGE message;
+	message.client = client;
+	message.text = text;
+	m_outgoing.push_back(message);
+	Wake();
+}
+
+/***********************************************************
+ *  PopCommand()
+ *
+ *  This method is used for taking the command at the head
+ *  of the queue when its type is one of the bits of the
+ *  mask.  A command of another type is left for the point
+ *  of the frame that handles it, and the commands behind it
+ *  wait for it.
+ ***********************************************************/
+bool ControlServer::PopCommand(int typeMask, CONTROL_COMMAND& command)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if ((m_commands.size() == 0) || ((m_commands.front().type & typeMask) == 0))
+	{
+		return(false);
+	}
+
+	command = m_commands.front();
+	m_commands.pop_front();
+
+	return(true);
+}
+
+/***********************************************************
+ *  Reply()
+ *
+ *  This method is used for answering a command.
+ ***********************************************************/
+void ControlServer::Reply(const CONTROL_COMMAND& command, bool bSucceeded, const char* error)
+{
+	Send(command.client, ReplyText(command.id, bSucceeded, error));
+}
+
+/***********************************************************
+ *  PublishStats()
+ *
+ *  This method is used for sending the stats of a frame to
+ *  the clients that asked for them.
+ ***********************************************************/
+void ControlServer::PublishStats(const FRAME_STATS& stats)
+{
+	char text[256];
+	snprintf(text, sizeof(text),
+		"{\"stats\":{\"frame\":%u,\"cpu_ms\":%.3f,\"gpu_ms\":%.3f,\"draws\":%d,"
+		"\"triangles\":%llu,\"resident_bytes\":%llu,\"streamed_bytes\":%llu}}\n",
+		stats.frame, stats.cpuMilliseconds, stats.gpuMilliseconds, stats.drawCount,
+		(unsigned long long)stats.triangleCount,
+		(unsigned long long)stats.residentBytes,
+		(unsigned long long)stats.streamedBytes);
+	Send(STATS_CLIENTS, text);
+}
+
+/***********************************************************
+ *  RequestScreenshot()
+ *
+ *  This method is used for copying the back buffer into a
+ *  pixel buffer behind a fence.  The copy is collected on a
+ *  later frame once the fence has passed.
+ ***********************************************************/
+void ControlServer::RequestScreenshot(const CONTROL_COMMAND& command, int width, int height)
+{
+	if ((width <= 0) || (height <= 0))
+	{
+		Reply(command, false, "the window has no pixels to capture");
+		return;
+	}
+
+	PENDING_SCREENSHOT screenshot;
+	screenshot.command = command;
+	screenshot.width = width;
+	screenshot.height = height;
+
+	glGenBuffers(1, &screenshot.pixelBuffer);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, screenshot.pixelBuffer);
+	glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)width * height * 3, NULL, GL_STREAM_READ);
+	glReadBuffer(GL_BACK);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, 0);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	screenshot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	m_screenshots.push_back(screenshot);
+}
+
+/***********************************************************
+ *  CollectScreenshots()
+ *
+ *  This method is used for handing the screenshots whose
+ *  copies have finished to the writer, oldest first.  The
+ *  fences are only polled, so an unfinished copy is simply
+ *  collected on a later frame.
+ ***********************************************************/
+void ControlServer::CollectScreenshots()
+{
+	size_t collected = 0;
+	while (collected < m_screenshots.size())
+	{
+		PENDING_SCREENSHOT& screenshot = m_screenshots[collected];
+		GLenum status = glClientWaitSync(screenshot.fence, 0, 0);
+		if (status == GL_TIMEOUT_EXPIRED)
+		{
+			break;
+		}
+		glDeleteSync(screenshot.fence);
+		collected++;
+
+		size_t byteCount = (size_t)screenshot.width * screenshot.height * 3;
+		const unsigned char* pMapped = NULL;
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, screenshot.pixelBuffer);
+		if (status != GL_WAIT_FAILED)
+		{
+			pMapped = (const unsigned char*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, byteCount, GL_MAP_READ_BIT);
+		}
+		if (NULL == pMapped)
+		{
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+			glDeleteBuffers(1, &screenshot.pixelBuffer);
+			Reply(screenshot.command, false, "the window could not be read back");
+			continue;
+		}
+		std::shared_ptr<std::vector<unsigned char>> pPixels =
+			std::make_shared<std::vector<unsigned char>>(pMapped, pMapped + byteCount);
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		glDeleteBuffers(1, &screenshot.pixelBuffer);
+
+		CONTROL_COMMAND command = screenshot.command;
+		int width = screenshot.width;
+		int height = screenshot.height;
+		m_pWriterPool->Enqueue([this, command, pPixels, width, height]()
+		{
+			if (ImageWriter::WritePng(command.path.c_str(), width, height, pPixels->data()) == true)
+			{
+				Reply(command, true);
+			}
+			else
+			{
+				Reply(command, false, "the screenshot could not be written");
+			}
+		});
+	}
+	m_screenshots.erase(m_screenshots.begin(), m_screenshots.begin() + collected);
+}
+
+/***********************************************************
+ *  HandleLine()
+ *
+ *  This method is used for reading a command line of a
+ *  client on the server thread.  The stats subscription and
+ *  the metrics are answered right away, a malformed command
+ *  is answered with its error, and the others are queued
+ *  for the render thread.
+ ***********************************************************/
+void ControlServer::HandleLine(CONTROL_CLIENT& client, const std::string& line)
+{
+	JSON_OBJECT object;
+	if (ParseObject(line, object) == false)
+	{
+		QueueOutput(client, ReplyText("", false, "the line is not a flat JSON object"));
+		return;
+	}
+
+	CONTROL_COMMAND command;
+	command.type = CONTROL_QUIT;
+	command.client = client.id;
+	command.position = glm::dvec3(0.0);
+	command.front = glm::vec3(0.0f, 0.0f, -1.0f);
+	command.zoom = 0.0f;
+	command.bOrthographic = false;
+	command.rooms[0] = 1;
+	command.rooms[1] = 1;
+	command.rooms[2] = 1;
+	command.seed = 0;
+	command.bHasSeed = false;
+	command.bStreamRooms = false;
+	JSON_OBJECT::const_iterator id = object.find("id");
+	if (id != object.end())
+	{
+		command.id = id->second.raw;
+	}
+
+	const JSON_VALUE* pName = FindField(object, "cmd", JSON_STRING);
+	if (NULL == pName)
+	{
+		QueueOutput(client, ReplyText(command.id, false, "the command has no cmd string"));
+		return;
+	}
+	const std::string& name = pName->text;
+
+	const char* error = NULL;
+	if (name == "stats")
+	{
+		const JSON_VALUE* pEnable = FindField(object, "enable", JSON_BOOL);
+		client.bStats = (NULL == pEnable) || pEnable->bValue;
+		QueueOutput(client, ReplyText(command.id, true, NULL));
+		return;
+	}
+	else if (name == "metrics")
+	{
+		// the reply carries the metrics in the Prometheus text format
+		std::string reply = ReplyText(command.id, true, NULL);
+		reply.insert(reply.size() - 2, ",\"metrics\":" + QuoteString(FrameMetrics::GetPrometheusText()));
+		QueueOutput(client, reply);
+		return;
+	}
+	else if (name == "set_camera")
+	{
+		double position[3];
+		double front[3];
+		const JSON_VALUE* pZoom = FindField(object, "zoom", JSON_NUMBER);
+		command.type = CONTROL_SET_CAMERA;
+		if ((GetVector(object, "position", position) == false) || (GetVector(object, "front", front) == false))
+		{
+			error = "set_camera needs a position and a front of three numbers";
+		}
+		else if ((front[0] == 0.0) && (front[1] == 0.0) && (front[2] == 0.0))
+		{
+			error = "the front of the camera must not be zero";
+		}
+		else
+		{
+			command.position = glm::dvec3(position[0], position[1], position[2]);
+			command.front = glm::vec3((float)front[0], (float)front[1], (float)front[2]);
+			command.zoom = (NULL != pZoom) ? (float)pZoom->number : 0.0f;
+
+			// the front is normalized in float, which a huge value
+			// would turn into infinities or a zero length
+			float frontLength = glm::length(command.front);
+			if ((std::isfinite(command.position.x) == false) || (std::isfinite(command.position.y) == false) ||
+				(std::isfinite(command.position.z) == false) || (std::isfinite(frontLength) == false) ||
+				(frontLength == 0.0f) || (std::isfinite(command.zoom) == false))
+			{
+				error = "the camera position, front and zoom must be finite numbers";
+			}
+		}
+	}
+	else if (name == "set_projection")
+	{
+		const JSON_VALUE* pMode = FindField(object, "mode", JSON_STRING);
+		command.type = CONTROL_SET_PROJECTION;
+		if ((NULL == pMode) || ((pMode->text != "perspective") && (pMode->text != "orthographic")))
+		{
+			error = "set_projection needs a mode of perspective or orthographic";
+		}
+		else
+		{
+			command.bOrthographic = (pMode->text == "orthographic");
+		}
+	}
+	else if (name == "load_scene")
+	{
+		double rooms[3];
+		const JSON_VALUE* pSeed = FindField(object, "seed", JSON_NUMBER);
+		const JSON_VALUE* pStream = FindField(object, "stream", JSON_BOOL);
+		command.type = CONTROL_LOAD_SCENE;
+		if ((GetVector(object, "rooms", rooms) == false) ||
+			(RoomReplicator::IsGridSizeValid(rooms[0], rooms[1], rooms[2]) == false))
+		{
+			error = "load_scene needs rooms of three whole counts of at least one, within the room limits";
+		}
+		else if ((NULL != pSeed) && ((pSeed->number < 0.0) || (pSeed->number > 4294967295.0)))
+		{
+			error = "the seed must be a number from 0 to 4294967295";
+		}
+		else
+		{
+			for (int i = 0; i < 3; i++)
+			{
+				command.rooms[i] = (int)rooms[i];
+			}
+			command.bHasSeed = (NULL != pSeed);
+			command.seed = (NULL != pSeed) ? (unsigned int)pSeed->number : 0;
+			command.bStreamRooms = (NULL != pStream) && pStream->bValue;
+		}
+	}
+	else if (name == "screenshot")
+	{
+		const JSON_VALUE* pPath = FindField(object, "path", JSON_STRING);
+		command.type = CONTROL_SCREENSHOT;
+		if ((NULL == pPath) || (pPath->text.size() == 0))
+		{
+			error = "screenshot needs a path";
+		}
+		else if ((IsFileName(pPath->text) == false) || (pPath->text.find("..") != std::string::npos))
+		{
+			error = "the screenshot path must be a file name without directories";
+		}
+		else
+		{
+			command.path = std::string(SCREENSHOT_DIRECTORY) + "/" + pPath->text;
+		}
+	}
+	else if (name == "quit")
+	{
+		command.type = CONTROL_QUIT;
+	}
+	else
+	{
+		error = "the command is not known";
+	}
+
+	if (NULL != error)
+	{
+		QueueOutput(client, ReplyText(command.id, false, error));
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if (m_commands.size() >= MAX_PENDING_COMMANDS)
+	{
+		lock.unlock();
+		QueueOutput(client, ReplyText(command.id, false, "too many commands are waiting to be applied"));
+		return;
+	}
+	m_commands.push_back(command);
+}
+
+/***********************************************************
+ *  QueueOutput()
+ *
+ *  This method is used for adding a message to the output
+ *  of a client on the server thread.  A client that has
+ *  stopped reading its replies is disconnected once its
+ *  output would pass the limit.
+ ***********************************************************/
+void ControlServer::QueueOutput(CONTROL_CLIENT& client, const std::string& text)
+{
+	if (client.output.size() + text.size() > MAX_CLIENT_OUTPUT_BYTES)
+	{
+		client.bDropped = true;
+		return;
+	}
+	client.output += text;
+}
+
+/***********************************************************
+ *  ServerLoop()
+ *
+ *  This method is run by the server thread, which waits on
+ *  the socket, the clients and the wake pipe.  New clients
+ *  are accepted, the lines they write are handled, and the
+ *  queued messages are written as the clients can take
+ *  them.  Stats are left out for a client that has stopped
+ *  reading, instead of growing its output without end, and
+ *  a client whose replies would pass the limit is closed.
+ ***********************************************************/
+void ControlServer::ServerLoop()
+{
+#ifndef _WIN32
+	std::vector<pollfd> polls;
+	while (true)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_bStopping == true)
+			{
+				break;
+			}
+
+			for (size_t m = 0; m < m_outgoing.size(); m++)
+			{
+				const OUTGOING_MESSAGE& message = m_outgoing[m];
+				for (size_t c = 0; c < m_clients.size(); c++)
+				{
+					CONTROL_CLIENT& client = m_clients[c];
+					if (message.client == client.id)
+					{
+						QueueOutput(client, message.text);
+					}
+					else if ((message.client == STATS_CLIENTS) && (client.bStats == true) &&
+						(client.output.size() < MAX_CLIENT_OUTPUT_BYTES))
+					{
+						client.output += message.text;
+					}
+				}
+			}
+			m_outgoing.clear();
+		}
+
+		polls.clear();
+		pollfd listenPoll = { m_listenSocket, POLLIN, 0 };
+		pollfd wakePoll = { m_wakePipe[0], POLLIN, 0 };
+		polls.push_back(listenPoll);
+		polls.push_back(wakePoll);
+		for (size_t c = 0; c < m_clients.size(); c++)
+		{
+			pollfd clientPoll = { m_clients[c].socket, (short)(POLLIN | ((m_clients[c].output.size() > 0) ? POLLOUT : 0)), 0 };
+			polls.push_back(clientPoll);
+		}
+
+		if (poll(polls.data(), polls.size(), -1) < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			LOG_ERROR("The control socket stopped working");
+			break;
+		}
+
+		if (polls[1].revents & POLLIN)
+		{
+			char buffer[64];
+			while (read(m_wakePipe[0], buffer, sizeof(buffer)) > 0)
+			{
+			}
+		}
+
+		// the clients are served before the new client is added, so
+		// they keep the order of their poll entries
+		for (size_t c = 0; c + 2 < polls.size(); c++)
+		{
+			CONTROL_CLIENT& client = m_clients[c];
+			short events = polls[c + 2].revents;
+			bool bClosed = client.bDropped;
+
+			if ((bClosed == false) && (events & (POLLIN | POLLHUP | POLLERR)))
+			{
+				char buffer[4096];
+				ssize_t count = recv(client.socket, buffer, sizeof(buffer), 0);
+				if ((count == 0) || ((count < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)))
+				{
+					bClosed = true;
+				}
+				else if (count > 0)
+				{
+					client.input.append(buffer, count);
+					size_t end = client.input.find('\n');
+					while (end != std::string::npos)
+					{
+						std::string line = client.input.substr(0, end);
+						client.input.erase(0, end + 1);
+						if (line.find_first_not_of(" \t\r") != std::string::npos)
+						{
+							HandleLine(client, line);
+						}
+						end = client.input.find('\n');
+					}
+					if ((client.input.size() > MAX_LINE_BYTES) || (client.bDropped == true))
+					{
+						bClosed = true;
+					}
+				}
+			}
+
+			if ((bClosed == false) && (client.output.size() > 0))
+			{
+				ssize_t count = send(client.socket, client.output.data(), client.output.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+				if (count > 0)
+				{
+					client.output.erase(0, count);
+				}
+				else if ((count < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+				{
+					bClosed = true;
+				}
+			}
+
+			if (bClosed == true)
+			{
+				close(client.socket);
+				client.socket = -1;
+			}
+		}
+
+		for (size_t c = 0; c < m_clients.size(); )
+		{
+			if (m_clients[c].socket < 0)
+			{
+				m_clients[c] = m_clients.back();
+				m_clients.pop_back();
+			}
+			else
+			{
+				c++;
+			}
+		}
+
+		if (polls[0].revents & POLLIN)
+		{
+			int socket = accept(m_listenSocket, NULL, NULL);
+			if (socket >= 0)
+			{
+				fcntl(socket, F_SETFL, O_NONBLOCK);
+				CONTROL_CLIENT client;
+				client.socket = socket;
+				client.id = m_nextClientId++;
+				client.bStats = false;
+				client.bDropped = false;
+				m_clients.push_back(client);
+			}
+		}
+	}
+
+	for (size_t c = 0; c < m_clients.size(); c++)
+	{
+		close(m_clients[c].socket);
+	}
+	m_clients.clear();
+#endif
+}
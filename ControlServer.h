@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////
+// controlserver.h
+// ===============
+// take commands from automation scripts over a local socket and stream the
+// frame stats back to them
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "FrameStats.h"
+#include "ThreadPool.h"
+
+#include <GL/glew.h>
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// the commands applied by the render thread - the values are bits,
+// so several types can be taken at one point of the frame
+enum CONTROL_COMMAND_TYPE
+{
+	CONTROL_SET_CAMERA = 1,
+	CONTROL_SET_PROJECTION = 2,
+	CONTROL_SCREENSHOT = 4,
+	CONTROL_LOAD_SCENE = 8,
+	CONTROL_QUIT = 16
+};
+
+// a command read from a client
+struct CONTROL_COMMAND
+{
+	CONTROL_COMMAND_TYPE type;
+	// the client the reply is sent to, and the id the client gave
+	// the command as it was written, or empty without one
+	int client;
+	std::string id;
+
+	// set_camera - the world position, the direction the camera
+	// looks in, and the zoom, which is kept when it is zero
+	glm::dvec3 position;
+	glm::vec3 front;
+	float zoom;
+	// set_projection
+	bool bOrthographic;
+	// load_scene - the room grid, its seed, which is kept when
+	// none is given, and whether the rooms are streamed
+	int rooms[3];
+	unsigned int seed;
+	bool bHasSeed;
+	bool bStreamRooms;
+	// screenshot - the PNG file written, inside the screenshots
+	// directory
+	std::string path;
+};
+
+/***********************************************************
+ *  ControlServer
+ *
+ *  This class listens on a Unix domain socket for clients
+ *  that write one JSON object per line, like
+ *
+ *      {"id":1,"cmd":"set_camera","position":[0,5,12],"front":[0,-0.5,-2]}
+ *
+ *  The socket is served by its own thread, which parses the
+ *  commands, answers the malformed ones and queues the rest
+ *  for the render thread.  The render thread only takes the
+ *  command at the head of the queue, and only when its type
+ *  is handled at that point of the frame, so the commands
+ *  are applied in the order they were sent - a screenshot
+ *  after a camera move shows the moved camera.  Replies and
+ *  frame stats are queued for the server thread to write,
+ *  and screenshots are copied through a pixel buffer and
+ *  written by a worker, so the render thread never waits on
+ *  a client.  The socket is only open to the user of the
+ *  application, and screenshots are only written as plain
+ *  file names under the screenshots directory.  The server
+ *  only runs where Unix domain sockets are available.
+ ***********************************************************/
+class ControlServer
+{
+public:
+	ControlServer();
+	// closes the socket and the clients
+	~ControlServer();
+
+	// listen on the socket file, replacing a stale one
+	bool Start(const char* socketPath);
+	void Stop();
+	bool IsRunning() const { return(m_listenSocket >= 0); }
+
+	// take the command at the head of the queue when its type is
+	// one of the bits of the mask
+	bool PopCommand(int typeMask, CONTROL_COMMAND& command);
+	// answer a command once it is applied
+	void Reply(const CONTROL_COMMAND& command, bool bSucceeded, const char* error = NULL);
+
+	// copy the back buffer of the window for a screenshot command,
+	// which is answered once the file is written
+	void RequestScreenshot(const CONTROL_COMMAND& command, int width, int height);
+	// hand the finished screenshot copies to the writer, without
+	// waiting for the unfinished ones
+	void CollectScreenshots();
+
+	// send the stats of a frame to the clients that asked for them
+	void PublishStats(const FRAME_STATS& stats);
+
+	// the server of the application, set by the main code so the
+	// view manager can take its commands
+	static ControlServer* GetActive();
+	static void SetActive(ControlServer* pServer);
+	// read the --control SOCKET command line option
+	static bool ParseArguments(int argc, char* argv[], const char*& socketPath);
+
+private:
+	// a connected client and the bytes not read or written yet
+	struct CONTROL_CLIENT
+	{
+		int socket;
+		int id;
+		std::string input;
+		std::string output;
+		bool bStats;
+		// set when the output went past its limit, which closes
+		// the client
+		bool bDropped;
+	};
+
+	// a message for one client, or for every client taking stats
+	struct OUTGOING_MESSAGE
+	{
+		int client;
+		std::string text;
+	};
+
+	// a screenshot being copied into a pixel buffer
+	struct PENDING_SCREENSHOT
+	{
+		CONTROL_COMMAND command;
+		GLuint pixelBuffer;
+		GLsync fence;
+		int width;
+		int height;
+	};
+
+	void ServerLoop();
+	void HandleLine(CONTROL_CLIENT& client, const std::string& line);
+	void QueueOutput(CONTROL_CLIENT& client, const std::string& text);
+	void Send(int client, const std::string& text);
+	void Wake();
+
+	std::string m_socketPath;
+	int m_listenSocket;
+	// written to wake the server thread when there is output
+	int m_wakePipe[2];
+	std::thread m_serverThread;
+
+	// shared by the render thread and the server thread
+	std::mutex m_mutex;
+	std::deque<CONTROL_COMMAND> m_commands;
+	std::vector<OUTGOING_MESSAGE> m_outgoing;
+	bool m_bStopping;
+
+	// only used by the server thread
+	std::vector<CONTROL_CLIENT> m_clients;
+	int m_nextClientId;
+
+	// only used by the render thread
+	std::vector<PENDING_SCREENSHOT> m_screenshots;
+	ThreadPool* m_pWriterPool;
+};
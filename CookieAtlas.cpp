@@ -0,0 +1,192 @@
+///////////////////////////////////////////////////////////////////////////////
+// cookieatlas.cpp
+// ===============
+// manage the shared atlas texture holding the projected light cookies
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CookieAtlas.h"
+#include "Logger.h"
+
+
+// the implementation of stb_image is compiled in SceneManager.cpp
+#include "stb_image.h"
+
+// declaration of global variables
+namespace
+{
+	// empty texels left around every cookie so that linear
+	// filtering and mipmaps do not bleed between neighbours
+	const int COOKIE_PADDING = 2;
+}
+
+/***********************************************************
+ *  CookieAtlas()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+CookieAtlas::CookieAtlas(int atlasSize)
+{
+	m_textureID = 0;
+	m_atlasSize = atlasSize;
+	m_shelfX = 0;
+	m_shelfY = 0;
+	m_shelfHeight = 0;
+}
+
+/***********************************************************
+ *  ~CookieAtlas()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+CookieAtlas::~CookieAtlas()
+{
+	DestroyAtlasTexture();
+	m_cookies.clear();
+}
+
+/***********************************************************
+ *  CreateAtlasTexture()
+ *
+ *  This method is used for allocating the empty atlas
+ *  texture.  Cookies are single channel light masks.
+ ***********************************************************/
+bool CookieAtlas::CreateAtlasTexture()
+{
+	if (m_textureID != 0)
+	{
+		return(true);
+	}
+
+	glGenTextures(1, &m_textureID);
+	glBindTexture(GL_TEXTURE_2D, m_textureID);
+
+	// cookies must not repeat outside of their rectangle
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	// start with a black atlas so the padding never lets light through
+	std::vector<unsigned char> clearTexels(m_atlasSize * m_atlasSize, 0);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, m_atlasSize, m_atlasSize, 0, GL_RED, GL_UNSIGNED_BYTE, clearTexels.data());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glGenerateMipmap(GL_TEXTURE_2D);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	return(m_textureID != 0);
+}
+
+/***********************************************************
+ *  DestroyAtlasTexture()
+ *
+ *  This method is used for freeing the atlas texture.
+ ***********************************************************/
+void CookieAtlas::DestroyAtlasTexture()
+{
+	if (m_textureID != 0)
+	{
+		glDeleteTextures(1, &m_textureID);
+		m_textureID = 0;
+	}
+}
+
+/***********************************************************
+ *  LoadCookie()
+ *
+ *  This method is used for loading a cookie image into the
+ *  next free area of the atlas.  The images are packed on
+ *  shelves, left to right and bottom to top.  A previously
+ *  loaded image is found by its filename and not reloaded.
+ ***********************************************************/
+bool CookieAtlas::LoadCookie(const char* filename, glm::vec4& uvRect)
+{
+	// the cookie may already be shared by another light
+	for (size_t i = 0; i < m_cookies.size(); i++)
+	{
+		if (m_cookies[i].filename.compare(filename) == 0)
+		{
+			uvRect = m_cookies[i].uvRect;
+			return(true);
+		}
+	}
+
+	if (CreateAtlasTexture() == false)
+	{
+		return(false);
+	}
+
+	int width = 0;
+	int height = 0;
+	int colorChannels = 0;
+
+	// always read the image as a single channel mask
+	stbi_set_flip_vertically_on_load(true);
+	unsigned char* image = stbi_load(filename, &width, &height, &colorChannels, 1);
+	if (!image)
+	{
+		LOG_ERROR("Could not load cookie image:%s", filename);
+		return(false);
+	}
+
+	// start a new shelf when the current one is full
+	if (m_shelfX + width + COOKIE_PADDING > m_atlasSize)
+	{
+		m_shelfX = 0;
+		m_shelfY += m_shelfHeight + COOKIE_PADDING;
+		m_shelfHeight = 0;
+	}
+	if ((width + COOKIE_PADDING > m_atlasSize) || (m_shelfY + height + COOKIE_PADDING > m_atlasSize))
+	{
+		LOG_ERROR("No room in the cookie atlas for:%s", filename);
+		stbi_image_free(image);
+		return(false);
+	}
+
+	int x = m_shelfX + COOKIE_PADDING;
+	int y = m_shelfY + COOKIE_PADDING;
+
+	glBindTexture(GL_TEXTURE_2D, m_textureID);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RED, GL_UNSIGNED_BYTE, image);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glGenerateMipmap(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	stbi_image_free(image);
+
+	m_shelfX = x + width;
+	if (height + COOKIE_PADDING > m_shelfHeight)
+	{
+		m_shelfHeight = height + COOKIE_PADDING;
+	}
+
+	COOKIE_INFO cookie;
+	cookie.filename = filename;
+	cookie.uvRect = glm::vec4(
+		(float)x / (float)m_atlasSize,
+		(float)y / (float)m_atlasSize,
+		(float)width / (float)m_atlasSize,
+		(float)height / (float)m_atlasSize);
+	m_cookies.push_back(cookie);
+
+	uvRect = cookie.uvRect;
+
+	return(true);
+}
+
+/***********************************************************
+ *  BindAtlasTexture()
+ *
+ *  This method is used for binding the atlas texture to
+ *  the passed in OpenGL texture memory slot.
+ ***********************************************************/
+void CookieAtlas::BindAtlasTexture(int textureSlot)
+{
+	glActiveTexture(GL_TEXTURE0 + textureSlot);
+	glBindTexture(GL_TEXTURE_2D, m_textureID);
+}
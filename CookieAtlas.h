@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////
+// cookieatlas.h
+// =============
+// manage the shared atlas texture holding the projected light cookies
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  CookieAtlas
+ *
+ *  This class packs the single channel cookie images that
+ *  are projected by spot lights into one shared texture, so
+ *  that any number of spot lights can use cookies with one
+ *  texture slot.  Each image file is only loaded once, no
+ *  matter how many lights project it.
+ ***********************************************************/
+class CookieAtlas
+{
+public:
+	CookieAtlas(int atlasSize = 1024);
+	~CookieAtlas();
+
+	// allocate the atlas texture memory in OpenGL
+	bool CreateAtlasTexture();
+	// free the atlas texture memory in OpenGL
+	void DestroyAtlasTexture();
+
+	// load a cookie image into the atlas, or find the previously
+	// loaded one, and return its UV rectangle as offset.xy, scale.zw
+	bool LoadCookie(const char* filename, glm::vec4& uvRect);
+
+	// bind the atlas texture to the passed in texture slot
+	void BindAtlasTexture(int textureSlot);
+
+	GLuint GetTextureID() const { return(m_textureID); }
+
+private:
+	// the atlas placement of a loaded cookie image
+	struct COOKIE_INFO
+	{
+		std::string filename;
+		glm::vec4 uvRect;
+	};
+
+	GLuint m_textureID;
+	int m_atlasSize;
+	// the shelf packing cursor
+	int m_shelfX;
+	int m_shelfY;
+	int m_shelfHeight;
+	std::vector<COOKIE_INFO> m_cookies;
+};
@@ -0,0 +1,401 @@
+///////////////////////////////////////////////////////////////////////////////
+// framemetrics.cpp
+// ================
+// keep the distributions of the frame, CPU phase and GPU pass times and
+// export them for monitoring
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameMetrics.h"
+#include "LatencyHistogram.h"
+#include "Logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// declaration of global variables
+namespace
+{
+	// the recorded durations are merged this often
+	const uint64_t MERGE_MICROSECONDS = 1000000;
+	// the merged intervals the rolling percentiles are taken over
+	const int WINDOW_INTERVALS = 10;
+	// the export file is replaced this often
+	const uint64_t EXPORT_MICROSECONDS = 5000000;
+
+	// the upper bounds of the exported buckets in seconds, around the
+	// frame times of the common refresh rates - each is moved up to
+	// the top of the histogram bucket it falls in, so the exported
+	// bucket counts every value up to its le label
+	const double BUCKET_BOUNDS[] =
+	{
+		0.001, 0.002, 0.004, 0.008, 0.0111, 0.0167, 0.025, 0.0333, 0.05, 0.1, 0.25, 0.5, 1.0
+	};
+	const int BUCKET_BOUND_COUNT = sizeof(BUCKET_BOUNDS) / sizeof(BUCKET_BOUNDS[0]);
+	// the rolling percentiles
+	const double WINDOW_QUANTILES[] = { 0.5, 0.9, 0.99, 0.999 };
+	const int WINDOW_QUANTILE_COUNT = sizeof(WINDOW_QUANTILES) / sizeof(WINDOW_QUANTILES[0]);
+
+	// how a metric is exported - the metrics of a family share its
+	// name and differ in one label
+	struct METRIC_EXPORT
+	{
+		const char* family;
+		const char* help;
+		const char* labelName;
+		const char* labelValue;
+	};
+
+	const METRIC_EXPORT METRIC_EXPORTS[METRIC_COUNT] =
+	{
+		{ "scene_frame_seconds", "Time between the starts of successive frames.", NULL, NULL },
+		{ "scene_cpu_phase_seconds", "CPU time of the phases of a frame.", "phase", "view" },
+		{ "scene_cpu_phase_seconds", "CPU time of the phases of a frame.", "phase", "cull" },
+		{ "scene_cpu_phase_seconds", "CPU time of the phases of a frame.", "phase", "render" },
+		{ "scene_cpu_phase_seconds", "CPU time of the phases of a frame.", "phase", "finish" },
+		{ "scene_cpu_phase_seconds", "CPU time of the phases of a frame.", "phase", "swap" },
+		{ "scene_gpu_pass_seconds", "GPU time of the passes of a frame.", "pass", "frame" },
+	};
+
+	// the histograms a thread records into
+	struct METRICS_SHARD
+	{
+		std::mutex mutex;
+		LatencyHistogram histograms[METRIC_COUNT];
+	};
+
+	std::atomic<bool> g_bEnabled(false);
+	std::string g_ExportFile;
+
+	// guards the shards and the merged histograms
+	std::mutex g_RegistryMutex;
+	std::vector<std::shared_ptr<METRICS_SHARD>> g_Shards;
+	LatencyHistogram g_Totals[METRIC_COUNT];
+	LatencyHistogram g_Intervals[WINDOW_INTERVALS][METRIC_COUNT];
+	int g_CurrentInterval = 0;
+
+	// only used by the main loop
+	uint64_t g_LastMerge = 0;
+	uint64_t g_LastExport = 0;
+
+	// the shard of the thread, which the registry keeps until its
+	// counts are merged after the thread has ended
+	thread_local std::shared_ptr<METRICS_SHARD> t_pShard;
+
+	/***********************************************************
+	 *  MergeShards()
+	 *
+	 *  This function is used for moving the counts of every
+	 *  thread into the totals and a new interval, which drops
+	 *  the oldest interval out of the window.
+	 ***********************************************************/
+	void MergeShards()
+	{
+		std::lock_guard<std::mutex> lock(g_RegistryMutex);
+
+		g_CurrentInterval = (g_CurrentInterval + 1) % WINDOW_INTERVALS;
+		for (int metric = 0; metric < METRIC_COUNT; metric++)
+		{
+			g_Intervals[g_CurrentInterval][metric].Reset();
+		}
+
+		for (size_t i = 0; i < g_Shards.size(); )
+		{
+			METRICS_SHARD& shard = *g_Shards[i];
+			{
+				std::lock_guard<std::mutex> shardLock(shard.mutex);
+				for (int metric = 0; metric < METRIC_COUNT; metric++)
+				{
+					g_Totals[metric].Add(shard.histograms[metric]);
+					g_Intervals[g_CurrentInterval][metric].Add(shard.histograms[metric]);
+					shard.histograms[metric].Reset();
+				}
+			}
+
+			// the thread of a shard only held by the registry has ended
+			if (g_Shards[i].use_count() == 1)
+			{
+				g_Shards[i] = g_Shards.back();
+				g_Shards.pop_back();
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+
+	/***********************************************************
+	 *  AppendSeries()
+	 *
+	 *  This function is used for writing one line of a metric,
+	 *  with its label and an optional extra label.
+	 ***********************************************************/
+	void AppendSeries(std::string& text, const char* name, const METRIC_EXPORT& metric,
+		const char* extraName, const char* extraValue, const char* value)
+	{
+		text += name;
+		if ((NULL != metric.labelName) || (NULL != extraName))
+		{
+			text += "{";
+			if (NULL != metric.labelName)
+			{
+				text += std::string(metric.labelName) + "=\"" + metric.labelValue + "\"";
+			}
+			if (NULL != extraName)
+			{
+				if (NULL != metric.labelName)
+				{
+					text += ",";
+				}
+				text += std::string(extraName) + "=\"" + extraValue + "\"";
+			}
+			text += "}";
+		}
+		text += " ";
+		text += value;
+		text += "\n";
+	}
+}
+
+/***********************************************************
+ *  Enable()
+ *
+ *  This method is used for starting the recording.
+ ***********************************************************/
+void FrameMetrics::Enable(const char* exportFile)
+{
+	if (NULL != exportFile)
+	{
+		g_ExportFile = exportFile;
+		LOG_INFO("Writing the frame metrics into %s", exportFile);
+	}
+	g_LastMerge = GetMicroseconds();
+	g_LastExport = g_LastMerge;
+	g_bEnabled = true;
+}
+
+/***********************************************************
+ *  IsEnabled()
+ *
+ *  This method is used for checking whether the durations
+ *  are recorded.
+ ***********************************************************/
+bool FrameMetrics::IsEnabled()
+{
+	return(g_bEnabled);
+}
+
+/***********************************************************
+ *  GetMicroseconds()
+ *
+ *  This method is used for getting the time of a steady
+ *  clock in microseconds.
+ ***********************************************************/
+uint64_t FrameMetrics::GetMicroseconds()
+{
+	return((uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/***********************************************************
+ *  Record()
+ *
+ *  This method is used for recording a duration into the
+ *  histograms of the calling thread, which are registered
+ *  on the first duration the thread records.
+ ***********************************************************/
+void FrameMetrics::Record(FRAME_METRIC metric, uint64_t microseconds)
+{
+	if (g_bEnabled == false)
+	{
+		return;
+	}
+
+	if (NULL == t_pShard)
+	{
+		t_pShard = std::make_shared<METRICS_SHARD>();
+		std::lock_guard<std::mutex> lock(g_RegistryMutex);
+		g_Shards.push_back(t_pShard);
+	}
+
+	std::lock_guard<std::mutex> lock(t_pShard->mutex);
+	t_pShard->histograms[metric].Record(microseconds);
+}
+
+/***********************************************************
+ *  RecordSince()
+ *
+ *  This method is used for recording the time since the
+ *  start of a phase.
+ ***********************************************************/
+uint64_t FrameMetrics::RecordSince(FRAME_METRIC metric, uint64_t startMicroseconds)
+{
+	uint64_t now = GetMicroseconds();
+	Record(metric, now - startMicroseconds);
+
+	return(now);
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for merging the durations once a
+ *  second, and replacing the export file every few seconds.
+ *  The file is written beside the old one and renamed over
+ *  it, so a collector never reads half a file.
+ ***********************************************************/
+void FrameMetrics::Update()
+{
+	if (g_bEnabled == false)
+	{
+		return;
+	}
+
+	uint64_t now = GetMicroseconds();
+	if (now - g_LastMerge < MERGE_MICROSECONDS)
+	{
+		return;
+	}
+	g_LastMerge = now;
+	MergeShards();
+
+	if ((g_ExportFile.size() == 0) || (now - g_LastExport < EXPORT_MICROSECONDS))
+	{
+		return;
+	}
+	g_LastExport = now;
+
+	std::string text = GetPrometheusText();
+	std::string partialFile = g_ExportFile + ".tmp";
+	FILE* pFile = fopen(partialFile.c_str(), "w");
+	bool bWritten = (NULL != pFile) && (fwrite(text.data(), 1, text.size(), pFile) == text.size());
+	if (NULL != pFile)
+	{
+		bWritten = (fclose(pFile) == 0) && bWritten;
+	}
+	if ((bWritten == false) || (rename(partialFile.c_str(), g_ExportFile.c_str()) != 0))
+	{
+		LOG_ERROR("Could not write the frame metrics into %s", g_ExportFile.c_str());
+		remove(partialFile.c_str());
+	}
+}
+
+/***********************************************************
+ *  GetPrometheusText()
+ *
+ *  This method is used for writing the merged metrics as a
+ *  cumulative histogram of every family since the start,
+ *  followed by the rolling percentiles of the window as a
+ *  summary family of their own.  The durations are exported
+ *  in seconds.
+ ***********************************************************/
+std::string FrameMetrics::GetPrometheusText()
+{
+	std::string text;
+	char value[64];
+	char name[128];
+
+	std::lock_guard<std::mutex> lock(g_RegistryMutex);
+
+	for (int metric = 0; metric < METRIC_COUNT; metric++)
+	{
+		const METRIC_EXPORT& exported = METRIC_EXPORTS[metric];
+		const LatencyHistogram& total = g_Totals[metric];
+		if ((metric == 0) || (strcmp(exported.family, METRIC_EXPORTS[metric - 1].family) != 0))
+		{
+			text += std::string("# HELP ") + exported.family + " " + exported.help + "\n";
+			text += std::string("# TYPE ") + exported.family + " histogram\n";
+		}
+
+		snprintf(name, sizeof(name), "%s_bucket", exported.family);
+		for (int bound = 0; bound < BUCKET_BOUND_COUNT; bound++)
+		{
+			char le[32];
+			uint64_t boundTop = LatencyHistogram::GetBucketTopAt((uint64_t)(BUCKET_BOUNDS[bound] * 1000000.0 + 0.5));
+			snprintf(le, sizeof(le), "%.7g", (double)boundTop / 1000000.0);
+			snprintf(value, sizeof(value), "%llu", (unsigned long long)total.GetCountAtOrBelow(boundTop));
+			AppendSeries(text, name, exported, "le", le, value);
+		}
+		snprintf(value, sizeof(value), "%llu", (unsigned long long)total.GetCount());
+		AppendSeries(text, name, exported, "le", "+Inf", value);
+
+		snprintf(name, sizeof(name), "%s_sum", exported.family);
+		snprintf(value, sizeof(value), "%.6f", (double)total.GetSum() / 1000000.0);
+		AppendSeries(text, name, exported, NULL, NULL, value);
+		snprintf(name, sizeof(name), "%s_count", exported.family);
+		snprintf(value, sizeof(value), "%llu", (unsigned long long)total.GetCount());
+		AppendSeries(text, name, exported, NULL, NULL, value);
+	}
+
+	LatencyHistogram window;
+	for (int metric = 0; metric < METRIC_COUNT; metric++)
+	{
+		const METRIC_EXPORT& exported = METRIC_EXPORTS[metric];
+		// the family name ends in _seconds, which stays at the end
+		std::string family = exported.family;
+		family.insert(family.size() - strlen("_seconds"), "_window");
+		if ((metric == 0) || (strcmp(exported.family, METRIC_EXPORTS[metric - 1].family) != 0))
+		{
+			text += "# HELP " + family + " Percentiles over the last " + std::to_string(WINDOW_INTERVALS) + " seconds.\n";
+			text += "# TYPE " + family + " summary\n";
+		}
+
+		window.Reset();
+		for (int interval = 0; interval < WINDOW_INTERVALS; interval++)
+		{
+			window.Add(g_Intervals[interval][metric]);
+		}
+		for (int quantile = 0; quantile < WINDOW_QUANTILE_COUNT; quantile++)
+		{
+			char label[32];
+			snprintf(label, sizeof(label), "%g", WINDOW_QUANTILES[quantile]);
+			snprintf(value, sizeof(value), "%.6f",
+				(double)window.GetPercentile(WINDOW_QUANTILES[quantile] * 100.0) / 1000000.0);
+			AppendSeries(text, family.c_str(), exported, "quantile", label, value);
+		}
+
+		// the sum and count of a summary are counters, so they are
+		// taken from the totals like the client libraries do
+		snprintf(name, sizeof(name), "%s_sum", family.c_str());
+		snprintf(value, sizeof(value), "%.6f", (double)g_Totals[metric].GetSum() / 1000000.0);
+		AppendSeries(text, name, exported, NULL, NULL, value);
+		snprintf(name, sizeof(name), "%s_count", family.c_str());
+		snprintf(value, sizeof(value), "%llu", (unsigned long long)g_Totals[metric].GetCount());
+		AppendSeries(text, name, exported, NULL, NULL, value);
+	}
+
+	return(text);
+}
+
+/***********************************************************
+ *  ParseArguments()
+ *
+ *  This method is used for reading the file the metrics are
+ *  exported into from the command line, which is left NULL
+ *  when the option is not given.
+ ***********************************************************/
+bool FrameMetrics::ParseArguments(int argc, char* argv[], const char*& exportFile)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--metrics") == 0) && (i + 1 < argc))
+		{
+			exportFile = argv[++i];
+		}
+		else if (strcmp(argv[i], "--metrics") == 0)
+		{
+			LOG_ERROR("the metrics file must be given as --metrics PATH");
+			return(false);
+		}
+	}
+
+	return(true);
+}
@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////
+// framemetrics.h
+// ==============
+// keep the distributions of the frame, CPU phase and GPU pass times and
+// export them for monitoring
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// the durations that are kept
+enum FRAME_METRIC
+{
+	// the time between the starts of successive frames
+	METRIC_FRAME = 0,
+	// the CPU phases of a frame - preparing the view, culling one
+	// view, which may run on a worker, rendering the views,
+	// finishing the frame with the captures and commands, and
+	// swapping the buffers
+	METRIC_CPU_VIEW,
+	METRIC_CPU_CULL,
+	METRIC_CPU_RENDER,
+	METRIC_CPU_FINISH,
+	METRIC_CPU_SWAP,
+	// the GPU time of the frame
+	METRIC_GPU_FRAME,
+	METRIC_COUNT
+};
+
+/***********************************************************
+ *  FrameMetrics
+ *
+ *  Every thread records its durations into histograms of
+ *  its own, behind a lock that only the merge contends for,
+ *  so recording stays cheap on the render thread and the
+ *  workers alike.  Once a second the main loop merges them
+ *  into the totals since the start and into a ring of
+ *  one-second intervals, whose last ten seconds give the
+ *  rolling percentiles.  The metrics are exported in the
+ *  Prometheus text format, into a file that is replaced
+ *  every few seconds for a textfile collector, or through
+ *  the control socket.  Nothing is recorded until the
+ *  metrics are enabled.
+ ***********************************************************/
+class FrameMetrics
+{
+public:
+	// start recording, and exporting into the file when it is not
+	// NULL
+	static void Enable(const char* exportFile);
+	static bool IsEnabled();
+
+	static void Record(FRAME_METRIC metric, uint64_t microseconds);
+	// the time in microseconds for measuring a phase
+	static uint64_t GetMicroseconds();
+	// record the time since the start of a phase, and return the
+	// time now as the start of the next phase
+	static uint64_t RecordSince(FRAME_METRIC metric, uint64_t startMicroseconds);
+
+	// merge the recorded durations and write the export file when
+	// they are due - called once a frame by the main loop
+	static void Update();
+	// the metrics in the Prometheus text format, from any thread
+	static std::string GetPrometheusText();
+
+	// read the --metrics FILE command line option
+	static bool ParseArguments(int argc, char* argv[], const char*& exportFile);
+};
@@ -0,0 +1,401 @@
+///////////////////////////////////////////////////////////////////////////////
+// framerecorder.cpp
+// =================
+// record the frames of the main window into a video by piping them to an
+// encoder process
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameRecorder.h"
+#include "Logger.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#else
+#include <csignal>
+#endif
+
+// declaration of global variables
+namespace
+{
+	// the pixel buffers the frames are copied into - a frame is
+	// dropped when all of them are still in flight
+	const int CAPTURE_SLOTS = 4;
+	// the most frames waiting for the encoder before new frames
+	// are dropped, which bounds the memory of a slow encoder
+	const size_t MAX_QUEUED_FRAMES = 8;
+	// the rate of the video clock the captured frames are
+	// repeated or skipped against
+	const int RECORD_FRAME_RATE = 60;
+	// the rows are read bottom first, so the encoder flips them
+	const char* const ENCODER_COMMAND =
+		"ffmpeg -loglevel error -y -f rawvideo -pixel_format rgb24 -video_size %dx%d -framerate %d -i - "
+		"-vf vflip -c:v libx264 -preset veryfast -pix_fmt yuv420p \"%s\"";
+#ifdef _WIN32
+	const char* const ENCODER_MODE = "wb";
+#else
+	const char* const ENCODER_MODE = "w";
+#endif
+
+	FrameRecorder* g_pActiveRecorder = nullptr;
+}
+
+/***********************************************************
+ *  FrameRecorder()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameRecorder::FrameRecorder()
+{
+	m_pWindow = NULL;
+	m_pEncoder = NULL;
+	m_width = 0;
+	m_height = 0;
+	m_startTime = 0.0;
+	m_oldestSlot = 0;
+	m_slotsInFlight = 0;
+	m_droppedCount = 0;
+	m_bStopping = false;
+	m_bEncoderFailed = false;
+	m_encodedCount = 0;
+}
+
+/***********************************************************
+ *  ~FrameRecorder()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FrameRecorder::~FrameRecorder()
+{
+	if (this == g_pActiveRecorder)
+	{
+		g_pActiveRecorder = NULL;
+	}
+	Stop();
+}
+
+/***********************************************************
+ *  GetActive()
+ *
+ *  This method is used for getting the recorder of the main
+ *  window, which is NULL while nothing is recorded.
+ ***********************************************************/
+FrameRecorder* FrameRecorder::GetActive()
+{
+	return(g_pActiveRecorder);
+}
+
+/***********************************************************
+ *  SetActive()
+ *
+ *  This method is used for setting the recorder of the main
+ *  window.
+ ***********************************************************/
+void FrameRecorder::SetActive(FrameRecorder* pRecorder)
+{
+	g_pActiveRecorder = pRecorder;
+}
+
+/***********************************************************
+ *  Start()
+ *
+ *  This method is used for starting the encoder process for
+ *  the framebuffer size of the window, and allocating the
+ *  pixel buffers of the ring.
+ ***********************************************************/
+bool FrameRecorder::Start(GLFWwindow* pWindow, const char* filename)
+{
+	if ((IsRecording() == true) || (NULL == pWindow) || (NULL == filename))
+	{
+		return(false);
+	}
+
+	int width = 0;
+	int height = 0;
+	glfwGetFramebufferSize(pWindow, &width, &height);
+	if ((width <= 0) || (height <= 0))
+	{
+		return(false);
+	}
+
+#ifndef _WIN32
+	// an encoder that quits fails the writes instead of ending the
+	// application
+	signal(SIGPIPE, SIG_IGN);
+#endif
+
+	char command[1024];
+	snprintf(command, sizeof(command), ENCODER_COMMAND, width, height, RECORD_FRAME_RATE, filename);
+	m_pEncoder = popen(command, ENCODER_MODE);
+	if (NULL == m_pEncoder)
+	{
+		LOG_ERROR("Could not start the encoder for %s", filename);
+		return(false);
+	}
+
+	m_pWindow = pWindow;
+	m_width = width;
+	m_height = height;
+
+	m_slots.resize(CAPTURE_SLOTS);
+	for (int i = 0; i < CAPTURE_SLOTS; i++)
+	{
+		glGenBuffers(1, &m_slots[i].pixelBuffer);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, m_slots[i].pixelBuffer);
+		glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)m_width * m_height * 3, NULL, GL_STREAM_READ);
+		m_slots[i].fence = 0;
+		m_slots[i].captureTime = 0.0;
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	m_oldestSlot = 0;
+	m_slotsInFlight = 0;
+	m_droppedCount = 0;
+
+	m_bStopping = false;
+	m_bEncoderFailed = false;
+	m_encodedCount = 0;
+	m_startTime = glfwGetTime();
+	m_encoderThread = std::thread(&FrameRecorder::EncoderLoop, this);
+
+	LOG_INFO("Recording %d x %d frames into %s", m_width, m_height, filename);
+
+	return(true);
+}
+
+/***********************************************************
+ *  Stop()
+ *
+ *  This method is used for ending the recording.  The copies
+ *  still in flight are waited for, since no later frame
+ *  will collect them, and the encoder thread writes the
+ *  queued frames before the encoder is closed.
+ ***********************************************************/
+void FrameRecorder::Stop()
+{
+	if (IsRecording() == false)
+	{
+		return;
+	}
+
+	while (m_slotsInFlight > 0)
+	{
+		CollectSlot(m_slots[m_oldestSlot], true);
+		m_oldestSlot = (m_oldestSlot + 1) % CAPTURE_SLOTS;
+		m_slotsInFlight--;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStopping = true;
+	}
+	m_frameQueued.notify_all();
+	m_encoderThread.join();
+
+	pclose(m_pEncoder);
+	m_pEncoder = NULL;
+	m_pWindow = NULL;
+
+	for (size_t i = 0; i < m_slots.size(); i++)
+	{
+		glDeleteBuffers(1, &m_slots[i].pixelBuffer);
+	}
+	m_slots.clear();
+	m_queuedFrames.clear();
+	m_freeFrames.clear();
+
+	LOG_INFO("Recorded %d frames, %d dropped", m_encodedCount, m_droppedCount);
+}
+
+/***********************************************************
+ *  CaptureFrame()
+ *
+ *  This method is used for collecting the copies that have
+ *  finished, oldest first, and copying the back buffer into
+ *  the next free buffer of the ring.  The recording stops
+ *  when the window was resized or the encoder has failed.
+ ***********************************************************/
+void FrameRecorder::CaptureFrame()
+{
+	if (IsRecording() == false)
+	{
+		return;
+	}
+
+	int width = 0;
+	int height = 0;
+	glfwGetFramebufferSize(m_pWindow, &width, &height);
+	bool bEncoderFailed = false;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		bEncoderFailed = m_bEncoderFailed;
+	}
+	if (bEncoderFailed == true)
+	{
+		LOG_ERROR("The encoder stopped taking frames, so the recording is stopped");
+		Stop();
+		return;
+	}
+	if ((width != m_width) || (height != m_height))
+	{
+		// a minimized window draws nothing worth recording
+		if ((width > 0) && (height > 0))
+		{
+			LOG_INFO("The window was resized, so the recording is stopped");
+			Stop();
+		}
+		return;
+	}
+
+	while ((m_slotsInFlight > 0) && (CollectSlot(m_slots[m_oldestSlot], false) == true))
+	{
+		m_oldestSlot = (m_oldestSlot + 1) % CAPTURE_SLOTS;
+		m_slotsInFlight--;
+	}
+	if (m_slotsInFlight == CAPTURE_SLOTS)
+	{
+		m_droppedCount++;
+		return;
+	}
+
+	// the copy into the pixel buffer only queues the transfer, and
+	// the fence tells when it has finished
+	CAPTURE_SLOT& slot = m_slots[(m_oldestSlot + m_slotsInFlight) % CAPTURE_SLOTS];
+	glReadBuffer(GL_BACK);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pixelBuffer);
+	glReadPixels(0, 0, m_width, m_height, GL_RGB, GL_UNSIGNED_BYTE, 0);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	slot.captureTime = glfwGetTime() - m_startTime;
+	m_slotsInFlight++;
+}
+
+/***********************************************************
+ *  CollectSlot()
+ *
+ *  This method is used for handing the frame of a finished
+ *  copy to the encoder thread.  False is returned while the
+ *  copy is still in flight, which is only waited for when
+ *  the recording is stopping.
+ ***********************************************************/
+bool FrameRecorder::CollectSlot(CAPTURE_SLOT& slot, bool bWait)
+{
+	GLenum status = glClientWaitSync(slot.fence, 0, 0);
+	while ((bWait == true) && (status == GL_TIMEOUT_EXPIRED))
+	{
+		status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+	}
+	if (status == GL_TIMEOUT_EXPIRED)
+	{
+		return(false);
+	}
+	glDeleteSync(slot.fence);
+	slot.fence = 0;
+
+	QUEUED_FRAME frame;
+	frame.captureTime = slot.captureTime;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if ((status == GL_WAIT_FAILED) || (m_queuedFrames.size() >= MAX_QUEUED_FRAMES))
+		{
+			m_droppedCount++;
+			return(true);
+		}
+		if (m_freeFrames.size() > 0)
+		{
+			frame.pixels.swap(m_freeFrames.back());
+			m_freeFrames.pop_back();
+		}
+	}
+
+	size_t byteCount = (size_t)m_width * m_height * 3;
+	frame.pixels.resize(byteCount);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pixelBuffer);
+	const void* pMapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, byteCount, GL_MAP_READ_BIT);
+	if (NULL == pMapped)
+	{
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		m_droppedCount++;
+		return(true);
+	}
+	memcpy(frame.pixels.data(), pMapped, byteCount);
+	glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_queuedFrames.push_back(std::move(frame));
+	}
+	m_frameQueued.notify_one();
+
+	return(true);
+}
+
+/***********************************************************
+ *  EncoderLoop()
+ *
+ *  This method is run by the encoder thread, which writes
+ *  the queued frames to the encoder until the recording
+ *  stops and the queue is empty.  A frame is held until the
+ *  next one arrives, and is then written once for every
+ *  tick of the video clock up to the capture of the next
+ *  frame - a frame the next one replaces within the same
+ *  tick is never written.  Once a write has failed the
+ *  frames are only thrown away, so the render loop is never
+ *  held up by an encoder that is gone.
+ ***********************************************************/
+void FrameRecorder::EncoderLoop()
+{
+	std::vector<unsigned char> heldFrame;
+	bool bEncoderFailed = false;
+
+	while (true)
+	{
+		QUEUED_FRAME frame;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_frameQueued.wait(lock, [this]() { return(m_bStopping || (m_queuedFrames.size() > 0)); });
+			if (m_queuedFrames.size() == 0)
+			{
+				break;
+			}
+			frame = std::move(m_queuedFrames.front());
+			m_queuedFrames.pop_front();
+		}
+
+		// the tick of the video clock the new frame starts at
+		long long tick = (long long)(frame.captureTime * RECORD_FRAME_RATE + 0.5);
+		while ((heldFrame.size() > 0) && (bEncoderFailed == false) && (m_encodedCount < tick))
+		{
+			if (fwrite(heldFrame.data(), 1, heldFrame.size(), m_pEncoder) == heldFrame.size())
+			{
+				m_encodedCount++;
+			}
+			else
+			{
+				bEncoderFailed = true;
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bEncoderFailed = bEncoderFailed;
+		if (heldFrame.size() > 0)
+		{
+			m_freeFrames.push_back(std::move(heldFrame));
+		}
+		heldFrame.swap(frame.pixels);
+	}
+
+	// the last frame is shown for one tick
+	if ((heldFrame.size() > 0) && (bEncoderFailed == false) &&
+		(fwrite(heldFrame.data(), 1, heldFrame.size(), m_pEncoder) == heldFrame.size()))
+	{
+		m_encodedCount++;
+	}
+}
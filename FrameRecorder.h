@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////
+// framerecorder.h
+// ===============
+// record the frames of the main window into a video by piping them to an
+// encoder process
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include "GLFW/glfw3.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  FrameRecorder
+ *
+ *  This class copies every finished frame of the window
+ *  into the next pixel buffer of a ring, behind a fence.
+ *  The fences are only polled, so a buffer is mapped a few
+ *  frames later once its copy has finished, and the frame
+ *  is dropped instead of waited for when every buffer is
+ *  still in flight.  The mapped pixels are handed to an
+ *  encoder thread that writes them to the standard input
+ *  of ffmpeg, so the render loop never waits for the copy
+ *  or for the encoder.  Every frame keeps the time it was
+ *  captured at, and the encoder thread holds each frame
+ *  until the next one on a fixed video clock - frames are
+ *  repeated when the display is slower than the video or
+ *  frames were dropped, and skipped when it is faster, so
+ *  the video plays at the speed it was recorded at no
+ *  matter the refresh rate.  The video keeps the framebuffer
+ *  size the recording was started at, and the recording
+ *  stops when the window is resized.
+ ***********************************************************/
+class FrameRecorder
+{
+public:
+	FrameRecorder();
+	// stops the recording
+	~FrameRecorder();
+
+	// start the encoder for the framebuffer of the window
+	bool Start(GLFWwindow* pWindow, const char* filename);
+	// wait for the frames in flight, let the encoder finish and
+	// close it
+	void Stop();
+	bool IsRecording() const { return(NULL != m_pEncoder); }
+
+	// copy the back buffer of the window - called once the frame
+	// is drawn and before it is swapped
+	void CaptureFrame();
+	// the frames left out because the GPU or the encoder was behind
+	int GetDroppedCount() const { return(m_droppedCount); }
+
+	// the recorder of the main window, set by the view manager so
+	// the main loop can capture the frames
+	static FrameRecorder* GetActive();
+	static void SetActive(FrameRecorder* pRecorder);
+
+private:
+	// a pixel buffer of the ring and the fence after its copy
+	struct CAPTURE_SLOT
+	{
+		GLuint pixelBuffer;
+		GLsync fence;
+		double captureTime;
+	};
+
+	// a frame waiting for the encoder thread, with the seconds
+	// since the recording started at its capture
+	struct QUEUED_FRAME
+	{
+		double captureTime;
+		std::vector<unsigned char> pixels;
+	};
+
+	bool CollectSlot(CAPTURE_SLOT& slot, bool bWait);
+	void EncoderLoop();
+
+	GLFWwindow* m_pWindow;
+	FILE* m_pEncoder;
+	int m_width;
+	int m_height;
+	// the GLFW time the recording started at
+	double m_startTime;
+
+	// the copies in flight are the oldest slot and the ones after it
+	std::vector<CAPTURE_SLOT> m_slots;
+	int m_oldestSlot;
+	int m_slotsInFlight;
+	int m_droppedCount;
+
+	// the frames waiting for the encoder thread, and the frames it
+	// has written, which are reused for the next copies
+	std::thread m_encoderThread;
+	std::mutex m_mutex;
+	std::condition_variable m_frameQueued;
+	std::deque<QUEUED_FRAME> m_queuedFrames;
+	std::vector<std::vector<unsigned char>> m_freeFrames;
+	bool m_bStopping;
+	bool m_bEncoderFailed;
+	// the video frames written by the encoder thread, read once it
+	// is joined
+	int m_encodedCount;
+};
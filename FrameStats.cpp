@@ -0,0 +1,235 @@
+///////////////////////////////////////////////////////////////////////////////
+// framestats.cpp
+// ==============
+// measure the CPU and GPU time, draws, triangles and memory of every frame
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameStats.h"
+#include "WorldStreamer.h"
+
+#include <chrono>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+// declaration of global variables
+namespace
+{
+	// the frames whose queries can be in flight at the same time
+	const int QUERY_SLOTS = 4;
+	// the resident memory is read once every this many frames
+	const unsigned int MEMORY_SAMPLE_FRAMES = 30;
+
+	// the queries of one frame and its measurements on the CPU
+	struct QUERY_SLOT
+	{
+		GLuint timeQuery;
+		GLuint triangleQuery;
+		bool bPending;
+		FRAME_STATS stats;
+	};
+
+	QUERY_SLOT g_Slots[QUERY_SLOTS];
+	bool g_bQueriesCreated = false;
+	// the slot of the frame being drawn, or -1 when every slot was
+	// still busy as it began
+	int g_CurrentSlot = -1;
+	int g_NextSlot = 0;
+
+	std::chrono::steady_clock::time_point g_FrameStart;
+	unsigned int g_FrameNumber = 0;
+	int g_DrawCount = 0;
+	size_t g_ResidentBytes = 0;
+	FRAME_STATS g_Latest = {};
+
+	/***********************************************************
+	 *  ReadResidentBytes()
+	 *
+	 *  This function is used for reading the memory resident
+	 *  in the process, which is only known on Linux.
+	 ***********************************************************/
+	size_t ReadResidentBytes()
+	{
+#ifndef _WIN32
+		FILE* pFile = fopen("/proc/self/statm", "r");
+		if (NULL == pFile)
+		{
+			return(0);
+		}
+		unsigned long totalPages = 0;
+		unsigned long residentPages = 0;
+		int fields = fscanf(pFile, "%lu %lu", &totalPages, &residentPages);
+		fclose(pFile);
+		if (fields != 2)
+		{
+			return(0);
+		}
+		return((size_t)residentPages * (size_t)sysconf(_SC_PAGESIZE));
+#else
+		return(0);
+#endif
+	}
+
+	/***********************************************************
+	 *  CollectSlot()
+	 *
+	 *  This function is used for reading the queries of a slot
+	 *  when their results are available, without waiting for
+	 *  them.  True is returned when the slot was collected.
+	 ***********************************************************/
+	bool CollectSlot(QUERY_SLOT& slot)
+	{
+		GLuint bTimeAvailable = GL_FALSE;
+		GLuint bTrianglesAvailable = GL_FALSE;
+		glGetQueryObjectuiv(slot.timeQuery, GL_QUERY_RESULT_AVAILABLE, &bTimeAvailable);
+		glGetQueryObjectuiv(slot.triangleQuery, GL_QUERY_RESULT_AVAILABLE, &bTrianglesAvailable);
+		if ((bTimeAvailable == GL_FALSE) || (bTrianglesAvailable == GL_FALSE))
+		{
+			return(false);
+		}
+
+		GLuint64 elapsedNanoseconds = 0;
+		glGetQueryObjectui64v(slot.timeQuery, GL_QUERY_RESULT, &elapsedNanoseconds);
+		glGetQueryObjectui64v(slot.triangleQuery, GL_QUERY_RESULT, &slot.stats.triangleCount);
+		slot.stats.gpuMilliseconds = (float)((double)elapsedNanoseconds / 1000000.0);
+		slot.bPending = false;
+
+		if (slot.stats.frame > g_Latest.frame)
+		{
+			g_Latest = slot.stats;
+		}
+		return(true);
+	}
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for starting the measurements of a
+ *  frame.  The queries are created on the first frame.
+ ***********************************************************/
+void FrameStats::BeginFrame()
+{
+	if (g_bQueriesCreated == false)
+	{
+		for (int i = 0; i < QUERY_SLOTS; i++)
+		{
+			glGenQueries(1, &g_Slots[i].timeQuery);
+			glGenQueries(1, &g_Slots[i].triangleQuery);
+			g_Slots[i].bPending = false;
+		}
+		g_bQueriesCreated = true;
+	}
+
+	g_FrameNumber++;
+	g_DrawCount = 0;
+	g_FrameStart = std::chrono::steady_clock::now();
+
+	QUERY_SLOT& slot = g_Slots[g_NextSlot];
+	if ((slot.bPending == true) && (CollectSlot(slot) == false))
+	{
+		g_CurrentSlot = -1;
+		return;
+	}
+
+	g_CurrentSlot = g_NextSlot;
+	g_NextSlot = (g_NextSlot + 1) % QUERY_SLOTS;
+	glBeginQuery(GL_TIME_ELAPSED, slot.timeQuery);
+	glBeginQuery(GL_PRIMITIVES_GENERATED, slot.triangleQuery);
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for ending the measurements of a
+ *  frame, and collecting the frames before it whose queries
+ *  have finished, oldest first.
+ ***********************************************************/
+bool FrameStats::EndFrame()
+{
+	float cpuMilliseconds = std::chrono::duration<float, std::milli>(
+		std::chrono::steady_clock::now() - g_FrameStart).count();
+
+	if ((g_FrameNumber % MEMORY_SAMPLE_FRAMES == 1) || (g_ResidentBytes == 0))
+	{
+		g_ResidentBytes = ReadResidentBytes();
+	}
+
+	if (g_CurrentSlot >= 0)
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		glEndQuery(GL_PRIMITIVES_GENERATED);
+
+		QUERY_SLOT& slot = g_Slots[g_CurrentSlot];
+		slot.stats.frame = g_FrameNumber;
+		slot.stats.cpuMilliseconds = cpuMilliseconds;
+		slot.stats.gpuMilliseconds = 0.0f;
+		slot.stats.drawCount = g_DrawCount;
+		slot.stats.triangleCount = 0;
+		slot.stats.residentBytes = g_ResidentBytes;
+		slot.stats.streamedBytes = (NULL != WorldStreamer::GetScene()) ? WorldStreamer::GetScene()->GetResidentBytes() : 0;
+		slot.bPending = true;
+		g_CurrentSlot = -1;
+	}
+
+	unsigned int latestFrame = g_Latest.frame;
+	for (int i = 0; i < QUERY_SLOTS; i++)
+	{
+		QUERY_SLOT& slot = g_Slots[(g_NextSlot + i) % QUERY_SLOTS];
+		if ((slot.bPending == true) && (CollectSlot(slot) == false))
+		{
+			break;
+		}
+	}
+
+	return(g_Latest.frame != latestFrame);
+}
+
+/***********************************************************
+ *  CountDraw()
+ *
+ *  This method is used for counting a scene object drawn in
+ *  the frame.
+ ***********************************************************/
+void FrameStats::CountDraw()
+{
+	g_DrawCount++;
+}
+
+/***********************************************************
+ *  GetLatest()
+ *
+ *  This method is used for getting the stats of the latest
+ *  frame whose queries have finished.
+ ***********************************************************/
+const FRAME_STATS& FrameStats::GetLatest()
+{
+	return(g_Latest);
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the queries.
+ ***********************************************************/
+void FrameStats::Destroy()
+{
+	if (g_bQueriesCreated == false)
+	{
+		return;
+	}
+
+	for (int i = 0; i < QUERY_SLOTS; i++)
+	{
+		glDeleteQueries(1, &g_Slots[i].timeQuery);
+		glDeleteQueries(1, &g_Slots[i].triangleQuery);
+		g_Slots[i].bPending = false;
+	}
+	g_bQueriesCreated = false;
+	g_CurrentSlot = -1;
+}
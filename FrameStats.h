@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////
+// framestats.h
+// ============
+// measure the CPU and GPU time, draws, triangles and memory of every frame
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+
+// the measurements of one frame
+struct FRAME_STATS
+{
+	// counts up from one with every measured frame
+	unsigned int frame;
+	// the time the main thread spent on the frame, before the swap
+	float cpuMilliseconds;
+	// the time the GPU spent on the commands of the frame
+	float gpuMilliseconds;
+	// the scene objects drawn in every view of the frame
+	int drawCount;
+	// the triangles the GPU assembled for the frame
+	GLuint64 triangleCount;
+	// the memory resident in the process, and the part of it taken
+	// by the streamed rooms
+	size_t residentBytes;
+	size_t streamedBytes;
+};
+
+/***********************************************************
+ *  FrameStats
+ *
+ *  The main loop marks the start and end of every frame,
+ *  and the GPU time and triangles of the frame are counted
+ *  by queries around it.  The queries are read a few frames
+ *  later, once their results are available, so measuring
+ *  never waits for the GPU - the latest stats are those of
+ *  the latest frame whose queries have finished.  A frame
+ *  is still measured on the CPU when every query is busy,
+ *  but it is left out of the stats.
+ ***********************************************************/
+class FrameStats
+{
+public:
+	static void BeginFrame();
+	// true is returned when the stats of an earlier frame have
+	// become available
+	static bool EndFrame();
+	// count a scene object drawn in the frame
+	static void CountDraw();
+
+	// the latest stats whose queries have finished
+	static const FRAME_STATS& GetLatest();
+	// free the queries while the context is still current
+	static void Destroy();
+};
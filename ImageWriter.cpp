@@ -0,0 +1,331 @@
+///////////////////////////////////////////////////////////////////////////////
+// imagewriter.cpp
+// ===============
+// write the pixels read back from a render target into PNG and EXR files
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ImageWriter.h"
+#include "Logger.h"
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+// declaration of global variables
+namespace
+{
+	// the most bytes in one stored deflate block
+	const int DEFLATE_BLOCK_BYTES = 65535;
+	// the magic number and version at the start of an EXR file
+	const uint32_t EXR_MAGIC = 20000630;
+	const uint32_t EXR_VERSION = 2;
+
+	/***********************************************************
+	 *  PutBigEndian()
+	 *
+	 *  This function is used for appending a 32 bit number
+	 *  with its high byte first, as PNG stores them.
+	 ***********************************************************/
+	void PutBigEndian(std::vector<uint8_t>& bytes, uint32_t value)
+	{
+		bytes.push_back((uint8_t)(value >> 24));
+		bytes.push_back((uint8_t)(value >> 16));
+		bytes.push_back((uint8_t)(value >> 8));
+		bytes.push_back((uint8_t)value);
+	}
+
+	/***********************************************************
+	 *  PutLittleEndian()
+	 *
+	 *  This function is used for appending a number of the
+	 *  passed in byte count with its low byte first, as EXR
+	 *  stores them.
+	 ***********************************************************/
+	void PutLittleEndian(std::vector<uint8_t>& bytes, uint64_t value, int byteCount)
+	{
+		for (int i = 0; i < byteCount; i++)
+		{
+			bytes.push_back((uint8_t)(value >> (8 * i)));
+		}
+	}
+
+	/***********************************************************
+	 *  PutString()
+	 *
+	 *  This function is used for appending a string with its
+	 *  terminating zero.
+	 ***********************************************************/
+	void PutString(std::vector<uint8_t>& bytes, const char* text)
+	{
+		bytes.insert(bytes.end(), text, text + strlen(text) + 1);
+	}
+
+	// the checksums of every byte value, filled once on first use
+	struct CRC_TABLE
+	{
+		uint32_t entries[256];
+
+		CRC_TABLE()
+		{
+			for (uint32_t n = 0; n < 256; n++)
+			{
+				uint32_t c = n;
+				for (int k = 0; k < 8; k++)
+				{
+					c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+				}
+				entries[n] = c;
+			}
+		}
+	};
+
+	/***********************************************************
+	 *  Crc32()
+	 *
+	 *  This function is used for computing the checksum of a
+	 *  PNG chunk.
+	 ***********************************************************/
+	uint32_t Crc32(const uint8_t* pBytes, size_t count)
+	{
+		// a local static is built only once, even when the first
+		// images are written on several workers at the same time
+		static const CRC_TABLE table;
+
+		uint32_t crc = 0xFFFFFFFFu;
+		for (size_t i = 0; i < count; i++)
+		{
+			crc = table.entries[(crc ^ pBytes[i]) & 0xFF] ^ (crc >> 8);
+		}
+		return(crc ^ 0xFFFFFFFFu);
+	}
+
+	/***********************************************************
+	 *  PutPngChunk()
+	 *
+	 *  This function is used for appending a PNG chunk with
+	 *  its length, type and checksum.
+	 ***********************************************************/
+	void PutPngChunk(std::vector<uint8_t>& bytes, const char* type, const std::vector<uint8_t>& data)
+	{
+		PutBigEndian(bytes, (uint32_t)data.size());
+		size_t typeStart = bytes.size();
+		bytes.insert(bytes.end(), type, type + 4);
+		bytes.insert(bytes.end(), data.begin(), data.end());
+		PutBigEndian(bytes, Crc32(bytes.data() + typeStart, bytes.size() - typeStart));
+	}
+}
+
+/***********************************************************
+ *  IsExrFile()
+ *
+ *  This method is used for telling whether a file name asks
+ *  for an EXR image.
+ ***********************************************************/
+bool ImageWriter::IsExrFile(const char* filename)
+{
+	if (NULL == filename)
+	{
+		return(false);
+	}
+
+	size_t length = strlen(filename);
+	if (length < 4)
+	{
+		return(false);
+	}
+
+	const char* extension = filename + length - 4;
+	return((extension[0] == '.') &&
+		((extension[1] | 0x20) == 'e') &&
+		((extension[2] | 0x20) == 'x') &&
+		((extension[3] | 0x20) == 'r'));
+}
+
+/***********************************************************
+ *  WritePng()
+ *
+ *  This method is used for writing 8 bit RGB pixels into a
+ *  PNG file.  Every row is stored without a filter, and the
+ *  rows are wrapped into stored deflate blocks with the
+ *  zlib header and checksum around them.
+ ***********************************************************/
+bool ImageWriter::WritePng(const char* filename, int width, int height, const uint8_t* pPixels)
+{
+	if ((NULL == filename) || (NULL == pPixels) || (width <= 0) || (height <= 0))
+	{
+		return(false);
+	}
+
+	size_t rowBytes = (size_t)width * 3;
+	std::vector<uint8_t> rows;
+	rows.reserve((rowBytes + 1) * height);
+	for (int y = height - 1; y >= 0; y--)
+	{
+		rows.push_back(0);
+		rows.insert(rows.end(), pPixels + rowBytes * y, pPixels + rowBytes * (y + 1));
+	}
+
+	std::vector<uint8_t> compressed;
+	compressed.reserve(rows.size() + rows.size() / DEFLATE_BLOCK_BYTES * 5 + 16);
+	compressed.push_back(0x78);
+	compressed.push_back(0x01);
+	size_t offset = 0;
+	do
+	{
+		size_t blockBytes = rows.size() - offset;
+		if (blockBytes > (size_t)DEFLATE_BLOCK_BYTES)
+		{
+			blockBytes = DEFLATE_BLOCK_BYTES;
+		}
+		bool bFinal = (offset + blockBytes == rows.size());
+		compressed.push_back(bFinal ? 1 : 0);
+		PutLittleEndian(compressed, blockBytes, 2);
+		PutLittleEndian(compressed, ~blockBytes & 0xFFFF, 2);
+		compressed.insert(compressed.end(), rows.begin() + offset, rows.begin() + offset + blockBytes);
+		offset += blockBytes;
+	} while (offset < rows.size());
+
+	uint32_t adlerLow = 1;
+	uint32_t adlerHigh = 0;
+	for (size_t i = 0; i < rows.size(); i++)
+	{
+		adlerLow = (adlerLow + rows[i]) % 65521;
+		adlerHigh = (adlerHigh + adlerLow) % 65521;
+	}
+	PutBigEndian(compressed, (adlerHigh << 16) | adlerLow);
+
+	std::vector<uint8_t> header;
+	PutBigEndian(header, (uint32_t)width);
+	PutBigEndian(header, (uint32_t)height);
+	// 8 bits per channel, RGB, deflate, no filter method, no interlace
+	const uint8_t format[5] = { 8, 2, 0, 0, 0 };
+	header.insert(header.end(), format, format + 5);
+
+	const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	std::vector<uint8_t> bytes(signature, signature + 8);
+	PutPngChunk(bytes, "IHDR", header);
+	PutPngChunk(bytes, "IDAT", compressed);
+	PutPngChunk(bytes, "IEND", std::vector<uint8_t>());
+
+	std::ofstream file(filename, std::ios::binary);
+	if (!file)
+	{
+		LOG_ERROR("Could not write the image %s", filename);
+		return(false);
+	}
+	file.write((const char*)bytes.data(), bytes.size());
+
+	return(file.good());
+}
+
+/***********************************************************
+ *  WriteExr()
+ *
+ *  This method is used for writing half float RGB pixels
+ *  into an uncompressed scanline EXR file.  The channels of
+ *  a row are stored one after the other in the name order
+ *  of the channels, which is blue, green and red.
+ ***********************************************************/
+bool ImageWriter::WriteExr(const char* filename, int width, int height, const uint16_t* pPixels)
+{
+	if ((NULL == filename) || (NULL == pPixels) || (width <= 0) || (height <= 0))
+	{
+		return(false);
+	}
+
+	std::vector<uint8_t> bytes;
+	PutLittleEndian(bytes, EXR_MAGIC, 4);
+	PutLittleEndian(bytes, EXR_VERSION, 4);
+
+	// three half float channels, without subsampling
+	PutString(bytes, "channels");
+	PutString(bytes, "chlist");
+	PutLittleEndian(bytes, 3 * 18 + 1, 4);
+	const char* channelNames[3] = { "B", "G", "R" };
+	for (int channel = 0; channel < 3; channel++)
+	{
+		PutString(bytes, channelNames[channel]);
+		PutLittleEndian(bytes, 1, 4);
+		PutLittleEndian(bytes, 0, 4);
+		PutLittleEndian(bytes, 1, 4);
+		PutLittleEndian(bytes, 1, 4);
+	}
+	bytes.push_back(0);
+
+	PutString(bytes, "compression");
+	PutString(bytes, "compression");
+	PutLittleEndian(bytes, 1, 4);
+	bytes.push_back(0);
+
+	const char* windowNames[2] = { "dataWindow", "displayWindow" };
+	for (int window = 0; window < 2; window++)
+	{
+		PutString(bytes, windowNames[window]);
+		PutString(bytes, "box2i");
+		PutLittleEndian(bytes, 16, 4);
+		PutLittleEndian(bytes, 0, 4);
+		PutLittleEndian(bytes, 0, 4);
+		PutLittleEndian(bytes, (uint32_t)(width - 1), 4);
+		PutLittleEndian(bytes, (uint32_t)(height - 1), 4);
+	}
+
+	PutString(bytes, "lineOrder");
+	PutString(bytes, "lineOrder");
+	PutLittleEndian(bytes, 1, 4);
+	bytes.push_back(0);
+
+	// 1.0f, and the center and width of the screen window
+	const uint32_t floatOne = 0x3F800000;
+	PutString(bytes, "pixelAspectRatio");
+	PutString(bytes, "float");
+	PutLittleEndian(bytes, 4, 4);
+	PutLittleEndian(bytes, floatOne, 4);
+
+	PutString(bytes, "screenWindowCenter");
+	PutString(bytes, "v2f");
+	PutLittleEndian(bytes, 8, 4);
+	PutLittleEndian(bytes, 0, 8);
+
+	PutString(bytes, "screenWindowWidth");
+	PutString(bytes, "float");
+	PutLittleEndian(bytes, 4, 4);
+	PutLittleEndian(bytes, floatOne, 4);
+	bytes.push_back(0);
+
+	// the offsets of the rows follow the header, and every row is
+	// its number, its size and its channels
+	size_t rowBytes = (size_t)width * 3 * sizeof(uint16_t);
+	uint64_t rowOffset = bytes.size() + (size_t)height * sizeof(uint64_t);
+	for (int y = 0; y < height; y++)
+	{
+		PutLittleEndian(bytes, rowOffset + (uint64_t)y * (8 + rowBytes), 8);
+	}
+
+	bytes.reserve(bytes.size() + (8 + rowBytes) * height);
+	for (int y = 0; y < height; y++)
+	{
+		const uint16_t* pRow = pPixels + (size_t)width * 3 * (height - 1 - y);
+		PutLittleEndian(bytes, (uint32_t)y, 4);
+		PutLittleEndian(bytes, (uint32_t)rowBytes, 4);
+		for (int channel = 2; channel >= 0; channel--)
+		{
+			for (int x = 0; x < width; x++)
+			{
+				PutLittleEndian(bytes, pRow[x * 3 + channel], 2);
+			}
+		}
+	}
+
+	std::ofstream file(filename, std::ios::binary);
+	if (!file)
+	{
+		LOG_ERROR("Could not write the image %s", filename);
+		return(false);
+	}
+	file.write((const char*)bytes.data(), bytes.size());
+
+	return(file.good());
+}
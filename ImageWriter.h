@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////////
+// imagewriter.h
+// =============
+// write the pixels read back from a render target into PNG and EXR files
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+/***********************************************************
+ *  ImageWriter
+ *
+ *  This class writes RGB images in the row order OpenGL
+ *  reads them back, bottom row first, flipping them into
+ *  the top row first order of the files.  PNG files hold
+ *  8 bit channels in stored deflate blocks, so no
+ *  compression library is needed, and EXR files hold
+ *  uncompressed half float channels for values past one.
+ *  The writers touch no OpenGL state, so they can run on
+ *  the worker threads.
+ ***********************************************************/
+class ImageWriter
+{
+public:
+	// 8 bits for each of red, green and blue
+	static bool WritePng(const char* filename, int width, int height, const uint8_t* pPixels);
+	// a half float for each of red, green and blue
+	static bool WriteExr(const char* filename, int width, int height, const uint16_t* pPixels);
+
+	// true when the file name ends with .exr
+	static bool IsExrFile(const char* filename);
+};
@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////
+// inputqueue.cpp
+// ==============
+// pass timestamped input events from the GLFW callbacks to the simulation
+// step through a lock-free ring
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "InputQueue.h"
+
+/***********************************************************
+ *  InputQueue()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+InputQueue::InputQueue(int capacity)
+{
+	unsigned int size = 1;
+	while ((int)size < capacity)
+	{
+		size <<= 1;
+	}
+
+	m_events.resize(size);
+	m_mask = size - 1;
+	m_readIndex.store(0, std::memory_order_relaxed);
+	m_writeIndex.store(0, std::memory_order_relaxed);
+	m_droppedCount.store(0, std::memory_order_relaxed);
+}
+
+/***********************************************************
+ *  Push()
+ *
+ *  This method is used for adding an event at the back of
+ *  the ring.  The event is written before the new write
+ *  position is released, so the consumer never sees a
+ *  slot that is still being filled.
+ ***********************************************************/
+bool InputQueue::Push(const INPUT_EVENT& event)
+{
+	unsigned int writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+	unsigned int readIndex = m_readIndex.load(std::memory_order_acquire);
+
+	// the positions only grow and wrap together, so their difference
+	// is the number of events in the ring
+	if (writeIndex - readIndex > m_mask)
+	{
+		m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+		return(false);
+	}
+
+	m_events[writeIndex & m_mask] = event;
+	m_writeIndex.store(writeIndex + 1, std::memory_order_release);
+	return(true);
+}
+
+/***********************************************************
+ *  Pop()
+ *
+ *  This method is used for taking the event at the front
+ *  of the ring.  The slot is copied out before the new read
+ *  position is released to the producer.
+ ***********************************************************/
+bool InputQueue::Pop(INPUT_EVENT& event)
+{
+	unsigned int readIndex = m_readIndex.load(std::memory_order_relaxed);
+	unsigned int writeIndex = m_writeIndex.load(std::memory_order_acquire);
+
+	if (readIndex == writeIndex)
+	{
+		return(false);
+	}
+
+	event = m_events[readIndex & m_mask];
+	m_readIndex.store(readIndex + 1, std::memory_order_release);
+	return(true);
+}
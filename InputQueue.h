@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////
+// inputqueue.h
+// ============
+// pass timestamped input events from the GLFW callbacks to the simulation
+// step through a lock-free ring
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+// the kinds of input events
+enum INPUT_EVENT_TYPE
+{
+	INPUT_KEY,
+	INPUT_MOUSE_MOVE,
+	INPUT_MOUSE_BUTTON,
+	INPUT_SCROLL
+};
+
+// one input event, in the order GLFW reported it
+struct INPUT_EVENT
+{
+	INPUT_EVENT_TYPE type;
+	// the GLFW time the callback was called at
+	double time;
+	// the key or mouse button, and GLFW_PRESS or GLFW_RELEASE
+	int code;
+	int action;
+	// the cursor position, the picked framebuffer pixel of a button,
+	// or the scroll offsets
+	double x;
+	double y;
+};
+
+/***********************************************************
+ *  InputQueue
+ *
+ *  This class is a fixed size ring of input events with a
+ *  single producer, the thread running the GLFW callbacks,
+ *  and a single consumer, the simulation step.  The two
+ *  sides only share the read and write positions, which
+ *  are atomic and kept on separate cache lines, so neither
+ *  side ever takes a lock or waits for the other.  When the
+ *  consumer falls so far behind that the ring is full, new
+ *  events are dropped and counted.
+ ***********************************************************/
+class InputQueue
+{
+public:
+	// the capacity is rounded up to a power of two
+	InputQueue(int capacity = 1024);
+
+	// called by the producer only - false is returned when the
+	// ring is full and the event was dropped
+	bool Push(const INPUT_EVENT& event);
+	// called by the consumer only - false is returned when the
+	// ring is empty
+	bool Pop(INPUT_EVENT& event);
+
+	unsigned int GetDroppedCount() const { return(m_droppedCount.load(std::memory_order_relaxed)); }
+
+private:
+	std::vector<INPUT_EVENT> m_events;
+	unsigned int m_mask;
+
+	// the next event to pop, written by the consumer
+	alignas(64) std::atomic<unsigned int> m_readIndex;
+	// the next slot to push into, written by the producer
+	alignas(64) std::atomic<unsigned int> m_writeIndex;
+	std::atomic<unsigned int> m_droppedCount;
+};
@@ -0,0 +1,200 @@
+///////////////////////////////////////////////////////////////////////////////
+// latencyhistogram.cpp
+// ====================
+// count durations in log-linear buckets for percentiles and exported buckets
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "LatencyHistogram.h"
+
+// declaration of global variables
+namespace
+{
+	// the values below this are counted exactly, and every power of
+	// two above it is split into half as many buckets
+	const int LINEAR_BUCKETS = 128;
+	const int HALF_BUCKETS = LINEAR_BUCKETS / 2;
+	// the largest value kept apart, a little over an hour
+	const uint64_t MAX_VALUE = 0xFFFFFFFFull;
+	const int BUCKET_COUNT = 1728;
+}
+
+/***********************************************************
+ *  LatencyHistogram()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+LatencyHistogram::LatencyHistogram()
+{
+	m_counts.resize(BUCKET_COUNT, 0);
+	m_count = 0;
+	m_sum = 0;
+}
+
+/***********************************************************
+ *  GetBucket()
+ *
+ *  This method is used for finding the bucket of a value.
+ *  Above the linear buckets the value is shifted down until
+ *  it lands in the upper half of them, and every shift
+ *  moves on by half the linear buckets.
+ ***********************************************************/
+int LatencyHistogram::GetBucket(uint64_t microseconds)
+{
+	if (microseconds > MAX_VALUE)
+	{
+		microseconds = MAX_VALUE;
+	}
+
+	int shift = 0;
+	while ((microseconds >> shift) >= (uint64_t)LINEAR_BUCKETS)
+	{
+		shift++;
+	}
+
+	return((HALF_BUCKETS * shift) + (int)(microseconds >> shift));
+}
+
+/***********************************************************
+ *  GetBucketTop()
+ *
+ *  This method is used for getting the largest value that
+ *  is counted in a bucket.
+ ***********************************************************/
+uint64_t LatencyHistogram::GetBucketTop(int bucket)
+{
+	if (bucket < LINEAR_BUCKETS)
+	{
+		return((uint64_t)bucket);
+	}
+
+	int shift = (bucket / HALF_BUCKETS) - 1;
+	uint64_t subBucket = (uint64_t)(bucket - (HALF_BUCKETS * shift));
+
+	return(((subBucket + 1) << shift) - 1);
+}
+
+/***********************************************************
+ *  GetBucketTopAt()
+ *
+ *  This method is used for getting the largest value that
+ *  is counted in the bucket of the passed in value.
+ ***********************************************************/
+uint64_t LatencyHistogram::GetBucketTopAt(uint64_t microseconds)
+{
+	return(GetBucketTop(GetBucket(microseconds)));
+}
+
+/***********************************************************
+ *  Record()
+ *
+ *  This method is used for counting a duration.
+ ***********************************************************/
+void LatencyHistogram::Record(uint64_t microseconds)
+{
+	m_counts[GetBucket(microseconds)]++;
+	m_count++;
+	m_sum += microseconds;
+}
+
+/***********************************************************
+ *  Add()
+ *
+ *  This method is used for adding the counts of another
+ *  histogram into this one.
+ ***********************************************************/
+void LatencyHistogram::Add(const LatencyHistogram& other)
+{
+	if (other.m_count == 0)
+	{
+		return;
+	}
+
+	for (int i = 0; i < BUCKET_COUNT; i++)
+	{
+		m_counts[i] += other.m_counts[i];
+	}
+	m_count += other.m_count;
+	m_sum += other.m_sum;
+}
+
+/***********************************************************
+ *  Reset()
+ *
+ *  This method is used for clearing the counts.
+ ***********************************************************/
+void LatencyHistogram::Reset()
+{
+	if (m_count == 0)
+	{
+		return;
+	}
+
+	for (int i = 0; i < BUCKET_COUNT; i++)
+	{
+		m_counts[i] = 0;
+	}
+	m_count = 0;
+	m_sum = 0;
+}
+
+/***********************************************************
+ *  GetPercentile()
+ *
+ *  This method is used for finding the bucket that holds
+ *  the value at the passed in percentage of the counts.
+ ***********************************************************/
+uint64_t LatencyHistogram::GetPercentile(double percent) const
+{
+	if (m_count == 0)
+	{
+		return(0);
+	}
+
+	// the rank of the value, counting from one
+	uint64_t rank = (uint64_t)((percent / 100.0) * (double)m_count + 0.5);
+	if (rank < 1)
+	{
+		rank = 1;
+	}
+	if (rank > m_count)
+	{
+		rank = m_count;
+	}
+
+	uint64_t counted = 0;
+	for (int i = 0; i < BUCKET_COUNT; i++)
+	{
+		counted += m_counts[i];
+		if (counted >= rank)
+		{
+			return(GetBucketTop(i));
+		}
+	}
+
+	return(GetBucketTop(BUCKET_COUNT - 1));
+}
+
+/***********************************************************
+ *  GetCountAtOrBelow()
+ *
+ *  This method is used for counting the values of the
+ *  buckets that end at or below the passed in value, which
+ *  are the values of a cumulative exported bucket.
+ ***********************************************************/
+uint64_t LatencyHistogram::GetCountAtOrBelow(uint64_t microseconds) const
+{
+	uint64_t counted = 0;
+	for (int i = 0; i < BUCKET_COUNT; i++)
+	{
+		if (GetBucketTop(i) > microseconds)
+		{
+			break;
+		}
+		counted += m_counts[i];
+	}
+
+	return(counted);
+}
@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////
+// latencyhistogram.h
+// ==================
+// count durations in log-linear buckets for percentiles and exported buckets
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/***********************************************************
+ *  LatencyHistogram
+ *
+ *  This class counts durations in microseconds the way an
+ *  HDR histogram does - every power of two is split into
+ *  64 linear buckets, so any value from one microsecond up
+ *  to an hour is kept within about 1.6 percent, at a fixed
+ *  size and with a constant cost for every value.
+ *  Histograms recorded on different threads can be added
+ *  together without losing anything.
+ ***********************************************************/
+class LatencyHistogram
+{
+public:
+	LatencyHistogram();
+
+	// values past the largest bucket are counted in it
+	void Record(uint64_t microseconds);
+	void Add(const LatencyHistogram& other);
+	void Reset();
+
+	uint64_t GetCount() const { return(m_count); }
+	uint64_t GetSum() const { return(m_sum); }
+	// the value that the percentage of the values, from 0 to 100,
+	// are at or below - the top of its bucket is returned
+	uint64_t GetPercentile(double percent) const;
+	// the values whose bucket ends at or below the passed in value
+	uint64_t GetCountAtOrBelow(uint64_t microseconds) const;
+	// the top of the bucket the passed in value is counted in, which
+	// is a bound that GetCountAtOrBelow counts exactly
+	static uint64_t GetBucketTopAt(uint64_t microseconds);
+
+private:
+	static int GetBucket(uint64_t microseconds);
+	static uint64_t GetBucketTop(int bucket);
+
+	std::vector<uint64_t> m_counts;
+	uint64_t m_count;
+	uint64_t m_sum;
+};
@@ -0,0 +1,773 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightmanager.cpp
+// ================
+// manage the light sources of the 3D scene - typed lights, per-frame
+// animation hooks and dirty-tracked uploads into the shader light uniforms
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "LightManager.h"
+#include "Logger.h"
+#include "RenderOrigin.h"
+
+#include <cfloat>
+#include <cmath>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/transform.hpp>
+
+// declaration of global variables
+namespace
+{
+	const char* g_UseLightingName = "bUseLighting";
+	const char* g_DirectionalLightName = "directionalLight";
+	const char* g_PointLightsName = "pointLights";
+	const char* g_SpotLightsName = "spotLights";
+
+	// the light contribution below which a light ends, which sets its range
+	const float g_LightCutoffIntensity = 1.0f / 256.0f;
+
+	// the value returned for an invalid light handle
+	const LightManager::SCENE_LIGHT g_InvalidLight = {};
+}
+
+/***********************************************************
+ *  LightManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+LightManager::LightManager(ShaderManager* pShaderManager)
+{
+	m_pShaderManager = pShaderManager;
+	m_directionalCount = 0;
+	m_pointCount = 0;
+	m_spotCount = 0;
+	m_pointLimit = MAX_POINT_LIGHTS;
+	m_spotLimit = MAX_SPOT_LIGHTS;
+	m_bLightingEnabled = false;
+	m_pCookieAtlas = new CookieAtlas();
+	m_renderOrigin = glm::dvec3(0.0);
+}
+
+/***********************************************************
+ *  ~LightManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+LightManager::~LightManager()
+{
+	m_pShaderManager = NULL;
+	m_lights.clear();
+	m_animatedLights.clear();
+	m_dirtyLights.clear();
+	if (NULL != m_pCookieAtlas)
+	{
+		delete m_pCookieAtlas;
+		m_pCookieAtlas = NULL;
+	}
+}
+
+/***********************************************************
+ *  AddLight()
+ *
+ *  This method is used for registering a light source and
+ *  pre-building the uniform names of its shader slot.
+ ***********************************************************/
+int LightManager::AddLight(const SCENE_LIGHT& light, const std::string& uniformPrefix, int slot)
+{
+	LIGHT_ENTRY entry;
+
+	entry.light = light;
+	entry.baseLight = light;
+	entry.uniforms.position = uniformPrefix + ".position";
+	entry.uniforms.direction = uniformPrefix + ".direction";
+	entry.uniforms.ambient = uniformPrefix + ".ambient";
+	entry.uniforms.diffuse = uniformPrefix + ".diffuse";
+	entry.uniforms.specular = uniformPrefix + ".specular";
+	entry.uniforms.constant = uniformPrefix + ".constant";
+	entry.uniforms.linear = uniformPrefix + ".linear";
+	entry.uniforms.quadratic = uniformPrefix + ".quadratic";
+	entry.uniforms.cutOff = uniformPrefix + ".cutOff";
+	entry.uniforms.outerCutOff = uniformPrefix + ".outerCutOff";
+	entry.uniforms.range = uniformPrefix + ".range";
+	entry.uniforms.lightSpace = uniformPrefix + ".lightSpace";
+	entry.uniforms.cookieRect = uniformPrefix + ".cookieRect";
+	entry.uniforms.bUseCookie = uniformPrefix + ".bUseCookie";
+	entry.uniforms.bActive = uniformPrefix + ".bActive";
+	entry.dirtyFlags = DIRTY_NONE;
+	entry.slot = slot;
+
+	int handle = (int)m_lights.size();
+	m_lights.push_back(entry);
+
+	// new lights always need a complete upload
+	MarkDirty(handle, DIRTY_ALL);
+
+	return(handle);
+}
+
+/***********************************************************
+ *  AddDirectionalLight()
+ *
+ *  This method is used for adding the directional light.
+ *  The shader only has one directional light slot.
+ ***********************************************************/
+int LightManager::AddDirectionalLight(
+	glm::vec3 direction,
+	glm::vec3 ambient,
+	glm::vec3 diffuse,
+	glm::vec3 specular)
+{
+	if (m_directionalCount >= 1)
+	{
+		LOG_WARNING("Only one directional light is supported");
+		return(-1);
+	}
+
+	SCENE_LIGHT light = {};
+	light.type = LIGHT_DIRECTIONAL;
+	light.direction = direction;
+	light.ambient = ambient;
+	light.diffuse = diffuse;
+	light.specular = specular;
+	light.bActive = true;
+
+	m_directionalCount++;
+
+	return(AddLight(light, g_DirectionalLightName, 0));
+}
+
+/***********************************************************
+ *  AddPointLight()
+ *
+ *  This method is used for adding a point light into the
+ *  next free point light slot of the shader.
+ ***********************************************************/
+int LightManager::AddPointLight(
+	glm::dvec3 position,
+	glm::vec3 ambient,
+	glm::vec3 diffuse,
+	glm::vec3 specular,
+	float constant,
+	float linear,
+	float quadratic)
+{
+	if (m_pointCount >= m_pointLimit)
+	{
+		if (m_pointLimit < MAX_POINT_LIGHTS)
+		{
+			LOG_INFO("Point light left out, %d are kept by the quality settings", m_pointLimit);
+		}
+		else
+		{
+			LOG_WARNING("No free point light slot, up to %d are supported", MAX_POINT_LIGHTS);
+		}
+		return(-1);
+	}
+
+	SCENE_LIGHT light = {};
+	light.type = LIGHT_POINT;
+	light.position = position;
+	light.ambient = ambient;
+	light.diffuse = diffuse;
+	light.specular = specular;
+	light.constant = constant;
+	light.linear = linear;
+	light.quadratic = quadratic;
+	light.bActive = true;
+
+	int slot = m_pointCount;
+	std::string prefix = std::string(g_PointLightsName) + "[" + std::to_string(slot) + "]";
+	m_pointCount++;
+
+	return(AddLight(light, prefix, slot));
+}
+
+/***********************************************************
+ *  AddSpotLight()
+ *
+ *  This method is used for adding a spot light into the
+ *  next free spot light slot of the shader.  The cone angles
+ *  are half angles passed in degrees and stored as cosines.
+ ***********************************************************/
+int LightManager::AddSpotLight(
+	glm::dvec3 position,
+	glm::vec3 direction,
+	float innerConeDegrees,
+	float outerConeDegrees,
+	glm::vec3 ambient,
+	glm::vec3 diffuse,
+	glm::vec3 specular,
+	float constant,
+	float linear,
+	float quadratic)
+{
+	if (m_spotCount >= m_spotLimit)
+	{
+		if (m_spotLimit < MAX_SPOT_LIGHTS)
+		{
+			LOG_INFO("Spot light left out, %d are kept by the quality settings", m_spotLimit);
+		}
+		else
+		{
+			LOG_WARNING("No free spot light slot, up to %d are supported", MAX_SPOT_LIGHTS);
+		}
+		return(-1);
+	}
+
+	SCENE_LIGHT light = {};
+	light.type = LIGHT_SPOT;
+	light.position = position;
+	light.direction = direction;
+	light.ambient = ambient;
+	light.diffuse = diffuse;
+	light.specular = specular;
+	light.constant = constant;
+	light.linear = linear;
+	light.quadratic = quadratic;
+	light.cutOff = cos(glm::radians(innerConeDegrees));
+	light.outerCutOff = cos(glm::radians(outerConeDegrees));
+	light.range = ComputeLightRange(light);
+	light.bUseCookie = false;
+	light.bActive = true;
+
+	int slot = m_spotCount;
+	std::string prefix = std::string(g_SpotLightsName) + "[" + std::to_string(slot) + "]";
+	m_spotCount++;
+
+	return(AddLight(light, prefix, slot));
+}
+
+/***********************************************************
+ *  GetLight()
+ *
+ *  This method is used for reading the current properties
+ *  of the light associated with the passed in handle.
+ ***********************************************************/
+const LightManager::SCENE_LIGHT& LightManager::GetLight(int handle) const
+{
+	if ((handle < 0) || (handle >= (int)m_lights.size()))
+	{
+		return(g_InvalidLight);
+	}
+
+	return(m_lights[handle].light);
+}
+
+/***********************************************************
+ *  SetLightPosition()
+ *
+ *  This method is used for moving a point or spot light.
+ ***********************************************************/
+void LightManager::SetLightPosition(int handle, glm::dvec3 position)
+{
+	if ((handle < 0) || (handle >= (int)m_lights.size()))
+	{
+		return;
+	}
+
+	m_lights[handle].light.position = position;
+	m_lights[handle].baseLight.position = position;
+	MarkDirty(handle, DIRTY_POSITION);
+}
+
+/***********************************************************
+ *  SetLightDirection()
+ *
+ *  This method is used for aiming a directional or spot light.
+ ***********************************************************/
+void LightManager::SetLightDirection(int handle, glm::vec3 direction)
+{
+	if ((handle < 0) || (handle >= (int)m_lights.size()))
+	{
+		return;
+	}
+
+	m_lights[handle].light.direction = direction;
+	m_lights[handle].baseLight.direction = direction;
+	MarkDirty(handle, DIRTY_DIRECTION);
+}
+
+/***********************************************************
+ *  SetLightColor()
+ *
+ *  This method is used for changing the light colors.
+ ***********************************************************/
+void LightManager::SetLightColor(int handle, glm::vec3 ambient, glm::vec3 diffuse, glm::vec3 specular)
+{
+	if ((handle < 0) || (handle >= (int)m_lights.size()))
+	{
+		return;
+	}
+
+	SCENE_LIGHT& light = m_lights[handle].light;
+	light.ambient = ambient;
+	light.diffuse = diffuse;
+	light.specular = specular;
+	m_lights[handle].baseLight.ambient = ambient;
+	m_lights[handle].baseLight.diffuse = diffuse;
+	m_lights[handle].baseLight.specular = specular;
+	MarkDirty(handle, DIRTY_COLOR);
+}
+
+/***********************************************************
+ *  SetLightActive()
+ *
+ *  This method is used for switching a light on or off.
+ ***********************************************************/
+void LightManager::SetLightActive(int handle, bool bActive)
+{
+	if ((handle < 0) || (handle >= (int)m_lights.size()))
+	{
+		return;
+	}
+
+	m_lights[handle].light.bActive = bActive;
+	m_lights[handle].baseLight.bActive = bActive;
+	MarkDirty(handle, DIRTY_ACTIVE);
+}
+
+/***********************************************************
+ *  SetSpotLightCone()
+ *
+ *  This method is used for changing the inner and outer
+ *  cone half angles of a spot light, in degrees.
+ ***********************************************************/
+void LightManager::SetSpotLightCone(int handle, float innerConeDegrees, float outerConeDegrees)
+{
+	if ((handle < 0) || (handle >= (int)m_lights.size()) ||
+		(m_lights[handle].light.type != LIGHT_SPOT))
+	{
+		return;
+	}
+
+	m_lights[handle].light.cutOff = cos(glm::radians(innerConeDegrees));
+	m_lights[handle].light.outerCutOff = cos(glm::radians(outerConeDegrees));
+	m_lights[handle].baseLight.cutOff = m_lights[handle].light.cutOff;
+	m_lights[handle].baseLight.outerCutOff = m_lights[handle].light.outerCutOff;
+	MarkDirty(handle, DIRTY_CONE);
+}
+
+/***********************************************************
+ *  SetSpotLightCookie()
+ *
+ *  This method is used for projecting a cookie image
+ *  through a spot light.  Lights that use the same image
+ *  file share one area of the cookie atlas.
+ ***********************************************************/
+bool LightManager::SetSpotLightCookie(int handle, const char* filename)
+{
+	if ((handle < 0) || (handle >= (int)m_lights.size()) ||
+		(m_lights[handle].light.type != LIGHT_SPOT))
+	{
+		return(false);
+	}
+
+	glm::vec4 uvRect;
+	if (m_pCookieAtlas->LoadCookie(filename, uvRect) == false)
+	{
+		return(false);
+	}
+
+	m_lights[handle].light.cookieRect = uvRect;
+	m_lights[handle].light.bUseCookie = true;
+	m_lights[handle].baseLight.cookieRect = uvRect;
+	m_lights[handle].baseLight.bUseCookie = true;
+	MarkDirty(handle, DIRTY_COOKIE);
+
+	return(true);
+}
+
+/***********************************************************
+ *  ClearSpotLightCookie()
+ *
+ *  This method is used for removing the projected cookie
+ *  from a spot light.
+ ***********************************************************/
+void LightManager::ClearSpotLightCookie(int handle)
+{
+	if ((handle < 0) || (handle >= (int)m_lights.size()) ||
+		(m_lights[handle].light.type != LIGHT_SPOT))
+	{
+		return;
+	}
+
+	m_lights[handle].light.bUseCookie = false;
+	m_lights[handle].baseLight.bUseCookie = false;
+	MarkDirty(handle, DIRTY_COOKIE);
+}
+
+/***********************************************************
+ *  BindCookieAtlas()
+ *
+ *  This method is used for binding the shared cookie atlas
+ *  to the passed in texture slot, when any cookie is used.
+ ***********************************************************/
+void LightManager::BindCookieAtlas(int textureSlot)
+{
+	if ((NULL == m_pCookieAtlas) || (m_pCookieAtlas->GetTextureID() == 0))
+	{
+		return;
+	}
+
+	m_pCookieAtlas->BindAtlasTexture(textureSlot);
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setSampler2DValue("spotLightCookies", textureSlot);
+	}
+}
+
+/***********************************************************
+ *  SetLightAnimator()
+ *
+ *  This method is used for attaching a per-frame animation
+ *  hook to a light.  Only lights with a hook are visited
+ *  by Update().
+ ***********************************************************/
+void LightManager::SetLightAnimator(int handle, LIGHT_ANIMATOR animator)
+{
+	if ((handle < 0) || (handle >= (int)m_lights.size()))
+	{
+		return;
+	}
+
+	if (!m_lights[handle].animator)
+	{
+		m_animatedLights.push_back(handle);
+	}
+	m_lights[handle].animator = animator;
+}
+
+/***********************************************************
+ *  ClearLightAnimator()
+ *
+ *  This method is used for removing the animation hook of
+ *  a light and restoring its un-animated properties.
+ ***********************************************************/
+void LightManager::ClearLightAnimator(int handle)
+{
+	if ((handle < 0) || (handle >= (int)m_lights.size()))
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < m_animatedLights.size(); i++)
+	{
+		if (m_animatedLights[i] == handle)
+		{
+			m_animatedLights.erase(m_animatedLights.begin() + i);
+			break;
+		}
+	}
+	m_lights[handle].animator = nullptr;
+	m_lights[handle].light = m_lights[handle].baseLight;
+	MarkDirty(handle, DIRTY_ALL);
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for running the animation hooks.
+ *  Static lights are never visited, so a scene without
+ *  animated lights costs nothing here.
+ ***********************************************************/
+void LightManager::Update(float time)
+{
+	for (size_t i = 0; i < m_animatedLights.size(); i++)
+	{
+		int handle = m_animatedLights[i];
+		LIGHT_ENTRY& entry = m_lights[handle];
+
+		// animators always start from the un-animated light so
+		// that the effects do not drift over time
+		SCENE_LIGHT animated = entry.baseLight;
+		int changed = entry.animator(animated, time);
+		if (changed != DIRTY_NONE)
+		{
+			entry.light = animated;
+			MarkDirty(handle, changed);
+		}
+	}
+}
+
+/***********************************************************
+ *  MarkDirty()
+ *
+ *  This method is used for queueing the changed fields of
+ *  a light for the next upload.
+ ***********************************************************/
+void LightManager::MarkDirty(int handle, int flags)
+{
+	LIGHT_ENTRY& entry = m_lights[handle];
+
+	if (entry.dirtyFlags == DIRTY_NONE)
+	{
+		m_dirtyLights.push_back(handle);
+	}
+	entry.dirtyFlags |= flags;
+}
+
+/***********************************************************
+ *  InvalidateAll()
+ *
+ *  This method is used for forcing a complete upload, for
+ *  example after the shader program has been reloaded.
+ ***********************************************************/
+void LightManager::InvalidateAll()
+{
+	m_bLightingEnabled = false;
+	for (int i = 0; i < (int)m_lights.size(); i++)
+	{
+		MarkDirty(i, DIRTY_ALL);
+	}
+}
+
+/***********************************************************
+ *  SetLightLimits()
+ *
+ *  This method is used for limiting the point and spot
+ *  lights that are kept, which must happen before they are
+ *  added.  The limits never go past the shader slots.
+ ***********************************************************/
+void LightManager::SetLightLimits(int pointLights, int spotLights)
+{
+	m_pointLimit = glm::clamp(pointLights, 0, MAX_POINT_LIGHTS);
+	m_spotLimit = glm::clamp(spotLights, 0, MAX_SPOT_LIGHTS);
+}
+
+/***********************************************************
+ *  SetRenderOrigin()
+ *
+ *  This method is used for marking the light positions for
+ *  upload again when the render origin has moved, since they
+ *  are uploaded relative to it.
+ ***********************************************************/
+void LightManager::SetRenderOrigin(glm::dvec3 origin)
+{
+	if ((origin.x == m_renderOrigin.x) &&
+		(origin.y == m_renderOrigin.y) &&
+		(origin.z == m_renderOrigin.z))
+	{
+		return;
+	}
+
+	m_renderOrigin = origin;
+	for (int i = 0; i < (int)m_lights.size(); i++)
+	{
+		MarkDirty(i, DIRTY_POSITION);
+	}
+}
+
+/***********************************************************
+ *  UploadChangedLights()
+ *
+ *  This method is used for writing the changed light slots
+ *  into the shader.  Only the uniforms of the dirty fields
+ *  are set.
+ ***********************************************************/
+int LightManager::UploadChangedLights()
+{
+	if ((NULL == m_pShaderManager) || (m_dirtyLights.size() == 0))
+	{
+		return(0);
+	}
+
+	// lighting is enabled by the first upload, and again after the
+	// shader has been reloaded, rather than with every change
+	if (m_bLightingEnabled == false)
+	{
+		m_pShaderManager->setBoolValue(g_UseLightingName, true);
+		m_bLightingEnabled = true;
+	}
+
+	int uploaded = 0;
+	for (size_t i = 0; i < m_dirtyLights.size(); i++)
+	{
+		UploadLight(m_lights[m_dirtyLights[i]]);
+		uploaded++;
+	}
+	m_dirtyLights.clear();
+
+	return(uploaded);
+}
+
+/***********************************************************
+ *  UploadLight()
+ *
+ *  This method is used for setting the dirty uniforms of a
+ *  single light slot into the shader.
+ ***********************************************************/
+void LightManager::UploadLight(LIGHT_ENTRY& entry)
+{
+	const SCENE_LIGHT& light = entry.light;
+	const LIGHT_UNIFORMS& uniforms = entry.uniforms;
+	int flags = entry.dirtyFlags;
+
+	if ((flags & DIRTY_POSITION) && (light.type != LIGHT_DIRECTIONAL))
+	{
+		m_pShaderManager->setVec3Value(uniforms.position, RenderOrigin::ToRender(light.position));
+	}
+	if ((flags & DIRTY_DIRECTION) && (light.type != LIGHT_POINT))
+	{
+		m_pShaderManager->setVec3Value(uniforms.direction, light.direction);
+	}
+	if (flags & DIRTY_COLOR)
+	{
+		m_pShaderManager->setVec3Value(uniforms.ambient, light.ambient);
+		m_pShaderManager->setVec3Value(uniforms.diffuse, light.diffuse);
+		m_pShaderManager->setVec3Value(uniforms.specular, light.specular);
+	}
+	if ((flags & DIRTY_ATTENUATION) && (light.type != LIGHT_DIRECTIONAL))
+	{
+		m_pShaderManager->setFloatValue(uniforms.constant, light.constant);
+		m_pShaderManager->setFloatValue(uniforms.linear, light.linear);
+		m_pShaderManager->setFloatValue(uniforms.quadratic, light.quadratic);
+	}
+	if (light.type == LIGHT_SPOT)
+	{
+		if (flags & (DIRTY_COLOR | DIRTY_ATTENUATION))
+		{
+			entry.light.range = ComputeLightRange(light);
+			m_pShaderManager->setFloatValue(uniforms.range, light.range);
+		}
+		if (flags & DIRTY_CONE)
+		{
+			m_pShaderManager->setFloatValue(uniforms.cutOff, light.cutOff);
+			m_pShaderManager->setFloatValue(uniforms.outerCutOff, light.outerCutOff);
+		}
+		if (flags & (DIRTY_POSITION | DIRTY_DIRECTION | DIRTY_CONE | DIRTY_COLOR | DIRTY_ATTENUATION))
+		{
+			// the matrix projecting world positions into cookie space
+			glm::vec3 axis = glm::normalize(light.direction);
+			glm::vec3 renderPosition = RenderOrigin::ToRender(light.position);
+			glm::vec3 up = (fabs(axis.y) > 0.99f) ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+			float farPlane = glm::min(light.range, 1000.0f);
+			glm::mat4 lightSpace =
+				glm::perspective(2.0f * (float)acos(light.outerCutOff), 1.0f, 0.1f, glm::max(farPlane, 0.2f)) *
+				glm::lookAt(renderPosition, renderPosition + axis, up);
+			m_pShaderManager->setMat4Value(uniforms.lightSpace, lightSpace);
+		}
+		if (flags & DIRTY_COOKIE)
+		{
+			m_pShaderManager->setVec4Value(uniforms.cookieRect, light.cookieRect);
+			m_pShaderManager->setBoolValue(uniforms.bUseCookie, light.bUseCookie);
+		}
+	}
+	if (flags & DIRTY_ACTIVE)
+	{
+		m_pShaderManager->setBoolValue(uniforms.bActive, light.bActive);
+	}
+
+	entry.dirtyFlags = DIRTY_NONE;
+}
+
+/***********************************************************
+ *  ComputeLightRange()
+ *
+ *  This method is used for calculating the distance at which
+ *  the attenuated light falls below the visible threshold.
+ ***********************************************************/
+float LightManager::ComputeLightRange(const SCENE_LIGHT& light)
+{
+	float intensity = glm::max(light.diffuse.r, glm::max(light.diffuse.g, light.diffuse.b));
+	intensity = glm::max(intensity, glm::max(light.specular.r, glm::max(light.specular.g, light.specular.b)));
+
+	// solve constant + linear * d + quadratic * d^2 = intensity / cutoff
+	float target = intensity / g_LightCutoffIntensity;
+	if (target <= light.constant)
+	{
+		return(0.0f);
+	}
+	if (light.quadratic > 0.0f)
+	{
+		float discriminant = (light.linear * light.linear) - (4.0f * light.quadratic * (light.constant - target));
+		return((-light.linear + sqrt(discriminant)) / (2.0f * light.quadratic));
+	}
+	if (light.linear > 0.0f)
+	{
+		return((target - light.constant) / light.linear);
+	}
+
+	// the light is never attenuated
+	return(FLT_MAX);
+}
+
+/***********************************************************
+ *  MakeFlickerAnimator()
+ *
+ *  This method is used for creating an animation hook that
+ *  flickers the light intensity like a candle or an old
+ *  bulb.  The amount is the fraction of the light to vary.
+ ***********************************************************/
+LightManager::LIGHT_ANIMATOR LightManager::MakeFlickerAnimator(float amount, float speed)
+{
+	return [amount, speed](SCENE_LIGHT& light, float time) -> int
+	{
+		// a few incommensurate sine waves read as random flicker
+		float t = time * speed;
+		float noise = 0.5f * sin(t * 7.13f) + 0.3f * sin(t * 13.7f + 1.3f) + 0.2f * sin(t * 29.1f + 2.7f);
+		float intensity = 1.0f + (amount * noise);
+
+		light.ambient *= intensity;
+		light.diffuse *= intensity;
+		light.specular *= intensity;
+
+		return(DIRTY_COLOR);
+	};
+}
+
+/***********************************************************
+ *  MakeColorCycleAnimator()
+ *
+ *  This method is used for creating an animation hook that
+ *  blends the diffuse color through the passed in colors,
+ *  completing one cycle every period seconds.
+ ***********************************************************/
+LightManager::LIGHT_ANIMATOR LightManager::MakeColorCycleAnimator(std::vector<glm::vec3> colors, float period)
+{
+	return [colors, period](SCENE_LIGHT& light, float time) -> int
+	{
+		if ((colors.size() == 0) || (period <= 0.0f))
+		{
+			return(DIRTY_NONE);
+		}
+
+		float phase = fmod(time, period) / period * (float)colors.size();
+		int index = (int)phase % (int)colors.size();
+		int next = (index + 1) % (int)colors.size();
+		float blend = phase - floor(phase);
+
+		light.diffuse = colors[index] * (1.0f - blend) + colors[next] * blend;
+
+		return(DIRTY_COLOR);
+	};
+}
+
+/***********************************************************
+ *  MakeMovingLampAnimator()
+ *
+ *  This method is used for creating an animation hook that
+ *  swings the light around the passed in center, reaching
+ *  the extent offset on each axis once per period.
+ ***********************************************************/
+LightManager::LIGHT_ANIMATOR LightManager::MakeMovingLampAnimator(glm::dvec3 center, glm::vec3 extent, float period)
+{
+	return [center, extent, period](SCENE_LIGHT& light, float time) -> int
+	{
+		if (period <= 0.0f)
+		{
+			return(DIRTY_NONE);
+		}
+
+		float angle = glm::radians(360.0f) * fmod(time, period) / period;
+
+		light.position = center + glm::dvec3(
+			extent.x * sin(angle),
+			extent.y * sin(angle * 2.0f) * 0.5f,
+			extent.z * cos(angle));
+
+		return(DIRTY_POSITION);
+	};
+}
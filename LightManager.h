@@ -0,0 +1,229 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightmanager.h
+// ==============
+// manage the light sources of the 3D scene - typed lights, per-frame
+// animation hooks and dirty-tracked uploads into the shader light uniforms
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "CookieAtlas.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  LightManager
+ *
+ *  This class owns every light source in the 3D scene. The
+ *  lights are kept in a CPU-side mirror of the shader light
+ *  uniforms, and only the fields of the lights that actually
+ *  changed since the last frame are uploaded again.  The
+ *  lights are placed in double precision world space and
+ *  uploaded in render space through RenderOrigin, like the
+ *  scene objects.
+ *
+ *  The spot lights only take effect in a scene fragment
+ *  shader that reads them, and shaders/fragmentShader.glsl
+ *  is not part of this tree.  That shader must declare the
+ *  spotLights[MAX_SPOT_LIGHTS] array with the fields set in
+ *  UploadLight(), loop over the active spot lights, fade
+ *  each spot between outerCutOff
+ *  and cutOff and by its attenuation up to range, and when
+ *  bUseCookie is set, multiply by the spotLightCookies red
+ *  channel at the lightSpace projection of the fragment,
+ *  mapped into cookieRect.
+ ***********************************************************/
+class LightManager
+{
+public:
+	// the number of light slots declared in the fragment shader
+	static const int MAX_POINT_LIGHTS = 4;
+	static const int MAX_SPOT_LIGHTS = 8;
+
+	// the supported types of light sources
+	enum LIGHT_TYPE
+	{
+		LIGHT_DIRECTIONAL,
+		LIGHT_POINT,
+		LIGHT_SPOT
+	};
+
+	// dirty flags for the groups of uniforms in one light slot
+	enum LIGHT_DIRTY_FLAGS
+	{
+		DIRTY_NONE = 0,
+		DIRTY_POSITION = 1 << 0,
+		DIRTY_DIRECTION = 1 << 1,
+		DIRTY_COLOR = 1 << 2,
+		DIRTY_ATTENUATION = 1 << 3,
+		DIRTY_CONE = 1 << 4,
+		DIRTY_ACTIVE = 1 << 5,
+		DIRTY_COOKIE = 1 << 6,
+		DIRTY_ALL = 0x7F
+	};
+
+	// the properties of a single light source
+	struct SCENE_LIGHT
+	{
+		LIGHT_TYPE type;
+		// the world position - point and spot only
+		glm::dvec3 position;
+		glm::vec3 direction;
+		glm::vec3 ambient;
+		glm::vec3 diffuse;
+		glm::vec3 specular;
+		float constant;
+		float linear;
+		float quadratic;
+		// cosines of the inner and outer cone angles - spot only
+		float cutOff;
+		float outerCutOff;
+		// distance beyond which the light no longer contributes
+		float range;
+		// projected cookie rectangle in the cookie atlas - spot only
+		glm::vec4 cookieRect;
+		bool bUseCookie;
+		bool bActive;
+	};
+
+	// per-frame animation hook - modifies the light for the passed
+	// in time (in seconds) and returns the LIGHT_DIRTY_FLAGS of the
+	// fields that were changed
+	typedef std::function<int(SCENE_LIGHT& light, float time)> LIGHT_ANIMATOR;
+
+	LightManager(ShaderManager* pShaderManager);
+	~LightManager();
+
+	// add a light source to the scene and return its handle
+	int AddDirectionalLight(
+		glm::vec3 direction,
+		glm::vec3 ambient,
+		glm::vec3 diffuse,
+		glm::vec3 specular);
+	int AddPointLight(
+		glm::dvec3 position,
+		glm::vec3 ambient,
+		glm::vec3 diffuse,
+		glm::vec3 specular,
+		float constant = 1.0f,
+		float linear = 0.09f,
+		float quadratic = 0.032f);
+	int AddSpotLight(
+		glm::dvec3 position,
+		glm::vec3 direction,
+		float innerConeDegrees,
+		float outerConeDegrees,
+		glm::vec3 ambient,
+		glm::vec3 diffuse,
+		glm::vec3 specular,
+		float constant = 1.0f,
+		float linear = 0.09f,
+		float quadratic = 0.032f);
+
+	// read and modify a light - the modifiers mark the light dirty
+	const SCENE_LIGHT& GetLight(int handle) const;
+	void SetLightPosition(int handle, glm::dvec3 position);
+	void SetLightDirection(int handle, glm::vec3 direction);
+	void SetLightColor(int handle, glm::vec3 ambient, glm::vec3 diffuse, glm::vec3 specular);
+	void SetLightActive(int handle, bool bActive);
+	void SetSpotLightCone(int handle, float innerConeDegrees, float outerConeDegrees);
+
+	// project a cookie image through a spot light - the image is
+	// loaded into the shared cookie atlas only the first time
+	bool SetSpotLightCookie(int handle, const char* filename);
+	void ClearSpotLightCookie(int handle);
+	// bind the cookie atlas into the passed in texture slot
+	void BindCookieAtlas(int textureSlot);
+
+	// attach or remove the per-frame animation hook of a light
+	void SetLightAnimator(int handle, LIGHT_ANIMATOR animator);
+	void ClearLightAnimator(int handle);
+
+	// run the animation hooks of the animated lights only
+	void Update(float time);
+	// upload the changed lights into the shader - returns the
+	// number of light slots that were written
+	int UploadChangedLights();
+	// mark every light dirty so the next upload writes everything
+	void InvalidateAll();
+	// move the render origin - the positions of every light are
+	// uploaded again when it changes
+	void SetRenderOrigin(glm::dvec3 origin);
+
+	int GetLightCount() const { return((int)m_lights.size()); }
+	// keep fewer point and spot lights than the shader has slots
+	// for - the lights added past the limits are left out
+	void SetLightLimits(int pointLights, int spotLights);
+
+	// built-in animation hooks
+	static LIGHT_ANIMATOR MakeFlickerAnimator(float amount, float speed);
+	static LIGHT_ANIMATOR MakeColorCycleAnimator(std::vector<glm::vec3> colors, float period);
+	static LIGHT_ANIMATOR MakeMovingLampAnimator(glm::dvec3 center, glm::vec3 extent, float period);
+
+private:
+	// the pre-built uniform names for one light slot, so that
+	// uploads do not format strings every frame
+	struct LIGHT_UNIFORMS
+	{
+		std::string position;
+		std::string direction;
+		std::string ambient;
+		std::string diffuse;
+		std::string specular;
+		std::string constant;
+		std::string linear;
+		std::string quadratic;
+		std::string cutOff;
+		std::string outerCutOff;
+		std::string range;
+		std::string lightSpace;
+		std::string cookieRect;
+		std::string bUseCookie;
+		std::string bActive;
+	};
+
+	// the bookkeeping for one light source
+	struct LIGHT_ENTRY
+	{
+		SCENE_LIGHT light;
+		// the light as it was before its animator last ran
+		SCENE_LIGHT baseLight;
+		LIGHT_UNIFORMS uniforms;
+		LIGHT_ANIMATOR animator;
+		int dirtyFlags;
+		// index of the light in its shader light array
+		int slot;
+	};
+
+	int AddLight(const SCENE_LIGHT& light, const std::string& uniformPrefix, int slot);
+	void MarkDirty(int handle, int flags);
+	void UploadLight(LIGHT_ENTRY& entry);
+	static float ComputeLightRange(const SCENE_LIGHT& light);
+
+	ShaderManager* m_pShaderManager;
+	std::vector<LIGHT_ENTRY> m_lights;
+	// handles of the lights with an animation hook
+	std::vector<int> m_animatedLights;
+	// handles of the lights waiting to be uploaded
+	std::vector<int> m_dirtyLights;
+	// the shared texture holding the spot light cookies
+	CookieAtlas* m_pCookieAtlas;
+	// the render origin of the last upload, so a move of the origin
+	// uploads the light positions again
+	glm::dvec3 m_renderOrigin;
+	int m_directionalCount;
+	int m_pointCount;
+	int m_spotCount;
+	int m_pointLimit;
+	int m_spotLimit;
+	// set once bUseLighting has been written into the shader
+	bool m_bLightingEnabled;
+};
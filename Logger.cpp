@@ -0,0 +1,358 @@
+///////////////////////////////////////////////////////////////////////////////
+// logger.cpp
+// ==========
+// write leveled log lines from any thread through a lock-free ring that a
+// background thread formats and writes
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// declaration of global variables
+namespace
+{
+	// the lines that can wait for the writer - a power of two
+	const uint64_t LOG_SLOTS = 4096;
+	// the writer is woken every time this many lines are written, so
+	// a burst of lines is written before it fills the ring
+	const uint64_t WAKE_SLOTS = LOG_SLOTS / 4;
+	// the longest line written, past which the text is cut
+	const size_t LOG_LINE_BYTES = 1024;
+	// the writer looks for lines this often when it is not woken
+	const int WRITER_WAKE_MILLISECONDS = 10;
+
+	const char* const LEVEL_NAMES[] = { "DEBUG", "INFO", "WARNING", "ERROR" };
+
+	// a slot of the ring - the sequence tells whether the slot is
+	// free for the write at a position, or holds the line written
+	// at the position before it
+	struct LOG_ENTRY
+	{
+		std::atomic<uint64_t> sequence;
+		LOG_LEVEL level;
+		uint64_t microseconds;
+		const char* format;
+		LOG_FORMATTER pFormatter;
+		LOG_ARGUMENTS arguments;
+	};
+
+	LOG_ENTRY g_Entries[LOG_SLOTS];
+	// the next position to write, claimed by the writing threads
+	alignas(64) std::atomic<uint64_t> g_WritePosition(0);
+	// the next position to read, only used by the writer thread
+	alignas(64) uint64_t g_ReadPosition = 0;
+	std::atomic<unsigned int> g_DroppedCount(0);
+	std::atomic<bool> g_bRunning(false);
+
+	std::chrono::steady_clock::time_point g_StartTime = std::chrono::steady_clock::now();
+
+	std::mutex g_WakeMutex;
+	std::condition_variable g_Wake;
+	bool g_bWakeRequested = false;
+	bool g_bStopping = false;
+	std::thread g_WriterThread;
+
+	// stops the writer when the application exits without stopping
+	// it, which runs before the thread object is destroyed
+	struct LOG_SHUTDOWN
+	{
+		~LOG_SHUTDOWN()
+		{
+			Logger::Stop();
+		}
+	};
+	LOG_SHUTDOWN g_Shutdown;
+
+	/***********************************************************
+	 *  AppendLine()
+	 *
+	 *  This function is used for formatting a line with the
+	 *  time since the start and its level in front.
+	 ***********************************************************/
+	void AppendLine(std::string& output, LOG_LEVEL level, uint64_t microseconds,
+		const char* format, LOG_FORMATTER pFormatter, const LOG_ARGUMENTS& arguments)
+	{
+		char text[LOG_LINE_BYTES];
+		char prefix[48];
+		pFormatter(format, arguments.bytes, arguments.size, text, sizeof(text));
+		snprintf(prefix, sizeof(prefix), "[%10.6f] %s: ", (double)microseconds / 1000000.0, LEVEL_NAMES[level]);
+		output += prefix;
+		output += text;
+		output += "\n";
+	}
+
+	/***********************************************************
+	 *  WriteOutput()
+	 *
+	 *  This function is used for writing the formatted lines
+	 *  with one write and one flush.
+	 ***********************************************************/
+	void WriteOutput(std::string& output)
+	{
+		if (output.size() == 0)
+		{
+			return;
+		}
+		fwrite(output.data(), 1, output.size(), stdout);
+		fflush(stdout);
+		output.clear();
+	}
+
+	/***********************************************************
+	 *  ReadEntries()
+	 *
+	 *  This function is used for formatting every line that
+	 *  has been written, oldest first, and freeing its slot.
+	 ***********************************************************/
+	void ReadEntries(std::string& output)
+	{
+		while (true)
+		{
+			LOG_ENTRY& entry = g_Entries[g_ReadPosition & (LOG_SLOTS - 1)];
+			if (entry.sequence.load(std::memory_order_acquire) != g_ReadPosition + 1)
+			{
+				break;
+			}
+			AppendLine(output, entry.level, entry.microseconds, entry.format, entry.pFormatter, entry.arguments);
+			entry.sequence.store(g_ReadPosition + LOG_SLOTS, std::memory_order_release);
+			g_ReadPosition++;
+		}
+
+		unsigned int droppedCount = g_DroppedCount.exchange(0, std::memory_order_relaxed);
+		if (droppedCount > 0)
+		{
+			char text[96];
+			uint64_t microseconds = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - g_StartTime).count();
+			snprintf(text, sizeof(text), "[%10.6f] WARNING: %u log lines were dropped while the log was full\n",
+				(double)microseconds / 1000000.0, droppedCount);
+			output += text;
+		}
+	}
+
+	/***********************************************************
+	 *  WriterLoop()
+	 *
+	 *  This function is run by the writer thread, which wakes
+	 *  every few milliseconds, or right away for an error or a
+	 *  burst of lines, and writes the lines waiting in the ring.
+	 ***********************************************************/
+	void WriterLoop()
+	{
+		std::string output;
+		while (true)
+		{
+			bool bStopping = false;
+			{
+				std::unique_lock<std::mutex> lock(g_WakeMutex);
+				g_Wake.wait_for(lock, std::chrono::milliseconds(WRITER_WAKE_MILLISECONDS),
+					[]() { return(g_bWakeRequested || g_bStopping); });
+				g_bWakeRequested = false;
+				bStopping = g_bStopping;
+			}
+
+			ReadEntries(output);
+			WriteOutput(output);
+			if (bStopping == true)
+			{
+				break;
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  Start()
+ *
+ *  This method is used for freeing every slot of the ring
+ *  and starting the writer thread.
+ ***********************************************************/
+void Logger::Start()
+{
+	if (g_bRunning.load(std::memory_order_acquire) == true)
+	{
+		return;
+	}
+
+	for (uint64_t i = 0; i < LOG_SLOTS; i++)
+	{
+		g_Entries[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	g_WritePosition.store(0, std::memory_order_relaxed);
+	g_ReadPosition = 0;
+	g_bStopping = false;
+	g_bWakeRequested = false;
+	g_WriterThread = std::thread(WriterLoop);
+
+	g_bRunning.store(true, std::memory_order_release);
+}
+
+/***********************************************************
+ *  Stop()
+ *
+ *  This method is used for writing the waiting lines and
+ *  stopping the writer thread.  The lines written after it
+ *  are written right away.
+ ***********************************************************/
+void Logger::Stop()
+{
+	if (g_bRunning.exchange(false, std::memory_order_acq_rel) == false)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(g_WakeMutex);
+		g_bStopping = true;
+	}
+	g_Wake.notify_one();
+	g_WriterThread.join();
+}
+
+/***********************************************************
+ *  Submit()
+ *
+ *  This method is used for claiming the next slot of the
+ *  ring and filling it with a line.  A slot is claimed by
+ *  moving the write position on from the position the slot
+ *  is free for, and a slot still holding a line from one
+ *  lap before means the ring is full, so the line is
+ *  dropped instead of waiting for the writer.
+ ***********************************************************/
+void Logger::Submit(LOG_LEVEL level, const char* format, LOG_FORMATTER pFormatter, const LOG_ARGUMENTS& arguments)
+{
+	uint64_t microseconds = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - g_StartTime).count();
+
+	if (g_bRunning.load(std::memory_order_acquire) == false)
+	{
+		std::string output;
+		AppendLine(output, level, microseconds, format, pFormatter, arguments);
+		WriteOutput(output);
+		return;
+	}
+
+	LOG_ENTRY* pEntry = NULL;
+	uint64_t position = g_WritePosition.load(std::memory_order_relaxed);
+	while (true)
+	{
+		pEntry = &g_Entries[position & (LOG_SLOTS - 1)];
+		uint64_t sequence = pEntry->sequence.load(std::memory_order_acquire);
+		if (sequence == position)
+		{
+			if (g_WritePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed) == true)
+			{
+				break;
+			}
+		}
+		else if (sequence < position)
+		{
+			g_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		else
+		{
+			position = g_WritePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	pEntry->level = level;
+	pEntry->microseconds = microseconds;
+	pEntry->format = format;
+	pEntry->pFormatter = pFormatter;
+	memcpy(pEntry->arguments.bytes, arguments.bytes, arguments.size);
+	pEntry->arguments.size = arguments.size;
+	pEntry->arguments.bFull = arguments.bFull;
+	pEntry->sequence.store(position + 1, std::memory_order_release);
+
+	// an error is written right away, in case the application is
+	// about to end
+	if ((level >= LOG_LEVEL_ERROR) || ((position + 1) % WAKE_SLOTS == 0))
+	{
+		{
+			std::lock_guard<std::mutex> lock(g_WakeMutex);
+			g_bWakeRequested = true;
+		}
+		g_Wake.notify_one();
+	}
+}
+
+/***********************************************************
+ *  FormatText()
+ *
+ *  This method is used for formatting the decoded arguments
+ *  of a line.
+ ***********************************************************/
+void Logger::FormatText(char* text, size_t textSize, const char* format, ...)
+{
+	va_list arguments;
+	va_start(arguments, format);
+	vsnprintf(text, textSize, format, arguments);
+	va_end(arguments);
+}
+
+/***********************************************************
+ *  Capture()
+ *
+ *  This method is used for copying a C string argument with
+ *  its length in front.  A string longer than the room left
+ *  is cut, and a NULL string is copied as "(null)".
+ ***********************************************************/
+void Logger::Capture(LOG_ARGUMENTS& captured, const char* text)
+{
+	if (NULL == text)
+	{
+		text = "(null)";
+	}
+
+	size_t room = LOG_ARGUMENT_BYTES - captured.size;
+	if ((captured.bFull == true) || (room < sizeof(uint16_t) + 1))
+	{
+		captured.bFull = true;
+		return;
+	}
+
+	size_t length = strlen(text);
+	if (length > room - sizeof(uint16_t) - 1)
+	{
+		length = room - sizeof(uint16_t) - 1;
+	}
+	uint16_t storedLength = (uint16_t)length;
+	memcpy(captured.bytes + captured.size, &storedLength, sizeof(uint16_t));
+	memcpy(captured.bytes + captured.size + sizeof(uint16_t), text, length);
+	captured.bytes[captured.size + sizeof(uint16_t) + length] = 0;
+	captured.size += sizeof(uint16_t) + length + 1;
+}
+
+/***********************************************************
+ *  Decode()
+ *
+ *  This method is used for reading a copied C string, which
+ *  is formatted straight from the copy.
+ ***********************************************************/
+const char* Logger::Decode(LOG_READER& reader, const char*)
+{
+	if ((reader.bFailed == true) || (reader.position + sizeof(uint16_t) + 1 > reader.size))
+	{
+		reader.bFailed = true;
+		return("");
+	}
+
+	uint16_t length = 0;
+	memcpy(&length, reader.pBytes + reader.position, sizeof(uint16_t));
+	const char* text = (const char*)(reader.pBytes + reader.position + sizeof(uint16_t));
+	reader.position += sizeof(uint16_t) + length + 1;
+
+	return(text);
+}
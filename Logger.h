@@ -0,0 +1,198 @@
+///////////////////////////////////////////////////////////////////////////////
+// logger.h
+// ========
+// write leveled log lines from any thread through a lock-free ring that a
+// background thread formats and writes
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// the levels of the log lines
+enum LOG_LEVEL
+{
+	LOG_LEVEL_DEBUG = 0,
+	LOG_LEVEL_INFO,
+	LOG_LEVEL_WARNING,
+	LOG_LEVEL_ERROR
+};
+
+// the lines below this level are compiled out
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL LOG_LEVEL_INFO
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LOG_PRINTF_FORMAT(formatIndex, firstArgument) __attribute__((format(printf, formatIndex, firstArgument)))
+#else
+#define LOG_PRINTF_FORMAT(formatIndex, firstArgument)
+#endif
+
+// the format is checked against the arguments by the compiler, as if
+// they were passed to printf, without the check ever running
+#define LOG_WRITE(level, ...) \
+	do \
+	{ \
+		if ((level) >= LOG_MIN_LEVEL) \
+		{ \
+			if (false) \
+			{ \
+				Logger::CheckFormat(__VA_ARGS__); \
+			} \
+			Logger::Write((level), __VA_ARGS__); \
+		} \
+	} while (false)
+
+#define LOG_DEBUG(...) LOG_WRITE(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) LOG_WRITE(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARNING(...) LOG_WRITE(LOG_LEVEL_WARNING, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_WRITE(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+// the bytes the arguments of one line are copied into - a line whose
+// arguments do not fit prints the rest as zeros and empty strings
+const size_t LOG_ARGUMENT_BYTES = 224;
+
+// the arguments of a line, copied as they were passed
+struct LOG_ARGUMENTS
+{
+	unsigned char bytes[LOG_ARGUMENT_BYTES];
+	size_t size;
+	// set once an argument did not fit, so the later ones are left
+	// out as well
+	bool bFull;
+};
+
+// formats the copied arguments of a line with their types
+typedef void (*LOG_FORMATTER)(const char* format, const unsigned char* pBytes, size_t size, char* text, size_t textSize);
+
+/***********************************************************
+ *  Logger
+ *
+ *  A log line only copies its format string, which must be
+ *  a literal, and the binary values of its arguments into
+ *  a slot of a fixed ring, along with the function that
+ *  formats those argument types - strings are copied into
+ *  the slot, since they may not outlive the call.  Any
+ *  thread can write lines, claiming slots with an atomic
+ *  position instead of a lock, and a background thread
+ *  formats the waiting lines and writes them in one go, so
+ *  the writing threads never format, flush or wait on the
+ *  output.  When the ring is full, lines are dropped and
+ *  counted.  Before the logger is started and after it is
+ *  stopped, lines are written right away.
+ ***********************************************************/
+class Logger
+{
+public:
+	static void Start();
+	// writes the waiting lines before returning
+	static void Stop();
+
+	template <typename... ARGUMENTS>
+	static void Write(LOG_LEVEL level, const char* format, ARGUMENTS... arguments)
+	{
+		LOG_ARGUMENTS captured;
+		captured.size = 0;
+		captured.bFull = false;
+		// the braces copy the arguments in order
+		int order[] = { 0, (Capture(captured, arguments), 0)... };
+		(void)order;
+		Submit(level, format, &Logger::Format<ARGUMENTS...>, captured);
+	}
+
+	// only there for the compiler to check the format, and never
+	// called
+	static void CheckFormat(const char* format, ...) LOG_PRINTF_FORMAT(1, 2);
+
+private:
+	// the type an argument is formatted as
+	template <typename T>
+	struct DECODED
+	{
+		typedef T type;
+	};
+
+	// reads the copied arguments back in the order they were copied
+	struct LOG_READER
+	{
+		const unsigned char* pBytes;
+		size_t size;
+		size_t position;
+		bool bFailed;
+	};
+
+	static void Submit(LOG_LEVEL level, const char* format, LOG_FORMATTER pFormatter, const LOG_ARGUMENTS& arguments);
+	static void FormatText(char* text, size_t textSize, const char* format, ...);
+
+	static void Capture(LOG_ARGUMENTS& captured, const char* text);
+	static void Capture(LOG_ARGUMENTS& captured, char* text)
+	{
+		Capture(captured, (const char*)text);
+	}
+	template <typename T>
+	static void Capture(LOG_ARGUMENTS& captured, T value)
+	{
+		static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value,
+			"log arguments must be numbers, enums, pointers or C strings");
+		if ((captured.bFull == true) || (captured.size + sizeof(T) > LOG_ARGUMENT_BYTES))
+		{
+			captured.bFull = true;
+			return;
+		}
+		memcpy(captured.bytes + captured.size, &value, sizeof(T));
+		captured.size += sizeof(T);
+	}
+
+	// the second argument only picks the type that is read
+	static const char* Decode(LOG_READER& reader, const char*);
+	template <typename T>
+	static T Decode(LOG_READER& reader, T)
+	{
+		if ((reader.bFailed == true) || (reader.position + sizeof(T) > reader.size))
+		{
+			reader.bFailed = true;
+			return(T());
+		}
+		T value;
+		memcpy(&value, reader.pBytes + reader.position, sizeof(T));
+		reader.position += sizeof(T);
+		return(value);
+	}
+
+	template <typename... ARGUMENTS>
+	static void Format(const char* format, const unsigned char* pBytes, size_t size, char* text, size_t textSize)
+	{
+		LOG_READER reader = { pBytes, size, 0, false };
+		(void)reader;
+		// the braces read the arguments in order
+		std::tuple<typename DECODED<ARGUMENTS>::type...> values{ Decode(reader, typename DECODED<ARGUMENTS>::type())... };
+		FormatValues(format, text, textSize, values, std::index_sequence_for<ARGUMENTS...>());
+	}
+
+	template <typename TUPLE, size_t... INDICES>
+	static void FormatValues(const char* format, char* text, size_t textSize, const TUPLE& values, std::index_sequence<INDICES...>)
+	{
+		FormatText(text, textSize, format, std::get<INDICES>(values)...);
+	}
+};
+
+// a C string is formatted from its copy in the slot
+template <>
+struct Logger::DECODED<char*>
+{
+	typedef const char* type;
+};
+
+inline void Logger::CheckFormat(const char* format, ...)
+{
+	(void)format;
+}
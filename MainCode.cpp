@@ -7,7 +7,6 @@
 //	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
 ///////////////////////////////////////////////////////////////////////////////
 
-#include <iostream>         // error handling and output
 #include <cstdlib>          // EXIT_FAILURE
 
 #include <GL/glew.h>        // GLEW library
@@ -23,6 +22,16 @@
 #include "ViewManager.h"
 #include "ShapeMeshes.h"
 #include "ShaderManager.h"
+#include "RoomReplicator.h"
+#include "ViewLayout.h"
+#include "PresentationWindow.h"
+#include "BatchRenderer.h"
+#include "FrameRecorder.h"
+#include "ControlServer.h"
+#include "FrameStats.h"
+#include "FrameMetrics.h"
+#include "RenderSettings.h"
+#include "Logger.h"
 
 // Namespace for declaring global variables
 namespace
@@ -39,12 +48,16 @@ namespace
 	ShaderManager* g_ShaderManager = nullptr;
 	// view manager object for managing the 3D view setup and projection to 2D
 	ViewManager* g_ViewManager = nullptr;
+	// control server object for taking the commands of automation
+	// scripts, which is only created with --control
+	ControlServer* g_ControlServer = nullptr;
 }
 
 // Function declarations - all functions that are called manually
 // need to be pre-declared at the beginning of the source code.
-bool InitializeGLFW();
+bool InitializeGLFW(bool bHeadless);
 bool InitializeGLEW();
+void ProcessControlCommands();
 
 
 /***********************************************************
@@ -55,12 +68,74 @@ bool InitializeGLEW();
  ***********************************************************/
 int main(int argc, char* argv[])
 {
+	// the log lines are written by a background thread from here on
+	Logger::Start();
+
+	// the room grid used for scaling measurements, which is a
+	// single room unless it is given on the command line
+	ROOM_GRID_SETTINGS roomGrid = RoomReplicator::GetDefaultSettings();
+	if (RoomReplicator::ParseArguments(argc, argv, roomGrid) == false)
+	{
+		return(EXIT_FAILURE);
+	}
+	RoomReplicator::SetSceneSettings(roomGrid);
+
+	// a list of camera poses on the command line renders them into
+	// image files instead of showing the scene
+	BATCH_SETTINGS batch = BatchRenderer::GetDefaultSettings();
+	if (BatchRenderer::ParseArguments(argc, argv, batch) == false)
+	{
+		return(EXIT_FAILURE);
+	}
+	bool bBatch = (NULL != batch.poseFile);
+	int exitCode = EXIT_SUCCESS;
+
+	// a control socket on the command line lets scripts drive the
+	// camera and take the stats of every frame
+	const char* controlSocket = NULL;
+	if (ControlServer::ParseArguments(argc, argv, controlSocket) == false)
+	{
+		return(EXIT_FAILURE);
+	}
+	// a metrics file on the command line is replaced with the frame
+	// time distributions every few seconds
+	const char* metricsFile = NULL;
+	if (FrameMetrics::ParseArguments(argc, argv, metricsFile) == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// the window size, the clip planes, the lights and the texture
+	// and edge smoothing come from a quality preset, a settings file
+	// and the command line
+	QUALITY_PRESET quality = QUALITY_MEDIUM;
+	bool bAutoQuality = false;
+	if (RenderSettings::ParseQuality(argc, argv, quality, bAutoQuality) == false)
+	{
+		return(EXIT_FAILURE);
+	}
+	RENDER_SETTINGS renderSettings = RenderSettings::GetPreset(quality);
+	if (RenderSettings::ParseArguments(argc, argv, renderSettings) == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
 	// if GLFW fails initialization, then terminate the application
-	if (InitializeGLFW() == false)
+	if (InitializeGLFW(bBatch) == false)
 	{
 		return(EXIT_FAILURE);
 	}
 
+	// the benchmark picks the preset before the main window is
+	// created, and the file and the command line still apply over it
+	if ((bAutoQuality == true) && (bBatch == false))
+	{
+		renderSettings = RenderSettings::GetPreset(RenderSettings::AutoTune());
+		RenderSettings::ParseArguments(argc, argv, renderSettings);
+	}
+	RenderSettings::Set(renderSettings);
+	LOG_INFO("Rendering with the %s quality preset", RenderSettings::GetPresetName(renderSettings.preset));
+
 	// try to create a new shader manager object
 	g_ShaderManager = new ShaderManager();
 	// try to create a new view manager object
@@ -86,10 +161,59 @@ int main(int argc, char* argv[])
 	g_SceneManager = new SceneManager(g_ShaderManager);
 	g_SceneManager->PrepareScene();
 
+	// the batch run writes every image and quits without entering
+	// the render loop
+	if (bBatch == true)
+	{
+		BatchRenderer* pBatchRenderer = new BatchRenderer(g_ShaderManager, g_SceneManager);
+		if ((pBatchRenderer->LoadPoses(batch) == false) ||
+			(pBatchRenderer->Run() != pBatchRenderer->GetPoseCount()))
+		{
+			exitCode = EXIT_FAILURE;
+		}
+		delete pBatchRenderer;
+		pBatchRenderer = NULL;
+	}
+	else if (NULL != controlSocket)
+	{
+		g_ControlServer = new ControlServer();
+		if (g_ControlServer->Start(controlSocket) == true)
+		{
+			ControlServer::SetActive(g_ControlServer);
+		}
+		else
+		{
+			delete g_ControlServer;
+			g_ControlServer = NULL;
+		}
+	}
+	// the metrics are kept for the export file and the control clients
+	if ((bBatch == false) && ((NULL != metricsFile) || (NULL != g_ControlServer)))
+	{
+		FrameMetrics::Enable(metricsFile);
+	}
+
+	// the frames are measured for the control clients and the metrics
+	bool bMeasureFrames = FrameMetrics::IsEnabled();
+	uint64_t frameStart = 0;
+
 	// loop will keep running until the application is closed 
 	// or until an error has occurred
-	while (!glfwWindowShouldClose(g_Window))
+	while ((bBatch == false) && !glfwWindowShouldClose(g_Window))
 	{
+		// the frame time runs from the start of the previous frame, and
+		// every phase from the end of the one before it
+		uint64_t phaseStart = FrameMetrics::GetMicroseconds();
+		if (frameStart > 0)
+		{
+			FrameMetrics::Record(METRIC_FRAME, phaseStart - frameStart);
+		}
+		frameStart = phaseStart;
+		if (bMeasureFrames == true)
+		{
+			FrameStats::BeginFrame();
+		}
+
 		// Enable z-depth
 		glEnable(GL_DEPTH_TEST);
 
@@ -99,19 +223,67 @@ int main(int argc, char* argv[])
 
 		// convert from 3D object space to 2D view
 		g_ViewManager->PrepareSceneView();
+		phaseStart = FrameMetrics::RecordSince(METRIC_CPU_VIEW, phaseStart);
 
-		// refresh the 3D scene
-		g_SceneManager->RenderScene();
+		// refresh the 3D scene in every view - the view manager has
+		// already made the first view current
+		for (int view = 0; view < ViewLayout::GetViewCount(); view++)
+		{
+			if (view > 0)
+			{
+				ViewLayout::ApplyView(view, g_ShaderManager);
+			}
+			g_SceneManager->RenderScene();
+		}
+		phaseStart = FrameMetrics::RecordSince(METRIC_CPU_RENDER, phaseStart);
 
+		// the views of other windows leave their target bound, and
+		// the presentation window copies its view once it is drawn
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		// a recording copies the finished frame before it is swapped
+		if (NULL != FrameRecorder::GetActive())
+		{
+			FrameRecorder::GetActive()->CaptureFrame();
+		}
+		if (NULL != PresentationWindow::GetActive())
+		{
+			PresentationWindow::GetActive()->Present();
+		}
+		// the screenshots copy the finished frame too, and the stats
+		// of the frames whose queries have finished are sent
+		if (NULL != g_ControlServer)
+		{
+			ProcessControlCommands();
+		}
+		if ((bMeasureFrames == true) && (FrameStats::EndFrame() == true))
+		{
+			const FRAME_STATS& stats = FrameStats::GetLatest();
+			FrameMetrics::Record(METRIC_GPU_FRAME, (uint64_t)(stats.gpuMilliseconds * 1000.0f));
+			if (NULL != g_ControlServer)
+			{
+				g_ControlServer->PublishStats(stats);
+			}
+		}
+		phaseStart = FrameMetrics::RecordSince(METRIC_CPU_FINISH, phaseStart);
 
 		// Flips the the back buffer with the front buffer every frame.
 		glfwSwapBuffers(g_Window);
+		FrameMetrics::RecordSince(METRIC_CPU_SWAP, phaseStart);
 
 		// query the latest GLFW events
 		glfwPollEvents();
+
+		// merge the recorded times and export them when they are due
+		FrameMetrics::Update();
 	}
 
 	// clear the allocated manager objects from memory
+	if (NULL != g_ControlServer)
+	{
+		delete g_ControlServer;
+		g_ControlServer = NULL;
+	}
+	FrameStats::Destroy();
 	if (NULL != g_SceneManager)
 	{
 		delete g_SceneManager;
@@ -128,19 +300,33 @@ int main(int argc, char* argv[])
 		g_ShaderManager = NULL;
 	}
 
-	// Terminates the program successfully
-	exit(EXIT_SUCCESS); 
+	// write the waiting log lines before the program ends
+	Logger::Stop();
+
+	// Terminates the program, successfully unless a batch image
+	// could not be written
+	exit(exitCode); 
 }
 
 /***********************************************************
  *	InitializeGLFW()
  * 
  *  This function is used to initialize the GLFW library.   
+ *  A headless run only draws into offscreen targets, so it
+ *  uses the null platform with an EGL context where GLFW
+ *  has one, which needs no display and also runs on servers
+ *  rendering with llvmpipe, and the window is never shown.
  ***********************************************************/
-bool InitializeGLFW()
+bool InitializeGLFW(bool bHeadless)
 {
 	// GLFW: initialize and configure library
 	// --------------------------------------
+#ifdef GLFW_PLATFORM_NULL
+	if (bHeadless == true)
+	{
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+	}
+#endif
 	glfwInit();
 
 #ifdef __APPLE__
@@ -154,6 +340,13 @@ bool InitializeGLFW()
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
 	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #endif
+	if (bHeadless == true)
+	{
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef GLFW_PLATFORM_NULL
+		glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+#endif
+	}
 	// GLFW: end -------------------------------
 
 	return(true);
@@ -174,14 +367,67 @@ bool InitializeGLEW()
 	GLEWInitResult = glewInit();
 	if (GLEW_OK != GLEWInitResult)
 	{
-		std::cerr << glewGetErrorString(GLEWInitResult) << std::endl;
+		LOG_ERROR("%s", (const char*)glewGetErrorString(GLEWInitResult));
 		return false;
 	}
 	// GLEW: end -------------------------------
 
 	// Displays a successful OpenGL initialization message
-	std::cout << "INFO: OpenGL Successfully Initialized\n";
-	std::cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << "\n" << std::endl;
+	LOG_INFO("OpenGL Successfully Initialized");
+	LOG_INFO("OpenGL Version: %s", (const char*)glGetString(GL_VERSION));
 
 	return(true);
-}
\ No newline at end of file
+}
+
+/***********************************************************
+ *	ProcessControlCommands()
+ *
+ *  This function is used to apply the commands of the
+ *  control clients that act on the finished frame or
+ *  between frames.  A screenshot copies the back buffer,
+ *  a scene load rebuilds the scene manager for the new
+ *  room grid, and a quit closes the window.  Nothing more
+ *  is taken after a scene load, so the commands behind it
+ *  see a frame of the new scene.
+ ***********************************************************/
+void ProcessControlCommands()
+{
+	g_ControlServer->CollectScreenshots();
+
+	CONTROL_COMMAND command;
+	while (g_ControlServer->PopCommand(CONTROL_SCREENSHOT | CONTROL_LOAD_SCENE | CONTROL_QUIT, command) == true)
+	{
+		if (command.type == CONTROL_SCREENSHOT)
+		{
+			int width = 0;
+			int height = 0;
+			glfwGetFramebufferSize(g_Window, &width, &height);
+			g_ControlServer->RequestScreenshot(command, width, height);
+		}
+		else if (command.type == CONTROL_LOAD_SCENE)
+		{
+			ROOM_GRID_SETTINGS roomGrid = RoomReplicator::GetSceneSettings();
+			roomGrid.roomsX = command.rooms[0];
+			roomGrid.roomsY = command.rooms[1];
+			roomGrid.roomsZ = command.rooms[2];
+			if (command.bHasSeed == true)
+			{
+				roomGrid.seed = command.seed;
+			}
+			roomGrid.bStreamRooms = command.bStreamRooms;
+
+			delete g_SceneManager;
+			RoomReplicator::SetSceneSettings(roomGrid);
+			g_SceneManager = new SceneManager(g_ShaderManager);
+			g_SceneManager->PrepareScene();
+
+			g_ControlServer->Reply(command, true);
+			break;
+		}
+		else
+		{
+			glfwSetWindowShouldClose(g_Window, GLFW_TRUE);
+			g_ControlServer->Reply(command, true);
+		}
+	}
+}
@@ -0,0 +1,371 @@
+///////////////////////////////////////////////////////////////////////////////
+// objectpicker.cpp
+// ================
+// find the object under a pixel by drawing object ids into an integer target
+// and reading the pixel back a frame later
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ObjectPicker.h"
+#include "ViewLayout.h"
+#include "CameraState.h"
+#include "Logger.h"
+
+#include <algorithm>
+
+// declaration of global variables
+namespace
+{
+	ObjectPicker* g_pScenePicker = nullptr;
+}
+
+/***********************************************************
+ *  ObjectPicker()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ObjectPicker::ObjectPicker(ShaderManager* pSceneShaderManager)
+{
+	m_pSceneShaderManager = pSceneShaderManager;
+	m_pIdShaderManager = NULL;
+	m_framebuffer = 0;
+	m_idBuffer = 0;
+	m_depthBuffer = 0;
+	m_pixelBuffer = 0;
+	m_readFence = 0;
+	m_targetWidth = 0;
+	m_targetHeight = 0;
+	m_bPickRequested = false;
+	m_pickX = 0;
+	m_pickY = 0;
+	m_pickedObject = -1;
+}
+
+/***********************************************************
+ *  ~ObjectPicker()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ObjectPicker::~ObjectPicker()
+{
+	if (this == g_pScenePicker)
+	{
+		g_pScenePicker = NULL;
+	}
+	DestroyPicker();
+	m_pSceneShaderManager = NULL;
+}
+
+/***********************************************************
+ *  GetScene()
+ *
+ *  This method is used for getting the picker of the scene,
+ *  which is NULL until the scene is prepared.
+ ***********************************************************/
+ObjectPicker* ObjectPicker::GetScene()
+{
+	return(g_pScenePicker);
+}
+
+/***********************************************************
+ *  SetScene()
+ *
+ *  This method is used for setting the picker of the scene.
+ ***********************************************************/
+void ObjectPicker::SetScene(ObjectPicker* pScenePicker)
+{
+	g_pScenePicker = pScenePicker;
+}
+
+/***********************************************************
+ *  CreatePicker()
+ *
+ *  This method is used for loading the id shader and
+ *  allocating the pixel buffer the picks are read into.
+ *  The id target is allocated on the first pick, when the
+ *  size of the viewport is known.
+ ***********************************************************/
+bool ObjectPicker::CreatePicker()
+{
+	glGenBuffers(1, &m_pixelBuffer);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pixelBuffer);
+	glBufferData(GL_PIXEL_PACK_BUFFER, sizeof(GLuint), NULL, GL_STREAM_READ);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	m_pIdShaderManager = new ShaderManager();
+	m_pIdShaderManager->LoadShaders(
+		"shaders/pickIdVertex.glsl",
+		"shaders/pickIdFragment.glsl");
+
+	// the scene shader must be active again for the scene rendering
+	m_pSceneShaderManager->use();
+
+	return(true);
+}
+
+/***********************************************************
+ *  DestroyPicker()
+ *
+ *  This method is used for freeing the OpenGL memory of
+ *  the picker.
+ ***********************************************************/
+void ObjectPicker::DestroyPicker()
+{
+	if (m_readFence != 0)
+	{
+		glDeleteSync(m_readFence);
+		m_readFence = 0;
+	}
+	if (m_framebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		m_framebuffer = 0;
+	}
+	if (m_idBuffer != 0)
+	{
+		glDeleteRenderbuffers(1, &m_idBuffer);
+		m_idBuffer = 0;
+	}
+	if (m_depthBuffer != 0)
+	{
+		glDeleteRenderbuffers(1, &m_depthBuffer);
+		m_depthBuffer = 0;
+	}
+	if (m_pixelBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_pixelBuffer);
+		m_pixelBuffer = 0;
+	}
+	if (NULL != m_pIdShaderManager)
+	{
+		CameraState::ForgetShader(m_pIdShaderManager);
+		delete m_pIdShaderManager;
+		m_pIdShaderManager = NULL;
+	}
+	m_targetWidth = 0;
+	m_targetHeight = 0;
+	m_bPickRequested = false;
+}
+
+/***********************************************************
+ *  ResizeTarget()
+ *
+ *  This method is used for allocating the id target at the
+ *  settled framebuffer size, or larger when the viewport has
+ *  grown past it during a resize.  The target is only
+ *  reallocated when that size changes.
+ ***********************************************************/
+bool ObjectPicker::ResizeTarget(int viewportWidth, int viewportHeight)
+{
+	int width = 0;
+	int height = 0;
+	ViewLayout::GetTargetSize(width, height);
+	width = std::max(width, viewportWidth);
+	height = std::max(height, viewportHeight);
+
+	if ((width == m_targetWidth) && (height == m_targetHeight) && (m_framebuffer != 0))
+	{
+		return(true);
+	}
+
+	if (m_framebuffer == 0)
+	{
+		glGenFramebuffers(1, &m_framebuffer);
+		glGenRenderbuffers(1, &m_idBuffer);
+		glGenRenderbuffers(1, &m_depthBuffer);
+	}
+
+	glBindRenderbuffer(GL_RENDERBUFFER, m_idBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_R32UI, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_idBuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		LOG_ERROR("Object picking framebuffer is incomplete: 0x%x", status);
+		m_targetWidth = 0;
+		m_targetHeight = 0;
+		return(false);
+	}
+
+	m_targetWidth = width;
+	m_targetHeight = height;
+
+	return(true);
+}
+
+/***********************************************************
+ *  RequestPick()
+ *
+ *  This method is used for asking for the object under a
+ *  pixel.  The ids are drawn on the next update.
+ ***********************************************************/
+void ObjectPicker::RequestPick(int x, int y)
+{
+	m_bPickRequested = true;
+	m_pickX = x;
+	m_pickY = y;
+}
+
+/***********************************************************
+ *  SetObject()
+ *
+ *  This method is used for setting the model matrix and id
+ *  of the next object drawn into the id target.
+ ***********************************************************/
+void ObjectPicker::SetObject(const glm::mat4& model, int objectId)
+{
+	m_pIdShaderManager->setMat4Value("model", model);
+	m_pIdShaderManager->setIntValue("objectId", objectId + 1);
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for collecting a pick whose read
+ *  has finished, and for drawing the ids of a requested
+ *  pick once no read is in flight.
+ ***********************************************************/
+bool ObjectPicker::Update(RENDER_CALLBACK renderIds)
+{
+	if ((NULL == m_pIdShaderManager) || (m_pixelBuffer == 0))
+	{
+		return(false);
+	}
+
+	bool bCollected = false;
+	if (m_readFence != 0)
+	{
+		bCollected = CollectPick();
+	}
+
+	if (m_bPickRequested && (m_readFence == 0))
+	{
+		// with several views on the screen, the ids are drawn by
+		// the view whose viewport holds the pixel
+		GLint viewport[4];
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		int pixelX = m_pickX - viewport[0];
+		int pixelY = m_pickY - viewport[1];
+		if ((pixelX >= 0) && (pixelX < viewport[2]) &&
+			(pixelY >= 0) && (pixelY < viewport[3]))
+		{
+			m_bPickRequested = false;
+			if (RenderIds(renderIds, viewport, pixelX, pixelY) == false)
+			{
+				m_pickedObject = -1;
+				bCollected = true;
+			}
+		}
+	}
+
+	return(bCollected);
+}
+
+/***********************************************************
+ *  RenderIds()
+ *
+ *  This method is used for drawing the object ids into the
+ *  picked pixel of the viewport with the current camera,
+ *  and copying the pixel into the pixel
+ *  buffer.  The copy only queues the transfer, and the
+ *  fence placed after it tells when the transfer has
+ *  finished.
+ ***********************************************************/
+bool ObjectPicker::RenderIds(RENDER_CALLBACK renderIds, const GLint* viewport, int pixelX, int pixelY)
+{
+	GLint previousFramebuffer = 0;
+	const CameraState* pCamera = CameraState::GetCurrent();
+	if (NULL == pCamera)
+	{
+		return(false);
+	}
+
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+	if (ResizeTarget(viewport[2], viewport[3]) == false)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+		return(false);
+	}
+
+	// only the picked pixel is rasterized, so the pass costs the
+	// vertex work of the objects and almost no fragment work
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glViewport(0, 0, viewport[2], viewport[3]);
+	glEnable(GL_SCISSOR_TEST);
+	glScissor(pixelX, pixelY, 1, 1);
+	const GLuint clearId[4] = { 0, 0, 0, 0 };
+	const GLfloat clearDepth = 1.0f;
+	glClearBufferuiv(GL_COLOR, 0, clearId);
+	glClearBufferfv(GL_DEPTH, 0, &clearDepth);
+
+	// the ids must be written as they are, not blended
+	GLboolean bBlend = glIsEnabled(GL_BLEND);
+	glDisable(GL_BLEND);
+
+	m_pIdShaderManager->use();
+	pCamera->Upload(m_pIdShaderManager);
+	renderIds();
+
+	glReadBuffer(GL_COLOR_ATTACHMENT0);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pixelBuffer);
+	glReadPixels(pixelX, pixelY, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT, 0);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	m_readFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	if (bBlend == GL_TRUE)
+	{
+		glEnable(GL_BLEND);
+	}
+	glDisable(GL_SCISSOR_TEST);
+	glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+	m_pSceneShaderManager->use();
+
+	return(true);
+}
+
+/***********************************************************
+ *  CollectPick()
+ *
+ *  This method is used for reading the picked id from the
+ *  pixel buffer once the fence has passed.  The fence is
+ *  polled without waiting, so an unfinished read is simply
+ *  collected on a later frame.
+ ***********************************************************/
+bool ObjectPicker::CollectPick()
+{
+	GLenum status = glClientWaitSync(m_readFence, 0, 0);
+	if (status == GL_TIMEOUT_EXPIRED)
+	{
+		return(false);
+	}
+
+	glDeleteSync(m_readFence);
+	m_readFence = 0;
+	m_pickedObject = -1;
+	if (status == GL_WAIT_FAILED)
+	{
+		LOG_ERROR("Object pick could not be read back");
+		return(true);
+	}
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pixelBuffer);
+	const GLuint* pId = (const GLuint*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, sizeof(GLuint), GL_MAP_READ_BIT);
+	if (NULL != pId)
+	{
+		m_pickedObject = (int)*pId - 1;
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	return(true);
+}
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+// objectpicker.h
+// ==============
+// find the object under a pixel by drawing object ids into an integer target
+// and reading the pixel back a frame later
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+
+#include <functional>
+
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  ObjectPicker
+ *
+ *  This class draws the scene objects into a 32 bit integer
+ *  target, writing one plus the id of the object into every
+ *  covered pixel, only on the frames when a pick has been
+ *  requested.  Only the requested pixel is rasterized, and
+ *  it is copied into a pixel buffer behind a fence instead
+ *  of being read back right away.  The pick is collected on
+ *  a later frame once the fence has passed, so picking never
+ *  waits for the GPU to finish the frame.
+ ***********************************************************/
+class ObjectPicker
+{
+public:
+	// the callback that draws the objects with SetObject
+	typedef std::function<void()> RENDER_CALLBACK;
+
+	ObjectPicker(ShaderManager* pSceneShaderManager);
+	~ObjectPicker();
+
+	// load the id shader and allocate the pixel buffer
+	bool CreatePicker();
+	// free the OpenGL memory of the picker
+	void DestroyPicker();
+
+	// ask for the object under a pixel of the framebuffer, counted
+	// from the bottom left corner - a pick that is still waiting is
+	// replaced
+	void RequestPick(int x, int y);
+	// collect a finished pick and draw the ids for a requested one
+	// - true is returned when a new pick has been collected
+	bool Update(RENDER_CALLBACK renderIds);
+	// set the model matrix and id of the next object drawn by the
+	// render callback
+	void SetObject(const glm::mat4& model, int objectId);
+
+	// the id of the last picked object, or -1 when nothing was
+	// under the pixel
+	int GetPickedObject() const { return(m_pickedObject); }
+
+	// the picker of the scene, set by the scene manager so the view
+	// manager can request picks
+	static ObjectPicker* GetScene();
+	static void SetScene(ObjectPicker* pScenePicker);
+
+private:
+	bool ResizeTarget(int viewportWidth, int viewportHeight);
+	bool RenderIds(RENDER_CALLBACK renderIds, const GLint* viewport, int pixelX, int pixelY);
+	bool CollectPick();
+
+	ShaderManager* m_pSceneShaderManager;
+	ShaderManager* m_pIdShaderManager;
+	GLuint m_framebuffer;
+	GLuint m_idBuffer;
+	GLuint m_depthBuffer;
+	GLuint m_pixelBuffer;
+	GLsync m_readFence;
+	int m_targetWidth;
+	int m_targetHeight;
+
+	bool m_bPickRequested;
+	int m_pickX;
+	int m_pickY;
+	int m_pickedObject;
+};
@@ -0,0 +1,563 @@
+///////////////////////////////////////////////////////////////////////////////
+// particlesystem.cpp
+// ==================
+// manage the snow particles swirling inside the snowglobe - simulated by a
+// compute shader when available, otherwise by a SIMD loop on the CPU
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ParticleSystem.h"
+#include "RenderOrigin.h"
+#include "CameraState.h"
+#include "Logger.h"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define PARTICLES_USE_SSE2
+#endif
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtc/type_ptr.hpp>
+
+// declaration of global variables
+namespace
+{
+	// the work group size declared in the compute shader
+	const int COMPUTE_GROUP_SIZE = 256;
+	// the longest time step simulated in one update
+	const float MAX_TIME_STEP = 1.0f / 30.0f;
+
+	/***********************************************************
+	 *  CreateComputeProgram()
+	 *
+	 *  This function is used for compiling and linking a compute
+	 *  shader program from the passed in GLSL file.
+	 ***********************************************************/
+	GLuint CreateComputeProgram(const char* computeShaderFile)
+	{
+		std::ifstream shaderFile(computeShaderFile);
+		if (!shaderFile.is_open())
+		{
+			LOG_ERROR("Could not open compute shader file:%s", computeShaderFile);
+			return(0);
+		}
+		std::stringstream shaderStream;
+		shaderStream << shaderFile.rdbuf();
+		std::string shaderCode = shaderStream.str();
+		const char* shaderSource = shaderCode.c_str();
+
+		GLint success = 0;
+		char infoLog[512];
+
+		GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+		glShaderSource(shader, 1, &shaderSource, NULL);
+		glCompileShader(shader);
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+		if (!success)
+		{
+			glGetShaderInfoLog(shader, 512, NULL, infoLog);
+			LOG_ERROR("Compute shader compilation failed:\n%s", infoLog);
+			glDeleteShader(shader);
+			return(0);
+		}
+
+		GLuint program = glCreateProgram();
+		glAttachShader(program, shader);
+		glLinkProgram(program);
+		glDeleteShader(shader);
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		if (!success)
+		{
+			glGetProgramInfoLog(program, 512, NULL, infoLog);
+			LOG_ERROR("Compute program linking failed:\n%s", infoLog);
+			glDeleteProgram(program);
+			return(0);
+		}
+
+		return(program);
+	}
+}
+
+/***********************************************************
+ *  ParticleSystem()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ParticleSystem::ParticleSystem(
+	ShaderManager* pSceneShaderManager,
+	glm::vec3 globeCenter,
+	float globeRadius,
+	int particleCount)
+{
+	m_pSceneShaderManager = pSceneShaderManager;
+	m_pRenderShaderManager = NULL;
+	m_computeProgram = 0;
+	m_positionBuffer = 0;
+	m_velocityBuffer = 0;
+	m_vertexArray = 0;
+	m_globeCenter = globeCenter;
+	m_globeRadius = globeRadius;
+	m_particleCount = particleCount;
+	m_bUseCompute = false;
+	m_lastTime = -1.0f;
+	m_simulationTime = 0.0f;
+	m_randomState = 0x9E3779B9u;
+
+	// default snow settings
+	m_settings.gravity = glm::vec3(0.0f, -0.35f, 0.0f);
+	m_settings.swirlStrength = 0.8f;
+	m_settings.drag = 1.5f;
+	m_settings.restitution = 0.2f;
+	m_settings.lifetime = 8.0f;
+	m_settings.flakeSize = 0.012f;
+}
+
+/***********************************************************
+ *  ~ParticleSystem()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ParticleSystem::~ParticleSystem()
+{
+	DestroyParticles();
+	m_pSceneShaderManager = NULL;
+}
+
+/***********************************************************
+ *  CreateParticles()
+ *
+ *  This method is used for allocating the particle buffers
+ *  and loading the simulation and rendering shaders.
+ ***********************************************************/
+bool ParticleSystem::CreateParticles(bool bForceCPU)
+{
+	GLint majorVersion = 0;
+	GLint minorVersion = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &majorVersion);
+	glGetIntegerv(GL_MINOR_VERSION, &minorVersion);
+
+	// compute shaders and storage buffers need OpenGL 4.3
+	m_bUseCompute = (bForceCPU == false) &&
+		((majorVersion > 4) || ((majorVersion == 4) && (minorVersion >= 3)));
+	if (m_bUseCompute)
+	{
+		m_computeProgram = CreateComputeProgram("shaders/snowUpdateCompute.glsl");
+		m_bUseCompute = (m_computeProgram != 0);
+	}
+
+	std::vector<glm::vec4> positions;
+	std::vector<glm::vec4> velocities;
+	SeedParticles(positions, velocities);
+
+	// the position buffer is written by the simulation and read
+	// as the vertex attribute of the point sprites
+	glGenVertexArrays(1, &m_vertexArray);
+	glGenBuffers(1, &m_positionBuffer);
+	glGenBuffers(1, &m_velocityBuffer);
+
+	glBindVertexArray(m_vertexArray);
+	glBindBuffer(GL_ARRAY_BUFFER, m_positionBuffer);
+	glBufferData(
+		GL_ARRAY_BUFFER,
+		m_particleCount * sizeof(glm::vec4),
+		positions.data(),
+		m_bUseCompute ? GL_DYNAMIC_COPY : GL_STREAM_DRAW);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), (void*)0);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	if (m_bUseCompute)
+	{
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_velocityBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, m_particleCount * sizeof(glm::vec4), velocities.data(), GL_DYNAMIC_COPY);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+	else
+	{
+		// the CPU path keeps the state in structure of arrays form,
+		// padded to whole SIMD registers
+		int paddedCount = (m_particleCount + 3) & ~3;
+		m_positionX.assign(paddedCount, 0.0f);
+		m_positionY.assign(paddedCount, 0.0f);
+		m_positionZ.assign(paddedCount, 0.0f);
+		m_velocityX.assign(paddedCount, 0.0f);
+		m_velocityY.assign(paddedCount, 0.0f);
+		m_velocityZ.assign(paddedCount, 0.0f);
+		m_life.assign(paddedCount, 0.0f);
+		for (int i = 0; i < m_particleCount; i++)
+		{
+			m_positionX[i] = positions[i].x;
+			m_positionY[i] = positions[i].y;
+			m_positionZ[i] = positions[i].z;
+			m_life[i] = positions[i].w;
+			m_velocityX[i] = velocities[i].x;
+			m_velocityY[i] = velocities[i].y;
+			m_velocityZ[i] = velocities[i].z;
+		}
+		m_uploadBuffer.resize(m_particleCount);
+	}
+
+	m_pRenderShaderManager = new ShaderManager();
+	m_pRenderShaderManager->LoadShaders(
+		"shaders/snowVertex.glsl",
+		"shaders/snowFragment.glsl");
+	m_pSceneShaderManager->use();
+
+	LOG_INFO("Snow particles: %d%s", m_particleCount, m_bUseCompute ? " (compute shader)" : " (CPU fallback)");
+
+	return(m_positionBuffer != 0);
+}
+
+/***********************************************************
+ *  DestroyParticles()
+ *
+ *  This method is used for freeing the particle memory.
+ ***********************************************************/
+void ParticleSystem::DestroyParticles()
+{
+	if (m_positionBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_positionBuffer);
+		m_positionBuffer = 0;
+	}
+	if (m_velocityBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_velocityBuffer);
+		m_velocityBuffer = 0;
+	}
+	if (m_vertexArray != 0)
+	{
+		glDeleteVertexArrays(1, &m_vertexArray);
+		m_vertexArray = 0;
+	}
+	if (m_computeProgram != 0)
+	{
+		glDeleteProgram(m_computeProgram);
+		m_computeProgram = 0;
+	}
+	if (NULL != m_pRenderShaderManager)
+	{
+		CameraState::ForgetShader(m_pRenderShaderManager);
+		delete m_pRenderShaderManager;
+		m_pRenderShaderManager = NULL;
+	}
+	m_positionX.clear();
+	m_positionY.clear();
+	m_positionZ.clear();
+	m_velocityX.clear();
+	m_velocityY.clear();
+	m_velocityZ.clear();
+	m_life.clear();
+	m_uploadBuffer.clear();
+}
+
+/***********************************************************
+ *  SetGlobe()
+ *
+ *  This method is used for moving or resizing the globe.
+ *  The particles are stored relative to the globe center,
+ *  so moving the globe carries the snow along with it.
+ ***********************************************************/
+void ParticleSystem::SetGlobe(glm::vec3 globeCenter, float globeRadius)
+{
+	m_globeCenter = globeCenter;
+	m_globeRadius = globeRadius;
+}
+
+/***********************************************************
+ *  SeedParticles()
+ *
+ *  This method is used for scattering the initial particles
+ *  through the globe with staggered lifetimes.
+ ***********************************************************/
+void ParticleSystem::SeedParticles(std::vector<glm::vec4>& positions, std::vector<glm::vec4>& velocities)
+{
+	positions.resize(m_particleCount);
+	velocities.resize(m_particleCount);
+
+	for (int i = 0; i < m_particleCount; i++)
+	{
+		glm::vec3 point;
+		do
+		{
+			// rejection sample the unit sphere with a xorshift generator
+			float coordinate[3];
+			for (int axis = 0; axis < 3; axis++)
+			{
+				m_randomState ^= m_randomState << 13;
+				m_randomState ^= m_randomState >> 17;
+				m_randomState ^= m_randomState << 5;
+				coordinate[axis] = ((float)(m_randomState & 0xFFFFFF) / (float)0xFFFFFF) * 2.0f - 1.0f;
+			}
+			point = glm::vec3(coordinate[0], coordinate[1], coordinate[2]);
+		} while (glm::dot(point, point) > 1.0f);
+
+		float life = m_settings.lifetime * (float)(i % 1024) / 1024.0f;
+		positions[i] = glm::vec4(point * (m_globeRadius * 0.9f), life);
+		velocities[i] = glm::vec4(0.0f, 0.0f, 0.0f, (float)(m_randomState & 0xFFFF));
+	}
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for advancing the simulation.  The
+ *  compute path dispatches one thread per particle and
+ *  never reads any data back.
+ ***********************************************************/
+void ParticleSystem::Update(float time)
+{
+	if (m_positionBuffer == 0)
+	{
+		return;
+	}
+
+	if (m_lastTime < 0.0f)
+	{
+		m_lastTime = time;
+	}
+	float deltaTime = glm::min(time - m_lastTime, MAX_TIME_STEP);
+	m_lastTime = time;
+	if (deltaTime <= 0.0f)
+	{
+		return;
+	}
+	m_simulationTime += deltaTime;
+
+	if (m_bUseCompute == false)
+	{
+		UpdateOnCPU(deltaTime);
+		UploadCPUPositions();
+		return;
+	}
+
+	glUseProgram(m_computeProgram);
+	glUniform1f(glGetUniformLocation(m_computeProgram, "deltaTime"), deltaTime);
+	glUniform1f(glGetUniformLocation(m_computeProgram, "time"), m_simulationTime);
+	glUniform3fv(glGetUniformLocation(m_computeProgram, "gravity"), 1, glm::value_ptr(m_settings.gravity));
+	glUniform1f(glGetUniformLocation(m_computeProgram, "swirlStrength"), m_settings.swirlStrength);
+	glUniform1f(glGetUniformLocation(m_computeProgram, "drag"), m_settings.drag);
+	glUniform1f(glGetUniformLocation(m_computeProgram, "restitution"), m_settings.restitution);
+	glUniform1f(glGetUniformLocation(m_computeProgram, "lifetime"), m_settings.lifetime);
+	glUniform1f(glGetUniformLocation(m_computeProgram, "globeRadius"), m_globeRadius);
+	glUniform1ui(glGetUniformLocation(m_computeProgram, "particleCount"), (GLuint)m_particleCount);
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_positionBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_velocityBuffer);
+	glDispatchCompute((m_particleCount + COMPUTE_GROUP_SIZE - 1) / COMPUTE_GROUP_SIZE, 1, 1);
+
+	// the positions are read as vertex attributes by the draw
+	glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+
+	m_pSceneShaderManager->use();
+}
+
+/***********************************************************
+ *  UpdateOnCPU()
+ *
+ *  This method is used for the CPU fallback simulation.  It
+ *  follows the compute shader step for step - swirl and
+ *  gravity, drag, integration and the bounce off the inside
+ *  of the globe - four particles per iteration.
+ ***********************************************************/
+void ParticleSystem::UpdateOnCPU(float deltaTime)
+{
+	const int paddedCount = (int)m_positionX.size();
+	const float radius = m_globeRadius;
+	const float damping = glm::max(0.0f, 1.0f - (m_settings.drag * deltaTime));
+	const float bounce = 1.0f + m_settings.restitution;
+	const float swirl = m_settings.swirlStrength;
+	const glm::vec3 gravity = m_settings.gravity;
+
+	float* px = m_positionX.data();
+	float* py = m_positionY.data();
+	float* pz = m_positionZ.data();
+	float* vx = m_velocityX.data();
+	float* vy = m_velocityY.data();
+	float* vz = m_velocityZ.data();
+	float* life = m_life.data();
+
+#ifdef PARTICLES_USE_SSE2
+	const __m128 dt4 = _mm_set1_ps(deltaTime);
+	const __m128 damping4 = _mm_set1_ps(damping);
+	const __m128 swirl4 = _mm_set1_ps(swirl);
+	const __m128 gravityX4 = _mm_set1_ps(gravity.x);
+	const __m128 gravityY4 = _mm_set1_ps(gravity.y);
+	const __m128 gravityZ4 = _mm_set1_ps(gravity.z);
+	const __m128 radius4 = _mm_set1_ps(radius);
+	const __m128 radiusSquared4 = _mm_set1_ps(radius * radius);
+	const __m128 bounce4 = _mm_set1_ps(bounce);
+	const __m128 zero4 = _mm_setzero_ps();
+
+	for (int i = 0; i < paddedCount; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(px + i);
+		__m128 y = _mm_loadu_ps(py + i);
+		__m128 z = _mm_loadu_ps(pz + i);
+		__m128 velX = _mm_loadu_ps(vx + i);
+		__m128 velY = _mm_loadu_ps(vy + i);
+		__m128 velZ = _mm_loadu_ps(vz + i);
+
+		// gravity plus a swirl tangent to the vertical axis
+		velX = _mm_add_ps(velX, _mm_mul_ps(_mm_sub_ps(gravityX4, _mm_mul_ps(swirl4, z)), dt4));
+		velY = _mm_add_ps(velY, _mm_mul_ps(gravityY4, dt4));
+		velZ = _mm_add_ps(velZ, _mm_mul_ps(_mm_add_ps(gravityZ4, _mm_mul_ps(swirl4, x)), dt4));
+		velX = _mm_mul_ps(velX, damping4);
+		velY = _mm_mul_ps(velY, damping4);
+		velZ = _mm_mul_ps(velZ, damping4);
+
+		x = _mm_add_ps(x, _mm_mul_ps(velX, dt4));
+		y = _mm_add_ps(y, _mm_mul_ps(velY, dt4));
+		z = _mm_add_ps(z, _mm_mul_ps(velZ, dt4));
+
+		// push escaped particles back onto the glass and reflect
+		// the part of their velocity heading outwards
+		__m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+		__m128 outside = _mm_cmpgt_ps(distanceSquared, radiusSquared4);
+		if (_mm_movemask_ps(outside) != 0)
+		{
+			__m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(distanceSquared));
+			__m128 normalX = _mm_mul_ps(x, inverseLength);
+			__m128 normalY = _mm_mul_ps(y, inverseLength);
+			__m128 normalZ = _mm_mul_ps(z, inverseLength);
+			__m128 normalSpeed = _mm_add_ps(_mm_add_ps(_mm_mul_ps(velX, normalX), _mm_mul_ps(velY, normalY)), _mm_mul_ps(velZ, normalZ));
+			__m128 impulse = _mm_and_ps(_mm_and_ps(outside, _mm_cmpgt_ps(normalSpeed, zero4)), _mm_mul_ps(normalSpeed, bounce4));
+
+			velX = _mm_sub_ps(velX, _mm_mul_ps(normalX, impulse));
+			velY = _mm_sub_ps(velY, _mm_mul_ps(normalY, impulse));
+			velZ = _mm_sub_ps(velZ, _mm_mul_ps(normalZ, impulse));
+			x = _mm_or_ps(_mm_and_ps(outside, _mm_mul_ps(normalX, radius4)), _mm_andnot_ps(outside, x));
+			y = _mm_or_ps(_mm_and_ps(outside, _mm_mul_ps(normalY, radius4)), _mm_andnot_ps(outside, y));
+			z = _mm_or_ps(_mm_and_ps(outside, _mm_mul_ps(normalZ, radius4)), _mm_andnot_ps(outside, z));
+		}
+
+		_mm_storeu_ps(px + i, x);
+		_mm_storeu_ps(py + i, y);
+		_mm_storeu_ps(pz + i, z);
+		_mm_storeu_ps(vx + i, velX);
+		_mm_storeu_ps(vy + i, velY);
+		_mm_storeu_ps(vz + i, velZ);
+		_mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), dt4));
+	}
+#else
+	for (int i = 0; i < paddedCount; i++)
+	{
+		vx[i] = (vx[i] + ((gravity.x - (swirl * pz[i])) * deltaTime)) * damping;
+		vy[i] = (vy[i] + (gravity.y * deltaTime)) * damping;
+		vz[i] = (vz[i] + ((gravity.z + (swirl * px[i])) * deltaTime)) * damping;
+
+		px[i] += vx[i] * deltaTime;
+		py[i] += vy[i] * deltaTime;
+		pz[i] += vz[i] * deltaTime;
+
+		float distanceSquared = (px[i] * px[i]) + (py[i] * py[i]) + (pz[i] * pz[i]);
+		if (distanceSquared > (radius * radius))
+		{
+			float inverseLength = 1.0f / sqrt(distanceSquared);
+			float normalX = px[i] * inverseLength;
+			float normalY = py[i] * inverseLength;
+			float normalZ = pz[i] * inverseLength;
+			float normalSpeed = (vx[i] * normalX) + (vy[i] * normalY) + (vz[i] * normalZ);
+			if (normalSpeed > 0.0f)
+			{
+				vx[i] -= normalX * normalSpeed * bounce;
+				vy[i] -= normalY * normalSpeed * bounce;
+				vz[i] -= normalZ * normalSpeed * bounce;
+			}
+			px[i] = normalX * radius;
+			py[i] = normalY * radius;
+			pz[i] = normalZ * radius;
+		}
+
+		life[i] -= deltaTime;
+	}
+#endif
+
+	// flakes at the end of their life are blown back up into the
+	// top of the globe - rare enough to be handled one at a time
+	for (int i = 0; i < m_particleCount; i++)
+	{
+		if (life[i] > 0.0f)
+		{
+			continue;
+		}
+
+		m_randomState ^= m_randomState << 13;
+		m_randomState ^= m_randomState >> 17;
+		m_randomState ^= m_randomState << 5;
+		float angle = (float)(m_randomState & 0xFFFF) / 65535.0f * 6.2831853f;
+		float spread = (float)((m_randomState >> 16) & 0xFFFF) / 65535.0f * 0.6f * radius;
+
+		px[i] = spread * cos(angle);
+		py[i] = radius * 0.6f;
+		pz[i] = spread * sin(angle);
+		vx[i] = 0.0f;
+		vy[i] = 0.0f;
+		vz[i] = 0.0f;
+		life[i] += m_settings.lifetime;
+	}
+}
+
+/***********************************************************
+ *  UploadCPUPositions()
+ *
+ *  This method is used for interleaving the CPU positions
+ *  and streaming them into the point sprite buffer.
+ ***********************************************************/
+void ParticleSystem::UploadCPUPositions()
+{
+	for (int i = 0; i < m_particleCount; i++)
+	{
+		m_uploadBuffer[i] = glm::vec4(m_positionX[i], m_positionY[i], m_positionZ[i], m_life[i]);
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_positionBuffer);
+	// orphan the previous contents so the upload never waits on
+	// the draw of the last frame
+	glBufferData(GL_ARRAY_BUFFER, m_particleCount * sizeof(glm::vec4), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, m_particleCount * sizeof(glm::vec4), m_uploadBuffer.data());
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/***********************************************************
+ *  Render()
+ *
+ *  This method is used for drawing the particles as point
+ *  sprites with the current camera.
+ ***********************************************************/
+void ParticleSystem::Render()
+{
+	const CameraState* pCamera = CameraState::GetCurrent();
+	if ((m_positionBuffer == 0) || (NULL == m_pRenderShaderManager) || (NULL == pCamera))
+	{
+		return;
+	}
+
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+
+	m_pRenderShaderManager->use();
+	pCamera->Upload(m_pRenderShaderManager);
+	m_pRenderShaderManager->setVec3Value("globeCenter", RenderOrigin::ToRender(glm::dvec3(m_globeCenter)));
+	m_pRenderShaderManager->setFloatValue("flakeSize", m_settings.flakeSize);
+	m_pRenderShaderManager->setFloatValue("viewportHeight", (float)viewport[3]);
+
+	// the flakes are blended, so they test against the depth
+	// buffer but do not write into it
+	glEnable(GL_PROGRAM_POINT_SIZE);
+	glDepthMask(GL_FALSE);
+	glBindVertexArray(m_vertexArray);
+	glDrawArrays(GL_POINTS, 0, m_particleCount);
+	glBindVertexArray(0);
+	glDepthMask(GL_TRUE);
+	glDisable(GL_PROGRAM_POINT_SIZE);
+
+	m_pSceneShaderManager->use();
+}
@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////
+// particlesystem.h
+// ================
+// manage the snow particles swirling inside the snowglobe - simulated by a
+// compute shader when available, otherwise by a SIMD loop on the CPU
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  ParticleSystem
+ *
+ *  This class simulates snow particles inside a sphere.  On
+ *  OpenGL 4.3 and newer the particle state lives in shader
+ *  storage buffers and is updated by a compute shader, and
+ *  the same buffer is drawn as point sprites - the particle
+ *  data never leaves the GPU.  Otherwise the particles are
+ *  updated on the CPU in structure of arrays form, four at
+ *  a time with SIMD, and only the positions are uploaded.
+ ***********************************************************/
+class ParticleSystem
+{
+public:
+	// the simulation settings of the snow
+	struct PARTICLE_SETTINGS
+	{
+		glm::vec3 gravity;
+		// angular speed of the swirl around the vertical axis
+		float swirlStrength;
+		// fraction of the velocity lost every second
+		float drag;
+		// fraction of the normal velocity kept after bouncing
+		float restitution;
+		// seconds a flake lives before it is blown back up
+		float lifetime;
+		// world space size of a rendered flake
+		float flakeSize;
+	};
+
+	ParticleSystem(
+		ShaderManager* pSceneShaderManager,
+		glm::vec3 globeCenter,
+		float globeRadius,
+		int particleCount);
+	~ParticleSystem();
+
+	// allocate the buffers and shaders - the compute path is used
+	// unless bForceCPU is set or the context does not support it
+	bool CreateParticles(bool bForceCPU = false);
+	void DestroyParticles();
+
+	// advance the simulation to the passed in time in seconds
+	void Update(float time);
+	// draw the particles with the current scene camera
+	void Render();
+
+	void SetSettings(const PARTICLE_SETTINGS& settings) { m_settings = settings; }
+	const PARTICLE_SETTINGS& GetSettings() const { return(m_settings); }
+	void SetGlobe(glm::vec3 globeCenter, float globeRadius);
+
+	bool IsUsingComputeShader() const { return(m_bUseCompute); }
+	int GetParticleCount() const { return(m_particleCount); }
+
+private:
+	void SeedParticles(std::vector<glm::vec4>& positions, std::vector<glm::vec4>& velocities);
+	void UpdateOnCPU(float deltaTime);
+	void UploadCPUPositions();
+
+	ShaderManager* m_pSceneShaderManager;
+	ShaderManager* m_pRenderShaderManager;
+	GLuint m_computeProgram;
+	// xyz position and remaining life in w
+	GLuint m_positionBuffer;
+	// xyz velocity and random seed in w
+	GLuint m_velocityBuffer;
+	GLuint m_vertexArray;
+
+	glm::vec3 m_globeCenter;
+	float m_globeRadius;
+	int m_particleCount;
+	PARTICLE_SETTINGS m_settings;
+	bool m_bUseCompute;
+	float m_lastTime;
+	float m_simulationTime;
+
+	// the CPU fallback state in structure of arrays form, with
+	// positions relative to the globe center
+	std::vector<float> m_positionX;
+	std::vector<float> m_positionY;
+	std::vector<float> m_positionZ;
+	std::vector<float> m_velocityX;
+	std::vector<float> m_velocityY;
+	std::vector<float> m_velocityZ;
+	std::vector<float> m_life;
+	std::vector<glm::vec4> m_uploadBuffer;
+	unsigned int m_randomState;
+};
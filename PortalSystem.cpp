@@ -0,0 +1,509 @@
+///////////////////////////////////////////////////////////////////////////////
+// portalsystem.cpp
+// ================
+// find the cells of an indoor scene that the camera can see by clipping the
+// view frustum through the portals that connect the cells
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PortalSystem.h"
+#include "PotentiallyVisibleSet.h"
+
+#include <cmath>
+
+// declaration of global variables
+namespace
+{
+	// the camera is treated as standing in a portal when it is
+	// closer to the portal plane than this, which is more than
+	// the distance to the near plane
+	const float PORTAL_PLANE_EPSILON = 0.5f;
+	// the portals are clipped this far inside the frustum planes, so
+	// that a portal lying in the plane of the portal it is seen
+	// through is clipped away
+	const float PORTAL_CLIP_EPSILON = 0.001f;
+
+	/***********************************************************
+	 *  PointInBox()
+	 *
+	 *  This function is used for testing whether a point is
+	 *  inside a box.
+	 ***********************************************************/
+	inline bool PointInBox(glm::vec3 point, glm::vec3 boundsMin, glm::vec3 boundsMax)
+	{
+		return((point.x >= boundsMin.x) && (point.x <= boundsMax.x) &&
+			(point.y >= boundsMin.y) && (point.y <= boundsMax.y) &&
+			(point.z >= boundsMin.z) && (point.z <= boundsMax.z));
+	}
+
+	/***********************************************************
+	 *  PointOverPolygon()
+	 *
+	 *  This function is used for testing whether a point lies
+	 *  over a convex polygon when seen along the normal of the
+	 *  polygon plane.
+	 ***********************************************************/
+	bool PointOverPolygon(glm::vec3 point, const glm::vec3* pVertices, int vertexCount, glm::vec3 normal)
+	{
+		float firstSide = 0.0f;
+		for (int v = 0; v < vertexCount; v++)
+		{
+			const glm::vec3& current = pVertices[v];
+			const glm::vec3& next = pVertices[(v + 1) % vertexCount];
+			float side = glm::dot(glm::cross(next - current, point - current), normal);
+			if (side * firstSide < 0.0f)
+			{
+				return(false);
+			}
+			if (firstSide == 0.0f)
+			{
+				firstSide = side;
+			}
+		}
+
+		return(true);
+	}
+}
+
+/***********************************************************
+ *  PortalSystem()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+PortalSystem::PortalSystem()
+{
+	m_exteriorCell = -1;
+	for (int view = 0; view < MAX_VIEWS; view++)
+	{
+		m_views[view].state.cameraPosition = glm::vec3(0.0f);
+		m_views[view].state.portalTestCount = 0;
+		m_views[view].lastCameraCell = -1;
+	}
+}
+
+/***********************************************************
+ *  AddCell()
+ *
+ *  This method is used for adding a box shaped cell.
+ ***********************************************************/
+int PortalSystem::AddCell(glm::vec3 boundsMin, glm::vec3 boundsMax)
+{
+	PORTAL_CELL cell;
+	cell.boundsMin = boundsMin;
+	cell.boundsMax = boundsMax;
+	cell.bExterior = false;
+
+	m_cells.push_back(cell);
+	for (int view = 0; view < MAX_VIEWS; view++)
+	{
+		m_views[view].state.cellVisible.push_back(0);
+		m_views[view].state.cellOnPath.push_back(0);
+	}
+
+	return((int)m_cells.size() - 1);
+}
+
+/***********************************************************
+ *  AddExteriorCell()
+ *
+ *  This method is used for adding the cell that holds the
+ *  space around the boxes - only one can be added.
+ ***********************************************************/
+int PortalSystem::AddExteriorCell()
+{
+	if (m_exteriorCell < 0)
+	{
+		m_exteriorCell = AddCell(glm::vec3(0.0f), glm::vec3(0.0f));
+		m_cells[m_exteriorCell].bExterior = true;
+	}
+
+	return(m_exteriorCell);
+}
+
+/***********************************************************
+ *  AddPortalDirection()
+ *
+ *  This method is used for adding the portal that leads
+ *  from one cell into another.
+ ***********************************************************/
+void PortalSystem::AddPortalDirection(int fromCell, int toCell, const std::vector<glm::vec3>& polygon)
+{
+	PORTAL portal;
+	portal.targetCell = toCell;
+	portal.firstVertex = (int)m_portalVertices.size();
+	portal.vertexCount = (int)polygon.size();
+	portal.plane.normal = glm::normalize(glm::cross(polygon[1] - polygon[0], polygon[2] - polygon[0]));
+	portal.plane.distance = -glm::dot(portal.plane.normal, polygon[0]);
+
+	m_portalVertices.insert(m_portalVertices.end(), polygon.begin(), polygon.end());
+	m_cells[fromCell].portals.push_back((int)m_portals.size());
+	m_portals.push_back(portal);
+}
+
+/***********************************************************
+ *  AddPortal()
+ *
+ *  This method is used for connecting two cells through a
+ *  convex polygon.  The portal can be seen through from
+ *  both of the cells.
+ ***********************************************************/
+void PortalSystem::AddPortal(int cellA, int cellB, const std::vector<glm::vec3>& polygon)
+{
+	if ((cellA < 0) || (cellA >= (int)m_cells.size()) ||
+		(cellB < 0) || (cellB >= (int)m_cells.size()) ||
+		(cellA == cellB) || (polygon.size() < 3))
+	{
+		return;
+	}
+
+	AddPortalDirection(cellA, cellB, polygon);
+	AddPortalDirection(cellB, cellA, polygon);
+}
+
+/***********************************************************
+ *  GetLayoutHash()
+ *
+ *  This method is used for hashing the layout with FNV-1a,
+ *  so a visible set baked for another layout is noticed
+ *  even when it has the same number of cells and portals.
+ ***********************************************************/
+uint64_t PortalSystem::GetLayoutHash() const
+{
+	uint64_t hash = 0xCBF29CE484222325ull;
+	auto addBytes = [&hash](const void* pData, size_t byteCount)
+	{
+		const uint8_t* pBytes = (const uint8_t*)pData;
+		for (size_t i = 0; i < byteCount; i++)
+		{
+			hash = (hash ^ pBytes[i]) * 0x100000001B3ull;
+		}
+	};
+
+	for (size_t cell = 0; cell < m_cells.size(); cell++)
+	{
+		uint8_t bExterior = m_cells[cell].bExterior ? 1 : 0;
+		addBytes(&m_cells[cell].boundsMin[0], 3 * sizeof(float));
+		addBytes(&m_cells[cell].boundsMax[0], 3 * sizeof(float));
+		addBytes(&bExterior, 1);
+		for (size_t p = 0; p < m_cells[cell].portals.size(); p++)
+		{
+			const PORTAL& portal = m_portals[m_cells[cell].portals[p]];
+			addBytes(&portal.targetCell, sizeof(int));
+			addBytes(&m_portalVertices[portal.firstVertex][0], portal.vertexCount * 3 * sizeof(float));
+		}
+	}
+
+	return(hash);
+}
+
+/***********************************************************
+ *  FindCell()
+ *
+ *  This method is used for finding the cell that holds the
+ *  passed in position.  The camera moves little between
+ *  frames, so the previous camera cell of the view is
+ *  tested first.
+ ***********************************************************/
+int PortalSystem::FindCell(glm::vec3 position, int view) const
+{
+	int lastCell = m_views[view].lastCameraCell;
+	if ((lastCell >= 0) && (m_cells[lastCell].bExterior == false) &&
+		PointInBox(position, m_cells[lastCell].boundsMin, m_cells[lastCell].boundsMax))
+	{
+		return(lastCell);
+	}
+
+	for (int cell = 0; cell < (int)m_cells.size(); cell++)
+	{
+		if ((m_cells[cell].bExterior == false) &&
+			PointInBox(position, m_cells[cell].boundsMin, m_cells[cell].boundsMax))
+		{
+			return(cell);
+		}
+	}
+
+	return(m_exteriorCell);
+}
+
+/***********************************************************
+ *  VisitCell()
+ *
+ *  This method is used for marking a cell visible and then
+ *  following each of its portals that is seen through the
+ *  passed in frustum.
+ ***********************************************************/
+void PortalSystem::VisitCell(VISIBILITY_STATE& state, int cell, const std::vector<FRUSTUM_PLANE>& frustum, int depth) const
+{
+	if (state.cellVisible[cell] == 0)
+	{
+		state.cellVisible[cell] = 1;
+		state.visibleCells.push_back(cell);
+	}
+	if (depth >= MAX_PORTAL_DEPTH)
+	{
+		return;
+	}
+
+	state.cellOnPath[cell] = 1;
+
+	std::vector<glm::vec3> polygon;
+	std::vector<glm::vec3> clipped;
+	const std::vector<int>& portals = m_cells[cell].portals;
+	for (size_t p = 0; p < portals.size(); p++)
+	{
+		const PORTAL& portal = m_portals[portals[p]];
+
+		// a cell is never seen through itself
+		if (state.cellOnPath[portal.targetCell] != 0)
+		{
+			continue;
+		}
+		state.portalTestCount++;
+
+		// standing in the portal, the frustum does not get smaller -
+		// the near plane would otherwise clip the whole portal away
+		float cameraSide = glm::dot(portal.plane.normal, state.cameraPosition) + portal.plane.distance;
+		if ((fabsf(cameraSide) < PORTAL_PLANE_EPSILON) &&
+			PointOverPolygon(state.cameraPosition, &m_portalVertices[portal.firstVertex], portal.vertexCount, portal.plane.normal))
+		{
+			VisitCell(state, portal.targetCell, frustum, depth + 1);
+			continue;
+		}
+
+		// clip the portal polygon to the frustum
+		polygon.assign(
+			m_portalVertices.begin() + portal.firstVertex,
+			m_portalVertices.begin() + portal.firstVertex + portal.vertexCount);
+		for (size_t f = 0; (f < frustum.size()) && (polygon.size() >= 3); f++)
+		{
+			clipped.clear();
+			for (size_t v = 0; v < polygon.size(); v++)
+			{
+				const glm::vec3& current = polygon[v];
+				const glm::vec3& next = polygon[(v + 1) % polygon.size()];
+				float currentSide = glm::dot(frustum[f].normal, current) + frustum[f].distance - PORTAL_CLIP_EPSILON;
+				float nextSide = glm::dot(frustum[f].normal, next) + frustum[f].distance - PORTAL_CLIP_EPSILON;
+
+				if (currentSide >= 0.0f)
+				{
+					clipped.push_back(current);
+				}
+				if ((currentSide >= 0.0f) != (nextSide >= 0.0f))
+				{
+					clipped.push_back(current + (next - current) * (currentSide / (currentSide - nextSide)));
+				}
+			}
+			polygon.swap(clipped);
+		}
+		if (polygon.size() < 3)
+		{
+			continue;
+		}
+
+		// the planes through the camera and the edges of the clipped
+		// polygon, facing the middle of the polygon
+		glm::vec3 centroid = glm::vec3(0.0f);
+		for (size_t v = 0; v < polygon.size(); v++)
+		{
+			centroid = centroid + polygon[v];
+		}
+		centroid = centroid * (1.0f / (float)polygon.size());
+
+		std::vector<FRUSTUM_PLANE> portalFrustum;
+		portalFrustum.reserve(polygon.size() + 1);
+		for (size_t v = 0; v < polygon.size(); v++)
+		{
+			glm::vec3 normal = glm::cross(polygon[v] - state.cameraPosition, polygon[(v + 1) % polygon.size()] - state.cameraPosition);
+			float length = glm::length(normal);
+			if (length < 1e-6f)
+			{
+				continue;
+			}
+
+			FRUSTUM_PLANE plane;
+			plane.normal = normal * (1.0f / length);
+			plane.distance = -glm::dot(plane.normal, state.cameraPosition);
+			if (glm::dot(plane.normal, centroid) + plane.distance < 0.0f)
+			{
+				plane.normal = -plane.normal;
+				plane.distance = -plane.distance;
+			}
+			portalFrustum.push_back(plane);
+		}
+
+		// only what is behind the portal can be seen through it
+		FRUSTUM_PLANE portalPlane = portal.plane;
+		if (cameraSide > 0.0f)
+		{
+			portalPlane.normal = -portalPlane.normal;
+			portalPlane.distance = -portalPlane.distance;
+		}
+		portalFrustum.push_back(portalPlane);
+
+		VisitCell(state, portal.targetCell, portalFrustum, depth + 1);
+	}
+
+	state.cellOnPath[cell] = 0;
+}
+
+/***********************************************************
+ *  MarkAllCellsVisible()
+ *
+ *  This method is used for treating every cell as visible,
+ *  when the camera is in no cell.
+ ***********************************************************/
+void PortalSystem::MarkAllCellsVisible(VISIBILITY_STATE& state) const
+{
+	for (int cell = 0; cell < (int)m_cells.size(); cell++)
+	{
+		state.cellVisible[cell] = 1;
+		state.visibleCells.push_back(cell);
+	}
+}
+
+/***********************************************************
+ *  BeginVisibility()
+ *
+ *  This method is used for clearing the last visibility
+ *  update of a view, finding the camera cell and extracting
+ *  the side and near planes of the view frustum from the
+ *  rows of the view projection matrix.
+ ***********************************************************/
+int PortalSystem::BeginVisibility(int view, glm::vec3 cameraPosition, const glm::mat4& viewProjection)
+{
+	VIEW_STATE& viewState = m_views[view];
+	VISIBILITY_STATE& state = viewState.state;
+	for (size_t i = 0; i < state.visibleCells.size(); i++)
+	{
+		state.cellVisible[state.visibleCells[i]] = 0;
+	}
+	state.visibleCells.clear();
+	state.portalTestCount = 0;
+	state.cameraPosition = cameraPosition;
+
+	int cameraCell = FindCell(cameraPosition, view);
+	viewState.lastCameraCell = cameraCell;
+
+	viewState.frustum.clear();
+	for (int axis = 0; axis < 3; axis++)
+	{
+		for (int sign = 0; sign < 2; sign++)
+		{
+			// the far plane is left out, the rooms are small
+			if ((axis == 2) && (sign == 1))
+			{
+				continue;
+			}
+
+			float direction = (sign == 0) ? 1.0f : -1.0f;
+			glm::vec4 row = glm::vec4(
+				viewProjection[0][3] + direction * viewProjection[0][axis],
+				viewProjection[1][3] + direction * viewProjection[1][axis],
+				viewProjection[2][3] + direction * viewProjection[2][axis],
+				viewProjection[3][3] + direction * viewProjection[3][axis]);
+			float length = glm::length(glm::vec3(row));
+
+			FRUSTUM_PLANE plane;
+			plane.normal = glm::vec3(row) * (1.0f / length);
+			plane.distance = row.w / length;
+			viewState.frustum.push_back(plane);
+		}
+	}
+
+	return(cameraCell);
+}
+
+/***********************************************************
+ *  UpdateVisibility()
+ *
+ *  This method is used for finding the cells seen by the
+ *  camera of a view with the passed in view and projection.
+ ***********************************************************/
+int PortalSystem::UpdateVisibility(glm::vec3 cameraPosition, const glm::mat4& viewProjection, int view)
+{
+	VIEW_STATE& viewState = m_views[view];
+	int cameraCell = BeginVisibility(view, cameraPosition, viewProjection);
+	if (cameraCell < 0)
+	{
+		MarkAllCellsVisible(viewState.state);
+		return((int)viewState.state.visibleCells.size());
+	}
+
+	VisitCell(viewState.state, cameraCell, viewState.frustum, 0);
+
+	return((int)viewState.state.visibleCells.size());
+}
+
+/***********************************************************
+ *  UpdateVisibility()
+ *
+ *  This method is used for finding the cells seen by the
+ *  camera from the baked set of the camera cell.  Only the
+ *  cells in the set are tested against the view frustum,
+ *  so the cost does not grow with the number of portals.
+ ***********************************************************/
+int PortalSystem::UpdateVisibility(glm::vec3 cameraPosition, const glm::mat4& viewProjection, PotentiallyVisibleSet& visibleSet, int view)
+{
+	VIEW_STATE& viewState = m_views[view];
+	const std::vector<FRUSTUM_PLANE>& frustum = viewState.frustum;
+	int cameraCell = BeginVisibility(view, cameraPosition, viewProjection);
+	if ((cameraCell < 0) || (visibleSet.GetCellCount() != (int)m_cells.size()))
+	{
+		MarkAllCellsVisible(viewState.state);
+		return((int)viewState.state.visibleCells.size());
+	}
+
+	const std::vector<int>& candidates = visibleSet.GetVisibleCells(cameraCell, view);
+	for (size_t i = 0; i < candidates.size(); i++)
+	{
+		const PORTAL_CELL& cell = m_cells[candidates[i]];
+
+		// a box is outside when its corner farthest along the plane
+		// normal is outside the plane
+		bool bInside = true;
+		for (size_t f = 0; (f < frustum.size()) && (cell.bExterior == false); f++)
+		{
+			glm::vec3 corner = glm::vec3(
+				(frustum[f].normal.x >= 0.0f) ? cell.boundsMax.x : cell.boundsMin.x,
+				(frustum[f].normal.y >= 0.0f) ? cell.boundsMax.y : cell.boundsMin.y,
+				(frustum[f].normal.z >= 0.0f) ? cell.boundsMax.z : cell.boundsMin.z);
+			if (glm::dot(frustum[f].normal, corner) + frustum[f].distance < 0.0f)
+			{
+				bInside = false;
+				break;
+			}
+		}
+
+		if (bInside || (candidates[i] == cameraCell))
+		{
+			viewState.state.cellVisible[candidates[i]] = 1;
+			viewState.state.visibleCells.push_back(candidates[i]);
+		}
+	}
+
+	return((int)viewState.state.visibleCells.size());
+}
+
+/***********************************************************
+ *  AddCellsSeenFrom()
+ *
+ *  This method is used for following the portals from a
+ *  point without a view frustum, so the cells seen in any
+ *  direction from the point are found.  The search state
+ *  is kept on the stack of the calling thread.
+ ***********************************************************/
+void PortalSystem::AddCellsSeenFrom(int cell, glm::vec3 position, std::vector<uint8_t>& cellsSeen) const
+{
+	VISIBILITY_STATE state;
+	state.cameraPosition = position;
+	state.cellVisible.swap(cellsSeen);
+	state.cellVisible.resize(m_cells.size(), 0);
+	state.cellOnPath.assign(m_cells.size(), 0);
+	state.portalTestCount = 0;
+
+	VisitCell(state, cell, std::vector<FRUSTUM_PLANE>(), 0);
+
+	cellsSeen.swap(state.cellVisible);
+}
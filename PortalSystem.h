@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////
+// portalsystem.h
+// ==============
+// find the cells of an indoor scene that the camera can see by clipping the
+// view frustum through the portals that connect the cells
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class PotentiallyVisibleSet;
+
+/***********************************************************
+ *  PortalSystem
+ *
+ *  This class keeps the cells of the scene as boxes, and
+ *  the openings between them as convex portal polygons.
+ *  Every frame the cell holding the camera is visible, and
+ *  each of its portals inside the view frustum is clipped
+ *  to the frustum - the clipped polygon and the camera make
+ *  a smaller frustum that the cell behind the portal is
+ *  seen through, and the search continues from there.  An
+ *  exterior cell can hold everything outside the boxes.
+ *  With a baked potentially visible set the search is
+ *  replaced by a frustum test of the cells in the set.
+ *  Every view keeps its own visibility state, so the views
+ *  can be updated at the same time from several threads.
+ ***********************************************************/
+class PortalSystem
+{
+public:
+	PortalSystem();
+
+	// add a cell and return its index
+	int AddCell(glm::vec3 boundsMin, glm::vec3 boundsMax);
+	// add the cell holding every point that is in no other cell
+	int AddExteriorCell();
+	// connect two cells through a convex polygon - the vertices
+	// go around the edge of the polygon in either direction
+	void AddPortal(int cellA, int cellB, const std::vector<glm::vec3>& polygon);
+
+	// the cell holding the passed in position, or -1 - the last
+	// camera cell of the view is tested first
+	int FindCell(glm::vec3 position, int view = 0) const;
+
+	// find the visible cells of a view and return their number -
+	// when the camera is in no cell every cell is treated as visible
+	int UpdateVisibility(glm::vec3 cameraPosition, const glm::mat4& viewProjection, int view = 0);
+	// find the visible cells among the baked set of the camera cell
+	int UpdateVisibility(glm::vec3 cameraPosition, const glm::mat4& viewProjection, PotentiallyVisibleSet& visibleSet, int view = 0);
+	bool IsCellVisible(int cell, int view = 0) const { return(m_views[view].state.cellVisible[cell] != 0); }
+	const std::vector<int>& GetVisibleCells(int view = 0) const { return(m_views[view].state.visibleCells); }
+
+	int GetCellCount() const { return((int)m_cells.size()); }
+	int GetPortalCount() const { return((int)m_portals.size()); }
+	bool IsExteriorCell(int cell) const { return(m_cells[cell].bExterior); }
+	glm::vec3 GetCellMinimum(int cell) const { return(m_cells[cell].boundsMin); }
+	glm::vec3 GetCellMaximum(int cell) const { return(m_cells[cell].boundsMax); }
+	// a hash of the cell boxes and the portal polygons, which differs
+	// for grids of other sizes, room boxes or doorways
+	uint64_t GetLayoutHash() const;
+	// set the flag of every cell seen in any direction from a point
+	// in the passed in cell - it can be called from several threads
+	void AddCellsSeenFrom(int cell, glm::vec3 position, std::vector<uint8_t>& cellsSeen) const;
+	// the number of portals clipped by the last update of a view
+	int GetPortalTestCount(int view = 0) const { return(m_views[view].state.portalTestCount); }
+
+	// the most portals followed from the camera cell
+	static const int MAX_PORTAL_DEPTH = 32;
+	// the most views with their own visibility
+	static const int MAX_VIEWS = 8;
+
+private:
+	// the inside of a plane is where dot(normal, p) + distance >= 0
+	struct FRUSTUM_PLANE
+	{
+		glm::vec3 normal;
+		float distance;
+	};
+
+	struct PORTAL
+	{
+		int targetCell;
+		int firstVertex;
+		int vertexCount;
+		FRUSTUM_PLANE plane;
+	};
+
+	struct PORTAL_CELL
+	{
+		glm::vec3 boundsMin;
+		glm::vec3 boundsMax;
+		bool bExterior;
+		std::vector<int> portals;
+	};
+
+	// the cells found from one camera position
+	struct VISIBILITY_STATE
+	{
+		glm::vec3 cameraPosition;
+		std::vector<uint8_t> cellVisible;
+		std::vector<uint8_t> cellOnPath;
+		std::vector<int> visibleCells;
+		int portalTestCount;
+	};
+
+	// the visibility of one view, and the frustum and camera cell
+	// it was found with
+	struct VIEW_STATE
+	{
+		VISIBILITY_STATE state;
+		std::vector<FRUSTUM_PLANE> frustum;
+		int lastCameraCell;
+	};
+
+	void VisitCell(VISIBILITY_STATE& state, int cell, const std::vector<FRUSTUM_PLANE>& frustum, int depth) const;
+	int BeginVisibility(int view, glm::vec3 cameraPosition, const glm::mat4& viewProjection);
+	void MarkAllCellsVisible(VISIBILITY_STATE& state) const;
+	void AddPortalDirection(int fromCell, int toCell, const std::vector<glm::vec3>& polygon);
+
+	std::vector<PORTAL_CELL> m_cells;
+	std::vector<PORTAL> m_portals;
+	std::vector<glm::vec3> m_portalVertices;
+	int m_exteriorCell;
+
+	// the state of the last visibility update of each view
+	VIEW_STATE m_views[MAX_VIEWS];
+};
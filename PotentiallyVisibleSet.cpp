@@ -0,0 +1,402 @@
+///////////////////////////////////////////////////////////////////////////////
+// potentiallyvisibleset.cpp
+// =========================
+// bake the cells that can be seen from every cell of a static portal layout
+// and keep them as compressed bitsets
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PotentiallyVisibleSet.h"
+#include "PortalSystem.h"
+#include "ThreadPool.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <fstream>
+
+// declaration of global variables
+namespace
+{
+	// marks the start of a baked file, and changes with the layout
+	// of the file
+	const uint32_t PVS_FILE_MAGIC = 0x32535650;
+	// the cells baked by one job of the thread pool
+	const int CELLS_PER_JOB = 16;
+	// keeps the sampled points off the walls of the cell
+	const float SAMPLE_MARGIN = 0.01f;
+
+	/***********************************************************
+	 *  RandomUnit()
+	 *
+	 *  This function is used for stepping a splitmix64
+	 *  generator and returning a number in [0, 1).
+	 ***********************************************************/
+	inline float RandomUnit(uint64_t& state)
+	{
+		state += 0x9E3779B97F4A7C15ull;
+		uint64_t value = state;
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+		value = value ^ (value >> 31);
+
+		return((float)(value >> 40) * (1.0f / 16777216.0f));
+	}
+}
+
+/***********************************************************
+ *  PotentiallyVisibleSet()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+PotentiallyVisibleSet::PotentiallyVisibleSet()
+{
+	m_cellCount = 0;
+	m_portalCount = 0;
+	m_layoutHash = 0;
+	ClearExpandedSets();
+}
+
+/***********************************************************
+ *  ClearExpandedSets()
+ *
+ *  This method is used for forgetting the expanded sets of
+ *  the views after the sets were baked or loaded.
+ ***********************************************************/
+void PotentiallyVisibleSet::ClearExpandedSets()
+{
+	for (int view = 0; view < PortalSystem::MAX_VIEWS; view++)
+	{
+		m_expandedSets[view].cell = -1;
+		m_expandedSets[view].cells.clear();
+	}
+}
+
+/***********************************************************
+ *  CompressSet()
+ *
+ *  This method is used for packing the flags of the cells
+ *  into a bitset and compressing the bitset.  Each zero
+ *  byte is followed by the number of zero bytes in its run,
+ *  and other bytes are kept as they are - most cells see
+ *  only a few others, so the sets are mostly zero.
+ ***********************************************************/
+void PotentiallyVisibleSet::CompressSet(const std::vector<uint8_t>& cellFlags, std::vector<uint8_t>& compressed)
+{
+	int byteCount = ((int)cellFlags.size() + 7) / 8;
+	int zeroRun = 0;
+
+	for (int byteIndex = 0; byteIndex < byteCount; byteIndex++)
+	{
+		uint8_t bits = 0;
+		for (int bit = 0; (bit < 8) && (byteIndex * 8 + bit < (int)cellFlags.size()); bit++)
+		{
+			if (cellFlags[byteIndex * 8 + bit] != 0)
+			{
+				bits |= (uint8_t)(1 << bit);
+			}
+		}
+
+		if (bits == 0)
+		{
+			zeroRun++;
+			if (zeroRun == 255)
+			{
+				compressed.push_back(0);
+				compressed.push_back(255);
+				zeroRun = 0;
+			}
+			continue;
+		}
+
+		if (zeroRun > 0)
+		{
+			compressed.push_back(0);
+			compressed.push_back((uint8_t)zeroRun);
+			zeroRun = 0;
+		}
+		compressed.push_back(bits);
+	}
+
+	if (zeroRun > 0)
+	{
+		compressed.push_back(0);
+		compressed.push_back((uint8_t)zeroRun);
+	}
+}
+
+/***********************************************************
+ *  IsSetValid()
+ *
+ *  This method is used for checking that a compressed set
+ *  read from a file decodes within its bytes, and sets no
+ *  bits past the last cell.
+ ***********************************************************/
+bool PotentiallyVisibleSet::IsSetValid(const uint8_t* pSet, size_t byteCount, int cellCount)
+{
+	int bitsetBytes = (cellCount + 7) / 8;
+	int byteIndex = 0;
+
+	for (size_t i = 0; i < byteCount; i++)
+	{
+		if (pSet[i] == 0)
+		{
+			i++;
+			if (i >= byteCount)
+			{
+				return(false);
+			}
+			byteIndex += pSet[i];
+		}
+		else
+		{
+			if ((byteIndex == bitsetBytes - 1) && ((cellCount % 8) != 0) &&
+				((pSet[i] >> (cellCount % 8)) != 0))
+			{
+				return(false);
+			}
+			byteIndex++;
+		}
+
+		if (byteIndex > bitsetBytes)
+		{
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  Bake()
+ *
+ *  This method is used for baking the sets of every cell
+ *  of the passed in portal system.  The exterior cell can
+ *  see every cell, since it has no box to cast rays from.
+ ***********************************************************/
+bool PotentiallyVisibleSet::Bake(const PortalSystem& portals, int samplesPerCell, uint32_t seed)
+{
+	int cellCount = portals.GetCellCount();
+	if ((cellCount <= 0) || (samplesPerCell <= 0))
+	{
+		return(false);
+	}
+
+	std::vector<std::vector<uint8_t>> cellSets(cellCount);
+	auto bakeCells = [&portals, &cellSets, cellCount, samplesPerCell, seed](int firstCell, int lastCell)
+	{
+		std::vector<uint8_t> cellFlags(cellCount);
+
+		for (int cell = firstCell; cell < lastCell; cell++)
+		{
+			bool bExterior = portals.IsExteriorCell(cell);
+			std::fill(cellFlags.begin(), cellFlags.end(), bExterior ? 1 : 0);
+			cellFlags[cell] = 1;
+
+			glm::vec3 boundsMin = portals.GetCellMinimum(cell);
+			glm::vec3 extent = portals.GetCellMaximum(cell) - boundsMin;
+			uint64_t state = ((uint64_t)seed << 32) | (uint64_t)cell;
+
+			for (int sample = 0; (sample < samplesPerCell) && (bExterior == false); sample++)
+			{
+				glm::vec3 position = boundsMin + glm::vec3(
+					extent.x * (SAMPLE_MARGIN + (1.0f - 2.0f * SAMPLE_MARGIN) * RandomUnit(state)),
+					extent.y * (SAMPLE_MARGIN + (1.0f - 2.0f * SAMPLE_MARGIN) * RandomUnit(state)),
+					extent.z * (SAMPLE_MARGIN + (1.0f - 2.0f * SAMPLE_MARGIN) * RandomUnit(state)));
+
+				portals.AddCellsSeenFrom(cell, position, cellFlags);
+			}
+
+			CompressSet(cellFlags, cellSets[cell]);
+		}
+	};
+
+	// the thread pool finishes the queued jobs before it is deleted
+	{
+		ThreadPool threadPool;
+		for (int firstCell = 0; firstCell < cellCount; firstCell += CELLS_PER_JOB)
+		{
+			int lastCell = (firstCell + CELLS_PER_JOB < cellCount) ? firstCell + CELLS_PER_JOB : cellCount;
+			threadPool.Enqueue([&bakeCells, firstCell, lastCell]() { bakeCells(firstCell, lastCell); });
+		}
+	}
+
+	m_compressedSets.clear();
+	m_setOffsets.clear();
+	for (int cell = 0; cell < cellCount; cell++)
+	{
+		m_setOffsets.push_back((uint32_t)m_compressedSets.size());
+		m_compressedSets.insert(m_compressedSets.end(), cellSets[cell].begin(), cellSets[cell].end());
+	}
+	m_setOffsets.push_back((uint32_t)m_compressedSets.size());
+
+	m_cellCount = cellCount;
+	m_portalCount = portals.GetPortalCount();
+	m_layoutHash = portals.GetLayoutHash();
+	ClearExpandedSets();
+
+	return(true);
+}
+
+/***********************************************************
+ *  SaveFile()
+ *
+ *  This method is used for writing the baked sets into a
+ *  binary file.
+ ***********************************************************/
+bool PotentiallyVisibleSet::SaveFile(const char* filename) const
+{
+	if ((NULL == filename) || (IsBaked() == false))
+	{
+		return(false);
+	}
+
+	std::ofstream file(filename, std::ios::binary);
+	if (!file)
+	{
+		LOG_ERROR("Could not write the visible sets to %s", filename);
+		return(false);
+	}
+
+	uint32_t header[6] =
+	{
+		PVS_FILE_MAGIC,
+		(uint32_t)m_cellCount,
+		(uint32_t)m_portalCount,
+		(uint32_t)m_layoutHash,
+		(uint32_t)(m_layoutHash >> 32),
+		(uint32_t)m_compressedSets.size()
+	};
+	file.write((const char*)header, sizeof(header));
+	file.write((const char*)m_setOffsets.data(), m_setOffsets.size() * sizeof(uint32_t));
+	file.write((const char*)m_compressedSets.data(), m_compressedSets.size());
+
+	return(file.good());
+}
+
+/***********************************************************
+ *  LoadFile()
+ *
+ *  This method is used for reading the baked sets from a
+ *  binary file, when they were baked for the layout of the
+ *  passed in portal system.  The offsets and the sets are
+ *  checked before the file is taken, so a damaged file is
+ *  baked again instead of being read past its end.
+ ***********************************************************/
+bool PotentiallyVisibleSet::LoadFile(const char* filename, const PortalSystem& portals)
+{
+	if (NULL == filename)
+	{
+		return(false);
+	}
+
+	std::ifstream file(filename, std::ios::binary);
+	if (!file)
+	{
+		return(false);
+	}
+
+	uint64_t layoutHash = portals.GetLayoutHash();
+	uint32_t header[6] = { 0, 0, 0, 0, 0, 0 };
+	file.read((char*)header, sizeof(header));
+	if ((!file) ||
+		(header[0] != PVS_FILE_MAGIC) ||
+		(header[1] != (uint32_t)portals.GetCellCount()) ||
+		(header[2] != (uint32_t)portals.GetPortalCount()) ||
+		(header[3] != (uint32_t)layoutHash) ||
+		(header[4] != (uint32_t)(layoutHash >> 32)))
+	{
+		LOG_INFO("The visible sets in %s do not match the rooms", filename);
+		return(false);
+	}
+
+	// a set is at most two bytes for every byte of its bitset,
+	// which keeps a damaged size from asking for a huge buffer
+	int cellCount = (int)header[1];
+	uint32_t compressedBytes = header[5];
+	if ((cellCount <= 0) || ((uint64_t)compressedBytes > (uint64_t)cellCount * ((cellCount + 7) / 8) * 2))
+	{
+		LOG_ERROR("The visible sets in %s are damaged", filename);
+		return(false);
+	}
+
+	std::vector<uint32_t> setOffsets(cellCount + 1);
+	std::vector<uint8_t> compressedSets(compressedBytes);
+	file.read((char*)setOffsets.data(), setOffsets.size() * sizeof(uint32_t));
+	file.read((char*)compressedSets.data(), compressedSets.size());
+	if (!file)
+	{
+		LOG_ERROR("Could not read the visible sets from %s", filename);
+		return(false);
+	}
+
+	bool bValid = (setOffsets[0] == 0) && (setOffsets.back() == compressedBytes);
+	for (int cell = 0; (cell < cellCount) && (bValid == true); cell++)
+	{
+		bValid = (setOffsets[cell] <= setOffsets[cell + 1]) &&
+			IsSetValid(compressedSets.data() + setOffsets[cell], setOffsets[cell + 1] - setOffsets[cell], cellCount);
+	}
+	if (bValid == false)
+	{
+		LOG_ERROR("The visible sets in %s are damaged", filename);
+		return(false);
+	}
+
+	m_setOffsets.swap(setOffsets);
+	m_compressedSets.swap(compressedSets);
+	m_cellCount = cellCount;
+	m_portalCount = (int)header[2];
+	m_layoutHash = layoutHash;
+	ClearExpandedSets();
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetVisibleCells()
+ *
+ *  This method is used for getting the cells that can be
+ *  seen from the passed in cell.  The set is expanded only
+ *  when the cell differs from the last call of the view,
+ *  which is once every time its camera moves into another
+ *  cell.
+ ***********************************************************/
+const std::vector<int>& PotentiallyVisibleSet::GetVisibleCells(int cell, int view)
+{
+	std::vector<int>& expandedCells = m_expandedSets[view].cells;
+	if (cell == m_expandedSets[view].cell)
+	{
+		return(expandedCells);
+	}
+
+	expandedCells.clear();
+	m_expandedSets[view].cell = cell;
+	if ((cell < 0) || (cell >= m_cellCount))
+	{
+		return(expandedCells);
+	}
+
+	int byteIndex = 0;
+	for (uint32_t i = m_setOffsets[cell]; i < m_setOffsets[cell + 1]; i++)
+	{
+		uint8_t bits = m_compressedSets[i];
+		if (bits == 0)
+		{
+			i++;
+			byteIndex += m_compressedSets[i];
+			continue;
+		}
+
+		for (int bit = 0; bit < 8; bit++)
+		{
+			if (bits & (1 << bit))
+			{
+				expandedCells.push_back(byteIndex * 8 + bit);
+			}
+		}
+		byteIndex++;
+	}
+
+	return(expandedCells);
+}
@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////////////
+// potentiallyvisibleset.h
+// =======================
+// bake the cells that can be seen from every cell of a static portal layout
+// and keep them as compressed bitsets
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "PortalSystem.h"
+
+/***********************************************************
+ *  PotentiallyVisibleSet
+ *
+ *  This class bakes, for every cell of a portal system, the
+ *  set of cells that can be seen from anywhere inside it.
+ *  Random points in the cell are sampled on worker threads,
+ *  and the cells seen in any direction through the portals
+ *  from each point are added to the set.  The sets are kept
+ *  as run length compressed bitsets, and the set of the
+ *  camera cell is expanded once when the camera enters the
+ *  cell.  Every view keeps its own expanded set, so the
+ *  views can ask for their sets from several threads.
+ ***********************************************************/
+class PotentiallyVisibleSet
+{
+public:
+	PotentiallyVisibleSet();
+
+	// sample the passed in number of points in every cell
+	bool Bake(const PortalSystem& portals, int samplesPerCell, uint32_t seed);
+	// the file holds the cell and portal count and the layout hash
+	// of the portals, and a file baked for a different layout or
+	// with sets that do not decode is not loaded
+	bool SaveFile(const char* filename) const;
+	bool LoadFile(const char* filename, const PortalSystem& portals);
+
+	bool IsBaked() const { return(m_cellCount > 0); }
+	int GetCellCount() const { return(m_cellCount); }
+	size_t GetCompressedBytes() const { return(m_compressedSets.size()); }
+	// the cells that can be seen from the passed in cell
+	const std::vector<int>& GetVisibleCells(int cell, int view = 0);
+
+	// the points sampled in every cell by default
+	static const int DEFAULT_SAMPLES_PER_CELL = 64;
+
+private:
+	static void CompressSet(const std::vector<uint8_t>& cellFlags, std::vector<uint8_t>& compressed);
+	static bool IsSetValid(const uint8_t* pSet, size_t byteCount, int cellCount);
+
+	int m_cellCount;
+	int m_portalCount;
+	uint64_t m_layoutHash;
+	std::vector<uint8_t> m_compressedSets;
+	// the start of the set of each cell, and the end of the last set
+	std::vector<uint32_t> m_setOffsets;
+
+	// the expanded set of the last cell asked for by each view
+	struct EXPANDED_SET
+	{
+		int cell;
+		std::vector<int> cells;
+	};
+	EXPANDED_SET m_expandedSets[PortalSystem::MAX_VIEWS];
+
+	void ClearExpandedSets();
+};
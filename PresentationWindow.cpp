@@ -0,0 +1,271 @@
+///////////////////////////////////////////////////////////////////////////////
+// presentationwindow.cpp
+// ======================
+// show a view of the scene in a second window, drawn by the context of the
+// main window so the meshes, textures and shaders are shared
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PresentationWindow.h"
+#include "Logger.h"
+
+
+// declaration of global variables
+namespace
+{
+	PresentationWindow* g_pActiveWindow = nullptr;
+}
+
+/***********************************************************
+ *  PresentationWindow()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+PresentationWindow::PresentationWindow()
+{
+	m_pWindow = NULL;
+	m_pMainWindow = NULL;
+	m_framebuffer = 0;
+	m_colorBuffer = 0;
+	m_depthBuffer = 0;
+	m_targetWidth = 0;
+	m_targetHeight = 0;
+	m_targetVersion = 0;
+	m_readFramebuffer = 0;
+	m_readVersion = 0;
+	m_bRendered = false;
+}
+
+/***********************************************************
+ *  ~PresentationWindow()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+PresentationWindow::~PresentationWindow()
+{
+	if (this == g_pActiveWindow)
+	{
+		g_pActiveWindow = NULL;
+	}
+	Close();
+}
+
+/***********************************************************
+ *  GetActive()
+ *
+ *  This method is used for getting the open presentation
+ *  window.
+ ***********************************************************/
+PresentationWindow* PresentationWindow::GetActive()
+{
+	return(g_pActiveWindow);
+}
+
+/***********************************************************
+ *  SetActive()
+ *
+ *  This method is used for setting the open presentation
+ *  window.
+ ***********************************************************/
+void PresentationWindow::SetActive(PresentationWindow* pWindow)
+{
+	g_pActiveWindow = pWindow;
+}
+
+/***********************************************************
+ *  Open()
+ *
+ *  This method is used for opening the window with a
+ *  context that shares the objects of the main window.
+ ***********************************************************/
+bool PresentationWindow::Open(GLFWwindow* pMainWindow, const char* title, int width, int height)
+{
+	if ((NULL != m_pWindow) || (NULL == pMainWindow))
+	{
+		return(false);
+	}
+
+	m_pWindow = glfwCreateWindow(width, height, title, NULL, pMainWindow);
+	if (NULL == m_pWindow)
+	{
+		LOG_ERROR("Could not create the presentation window");
+		return(false);
+	}
+	m_pMainWindow = pMainWindow;
+
+	// the main window waits for its own vertical blank, so the
+	// window would halve the frame rate by waiting for another
+	glfwMakeContextCurrent(m_pWindow);
+	glfwSwapInterval(0);
+	glfwMakeContextCurrent(m_pMainWindow);
+
+	return(true);
+}
+
+/***********************************************************
+ *  Close()
+ *
+ *  This method is used for freeing the target in the main
+ *  context and the read framebuffer in the window context,
+ *  and then closing the window.
+ ***********************************************************/
+void PresentationWindow::Close()
+{
+	if (NULL == m_pWindow)
+	{
+		return;
+	}
+
+	if (m_readFramebuffer != 0)
+	{
+		glfwMakeContextCurrent(m_pWindow);
+		glDeleteFramebuffers(1, &m_readFramebuffer);
+		m_readFramebuffer = 0;
+		glfwMakeContextCurrent(m_pMainWindow);
+	}
+	if (m_framebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		glDeleteRenderbuffers(1, &m_colorBuffer);
+		glDeleteRenderbuffers(1, &m_depthBuffer);
+		m_framebuffer = 0;
+		m_colorBuffer = 0;
+		m_depthBuffer = 0;
+	}
+	m_targetWidth = 0;
+	m_targetHeight = 0;
+	m_bRendered = false;
+
+	glfwDestroyWindow(m_pWindow);
+	m_pWindow = NULL;
+}
+
+/***********************************************************
+ *  IsOpen()
+ *
+ *  This method is used for checking whether the window is
+ *  still open.
+ ***********************************************************/
+bool PresentationWindow::IsOpen() const
+{
+	return((NULL != m_pWindow) && (glfwWindowShouldClose(m_pWindow) == 0));
+}
+
+/***********************************************************
+ *  PrepareTarget()
+ *
+ *  This method is used for allocating the target at the
+ *  framebuffer size of the window, only when the size has
+ *  changed.  The color buffer is a renderbuffer, so the
+ *  texture units of the scene are never disturbed.
+ ***********************************************************/
+bool PresentationWindow::PrepareTarget(int* pViewport)
+{
+	m_bRendered = false;
+	if (IsOpen() == false)
+	{
+		return(false);
+	}
+
+	int width = 0;
+	int height = 0;
+	glfwGetFramebufferSize(m_pWindow, &width, &height);
+	if ((width <= 0) || (height <= 0))
+	{
+		return(false);
+	}
+
+	if ((width != m_targetWidth) || (height != m_targetHeight) || (m_framebuffer == 0))
+	{
+		GLint previousFramebuffer = 0;
+		glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+		if (m_framebuffer == 0)
+		{
+			glGenFramebuffers(1, &m_framebuffer);
+			glGenRenderbuffers(1, &m_colorBuffer);
+			glGenRenderbuffers(1, &m_depthBuffer);
+		}
+
+		glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+		glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+		GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+		glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+		if (status != GL_FRAMEBUFFER_COMPLETE)
+		{
+			LOG_ERROR("Presentation framebuffer is incomplete: 0x%x", status);
+			m_targetWidth = 0;
+			m_targetHeight = 0;
+			return(false);
+		}
+
+		m_targetWidth = width;
+		m_targetHeight = height;
+		m_targetVersion++;
+	}
+
+	pViewport[0] = 0;
+	pViewport[1] = 0;
+	pViewport[2] = m_targetWidth;
+	pViewport[3] = m_targetHeight;
+	m_bRendered = true;
+
+	return(true);
+}
+
+/***********************************************************
+ *  Present()
+ *
+ *  This method is used for copying the target into the
+ *  back buffer of the window and showing it.  The fence is
+ *  flushed by the main context, and the window context
+ *  waits for it on the GPU, so the copy never reads a view
+ *  that is still being drawn and the CPU never waits.  The
+ *  context of the main window is current again afterwards.
+ ***********************************************************/
+void PresentationWindow::Present()
+{
+	if ((m_bRendered == false) || (IsOpen() == false))
+	{
+		return;
+	}
+	m_bRendered = false;
+
+	GLsync renderedFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	glFlush();
+
+	glfwMakeContextCurrent(m_pWindow);
+	glWaitSync(renderedFence, 0, GL_TIMEOUT_IGNORED);
+
+	// the framebuffer of this context is attached to the shared
+	// color buffer again after the buffer was reallocated
+	if (m_readFramebuffer == 0)
+	{
+		glGenFramebuffers(1, &m_readFramebuffer);
+	}
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, m_readFramebuffer);
+	if (m_readVersion != m_targetVersion)
+	{
+		glFramebufferRenderbuffer(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+		m_readVersion = m_targetVersion;
+	}
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+	glBlitFramebuffer(
+		0, 0, m_targetWidth, m_targetHeight,
+		0, 0, m_targetWidth, m_targetHeight,
+		GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+	glfwSwapBuffers(m_pWindow);
+
+	glDeleteSync(renderedFence);
+	glfwMakeContextCurrent(m_pMainWindow);
+}
@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////////////
+// presentationwindow.h
+// ====================
+// show a view of the scene in a second window, drawn by the context of the
+// main window so the meshes, textures and shaders are shared
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include "GLFW/glfw3.h"
+
+/***********************************************************
+ *  PresentationWindow
+ *
+ *  This class opens a window whose context shares objects
+ *  with the main window.  Vertex arrays and framebuffers
+ *  are never shared between contexts, so the scene is not
+ *  drawn by the window context at all - the view of the
+ *  window is rendered by the main context into an offscreen
+ *  target, and the window context only copies the target
+ *  onto its back buffer once a fence placed after the view
+ *  has passed.  The target is sized to the framebuffer of
+ *  the window and reallocated when it is resized.
+ ***********************************************************/
+class PresentationWindow
+{
+public:
+	PresentationWindow();
+	~PresentationWindow();
+
+	// open the window - the context of the main window stays current
+	bool Open(GLFWwindow* pMainWindow, const char* title, int width, int height);
+	// free the target and close the window
+	void Close();
+	// false once the window is closed, or asked to close by the user
+	bool IsOpen() const;
+	GLFWwindow* GetWindow() const { return(m_pWindow); }
+
+	// allocate the target at the size of the window and fill the
+	// viewport of the view rendered into it - false is returned
+	// while the window is minimized
+	bool PrepareTarget(int* pViewport);
+	GLuint GetTarget() const { return(m_framebuffer); }
+	// copy the rendered target into the window and show it
+	void Present();
+
+	// the open presentation window, set by the view manager so the
+	// main loop can present it
+	static PresentationWindow* GetActive();
+	static void SetActive(PresentationWindow* pWindow);
+
+private:
+	GLFWwindow* m_pWindow;
+	GLFWwindow* m_pMainWindow;
+
+	// the target in the main context
+	GLuint m_framebuffer;
+	GLuint m_colorBuffer;
+	GLuint m_depthBuffer;
+	int m_targetWidth;
+	int m_targetHeight;
+	// changes whenever the target is reallocated
+	unsigned int m_targetVersion;
+
+	// the framebuffer of the window context that reads the target
+	GLuint m_readFramebuffer;
+	unsigned int m_readVersion;
+	// the target was prepared and rendered since the last present
+	bool m_bRendered;
+};
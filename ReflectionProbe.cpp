@@ -0,0 +1,418 @@
+///////////////////////////////////////////////////////////////////////////////
+// reflectionprobe.cpp
+// ===================
+// manage a local reflection probe - a low resolution cubemap of the scene
+// captured around a point, prefiltered into roughness mip levels
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ReflectionProbe.h"
+#include "RenderOrigin.h"
+#include "RenderSettings.h"
+#include "Logger.h"
+
+#include <cmath>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+// declaration of global variables
+namespace
+{
+	// the number of prefiltered roughness levels - the smallest
+	// levels are too blurry to be worth rendering
+	const int MAX_PROBE_MIPS = 5;
+
+	// the look direction and up vector for each cubemap face,
+	// in the GL_TEXTURE_CUBE_MAP_POSITIVE_X face order
+	const glm::vec3 g_FaceDirections[6] =
+	{
+		glm::vec3(1.0f, 0.0f, 0.0f),
+		glm::vec3(-1.0f, 0.0f, 0.0f),
+		glm::vec3(0.0f, 1.0f, 0.0f),
+		glm::vec3(0.0f, -1.0f, 0.0f),
+		glm::vec3(0.0f, 0.0f, 1.0f),
+		glm::vec3(0.0f, 0.0f, -1.0f)
+	};
+	const glm::vec3 g_FaceUps[6] =
+	{
+		glm::vec3(0.0f, -1.0f, 0.0f),
+		glm::vec3(0.0f, -1.0f, 0.0f),
+		glm::vec3(0.0f, 0.0f, 1.0f),
+		glm::vec3(0.0f, 0.0f, -1.0f),
+		glm::vec3(0.0f, -1.0f, 0.0f),
+		glm::vec3(0.0f, -1.0f, 0.0f)
+	};
+
+	/***********************************************************
+	 *  CreateCubemap()
+	 *
+	 *  This function is used for allocating an empty cubemap
+	 *  with the passed in number of mip levels.
+	 ***********************************************************/
+	GLuint CreateCubemap(int resolution, int mipCount)
+	{
+		GLuint cubemap = 0;
+
+		glGenTextures(1, &cubemap);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap);
+		glTexStorage2D(GL_TEXTURE_CUBE_MAP, mipCount, GL_RGBA16F, resolution, resolution);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, mipCount - 1);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+		return(cubemap);
+	}
+}
+
+/***********************************************************
+ *  ReflectionProbe()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ReflectionProbe::ReflectionProbe(
+	ShaderManager* pSceneShaderManager,
+	glm::vec3 position,
+	float influenceRadius,
+	int resolution)
+{
+	m_pSceneShaderManager = pSceneShaderManager;
+	m_pPrefilterShaderManager = NULL;
+	m_position = position;
+	m_influenceRadius = influenceRadius;
+	m_resolution = resolution;
+	m_mipCount = 1;
+	m_captureCubemap = 0;
+	m_prefilteredCubemap = 0;
+	m_framebuffer = 0;
+	m_depthBuffer = 0;
+	m_emptyVAO = 0;
+	m_nextStep = 0;
+	m_bDirty = true;
+	m_bContinuousRefresh = false;
+	m_bValid = false;
+	m_refreshInterval = 0.0f;
+	m_captureStartTime = 0.0f;
+}
+
+/***********************************************************
+ *  ~ReflectionProbe()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ReflectionProbe::~ReflectionProbe()
+{
+	DestroyProbe();
+	m_pSceneShaderManager = NULL;
+}
+
+/***********************************************************
+ *  CreateProbe()
+ *
+ *  This method is used for allocating the probe cubemaps,
+ *  the capture framebuffer and the prefilter shader.
+ ***********************************************************/
+bool ReflectionProbe::CreateProbe()
+{
+	// one roughness level per halving of the resolution
+	m_mipCount = 1;
+	while (((m_resolution >> m_mipCount) >= 4) && (m_mipCount < MAX_PROBE_MIPS))
+	{
+		m_mipCount++;
+	}
+
+	// the capture cubemap has a full mip chain so that the
+	// prefilter can sample blurred source texels cheaply
+	int captureMips = 1;
+	while ((m_resolution >> captureMips) > 0)
+	{
+		captureMips++;
+	}
+	m_captureCubemap = CreateCubemap(m_resolution, captureMips);
+	m_prefilteredCubemap = CreateCubemap(m_resolution, m_mipCount);
+
+	glGenRenderbuffers(1, &m_depthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, m_resolution, m_resolution);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &m_framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X, m_captureCubemap, 0);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		LOG_ERROR("Reflection probe framebuffer is incomplete: 0x%x", status);
+		DestroyProbe();
+		return(false);
+	}
+
+	glGenVertexArrays(1, &m_emptyVAO);
+
+	m_pPrefilterShaderManager = new ShaderManager();
+	m_pPrefilterShaderManager->LoadShaders(
+		"shaders/probePrefilterVertex.glsl",
+		"shaders/probePrefilterFragment.glsl");
+
+	// the scene shader must be active again for the scene rendering
+	m_pSceneShaderManager->use();
+
+	m_nextStep = 0;
+	m_bDirty = true;
+	m_bValid = false;
+
+	return(true);
+}
+
+/***********************************************************
+ *  DestroyProbe()
+ *
+ *  This method is used for freeing the OpenGL memory of
+ *  the probe.
+ ***********************************************************/
+void ReflectionProbe::DestroyProbe()
+{
+	if (m_framebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		m_framebuffer = 0;
+	}
+	if (m_depthBuffer != 0)
+	{
+		glDeleteRenderbuffers(1, &m_depthBuffer);
+		m_depthBuffer = 0;
+	}
+	if (m_captureCubemap != 0)
+	{
+		glDeleteTextures(1, &m_captureCubemap);
+		m_captureCubemap = 0;
+	}
+	if (m_prefilteredCubemap != 0)
+	{
+		glDeleteTextures(1, &m_prefilteredCubemap);
+		m_prefilteredCubemap = 0;
+	}
+	if (m_emptyVAO != 0)
+	{
+		glDeleteVertexArrays(1, &m_emptyVAO);
+		m_emptyVAO = 0;
+	}
+	if (NULL != m_pPrefilterShaderManager)
+	{
+		delete m_pPrefilterShaderManager;
+		m_pPrefilterShaderManager = NULL;
+	}
+	m_bValid = false;
+}
+
+/***********************************************************
+ *  Invalidate()
+ *
+ *  This method is used for requesting a new capture.  A
+ *  capture already in progress is finished first, and the
+ *  new capture follows it.
+ ***********************************************************/
+void ReflectionProbe::Invalidate()
+{
+	m_bDirty = true;
+}
+
+/***********************************************************
+ *  InvalidateRegion()
+ *
+ *  This method is used for requesting a new capture when
+ *  the changed box overlaps the probe influence sphere.
+ ***********************************************************/
+void ReflectionProbe::InvalidateRegion(glm::vec3 boundsMin, glm::vec3 boundsMax)
+{
+	// the closest point of the box to the probe
+	glm::vec3 closest = glm::clamp(m_position, boundsMin, boundsMax);
+	glm::vec3 offset = closest - m_position;
+
+	if (glm::dot(offset, offset) <= (m_influenceRadius * m_influenceRadius))
+	{
+		m_bDirty = true;
+	}
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for advancing the time sliced capture
+ *  by a single step.  The previously prefiltered cubemap
+ *  stays in use until a complete new capture is filtered.
+ ***********************************************************/
+bool ReflectionProbe::Update(RENDER_CALLBACK renderScene, float time)
+{
+	if (m_framebuffer == 0)
+	{
+		return(false);
+	}
+
+	// a new capture only starts when something changed
+	if (m_nextStep == 0)
+	{
+		if ((m_bDirty == false) && (m_bContinuousRefresh == false))
+		{
+			return(false);
+		}
+		// the first capture starts right away, and later ones wait
+		// out the refresh interval
+		if ((m_bValid == true) && (time - m_captureStartTime < m_refreshInterval))
+		{
+			return(false);
+		}
+		m_bDirty = false;
+		m_captureStartTime = time;
+	}
+
+	if (m_nextStep < 6)
+	{
+		CaptureFace(m_nextStep, renderScene);
+		m_nextStep++;
+	}
+	else
+	{
+		PrefilterCubemap();
+		m_nextStep = 0;
+		m_bValid = true;
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  CaptureFace()
+ *
+ *  This method is used for rendering the scene into a
+ *  single face of the capture cubemap.  The face camera is
+ *  the current camera while the scene is rendered, and the
+ *  camera of the main view is restored afterwards.
+ ***********************************************************/
+void ReflectionProbe::CaptureFace(int face, RENDER_CALLBACK renderScene)
+{
+	GLint previousFramebuffer = 0;
+	GLint previousViewport[4];
+	const CameraState* pPreviousCamera = CameraState::GetCurrent();
+
+	// save the main view state set up by the view manager
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+	glGetIntegerv(GL_VIEWPORT, previousViewport);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, m_captureCubemap, 0);
+	glViewport(0, 0, m_resolution, m_resolution);
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	// the scene is drawn in render space, relative to the render origin
+	glm::vec3 renderPosition = RenderOrigin::ToRender(glm::dvec3(m_position));
+	glm::mat4 view = glm::lookAt(renderPosition, renderPosition + g_FaceDirections[face], g_FaceUps[face]);
+	glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f,
+		RenderSettings::Get().nearPlane, RenderSettings::Get().farPlane);
+	m_captureCamera.SetView(view, renderPosition);
+	m_captureCamera.SetProjection(projection);
+	m_captureCamera.Upload(m_pSceneShaderManager);
+	CameraState::SetCurrent(&m_captureCamera);
+
+	renderScene();
+
+	// restore the main view state
+	glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+	glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+	if (NULL != pPreviousCamera)
+	{
+		pPreviousCamera->Upload(m_pSceneShaderManager);
+	}
+	CameraState::SetCurrent(pPreviousCamera);
+}
+
+/***********************************************************
+ *  PrefilterCubemap()
+ *
+ *  This method is used for convolving the captured cubemap
+ *  into the roughness mips of the prefiltered cubemap.  Mip
+ *  level 0 is a mirror and the last level is fully rough.
+ ***********************************************************/
+void ReflectionProbe::PrefilterCubemap()
+{
+	GLint previousFramebuffer = 0;
+	GLint previousViewport[4];
+
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+	glGetIntegerv(GL_VIEWPORT, previousViewport);
+
+	// blurred copies of the capture reduce the samples needed
+	glBindTexture(GL_TEXTURE_CUBE_MAP, m_captureCubemap);
+	glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+
+	m_pPrefilterShaderManager->use();
+	m_pPrefilterShaderManager->setSampler2DValue("sourceCubemap", 0);
+	m_pPrefilterShaderManager->setFloatValue("sourceResolution", (float)m_resolution);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, m_captureCubemap);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_BLEND);
+	glBindVertexArray(m_emptyVAO);
+
+	for (int mip = 0; mip < m_mipCount; mip++)
+	{
+		int size = m_resolution >> mip;
+		float roughness = (m_mipCount > 1) ? (float)mip / (float)(m_mipCount - 1) : 0.0f;
+
+		glViewport(0, 0, size, size);
+		m_pPrefilterShaderManager->setFloatValue("roughness", roughness);
+
+		for (int face = 0; face < 6; face++)
+		{
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, m_prefilteredCubemap, mip);
+			m_pPrefilterShaderManager->setIntValue("faceIndex", face);
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+		}
+	}
+
+	glBindVertexArray(0);
+	glEnable(GL_BLEND);
+	glEnable(GL_DEPTH_TEST);
+	glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+	glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+
+	// slot 0 belongs to the scene textures, so the prefilter
+	// source must not stay bound there
+	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	m_pSceneShaderManager->use();
+}
+
+/***********************************************************
+ *  BindProbeTexture()
+ *
+ *  This method is used for binding the prefiltered cubemap
+ *  to the passed in OpenGL texture memory slot.
+ ***********************************************************/
+void ReflectionProbe::BindProbeTexture(int textureSlot)
+{
+	glActiveTexture(GL_TEXTURE0 + textureSlot);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, m_prefilteredCubemap);
+}
+
+/***********************************************************
+ *  ShininessToRoughness()
+ *
+ *  This method is used for converting the Phong shininess
+ *  of a material into a roughness between 0 and 1.
+ ***********************************************************/
+float ReflectionProbe::ShininessToRoughness(float shininess)
+{
+	return(glm::clamp((float)sqrt(2.0f / (shininess + 2.0f)), 0.0f, 1.0f));
+}
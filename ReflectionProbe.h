@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////
+// reflectionprobe.h
+// =================
+// manage a local reflection probe - a low resolution cubemap of the scene
+// captured around a point, prefiltered into roughness mip levels
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "CameraState.h"
+
+#include <functional>
+
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  ReflectionProbe
+ *
+ *  This class captures the 3D scene into a cubemap from the
+ *  probe position.  The capture is time sliced - one cube
+ *  face is rendered per frame, and once all six faces are
+ *  captured the cubemap is prefiltered into roughness mips.
+ *  The probe is only captured again after geometry inside
+ *  its influence radius changes, unless continuous refresh
+ *  has been turned on, and a new capture starts at most
+ *  once per refresh interval, so objects that move every
+ *  frame are recaptured at a steady rate.
+ *
+ *  The reflection only shows in a scene fragment shader
+ *  that samples it, and shaders/fragmentShader.glsl is not
+ *  part of this tree.  While bUseReflectionProbe is set,
+ *  that shader must reflect the view direction about the
+ *  normal, take the samplerCube reflectionProbe (slot 14)
+ *  along it at the mip of reflectionRoughness times
+ *  reflectionProbeMaxLod, and blend it into the color.
+ ***********************************************************/
+class ReflectionProbe
+{
+public:
+	// the callback that draws the scene into the bound framebuffer
+	typedef std::function<void()> RENDER_CALLBACK;
+
+	ReflectionProbe(
+		ShaderManager* pSceneShaderManager,
+		glm::vec3 position,
+		float influenceRadius,
+		int resolution = 64);
+	~ReflectionProbe();
+
+	// allocate the cubemaps, framebuffer and prefilter shader
+	bool CreateProbe();
+	// free the OpenGL memory of the probe
+	void DestroyProbe();
+
+	// request a new capture of the whole probe
+	void Invalidate();
+	// request a new capture if the changed world space box is
+	// inside the influence radius of the probe
+	void InvalidateRegion(glm::vec3 boundsMin, glm::vec3 boundsMax);
+	// keep capturing one face per frame even if nothing changes
+	void SetContinuousRefresh(bool bContinuous) { m_bContinuousRefresh = bContinuous; }
+	// the least time in seconds between the starts of two captures
+	void SetRefreshInterval(float seconds) { m_refreshInterval = seconds; }
+
+	// perform at most one step of the capture - one cube face or
+	// the prefilter pass - and return true if any work was done,
+	// with the time in seconds for the refresh interval
+	bool Update(RENDER_CALLBACK renderScene, float time);
+
+	// bind the prefiltered cubemap to the passed in texture slot
+	void BindProbeTexture(int textureSlot);
+
+	// true once the first complete capture has been prefiltered
+	bool IsValid() const { return(m_bValid); }
+	glm::vec3 GetPosition() const { return(m_position); }
+	int GetMipCount() const { return(m_mipCount); }
+
+	// convert a Phong shininess into the roughness used to pick
+	// the prefiltered mip level
+	static float ShininessToRoughness(float shininess);
+
+private:
+	void CaptureFace(int face, RENDER_CALLBACK renderScene);
+	void PrefilterCubemap();
+
+	ShaderManager* m_pSceneShaderManager;
+	ShaderManager* m_pPrefilterShaderManager;
+	glm::vec3 m_position;
+	float m_influenceRadius;
+	int m_resolution;
+	int m_mipCount;
+
+	// the camera of the face being captured
+	CameraState m_captureCamera;
+	// cubemap the scene faces are rendered into
+	GLuint m_captureCubemap;
+	// roughness filtered cubemap sampled by the shaded objects
+	GLuint m_prefilteredCubemap;
+	GLuint m_framebuffer;
+	GLuint m_depthBuffer;
+	// empty vertex array for the full screen prefilter triangle
+	GLuint m_emptyVAO;
+
+	// the next capture step - faces 0 to 5, then 6 for prefiltering
+	int m_nextStep;
+	bool m_bDirty;
+	bool m_bContinuousRefresh;
+	bool m_bValid;
+	float m_refreshInterval;
+	// the time the last capture was started
+	float m_captureStartTime;
+};
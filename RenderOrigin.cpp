@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderorigin.cpp
+// ================
+// keep the point that world positions are made relative to before they are
+// converted to float for the GPU
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RenderOrigin.h"
+
+#include <cmath>
+
+// declaration of global variables
+namespace
+{
+	// the camera may move this far from the origin before the
+	// origin follows it - floats below this keep a precision of
+	// a few micrometres
+	const float REBASE_DISTANCE = 64.0f;
+
+	glm::dvec3 g_RenderOrigin = glm::dvec3(0.0);
+	unsigned int g_RenderOriginVersion = 0;
+}
+
+/***********************************************************
+ *  Get()
+ *
+ *  This method is used for getting the render origin in
+ *  world space.
+ ***********************************************************/
+glm::dvec3 RenderOrigin::Get()
+{
+	return(g_RenderOrigin);
+}
+
+/***********************************************************
+ *  Set()
+ *
+ *  This method is used for moving the render origin.
+ ***********************************************************/
+void RenderOrigin::Set(glm::dvec3 origin)
+{
+	if ((origin.x != g_RenderOrigin.x) ||
+		(origin.y != g_RenderOrigin.y) ||
+		(origin.z != g_RenderOrigin.z))
+	{
+		g_RenderOrigin = origin;
+		g_RenderOriginVersion++;
+	}
+}
+
+/***********************************************************
+ *  GetVersion()
+ *
+ *  This method is used for getting the number of times the
+ *  render origin has moved.
+ ***********************************************************/
+unsigned int RenderOrigin::GetVersion()
+{
+	return(g_RenderOriginVersion);
+}
+
+/***********************************************************
+ *  Rebase()
+ *
+ *  This method is used for moving the render origin onto
+ *  the camera once the camera is far from it.  The float
+ *  camera position converts to double exactly, so the
+ *  camera does not move in world space.
+ ***********************************************************/
+bool RenderOrigin::Rebase(glm::vec3& cameraPosition)
+{
+	if ((fabsf(cameraPosition.x) < REBASE_DISTANCE) &&
+		(fabsf(cameraPosition.y) < REBASE_DISTANCE) &&
+		(fabsf(cameraPosition.z) < REBASE_DISTANCE))
+	{
+		return(false);
+	}
+
+	Set(g_RenderOrigin + glm::dvec3(cameraPosition.x, cameraPosition.y, cameraPosition.z));
+	cameraPosition = glm::vec3(0.0f);
+
+	return(true);
+}
+
+/***********************************************************
+ *  ToRender()
+ *
+ *  This method is used for converting a world position to
+ *  render space.  The subtraction is done in double, so only
+ *  the small result is rounded to float.
+ ***********************************************************/
+glm::vec3 RenderOrigin::ToRender(glm::dvec3 worldPosition)
+{
+	return(glm::vec3(
+		(float)(worldPosition.x - g_RenderOrigin.x),
+		(float)(worldPosition.y - g_RenderOrigin.y),
+		(float)(worldPosition.z - g_RenderOrigin.z)));
+}
+
+/***********************************************************
+ *  ToWorld()
+ *
+ *  This method is used for converting a render position to
+ *  world space.
+ ***********************************************************/
+glm::dvec3 RenderOrigin::ToWorld(glm::vec3 renderPosition)
+{
+	return(glm::dvec3(
+		g_RenderOrigin.x + renderPosition.x,
+		g_RenderOrigin.y + renderPosition.y,
+		g_RenderOrigin.z + renderPosition.z));
+}
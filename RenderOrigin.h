@@ -0,0 +1,43 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderorigin.h
+// ==============
+// keep the point that world positions are made relative to before they are
+// converted to float for the GPU
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  RenderOrigin
+ *
+ *  The scene is stored in double precision world space,
+ *  and everything sent to the shaders is in render space,
+ *  which is world space moved so the render origin is at
+ *  zero.  The camera position is kept in render space, and
+ *  the origin is moved onto the camera whenever it gets
+ *  farther than the rebase distance, so the floats on the
+ *  GPU stay small and keep their precision anywhere in
+ *  the world.  Every move of the origin bumps a version
+ *  number, so the systems holding render space values can
+ *  tell when to rebuild them.
+ ***********************************************************/
+class RenderOrigin
+{
+public:
+	static glm::dvec3 Get();
+	static void Set(glm::dvec3 origin);
+	static unsigned int GetVersion();
+
+	// move the origin onto a render space camera position that is
+	// too far from it - the position is changed to match the new
+	// origin and true is returned when the origin moved
+	static bool Rebase(glm::vec3& cameraPosition);
+
+	static glm::vec3 ToRender(glm::dvec3 worldPosition);
+	static glm::dvec3 ToWorld(glm::vec3 renderPosition);
+};
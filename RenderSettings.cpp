@@ -0,0 +1,616 @@
+///////////////////////////////////////////////////////////////////////////////
+// rendersettings.cpp
+// ==================
+// choose the performance-relevant rendering values from quality presets, a
+// settings file and the command line, or from a startup benchmark
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RenderSettings.h"
+#include "ShaderManager.h"
+#include "LightManager.h"
+#include "Logger.h"
+
+#include <GL/glew.h>
+#include "GLFW/glfw3.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+
+// GLM Math Header inclusions
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+
+// declaration of global variables
+namespace
+{
+	// the size of the target the GPU benchmark draws into
+	const int BENCHMARK_WIDTH = 1280;
+	const int BENCHMARK_HEIGHT = 720;
+	// the lighting loops of every benchmark pixel, which is about
+	// the cost of a lit scene pixel
+	const int BENCHMARK_ITERATIONS = 16;
+	// the GPU benchmark draws until this much time has passed or
+	// this many passes are drawn, whichever comes first
+	const double BENCHMARK_SECONDS = 0.1;
+	const int BENCHMARK_MAX_PASSES = 64;
+	// the transforms composed by the CPU benchmark
+	const int BENCHMARK_MATRICES = 200000;
+
+	// the benchmark results that pick the presets - below the low
+	// rates the low preset is picked, and the high preset needs the
+	// high rates and threads
+	const double LOW_GPU_MEGAPIXELS = 500.0;
+	const double HIGH_GPU_MEGAPIXELS = 5000.0;
+	const double LOW_CPU_MATRICES = 1000000.0;
+	const double HIGH_CPU_MATRICES = 10000000.0;
+	const unsigned int LOW_CPU_THREADS = 2;
+	const unsigned int HIGH_CPU_THREADS = 4;
+
+	const char* const PRESET_NAMES[] = { "low", "medium", "high" };
+
+	RENDER_SETTINGS g_Settings = RenderSettings::GetPreset(QUALITY_MEDIUM);
+
+	// keeps the CPU benchmark from being optimized away
+	volatile float g_BenchmarkResult = 0.0f;
+
+	/***********************************************************
+	 *  ParseInteger()
+	 *
+	 *  This function is used for reading a whole number that
+	 *  must be within the passed in range.
+	 ***********************************************************/
+	bool ParseInteger(const char* text, int minimum, int maximum, int& value)
+	{
+		char* pEnd = NULL;
+		long parsed = strtol(text, &pEnd, 10);
+		if ((pEnd == text) || (*pEnd != 0) || (parsed < minimum) || (parsed > maximum))
+		{
+			return(false);
+		}
+		value = (int)parsed;
+		return(true);
+	}
+
+	/***********************************************************
+	 *  ParseFloat()
+	 *
+	 *  This function is used for reading a number that must be
+	 *  within the passed in range.  NaN fails every comparison,
+	 *  so it is rejected before the range is checked.
+	 ***********************************************************/
+	bool ParseFloat(const char* text, float minimum, float maximum, float& value)
+	{
+		char* pEnd = NULL;
+		float parsed = strtof(text, &pEnd);
+		if ((pEnd == text) || (*pEnd != 0) || (std::isfinite(parsed) == false) ||
+			(parsed < minimum) || (parsed > maximum))
+		{
+			return(false);
+		}
+		value = parsed;
+		return(true);
+	}
+
+	/***********************************************************
+	 *  ParseSwitch()
+	 *
+	 *  This function is used for reading on or off.
+	 ***********************************************************/
+	bool ParseSwitch(const char* text, bool& bValue)
+	{
+		if ((strcmp(text, "on") == 0) || (strcmp(text, "1") == 0) || (strcmp(text, "true") == 0))
+		{
+			bValue = true;
+			return(true);
+		}
+		if ((strcmp(text, "off") == 0) || (strcmp(text, "0") == 0) || (strcmp(text, "false") == 0))
+		{
+			bValue = false;
+			return(true);
+		}
+		return(false);
+	}
+
+	/***********************************************************
+	 *  ApplyValue()
+	 *
+	 *  This function is used for setting one value by its key,
+	 *  which are the same in the settings file and the --set
+	 *  option.  False is returned for an unknown key or a
+	 *  malformed value.
+	 ***********************************************************/
+	bool ApplyValue(RENDER_SETTINGS& settings, const char* key, const char* value)
+	{
+		bool bValid = false;
+		if (strcmp(key, "window_width") == 0)
+		{
+			bValid = ParseInteger(value, 320, 16384, settings.windowWidth);
+		}
+		else if (strcmp(key, "window_height") == 0)
+		{
+			bValid = ParseInteger(value, 240, 16384, settings.windowHeight);
+		}
+		else if (strcmp(key, "near_plane") == 0)
+		{
+			bValid = ParseFloat(value, 0.001f, 10.0f, settings.nearPlane);
+		}
+		else if (strcmp(key, "far_plane") == 0)
+		{
+			bValid = ParseFloat(value, 1.0f, 100000.0f, settings.farPlane);
+		}
+		else if (strcmp(key, "msaa") == 0)
+		{
+			bValid = ParseInteger(value, 0, 16, settings.msaaSamples);
+		}
+		else if (strcmp(key, "trilinear") == 0)
+		{
+			bValid = ParseSwitch(value, settings.bTrilinearFiltering);
+		}
+		else if (strcmp(key, "anisotropy") == 0)
+		{
+			bValid = ParseFloat(value, 1.0f, 16.0f, settings.anisotropy);
+		}
+		else if (strcmp(key, "point_lights") == 0)
+		{
+			bValid = ParseInteger(value, 0, LightManager::MAX_POINT_LIGHTS, settings.pointLights);
+		}
+		else if (strcmp(key, "spot_lights") == 0)
+		{
+			bValid = ParseInteger(value, 0, LightManager::MAX_SPOT_LIGHTS, settings.spotLights);
+		}
+		else if (strcmp(key, "snow_particles") == 0)
+		{
+			bValid = ParseInteger(value, 0, 1 << 20, settings.snowParticles);
+		}
+		else if (strcmp(key, "reflection_probe") == 0)
+		{
+			bValid = ParseSwitch(value, settings.bReflectionProbe);
+		}
+		else if (strcmp(key, "swap_interval") == 0)
+		{
+			bValid = ParseInteger(value, -1, 4, settings.swapInterval);
+		}
+		else
+		{
+			LOG_ERROR("Unknown render setting %s", key);
+			return(false);
+		}
+
+		if (bValid == false)
+		{
+			LOG_ERROR("The render setting %s cannot be %s", key, value);
+			return(false);
+		}
+
+		return(true);
+	}
+
+	/***********************************************************
+	 *  MeasureGPU()
+	 *
+	 *  This function is used for measuring the fill rate of the
+	 *  GPU with a pixel shader about as costly as the lit scene.
+	 *  A hidden window gives the benchmark its own context, and
+	 *  the passes are drawn into an offscreen target, so the
+	 *  speed of the display does not count.  The first pass
+	 *  is not timed, since the driver may only finish compiling
+	 *  the shader when it is first drawn with.
+	 ***********************************************************/
+	bool MeasureGPU(double& megapixelsPerSecond)
+	{
+		megapixelsPerSecond = 0.0;
+
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		GLFWwindow* pWindow = glfwCreateWindow(64, 64, "Benchmark", NULL, NULL);
+		glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+		if (NULL == pWindow)
+		{
+			LOG_WARNING("Could not create the benchmark window");
+			return(false);
+		}
+		glfwMakeContextCurrent(pWindow);
+		if (glewInit() != GLEW_OK)
+		{
+			LOG_WARNING("Could not initialize GLEW for the benchmark");
+			glfwMakeContextCurrent(NULL);
+			glfwDestroyWindow(pWindow);
+			return(false);
+		}
+
+		GLuint colorTexture = 0;
+		glGenTextures(1, &colorTexture);
+		glBindTexture(GL_TEXTURE_2D, colorTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		GLuint framebuffer = 0;
+		glGenFramebuffers(1, &framebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+		bool bComplete = (glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+
+		GLuint emptyVAO = 0;
+		glGenVertexArrays(1, &emptyVAO);
+
+		ShaderManager* pShaderManager = new ShaderManager();
+		pShaderManager->LoadShaders(
+			"shaders/benchmarkVertex.glsl",
+			"shaders/benchmarkFragment.glsl");
+		pShaderManager->use();
+		pShaderManager->setIntValue("iterations", BENCHMARK_ITERATIONS);
+
+		glViewport(0, 0, BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+		glDisable(GL_DEPTH_TEST);
+		glDisable(GL_BLEND);
+		glBindVertexArray(emptyVAO);
+
+		int passes = 0;
+		double seconds = 0.0;
+		if (bComplete == true)
+		{
+			pShaderManager->setFloatValue("seed", 0.0f);
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+			glFinish();
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			while ((seconds < BENCHMARK_SECONDS) && (passes < BENCHMARK_MAX_PASSES))
+			{
+				// a new seed every pass keeps the driver from
+				// skipping a draw that writes the same pixels
+				pShaderManager->setFloatValue("seed", (float)(passes + 1));
+				glDrawArrays(GL_TRIANGLES, 0, 3);
+				glFinish();
+				passes++;
+				seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			}
+		}
+		else
+		{
+			LOG_WARNING("The benchmark framebuffer is incomplete");
+		}
+
+		glBindVertexArray(0);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glDeleteVertexArrays(1, &emptyVAO);
+		glDeleteFramebuffers(1, &framebuffer);
+		glDeleteTextures(1, &colorTexture);
+		delete pShaderManager;
+		pShaderManager = NULL;
+
+		glfwMakeContextCurrent(NULL);
+		glfwDestroyWindow(pWindow);
+
+		if ((passes == 0) || (seconds <= 0.0))
+		{
+			return(false);
+		}
+		megapixelsPerSecond = ((double)passes * BENCHMARK_WIDTH * BENCHMARK_HEIGHT) / (seconds * 1000000.0);
+		return(true);
+	}
+
+	/***********************************************************
+	 *  MeasureCPU()
+	 *
+	 *  This function is used for measuring how fast one thread
+	 *  composes object transforms, the way the scene does for
+	 *  every drawn object.
+	 ***********************************************************/
+	double MeasureCPU()
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		float sum = 0.0f;
+		for (int i = 0; i < BENCHMARK_MATRICES; i++)
+		{
+			float value = (float)(i & 1023) * 0.001f;
+			glm::mat4 scale = glm::scale(glm::vec3(1.0f + value));
+			glm::mat4 rotation = glm::rotate(value, glm::vec3(0.0f, 1.0f, 0.0f));
+			glm::mat4 translation = glm::translate(glm::vec3(value, 0.0f, -value));
+			glm::mat4 model = translation * rotation * scale;
+			sum += model[3][0];
+		}
+		g_BenchmarkResult = sum;
+
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (seconds <= 0.0)
+		{
+			return(HIGH_CPU_MATRICES);
+		}
+		return((double)BENCHMARK_MATRICES / seconds);
+	}
+}
+
+/***********************************************************
+ *  GetPreset()
+ *
+ *  This method is used for getting the values of a preset.
+ *  Medium keeps the look and speed the scene was made with,
+ *  low leaves out the costly effects for slow GPUs and thin
+ *  clients, and high smooths the edges and the textures.
+ ***********************************************************/
+RENDER_SETTINGS RenderSettings::GetPreset(QUALITY_PRESET preset)
+{
+	RENDER_SETTINGS settings;
+	settings.preset = preset;
+	settings.windowWidth = 1000;
+	settings.windowHeight = 800;
+	settings.nearPlane = 0.1f;
+	settings.farPlane = 100.0f;
+	settings.msaaSamples = 0;
+	settings.bTrilinearFiltering = true;
+	settings.anisotropy = 1.0f;
+	settings.pointLights = LightManager::MAX_POINT_LIGHTS;
+	settings.spotLights = LightManager::MAX_SPOT_LIGHTS;
+	settings.snowParticles = 1 << 16;
+	// the scene shader does not sample the probe yet, so capturing
+	// it only costs GPU time until it is turned on with --set
+	settings.bReflectionProbe = false;
+	settings.swapInterval = -1;
+
+	if (preset == QUALITY_LOW)
+	{
+		settings.windowWidth = 800;
+		settings.windowHeight = 640;
+		settings.bTrilinearFiltering = false;
+		// the two ceiling lights are kept, the lamp is left out
+		settings.pointLights = 2;
+		settings.snowParticles = 1 << 13;
+	}
+	else if (preset == QUALITY_HIGH)
+	{
+		settings.windowWidth = 1500;
+		settings.windowHeight = 1200;
+		settings.msaaSamples = 4;
+		settings.anisotropy = 8.0f;
+		settings.snowParticles = 1 << 17;
+	}
+
+	return(settings);
+}
+
+/***********************************************************
+ *  GetPresetName()
+ *
+ *  This method is used for getting the name of a preset as
+ *  it is given on the command line.
+ ***********************************************************/
+const char* RenderSettings::GetPresetName(QUALITY_PRESET preset)
+{
+	return(PRESET_NAMES[preset]);
+}
+
+/***********************************************************
+ *  ParseQuality()
+ *
+ *  This method is used for reading the preset from the
+ *  command line.  False is returned for an unknown preset.
+ ***********************************************************/
+bool RenderSettings::ParseQuality(int argc, char* argv[], QUALITY_PRESET& preset, bool& bAutoTune)
+{
+	bAutoTune = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--quality") == 0) && (i + 1 < argc))
+		{
+			const char* name = argv[++i];
+			if (strcmp(name, "auto") == 0)
+			{
+				bAutoTune = true;
+				continue;
+			}
+
+			bool bFound = false;
+			for (int j = QUALITY_LOW; j <= QUALITY_HIGH; j++)
+			{
+				if (strcmp(name, PRESET_NAMES[j]) == 0)
+				{
+					preset = (QUALITY_PRESET)j;
+					bFound = true;
+				}
+			}
+			if (bFound == false)
+			{
+				LOG_ERROR("The quality must be low, medium, high or auto");
+				return(false);
+			}
+			bAutoTune = false;
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  ParseArguments()
+ *
+ *  This method is used for applying the settings file and
+ *  then the single values of the command line, so the
+ *  command line wins over the file.  False is returned for
+ *  a malformed value.
+ ***********************************************************/
+bool RenderSettings::ParseArguments(int argc, char* argv[], RENDER_SETTINGS& settings)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--settings") == 0) && (i + 1 < argc))
+		{
+			if (LoadFile(argv[++i], settings) == false)
+			{
+				return(false);
+			}
+		}
+	}
+
+	for (int i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--window") == 0) && (i + 1 < argc))
+		{
+			int width = 0, height = 0;
+			if ((sscanf(argv[++i], "%dx%d", &width, &height) != 2) ||
+				(width < 320) || (height < 240))
+			{
+				LOG_ERROR("the window size must be given as WxH, like 1000x800");
+				return(false);
+			}
+			settings.windowWidth = width;
+			settings.windowHeight = height;
+		}
+		else if ((strcmp(argv[i], "--set") == 0) && (i + 1 < argc))
+		{
+			std::string assignment = argv[++i];
+			size_t equals = assignment.find('=');
+			if (equals == std::string::npos)
+			{
+				LOG_ERROR("a render setting must be given as key=value, like msaa=4");
+				return(false);
+			}
+			if (ApplyValue(settings, assignment.substr(0, equals).c_str(), assignment.substr(equals + 1).c_str()) == false)
+			{
+				return(false);
+			}
+		}
+	}
+
+	if ((settings.farPlane > settings.nearPlane) == false)
+	{
+		LOG_ERROR("The far plane must be farther than the near plane");
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  LoadFile()
+ *
+ *  This method is used for reading a settings file of
+ *  key = value lines.  Empty lines and the text after a #
+ *  are skipped.
+ ***********************************************************/
+bool RenderSettings::LoadFile(const char* fileName, RENDER_SETTINGS& settings)
+{
+	std::ifstream file(fileName);
+	if (!file)
+	{
+		LOG_ERROR("Could not read the render settings from %s", fileName);
+		return(false);
+	}
+
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(file, line))
+	{
+		lineNumber++;
+		size_t comment = line.find('#');
+		if (comment != std::string::npos)
+		{
+			line.erase(comment);
+		}
+		size_t first = line.find_first_not_of(" \t\r");
+		if (first == std::string::npos)
+		{
+			continue;
+		}
+
+		size_t equals = line.find('=');
+		if (equals == std::string::npos)
+		{
+			LOG_ERROR("Line %d of %s is not a key = value line", lineNumber, fileName);
+			return(false);
+		}
+		std::string key = line.substr(first, equals - first);
+		std::string value = line.substr(equals + 1);
+		key.erase(key.find_last_not_of(" \t") + 1);
+		value.erase(0, value.find_first_not_of(" \t"));
+		value.erase(value.find_last_not_of(" \t\r") + 1);
+
+		if (ApplyValue(settings, key.c_str(), value.c_str()) == false)
+		{
+			LOG_ERROR("Line %d of %s was not applied", lineNumber, fileName);
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  AutoTune()
+ *
+ *  This method is used for picking the preset from the
+ *  speed of this machine.  The GPU rate picks the preset,
+ *  and a slow CPU or few threads hold it back, since the
+ *  culling and the draw calls run on the CPU.  Medium is
+ *  kept when the GPU cannot be measured.
+ ***********************************************************/
+QUALITY_PRESET RenderSettings::AutoTune()
+{
+	double gpuMegapixels = 0.0;
+	if (MeasureGPU(gpuMegapixels) == false)
+	{
+		LOG_WARNING("The GPU could not be measured, the medium quality is used");
+		return(QUALITY_MEDIUM);
+	}
+	double cpuMatrices = MeasureCPU();
+	unsigned int threads = std::thread::hardware_concurrency();
+
+	QUALITY_PRESET preset = QUALITY_MEDIUM;
+	if (gpuMegapixels < LOW_GPU_MEGAPIXELS)
+	{
+		preset = QUALITY_LOW;
+	}
+	else if (gpuMegapixels >= HIGH_GPU_MEGAPIXELS)
+	{
+		preset = QUALITY_HIGH;
+	}
+
+	// hardware_concurrency is 0 when it is not known, which does
+	// not hold the preset back
+	if (((threads > 0) && (threads < LOW_CPU_THREADS)) || (cpuMatrices < LOW_CPU_MATRICES))
+	{
+		preset = QUALITY_LOW;
+	}
+	else if ((preset == QUALITY_HIGH) &&
+		(((threads > 0) && (threads < HIGH_CPU_THREADS)) || (cpuMatrices < HIGH_CPU_MATRICES)))
+	{
+		preset = QUALITY_MEDIUM;
+	}
+
+	LOG_INFO("Benchmark: GPU %.0f megapixels/s, CPU %.1f million transforms/s on %u threads, %s quality",
+		gpuMegapixels, cpuMatrices / 1000000.0, threads, PRESET_NAMES[preset]);
+
+	return(preset);
+}
+
+/***********************************************************
+ *  Set()
+ *
+ *  This method is used for choosing the settings that the
+ *  windows and the scene are created with.
+ ***********************************************************/
+void RenderSettings::Set(const RENDER_SETTINGS& settings)
+{
+	g_Settings = settings;
+}
+
+/***********************************************************
+ *  Get()
+ *
+ *  This method is used for getting the chosen settings.
+ ***********************************************************/
+const RENDER_SETTINGS& RenderSettings::Get()
+{
+	return(g_Settings);
+}
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+// rendersettings.h
+// ================
+// choose the performance-relevant rendering values from quality presets, a
+// settings file and the command line, or from a startup benchmark
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// the quality presets, from thin clients up to workstations
+enum QUALITY_PRESET
+{
+	QUALITY_LOW = 0,
+	QUALITY_MEDIUM,
+	QUALITY_HIGH
+};
+
+// the rendering values that trade quality for speed
+struct RENDER_SETTINGS
+{
+	// the preset the values started from
+	QUALITY_PRESET preset;
+	// the size of the main window in screen coordinates
+	int windowWidth;
+	int windowHeight;
+	// the clip planes of the perspective and orthographic views
+	float nearPlane;
+	float farPlane;
+	// the samples per pixel of the main window, 0 for none
+	int msaaSamples;
+	// filter the scene textures between their mipmaps
+	bool bTrilinearFiltering;
+	// the anisotropic filtering of the scene textures, 1 for none
+	float anisotropy;
+	// the point and spot lights that are kept, up to the slots of
+	// the fragment shader
+	int pointLights;
+	int spotLights;
+	// the snow particles in the snowglobe, 0 for no snow
+	int snowParticles;
+	// reflect the room in the snowglobe glass - off in every preset
+	// until the scene shader samples the probe
+	bool bReflectionProbe;
+	// the buffer swap interval, 0 for no vertical sync and -1 to
+	// keep the default of the driver
+	int swapInterval;
+};
+
+/***********************************************************
+ *  RenderSettings
+ *
+ *  The settings start from a preset, chosen with --quality
+ *  or medium when it is not given, and a settings file of
+ *  key = value lines and the --window and --set options are
+ *  applied over it, in that order.  With --quality auto the
+ *  preset is picked by a short benchmark that draws into a
+ *  hidden window before the main window is created.  The
+ *  settings must be chosen before the windows and the scene
+ *  are created, since they are read while those are set up.
+ ***********************************************************/
+class RenderSettings
+{
+public:
+	static RENDER_SETTINGS GetPreset(QUALITY_PRESET preset);
+	static const char* GetPresetName(QUALITY_PRESET preset);
+
+	// read the --quality option - auto asks for the benchmark
+	static bool ParseQuality(int argc, char* argv[], QUALITY_PRESET& preset, bool& bAutoTune);
+	// apply the --settings file and the --window and --set options
+	// over the passed in settings
+	static bool ParseArguments(int argc, char* argv[], RENDER_SETTINGS& settings);
+	// apply the key = value lines of a settings file
+	static bool LoadFile(const char* fileName, RENDER_SETTINGS& settings);
+
+	// measure the GPU and the CPU and pick the preset that fits
+	// them - GLFW must be initialized and no window created yet
+	static QUALITY_PRESET AutoTune();
+
+	static void Set(const RENDER_SETTINGS& settings);
+	static const RENDER_SETTINGS& Get();
+};
@@ -0,0 +1,475 @@
+///////////////////////////////////////////////////////////////////////////////
+// roomreplicator.cpp
+// ==================
+// replicate the reference room in a grid of rooms with reproducible random
+// variation, used for measuring how the renderer scales with scene size
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RoomReplicator.h"
+#include "Logger.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	// the book covers that replicated books choose from
+	const char* const g_BookCovers[] = { "books", "book2" };
+	const int BOOK_COVER_COUNT = (int)(sizeof(g_BookCovers) / sizeof(g_BookCovers[0]));
+
+	// the grid that the 3D scene is built with
+	ROOM_GRID_SETTINGS g_SceneSettings = RoomReplicator::GetDefaultSettings();
+
+	/***********************************************************
+	 *  RandomUnit()
+	 *
+	 *  This function is used for getting a random value from
+	 *  0 to 1 with the splitmix64 generator.  It is written out
+	 *  here, since the standard distributions differ between
+	 *  libraries and the rooms must be the same everywhere, and
+	 *  seeding a standard engine for every room is slow.
+	 ***********************************************************/
+	inline float RandomUnit(uint64_t& state)
+	{
+		state += 0x9E3779B97F4A7C15ull;
+		uint64_t value = state;
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+		value = value ^ (value >> 31);
+
+		return((float)(value >> 40) * (1.0f / 16777216.0f));
+	}
+
+	/***********************************************************
+	 *  PlaceWallWithDoorway()
+	 *
+	 *  This function is used for replacing a wall plane with
+	 *  the three planes around a doorway at the bottom middle
+	 *  of the wall - the parts to each side and the part over
+	 *  the doorway.
+	 ***********************************************************/
+	int PlaceWallWithDoorway(
+		const SCENE_OBJECT_DEFINITION& wall,
+		glm::dvec3 roomOrigin,
+		float doorwayWidth,
+		float doorwayHeight,
+		const RoomReplicator::PLACE_CALLBACK& placeObject)
+	{
+		// the world directions of the plane mesh X and Z axes, from
+		// the rotZ * rotY * rotX order of SetTransformations()
+		float radiansX = glm::radians(wall.XrotationDegrees);
+		float radiansY = glm::radians(wall.YrotationDegrees);
+		float radiansZ = glm::radians(wall.ZrotationDegrees);
+		float cx = cosf(radiansX), sx = sinf(radiansX);
+		float cy = cosf(radiansY), sy = sinf(radiansY);
+		float cz = cosf(radiansZ), sz = sinf(radiansZ);
+		glm::vec3 axisX = glm::vec3(cy * cz, cy * sz, -sy);
+		glm::vec3 axisZ = glm::vec3(
+			cx * sy * cz + sx * sz,
+			cx * sy * sz - sx * cz,
+			cx * cy);
+
+		// one of the axes runs up the wall, the other across it
+		bool bVerticalZ = fabsf(axisZ.y) > fabsf(axisX.y);
+		glm::vec3 acrossAxis = bVerticalZ ? axisX : axisZ;
+		glm::vec3 upAxis = bVerticalZ ? axisZ : axisX;
+		float halfAcross = bVerticalZ ? wall.scaleXYZ.x : wall.scaleXYZ.z;
+		float halfUp = bVerticalZ ? wall.scaleXYZ.z : wall.scaleXYZ.x;
+		if (upAxis.y < 0.0f)
+		{
+			upAxis = upAxis * -1.0f;
+		}
+
+		float halfDoorway = doorwayWidth * 0.5f;
+		float sideHalfWidth = (halfAcross - halfDoorway) * 0.5f;
+		float lintelHalfHeight = (2.0f * halfUp - doorwayHeight) * 0.5f;
+		if ((sideHalfWidth <= 0.0f) || (lintelHalfHeight <= 0.0f))
+		{
+			placeObject(wall, roomOrigin);
+			return(1);
+		}
+
+		// the center across, the center up, and the half sizes of
+		// the three parts of the wall
+		const float parts[3][4] =
+		{
+			{ -halfAcross + sideHalfWidth, 0.0f, sideHalfWidth, halfUp },
+			{ halfAcross - sideHalfWidth, 0.0f, sideHalfWidth, halfUp },
+			{ 0.0f, halfUp - lintelHalfHeight, halfDoorway, lintelHalfHeight }
+		};
+
+		for (int part = 0; part < 3; part++)
+		{
+			SCENE_OBJECT_DEFINITION wallPart = wall;
+			wallPart.positionXYZ = wall.positionXYZ + acrossAxis * parts[part][0] + upAxis * parts[part][1];
+			wallPart.scaleXYZ = bVerticalZ ?
+				glm::vec3(parts[part][2], wall.scaleXYZ.y, parts[part][3]) :
+				glm::vec3(parts[part][3], wall.scaleXYZ.y, parts[part][2]);
+			placeObject(wallPart, roomOrigin);
+		}
+
+		return(3);
+	}
+}
+
+/***********************************************************
+ *  RoomReplicator()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+RoomReplicator::RoomReplicator(const ROOM_GRID_SETTINGS& settings)
+{
+	m_settings = settings;
+	m_settings.roomsX = (settings.roomsX > 0) ? settings.roomsX : 1;
+	m_settings.roomsY = (settings.roomsY > 0) ? settings.roomsY : 1;
+	m_settings.roomsZ = (settings.roomsZ > 0) ? settings.roomsZ : 1;
+}
+
+/***********************************************************
+ *  GetDefaultSettings()
+ *
+ *  This method is used for getting the settings of the
+ *  single reference room.  The spacing and the bounds fit
+ *  the 40 x 40 floor and the 40 high walls of the room.
+ ***********************************************************/
+ROOM_GRID_SETTINGS RoomReplicator::GetDefaultSettings()
+{
+	ROOM_GRID_SETTINGS settings;
+
+	settings.roomsX = 1;
+	settings.roomsY = 1;
+	settings.roomsZ = 1;
+	settings.roomSpacing = glm::vec3(40.0f, 40.0f, 40.0f);
+	settings.roomBoundsMin = glm::vec3(-20.0f, 0.0f, -20.0f);
+	settings.roomBoundsMax = glm::vec3(20.0f, 40.0f, 20.0f);
+	settings.doorwayWidth = 8.0f;
+	settings.doorwayHeight = 14.0f;
+	settings.seed = 1;
+	settings.missingChance = 0.15f;
+	settings.rotationJitterDegrees = 15.0f;
+	settings.bStreamRooms = false;
+	settings.visibleSetFile = NULL;
+
+	return(settings);
+}
+
+/***********************************************************
+ *  GetRoomCount()
+ *
+ *  This method is used for getting the number of rooms.
+ ***********************************************************/
+int RoomReplicator::GetRoomCount() const
+{
+	return(m_settings.roomsX * m_settings.roomsY * m_settings.roomsZ);
+}
+
+/***********************************************************
+ *  GetRoomOrigin()
+ *
+ *  This method is used for getting the offset of a room
+ *  from the reference room.  The rooms are numbered along
+ *  X first, then Z, then Y.
+ ***********************************************************/
+glm::dvec3 RoomReplicator::GetRoomOrigin(int roomIndex) const
+{
+	int roomX = roomIndex % m_settings.roomsX;
+	int roomZ = (roomIndex / m_settings.roomsX) % m_settings.roomsZ;
+	int roomY = roomIndex / (m_settings.roomsX * m_settings.roomsZ);
+
+	return(glm::dvec3(
+		(double)m_settings.roomSpacing.x * roomX,
+		(double)m_settings.roomSpacing.y * roomY,
+		// the rooms extend away from the camera
+		-(double)m_settings.roomSpacing.z * roomZ));
+}
+
+/***********************************************************
+ *  ReplicateRoom()
+ *
+ *  This method is used for placing the room objects in one
+ *  room of the grid.  It only reads the settings, so rooms
+ *  can be built on several threads at once.
+ ***********************************************************/
+int RoomReplicator::ReplicateRoom(
+	int roomIndex,
+	const SCENE_OBJECT_DEFINITION* pRoomObjects,
+	int objectCount,
+	const PLACE_CALLBACK& placeObject) const
+{
+	if ((NULL == pRoomObjects) || (!placeObject) ||
+		(roomIndex < 0) || (roomIndex >= GetRoomCount()))
+	{
+		return(0);
+	}
+
+	glm::dvec3 roomOrigin = GetRoomOrigin(roomIndex);
+	bool bReferenceRoom = (roomIndex == 0);
+	uint64_t generator = ((uint64_t)m_settings.seed << 32) | (uint32_t)roomIndex;
+	int placedCount = 0;
+
+	for (int i = 0; i < objectCount; i++)
+	{
+		SCENE_OBJECT_DEFINITION object = pRoomObjects[i];
+
+		// the random values are drawn for every object, so
+		// that changing one flag does not shift the others
+		float missingRoll = RandomUnit(generator);
+		float rotationRoll = RandomUnit(generator);
+		float coverRoll = RandomUnit(generator);
+
+		if (bReferenceRoom == false)
+		{
+			if ((object.variation & VARIATION_OPTIONAL) &&
+				(missingRoll < m_settings.missingChance))
+			{
+				continue;
+			}
+			if (object.variation & VARIATION_ROTATION)
+			{
+				object.YrotationDegrees += (rotationRoll * 2.0f - 1.0f) * m_settings.rotationJitterDegrees;
+			}
+			if (object.variation & VARIATION_BOOK_COVER)
+			{
+				object.textureTag = g_BookCovers[(int)(coverRoll * BOOK_COVER_COUNT) % BOOK_COVER_COUNT];
+			}
+		}
+
+		if (((object.variation & VARIATION_DOORWAY_X) && HasDoorway(roomIndex, 0)) ||
+			((object.variation & VARIATION_DOORWAY_Z) && HasDoorway(roomIndex, 2)))
+		{
+			placedCount += PlaceWallWithDoorway(object, roomOrigin, m_settings.doorwayWidth, m_settings.doorwayHeight, placeObject);
+			continue;
+		}
+
+		placeObject(object, roomOrigin);
+		placedCount++;
+	}
+
+	return(placedCount);
+}
+
+/***********************************************************
+ *  HasDoorway()
+ *
+ *  This method is used for checking whether the wall of a
+ *  room toward its next room along +X or -Z has a doorway.
+ *  Only walls between two copies get one, so the reference
+ *  room keeps its closed walls.
+ ***********************************************************/
+bool RoomReplicator::HasDoorway(int roomIndex, int axis) const
+{
+	if ((roomIndex <= 0) || (roomIndex >= GetRoomCount()))
+	{
+		return(false);
+	}
+
+	int roomX = roomIndex % m_settings.roomsX;
+	int roomZ = (roomIndex / m_settings.roomsX) % m_settings.roomsZ;
+	if (axis == 0)
+	{
+		return(roomX + 1 < m_settings.roomsX);
+	}
+	if (axis == 2)
+	{
+		return(roomZ + 1 < m_settings.roomsZ);
+	}
+
+	return(false);
+}
+
+/***********************************************************
+ *  BuildPortals()
+ *
+ *  This method is used for adding the rooms to a portal
+ *  system, with the cell index matching the room index.
+ *  The rooms along the -X and +Z edges of the grid have no
+ *  wall on that side, and the top rooms have no ceiling,
+ *  so those sides are portals into the exterior cell.
+ ***********************************************************/
+void RoomReplicator::BuildPortals(PortalSystem& portals) const
+{
+	int roomCount = GetRoomCount();
+	glm::vec3 boundsMin = m_settings.roomBoundsMin;
+	glm::vec3 boundsMax = m_settings.roomBoundsMax;
+	glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+	float halfDoorway = m_settings.doorwayWidth * 0.5f;
+
+	for (int roomIndex = 0; roomIndex < roomCount; roomIndex++)
+	{
+		glm::vec3 origin = glm::vec3(GetRoomOrigin(roomIndex));
+		portals.AddCell(origin + boundsMin, origin + boundsMax);
+	}
+	int exteriorCell = portals.AddExteriorCell();
+
+	for (int roomIndex = 0; roomIndex < roomCount; roomIndex++)
+	{
+		glm::vec3 origin = glm::vec3(GetRoomOrigin(roomIndex));
+		glm::vec3 lower = origin + boundsMin;
+		glm::vec3 upper = origin + boundsMax;
+		glm::vec3 middle = origin + center;
+		int roomX = roomIndex % m_settings.roomsX;
+		int roomZ = (roomIndex / m_settings.roomsX) % m_settings.roomsZ;
+		int roomY = roomIndex / (m_settings.roomsX * m_settings.roomsZ);
+		float doorwayTop = lower.y + m_settings.doorwayHeight;
+
+		if (HasDoorway(roomIndex, 0))
+		{
+			portals.AddPortal(roomIndex, roomIndex + 1, {
+				glm::vec3(upper.x, lower.y, middle.z - halfDoorway),
+				glm::vec3(upper.x, lower.y, middle.z + halfDoorway),
+				glm::vec3(upper.x, doorwayTop, middle.z + halfDoorway),
+				glm::vec3(upper.x, doorwayTop, middle.z - halfDoorway) });
+		}
+		if (HasDoorway(roomIndex, 2))
+		{
+			portals.AddPortal(roomIndex, roomIndex + m_settings.roomsX, {
+				glm::vec3(middle.x - halfDoorway, lower.y, lower.z),
+				glm::vec3(middle.x + halfDoorway, lower.y, lower.z),
+				glm::vec3(middle.x + halfDoorway, doorwayTop, lower.z),
+				glm::vec3(middle.x - halfDoorway, doorwayTop, lower.z) });
+		}
+		if (roomX == 0)
+		{
+			portals.AddPortal(roomIndex, exteriorCell, {
+				glm::vec3(lower.x, lower.y, lower.z),
+				glm::vec3(lower.x, lower.y, upper.z),
+				glm::vec3(lower.x, upper.y, upper.z),
+				glm::vec3(lower.x, upper.y, lower.z) });
+		}
+		if (roomZ == 0)
+		{
+			portals.AddPortal(roomIndex, exteriorCell, {
+				glm::vec3(lower.x, lower.y, upper.z),
+				glm::vec3(upper.x, lower.y, upper.z),
+				glm::vec3(upper.x, upper.y, upper.z),
+				glm::vec3(lower.x, upper.y, upper.z) });
+		}
+		if (roomY == m_settings.roomsY - 1)
+		{
+			portals.AddPortal(roomIndex, exteriorCell, {
+				glm::vec3(lower.x, upper.y, lower.z),
+				glm::vec3(upper.x, upper.y, lower.z),
+				glm::vec3(upper.x, upper.y, upper.z),
+				glm::vec3(lower.x, upper.y, upper.z) });
+		}
+	}
+}
+
+/***********************************************************
+ *  Replicate()
+ *
+ *  This method is used for placing the room objects in
+ *  every room of the grid.
+ ***********************************************************/
+int RoomReplicator::Replicate(
+	const SCENE_OBJECT_DEFINITION* pRoomObjects,
+	int objectCount,
+	const PLACE_CALLBACK& placeObject) const
+{
+	int placedCount = 0;
+	int roomCount = GetRoomCount();
+
+	for (int roomIndex = 0; roomIndex < roomCount; roomIndex++)
+	{
+		placedCount += ReplicateRoom(roomIndex, pRoomObjects, objectCount, placeObject);
+	}
+
+	return(placedCount);
+}
+
+/***********************************************************
+ *  ParseArguments()
+ *
+ *  This method is used for reading the room grid from the
+ *  command line.  False is returned for a malformed value.
+ ***********************************************************/
+bool RoomReplicator::ParseArguments(int argc, char* argv[], ROOM_GRID_SETTINGS& settings)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--rooms") == 0) && (i + 1 < argc))
+		{
+			int roomsX = 0, roomsY = 0, roomsZ = 0;
+			if ((sscanf(argv[++i], "%dx%dx%d", &roomsX, &roomsY, &roomsZ) != 3) ||
+				(IsGridSizeValid(roomsX, roomsY, roomsZ) == false))
+			{
+				LOG_ERROR("the room grid must be given as NxMxK, like 10x1x10, with up to %d rooms along an axis and %d in all",
+					MAX_ROOMS_PER_AXIS, MAX_ROOM_COUNT);
+				return(false);
+			}
+			settings.roomsX = roomsX;
+			settings.roomsY = roomsY;
+			settings.roomsZ = roomsZ;
+		}
+		else if ((strcmp(argv[i], "--room-seed") == 0) && (i + 1 < argc))
+		{
+			settings.seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+		}
+		else if (strcmp(argv[i], "--stream-rooms") == 0)
+		{
+			settings.bStreamRooms = true;
+		}
+		else if ((strcmp(argv[i], "--room-pvs") == 0) && (i + 1 < argc))
+		{
+			settings.visibleSetFile = argv[++i];
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  IsGridSizeValid()
+ *
+ *  This method is used for checking room counts read from
+ *  the command line or a control client.  The counts must
+ *  be whole numbers from one up to the axis limit, and
+ *  their product must stay within the room limit, so that
+ *  GetRoomCount() cannot overflow.
+ ***********************************************************/
+bool RoomReplicator::IsGridSizeValid(double roomsX, double roomsY, double roomsZ)
+{
+	double counts[3] = { roomsX, roomsY, roomsZ };
+	double roomCount = 1.0;
+	for (int i = 0; i < 3; i++)
+	{
+		if ((std::isfinite(counts[i]) == false) || (counts[i] != std::floor(counts[i])) ||
+			(counts[i] < 1.0) || (counts[i] > (double)MAX_ROOMS_PER_AXIS))
+		{
+			return(false);
+		}
+		roomCount *= counts[i];
+	}
+
+	return(roomCount <= (double)MAX_ROOM_COUNT);
+}
+
+/***********************************************************
+ *  SetSceneSettings()
+ *
+ *  This method is used for choosing the grid that the 3D
+ *  scene is built with - it must be called before the
+ *  scene is prepared.
+ ***********************************************************/
+void RoomReplicator::SetSceneSettings(const ROOM_GRID_SETTINGS& settings)
+{
+	g_SceneSettings = settings;
+}
+
+/***********************************************************
+ *  GetSceneSettings()
+ *
+ *  This method is used for getting the grid that the 3D
+ *  scene is built with.
+ ***********************************************************/
+const ROOM_GRID_SETTINGS& RoomReplicator::GetSceneSettings()
+{
+	return(g_SceneSettings);
+}
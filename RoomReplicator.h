@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// roomreplicator.h
+// ================
+// replicate the reference room in a grid of rooms with reproducible random
+// variation, used for measuring how the renderer scales with scene size
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "PortalSystem.h"
+#include "SceneObjects.h"
+
+#include <functional>
+
+#include <glm/glm.hpp>
+
+// the layout of the replicated rooms
+struct ROOM_GRID_SETTINGS
+{
+	// the number of rooms along the X, Y and Z axes
+	int roomsX;
+	int roomsY;
+	int roomsZ;
+	// the distance between the origins of neighbouring rooms - it
+	// matches the room size, so the rooms share their walls
+	glm::vec3 roomSpacing;
+	// the box of the reference room
+	glm::vec3 roomBoundsMin;
+	glm::vec3 roomBoundsMax;
+	// the size of the doorways cut into the shared walls
+	float doorwayWidth;
+	float doorwayHeight;
+	// the seed of the variation - the same seed always builds
+	// the same rooms
+	unsigned int seed;
+	// chance that an optional object is left out of a copy
+	float missingChance;
+	// the largest random change of the Y rotation in degrees
+	float rotationJitterDegrees;
+	// stream the rooms in around the camera instead of placing
+	// every room when the scene is prepared
+	bool bStreamRooms;
+	// the file of the baked visible sets of the rooms - it is baked
+	// and written when it is missing or made for another grid
+	const char* visibleSetFile;
+};
+
+/***********************************************************
+ *  RoomReplicator
+ *
+ *  This class places copies of the reference room in an
+ *  N x M x K grid.  The room at the grid origin is kept
+ *  exactly as defined, and every other room draws its
+ *  variation from a generator seeded with the grid seed and
+ *  the room index, so a room looks the same no matter how
+ *  large the grid is or in which order it is built.  The
+ *  walls shared by two copies get a doorway, which is the
+ *  portal between the two rooms.
+ ***********************************************************/
+class RoomReplicator
+{
+public:
+	// called for every object placed in a room - the object keeps
+	// its position in the room, and the room origin is passed in
+	// double so large grids keep their precision
+	typedef std::function<void(const SCENE_OBJECT_DEFINITION&, glm::dvec3)> PLACE_CALLBACK;
+
+	RoomReplicator(const ROOM_GRID_SETTINGS& settings);
+
+	// place the passed in room objects in every room of the grid
+	// and return the number of placed objects
+	int Replicate(
+		const SCENE_OBJECT_DEFINITION* pRoomObjects,
+		int objectCount,
+		const PLACE_CALLBACK& placeObject) const;
+
+	// place the passed in room objects in a single room
+	int ReplicateRoom(
+		int roomIndex,
+		const SCENE_OBJECT_DEFINITION* pRoomObjects,
+		int objectCount,
+		const PLACE_CALLBACK& placeObject) const;
+
+	int GetRoomCount() const;
+	// the offset of a room from the reference room
+	glm::dvec3 GetRoomOrigin(int roomIndex) const;
+	// whether the wall of a room toward the next room along +X
+	// (axis 0) or -Z (axis 2) has a doorway
+	bool HasDoorway(int roomIndex, int axis) const;
+	// add a cell for every room and a cell for the space around
+	// them, connected through the doorways and the open sides
+	void BuildPortals(PortalSystem& portals) const;
+	const ROOM_GRID_SETTINGS& GetSettings() const { return(m_settings); }
+
+	// the largest grid that is built - every room is placed in the
+	// transform store or gets a streaming cell, so larger grids take
+	// more memory than the scene can use
+	static const int MAX_ROOMS_PER_AXIS = 256;
+	static const int MAX_ROOM_COUNT = 65536;
+	// true when the room counts are whole numbers within the limits
+	static bool IsGridSizeValid(double roomsX, double roomsY, double roomsZ);
+
+	// the single reference room
+	static ROOM_GRID_SETTINGS GetDefaultSettings();
+	// read the --rooms NxMxK, --room-seed S, --stream-rooms and
+	// --room-pvs FILE command line options
+	static bool ParseArguments(int argc, char* argv[], ROOM_GRID_SETTINGS& settings);
+	// the grid that the 3D scene is built with
+	static void SetSceneSettings(const ROOM_GRID_SETTINGS& settings);
+	static const ROOM_GRID_SETTINGS& GetSceneSettings();
+
+private:
+	ROOM_GRID_SETTINGS m_settings;
+};
@@ -24,6 +24,30 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "SceneManager.h"
+#include "LightManager.h"
+#include "ReflectionProbe.h"
+#include "ParticleSystem.h"
+#include "TransformStore.h"
+#include "SceneObjects.h"
+#include "AnimationSystem.h"
+#include "RoomReplicator.h"
+#include "WorldStreamer.h"
+#include "PortalSystem.h"
+#include "PotentiallyVisibleSet.h"
+#include "RenderOrigin.h"
+#include "SpatialQuery.h"
+#include "ObjectPicker.h"
+#include "ViewLayout.h"
+#include "ThreadPool.h"
+#include "FrameStats.h"
+#include "FrameMetrics.h"
+#include "RenderSettings.h"
+#include "Logger.h"
+
+#include "GLFW/glfw3.h"     // glfwGetTime() for the light animations
+
+#include <algorithm>
+#include <cmath>
 
 #ifndef STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
@@ -32,6 +56,7 @@
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
 
 // declaration of global variables
 namespace
@@ -40,7 +65,132 @@ namespace
 	const char* g_ColorValueName = "objectColor";
 	const char* g_TextureValueName = "objectTexture";
 	const char* g_UseTextureName = "bUseTexture";
-	const char* g_UseLightingName = "bUseLighting";
+
+	// texture slot reserved for the spot light cookie atlas - the
+	// scene textures use the slots below it
+	const int COOKIE_ATLAS_TEXTURE_SLOT = 15;
+	// texture slot reserved for the reflection probe cubemap
+	const int REFLECTION_PROBE_TEXTURE_SLOT = 14;
+	const char* g_UseReflectionProbeName = "bUseReflectionProbe";
+	// the least time between two captures of the reflection probe
+	// when the objects around it keep changing
+	const float PROBE_REFRESH_SECONDS = 0.5f;
+
+	// light manager object owning the scene light sources
+	LightManager* g_pLightManager = nullptr;
+
+	// reflection probe capturing the room around the snowglobe
+	ReflectionProbe* g_pSnowglobeProbe = nullptr;
+	// true while the scene is being rendered into the probe
+	bool g_bRenderingProbe = false;
+
+	// snow particles inside the snowglobe
+	ParticleSystem* g_pSnowParticles = nullptr;
+
+	// the transformations of the scene objects, composed in batches
+	TransformStore* g_pTransformStore = nullptr;
+	// the objects drawn in the 3D scene
+	std::vector<SCENE_OBJECT> g_SceneObjects;
+	// the keyframed animations playing on the scene objects
+	AnimationSystem* g_pAnimationSystem = nullptr;
+	// streams the replicated rooms in and out around the camera
+	WorldStreamer* g_pWorldStreamer = nullptr;
+	// the rooms seen through the doorways from the camera room,
+	// with the cell index matching the room index
+	PortalSystem* g_pPortalSystem = nullptr;
+	// the rooms that can be seen from every room, baked offline
+	PotentiallyVisibleSet* g_pVisibleSet = nullptr;
+	// finds the visible rooms of the views with their own cameras
+	// at the same time
+	ThreadPool* g_pCullingPool = nullptr;
+	// the first scene object of every placed room, and the end
+	// of the last room
+	std::vector<int> g_RoomFirstObject;
+	// answers the ray, nearest object and overlap queries against
+	// the boxes of the placed and resident streamed objects, with
+	// the transform handles as the object ids
+	SpatialQuery* g_pSpatialQuery = nullptr;
+	// the same query over the objects that are never animated,
+	// which the camera collides with
+	SpatialQuery* g_pStaticQuery = nullptr;
+	// the render origin and resident rooms the query was last
+	// marked out of date for
+	unsigned int g_QueryOriginVersion = 0;
+	unsigned int g_QueryResidentVersion = 0;
+	// draws the object ids under the cursor when a pick is asked for
+	ObjectPicker* g_pObjectPicker = nullptr;
+
+	/***********************************************************
+	 *  ComputeObjectBounds()
+	 *
+	 *  This function is used for getting the render space box
+	 *  around a mesh drawn with a composed model matrix.
+	 ***********************************************************/
+	void ComputeObjectBounds(const glm::mat4& modelView, glm::vec3& boundsMin, glm::vec3& boundsMax)
+	{
+		// the basic meshes all fit in the -1 to 1 unit cube, so its
+		// transformed extents bound the drawn mesh in render space
+		glm::vec3 boundsCenter = glm::vec3(modelView[3]);
+		glm::vec3 boundsExtent = glm::vec3(
+			fabs(modelView[0][0]) + fabs(modelView[1][0]) + fabs(modelView[2][0]),
+			fabs(modelView[0][1]) + fabs(modelView[1][1]) + fabs(modelView[2][1]),
+			fabs(modelView[0][2]) + fabs(modelView[1][2]) + fabs(modelView[2][2]));
+
+		boundsMin = boundsCenter - boundsExtent;
+		boundsMax = boundsCenter + boundsExtent;
+	}
+
+	/***********************************************************
+	 *  SetObjectTransform()
+	 *
+	 *  This function is used for setting a composed model
+	 *  matrix into the shader.
+	 ***********************************************************/
+	void SetObjectTransform(ShaderManager* pShaderManager, const glm::mat4& modelView)
+	{
+		if (NULL != pShaderManager)
+		{
+			pShaderManager->setMat4Value(g_ModelName, modelView);
+		}
+	}
+
+	/***********************************************************
+	 *  DrawObjectMesh()
+	 *
+	 *  This function is used for drawing the basic mesh of a
+	 *  scene object.
+	 ***********************************************************/
+	void DrawObjectMesh(ShapeMeshes* pMeshes, SCENE_MESH mesh)
+	{
+		FrameStats::CountDraw();
+		switch (mesh)
+		{
+		case MESH_PLANE:
+			pMeshes->DrawPlaneMesh();
+			break;
+		case MESH_SPHERE:
+			pMeshes->DrawSphereMesh();
+			break;
+		case MESH_CYLINDER:
+			pMeshes->DrawCylinderMesh();
+			break;
+		case MESH_BOX:
+			pMeshes->DrawBoxMesh();
+			break;
+		case MESH_CONE:
+			pMeshes->DrawConeMesh();
+			break;
+		case MESH_PRISM:
+			pMeshes->DrawPrismMesh();
+			break;
+		case MESH_PYRAMID4:
+			pMeshes->DrawPyramid4Mesh();
+			break;
+		case MESH_TAPERED_CYLINDER:
+			pMeshes->DrawTaperedCylinderMesh();
+			break;
+		}
+	}
 }
 
 /***********************************************************
@@ -52,6 +202,9 @@ SceneManager::SceneManager(ShaderManager *pShaderManager)
 {
 	m_pShaderManager = pShaderManager;
 	m_basicMeshes = new ShapeMeshes();
+	g_pTransformStore = new TransformStore();
+	g_pLightManager = new LightManager(pShaderManager);
+	g_pLightManager->SetLightLimits(RenderSettings::Get().pointLights, RenderSettings::Get().spotLights);
 }
 
 /***********************************************************
@@ -64,6 +217,74 @@ SceneManager::~SceneManager()
 	m_pShaderManager = NULL;
 	delete m_basicMeshes;
 	m_basicMeshes = NULL;
+	if (NULL != g_pLightManager)
+	{
+		delete g_pLightManager;
+		g_pLightManager = NULL;
+	}
+	if (NULL != g_pSnowglobeProbe)
+	{
+		delete g_pSnowglobeProbe;
+		g_pSnowglobeProbe = NULL;
+	}
+	if (NULL != g_pSnowParticles)
+	{
+		delete g_pSnowParticles;
+		g_pSnowParticles = NULL;
+	}
+	if (NULL != g_pAnimationSystem)
+	{
+		delete g_pAnimationSystem;
+		g_pAnimationSystem = NULL;
+	}
+	if (NULL != g_pSpatialQuery)
+	{
+		delete g_pSpatialQuery;
+		g_pSpatialQuery = NULL;
+	}
+	if (NULL != g_pStaticQuery)
+	{
+		delete g_pStaticQuery;
+		g_pStaticQuery = NULL;
+	}
+	if (NULL != g_pObjectPicker)
+	{
+		delete g_pObjectPicker;
+		g_pObjectPicker = NULL;
+	}
+	// the streamed rooms release their transforms, so the streamer
+	// is deleted before the transform store
+	if (NULL != g_pWorldStreamer)
+	{
+		delete g_pWorldStreamer;
+		g_pWorldStreamer = NULL;
+	}
+	if (NULL != g_pVisibleSet)
+	{
+		delete g_pVisibleSet;
+		g_pVisibleSet = NULL;
+	}
+	if (NULL != g_pCullingPool)
+	{
+		delete g_pCullingPool;
+		g_pCullingPool = NULL;
+	}
+	if (NULL != g_pPortalSystem)
+	{
+		delete g_pPortalSystem;
+		g_pPortalSystem = NULL;
+	}
+	g_SceneObjects.clear();
+	if (NULL != g_pTransformStore)
+	{
+		delete g_pTransformStore;
+		g_pTransformStore = NULL;
+	}
+	// a scene loaded after this one starts from nothing
+	g_RoomFirstObject.clear();
+	g_QueryOriginVersion = 0;
+	g_QueryResidentVersion = 0;
+	DestroyGLTextures();
 }
 
 /***********************************************************
@@ -95,7 +316,7 @@ bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
 	// if the image was successfully read from the image file
 	if (image)
 	{
-		std::cout << "Successfully loaded image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
+		LOG_INFO("Successfully loaded image:%s, width:%d, height:%d, channels:%d", filename, width, height, colorChannels);
 
 		glGenTextures(1, &textureID);
 		glBindTexture(GL_TEXTURE_2D, textureID);
@@ -103,9 +324,18 @@ bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
 		// set the texture wrapping parameters
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		// set texture filtering parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		// set texture filtering parameters - the quality settings
+		// choose between the mipmaps and how anisotropic it is
+		const RENDER_SETTINGS& settings = RenderSettings::Get();
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+			settings.bTrilinearFiltering ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR_MIPMAP_NEAREST);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		if ((settings.anisotropy > 1.0f) && (GLEW_EXT_texture_filter_anisotropic))
+		{
+			GLfloat maxAnisotropy = 1.0f;
+			glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy);
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, std::min(settings.anisotropy, maxAnisotropy));
+		}
 
 		// if the loaded image is in RGB format
 		if (colorChannels == 3)
@@ -115,7 +345,7 @@ bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
 			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
 		else
 		{
-			std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
+			LOG_ERROR("Not implemented to handle image with %d channels", colorChannels);
 			return false;
 		}
 
@@ -134,7 +364,7 @@ bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
 		return true;
 	}
 
-	std::cout << "Could not load image:" << filename << std::endl;
+	LOG_ERROR("Could not load image:%s", filename);
 
 	// Error loading the image
 	return false;
@@ -166,8 +396,9 @@ void SceneManager::DestroyGLTextures()
 {
 	for (int i = 0; i < m_loadedTextures; i++)
 	{
-		glGenTextures(1, &m_textureIDs[i].ID);
+		glDeleteTextures(1, &m_textureIDs[i].ID);
 	}
+	m_loadedTextures = 0;
 }
 
 /***********************************************************
@@ -287,10 +518,7 @@ void SceneManager::SetTransformations(
 
 	modelView = translation * rotationZ * rotationY * rotationX * scale;
 
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setMat4Value(g_ModelName, modelView);
-	}
+	SetObjectTransform(m_pShaderManager, modelView);
 }
 
 /***********************************************************
@@ -465,61 +693,70 @@ void SceneManager::DefineObjectMaterials()
  *  SetupSceneLights()
  *
  *  This method is called to add and configure the light
- *  sources for the 3D scene.  There are up to 4 light sources.
+ *  sources for the 3D scene.  There are up to 4 point lights
+ *  and 8 spot lights.
+ *  The lights are owned by the light manager, which uploads
+ *  only the lights that change after this initial setup.
  ***********************************************************/
 void SceneManager::SetupSceneLights()
 {
-	// Enable lighting in the shader
-	m_pShaderManager->setBoolValue(g_UseLightingName, true);
-
 	// Directional light setup
-	m_pShaderManager->setVec3Value("directionalLight.direction", -7.0f, 10.0f, -10.0f);
-	m_pShaderManager->setVec3Value("directionalLight.ambient", 0.2f, 0.2f, 0.2f);
-	m_pShaderManager->setVec3Value("directionalLight.diffuse", 0.7f, 0.7f, 0.7f);
-	m_pShaderManager->setVec3Value("directionalLight.specular", 0.0f, 0.0f, 0.0f);
-	m_pShaderManager->setBoolValue("directionalLight.bActive", true);
+	g_pLightManager->AddDirectionalLight(
+		glm::vec3(-7.0f, 10.0f, -10.0f),
+		glm::vec3(0.2f, 0.2f, 0.2f),
+		glm::vec3(0.7f, 0.7f, 0.7f),
+		glm::vec3(0.0f, 0.0f, 0.0f));
 
 	// Point light 1 over ottoman
-	m_pShaderManager->setVec3Value("pointLights[0].position", 14.0f, 35.0f, 5.0f);
-	m_pShaderManager->setVec3Value("pointLights[0].ambient", 0.08f, 0.08f, 0.08f);
-	m_pShaderManager->setVec3Value("pointLights[0].diffuse", 0.4f, 0.4f, 0.4f);
-	m_pShaderManager->setVec3Value("pointLights[0].specular", 0.2f, 0.2f, 0.2f);
-	m_pShaderManager->setFloatValue("pointLights[0].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[0].linear", 0.09f);
-	m_pShaderManager->setFloatValue("pointLights[0].quadratic", 0.032f);
-	m_pShaderManager->setBoolValue("pointLights[0].bActive", true);
+	g_pLightManager->AddPointLight(
+		glm::dvec3(14.0, 35.0, 5.0),
+		glm::vec3(0.08f, 0.08f, 0.08f),
+		glm::vec3(0.4f, 0.4f, 0.4f),
+		glm::vec3(0.2f, 0.2f, 0.2f));
 
 	// Point light 1 over bookshelf
-	m_pShaderManager->setVec3Value("pointLights[1].position", 14.0f, 35.0f, -17.0f);
-	m_pShaderManager->setVec3Value("pointLights[1].ambient", 0.08f, 0.08f, 0.08f);
-	m_pShaderManager->setVec3Value("pointLights[1].diffuse", 0.4f, 0.4f, 0.4f);
-	m_pShaderManager->setVec3Value("pointLights[1].specular", 0.2f, 0.2f, 0.2f);
-	m_pShaderManager->setFloatValue("pointLights[1].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[1].linear", 0.09f);
-	m_pShaderManager->setFloatValue("pointLights[1].quadratic", 0.032f);
-	m_pShaderManager->setBoolValue("pointLights[1].bActive", true);
+	g_pLightManager->AddPointLight(
+		glm::dvec3(14.0, 35.0, -17.0),
+		glm::vec3(0.08f, 0.08f, 0.08f),
+		glm::vec3(0.4f, 0.4f, 0.4f),
+		glm::vec3(0.2f, 0.2f, 0.2f));
 
 	// Point light in lamp
-	m_pShaderManager->setVec3Value("pointLights[2].position", -2.0f, 13.0f, -17.0f);
-	m_pShaderManager->setVec3Value("pointLights[2].ambient", 0.05f, 0.05f, 0.05f);
-	m_pShaderManager->setVec3Value("pointLights[2].diffuse", 0.3f, 0.3f, 0.3f);
-	m_pShaderManager->setVec3Value("pointLights[2].specular", 0.1f, 0.1f, 0.1f);
-	m_pShaderManager->setFloatValue("pointLights[2].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[2].linear", 0.09f);
-	m_pShaderManager->setFloatValue("pointLights[2].quadratic", 0.032f);
-	m_pShaderManager->setBoolValue("pointLights[2].bActive", true);
+	int lampLight1 = g_pLightManager->AddPointLight(
+		glm::dvec3(-2.0, 13.0, -17.0),
+		glm::vec3(0.05f, 0.05f, 0.05f),
+		glm::vec3(0.3f, 0.3f, 0.3f),
+		glm::vec3(0.1f, 0.1f, 0.1f));
 
 	// Point light in lamp
-	m_pShaderManager->setVec3Value("pointLights[3].position", -2.0f, 13.0f, -15.0f);
-	m_pShaderManager->setVec3Value("pointLights[3].ambient", 0.05f, 0.05f, 0.05f);
-	m_pShaderManager->setVec3Value("pointLights[3].diffuse", 0.3f, 0.3f, 0.3f);
-	m_pShaderManager->setVec3Value("pointLights[3].specular", 0.1f, 0.1f, 0.1f);
-	m_pShaderManager->setFloatValue("pointLights[3].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[3].linear", 0.09f);
-	m_pShaderManager->setFloatValue("pointLights[3].quadratic", 0.032f);
-	m_pShaderManager->setBoolValue("pointLights[3].bActive", true);
-
-	
+	int lampLight2 = g_pLightManager->AddPointLight(
+		glm::dvec3(-2.0, 13.0, -15.0),
+		glm::vec3(0.05f, 0.05f, 0.05f),
+		glm::vec3(0.3f, 0.3f, 0.3f),
+		glm::vec3(0.1f, 0.1f, 0.1f));
+
+	// the lamp bulb flickers very slightly - these are the only
+	// animated lights, the other lights are uploaded just once
+	g_pLightManager->SetLightAnimator(lampLight1, LightManager::MakeFlickerAnimator(0.05f, 1.0f));
+	g_pLightManager->SetLightAnimator(lampLight2, LightManager::MakeFlickerAnimator(0.05f, 1.1f));
+
+	// narrow spot light accenting the picture on the wall
+	g_pLightManager->AddSpotLight(
+		glm::dvec3(8.0, 35.0, 0.0),
+		glm::vec3(11.8f, -15.0f, 0.0f),
+		10.0f,
+		14.0f,
+		glm::vec3(0.0f, 0.0f, 0.0f),
+		glm::vec3(0.5f, 0.5f, 0.45f),
+		glm::vec3(0.2f, 0.2f, 0.2f),
+		1.0f,
+		0.014f,
+		0.0007f);
+
+	// upload all of the newly added lights into the shader
+	g_pLightManager->UploadChangedLights();
+	// cookies projected by spot lights are read from the shared atlas
+	g_pLightManager->BindCookieAtlas(COOKIE_ATLAS_TEXTURE_SLOT);
 }
 
 
@@ -603,6 +840,361 @@ void SceneManager::LoadSceneTextures()
 	BindGLTextures();
 }
 
+// declaration of the scene object definitions
+namespace
+{
+	/*** STUDENTS - add a row BELOW for every object drawn in the  ***/
+	/*** 3D scene - the mesh, the XYZ scale, the XYZ rotation in   ***/
+	/*** degrees, the XYZ position, the texture, the material and  ***/
+	/*** the color, and how replicated rooms may vary the object.  ***/
+	const SCENE_OBJECT_DEFINITION g_SceneObjectDefinitions[] =
+	{
+		{ "FLOOR", MESH_PLANE,
+			glm::vec3(20.0f, 1.0f, 20.0f), 0.0f, 0.0f, 0.0f, glm::vec3(0.0f, 0.0f, 0.0f),
+			"floor", "wood", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "WALL 1", MESH_PLANE,
+			glm::vec3(20.0f, 1.0f, 20.0f), 90.0f, 90.0f, 0.0f, glm::vec3(20.0f, 20.0f, 0.0f),
+			"wall", "wall", NO_OBJECT_COLOR, false, VARIATION_DOORWAY_X },
+		{ "WALL 2", MESH_PLANE,
+			glm::vec3(20.0f, 1.0f, 20.0f), 90.0f, 0.0f, 90.0f, glm::vec3(0.0f, 20.0f, -20.0f),
+			"wall", "wall", NO_OBJECT_COLOR, false, VARIATION_DOORWAY_Z },
+		{ "LEAF 1", MESH_PYRAMID4,
+			glm::vec3(0.5f, 1.5f, 0.5f), 45.0f, -90.0f, 0.0f, glm::vec3(-0.5f, 3.0f, 0.0f),
+			"leaf", "leaf", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "LEAF 2", MESH_PYRAMID4,
+			glm::vec3(0.5f, 1.5f, 0.5f), -45.0f, 0.0f, 0.0f, glm::vec3(0.0f, 3.0f, -0.5f),
+			"leaf", "leaf", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "LEAF 3", MESH_PYRAMID4,
+			glm::vec3(0.5f, 1.5f, 0.5f), 45.0f, 0.0f, 0.0f, glm::vec3(0.0f, 3.0f, 0.5f),
+			"leaf", "leaf", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "LEAF 4", MESH_PYRAMID4,
+			glm::vec3(0.5f, 1.5f, 0.5f), -45.0f, -90.0f, 0.0f, glm::vec3(0.5f, 3.0f, 0.0f),
+			"leaf", "leaf", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "LEAF BASE", MESH_PYRAMID4,
+			glm::vec3(0.5f, 1.5f, 0.5f), 0.0f, 0.0f, 0.0f, glm::vec3(0.0f, 3.2f, 0.0f),
+			"leaf", "leaf", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "VASE BASE", MESH_TAPERED_CYLINDER,
+			glm::vec3(1.0f, 1.5f, 1.0f), 180.0f, 0.0f, 0.0f, glm::vec3(0.0f, 2.4f, 0.0f),
+			"vase", "vase", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "OTTOMAN", MESH_CYLINDER,
+			glm::vec3(6.0f, 5.0f, 6.0f), 0.0f, 0.0f, 0.0f, glm::vec3(14.0f, 0.0f, 5.0f),
+			"ottoman", "fabric", NO_OBJECT_COLOR, false, VARIATION_OPTIONAL | VARIATION_ROTATION },
+		{ "PILLOW 1", MESH_BOX,
+			glm::vec3(5.0f, 1.0f, 5.0f), -75.0f, 120.0f, 0.0f, glm::vec3(16.0f, 7.5f, 3.0f),
+			"pillow", "fabric", NO_OBJECT_COLOR, false, VARIATION_OPTIONAL | VARIATION_ROTATION },
+		{ "PILLOW 2", MESH_BOX,
+			glm::vec3(5.0f, 1.0f, 5.0f), 90.0f, 90.0f, -20.0f, glm::vec3(18.0f, 7.5f, 6.0f),
+			"pillow", "fabric", NO_OBJECT_COLOR, false, VARIATION_OPTIONAL | VARIATION_ROTATION },
+		{ "BOOK SHELF BACK", MESH_BOX,
+			glm::vec3(15.0f, 0.5f, 20.0f), 90.0f, 0.0f, 0.0f, glm::vec3(10.8f, 10.0f, -20.0f),
+			"bookshelf", "wood", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "BOOK SHELF MIDDLE", MESH_BOX,
+			glm::vec3(7.0f, 0.5f, 15.0f), 0.0f, 90.0f, 0.0f, glm::vec3(10.8f, 10.0f, -18.0f),
+			"bookshelf", "wood", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "BOOK SHELF UPPER SHELF", MESH_BOX,
+			glm::vec3(7.0f, 0.5f, 15.0f), 0.0f, 90.0f, 0.0f, glm::vec3(10.8f, 15.0f, -18.0f),
+			"bookshelf", "wood", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "BOOK SHELF LOWER SHELF", MESH_BOX,
+			glm::vec3(7.0f, 0.5f, 15.0f), 0.0f, 90.0f, 0.0f, glm::vec3(10.8f, 5.0f, -18.0f),
+			"bookshelf", "wood", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "BOOK SHELF TOP", MESH_BOX,
+			glm::vec3(7.0f, 0.5f, 15.0f), 0.0f, 90.0f, 0.0f, glm::vec3(10.8f, 20.0f, -18.0f),
+			"bookshelf", "wood", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "BOOK SHELF BOTTOM", MESH_BOX,
+			glm::vec3(7.0f, 0.5f, 15.0f), 0.0f, 90.0f, 0.0f, glm::vec3(10.8f, 0.0f, -18.0f),
+			"bookshelf", "wood", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "BOOK SHELF LEFT", MESH_BOX,
+			glm::vec3(7.0f, 0.5f, 20.0f), 90.0f, 90.0f, 0.0f, glm::vec3(3.4f, 10.0f, -18.0f),
+			"bookshelf", "wood", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "BOOK SHELF RIGHT", MESH_BOX,
+			glm::vec3(7.0f, 0.5f, 20.0f), 90.0f, 90.0f, 0.0f, glm::vec3(18.4f, 10.0f, -18.0f),
+			"bookshelf", "wood", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "PICTURE", MESH_BOX,
+			glm::vec3(8.0f, 0.5f, 11.0f), 90.0f, 90.0f, 0.0f, glm::vec3(19.8f, 20.0f, 0.0f),
+			"picture", "paper", NO_OBJECT_COLOR, false, VARIATION_OPTIONAL },
+		{ "RUG", MESH_BOX,
+			glm::vec3(10.0f, 0.3f, 15.0f), 0.0f, 0.0f, 0.0f, glm::vec3(0.0f, 0.0f, 0.0f),
+			"rug", "fabric", NO_OBJECT_COLOR, false, VARIATION_ROTATION },
+		{ "LAMP TOP", MESH_TAPERED_CYLINDER,
+			glm::vec3(2.0f, 3.5f, 2.0f), 0.0f, 0.0f, 0.0f, glm::vec3(-2.0f, 13.0f, -17.0f),
+			"lamp_top", "paper", glm::vec4(0.3f, 0.3f, 0.3f, 0.3f), false, VARIATION_NONE },
+		{ "LAMP BOT", MESH_CYLINDER,
+			glm::vec3(0.3f, 13.0f, 0.3f), 0.0f, 0.0f, 0.0f, glm::vec3(-2.0f, 0.5f, -17.0f),
+			"lamp_bot", "metal", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "LAMP BOT", MESH_CYLINDER,
+			glm::vec3(2.0f, 0.5f, 2.0f), 0.0f, 0.0f, 0.0f, glm::vec3(-2.0f, 0.0f, -17.0f),
+			"lamp_bot", "metal", NO_OBJECT_COLOR, false, VARIATION_NONE },
+		{ "BOOK 1", MESH_BOX,
+			glm::vec3(3.0f, 1.0f, 4.0f), 90.0f, 90.0f, 0.0f, glm::vec3(17.6f, 12.0f, -18.0f),
+			"books", "fabric", NO_OBJECT_COLOR, false, VARIATION_OPTIONAL | VARIATION_BOOK_COVER },
+		{ "BOOK 2", MESH_BOX,
+			glm::vec3(3.0f, 1.0f, 5.0f), 90.0f, 90.0f, 0.0f, glm::vec3(16.3f, 12.5f, -18.0f),
+			"book2", "fabric", NO_OBJECT_COLOR, false, VARIATION_OPTIONAL | VARIATION_BOOK_COVER },
+		{ "BOOK 3", MESH_BOX,
+			glm::vec3(3.0f, 1.0f, 4.0f), 90.0f, 90.0f, 0.0f, glm::vec3(15.0f, 12.0f, -18.0f),
+			"books", "fabric", NO_OBJECT_COLOR, false, VARIATION_OPTIONAL | VARIATION_BOOK_COVER },
+		{ "BOOK 4", MESH_BOX,
+			glm::vec3(3.0f, 1.0f, 4.0f), 90.0f, 90.0f, 0.0f, glm::vec3(4.2f, 17.0f, -18.0f),
+			"books", "fabric", NO_OBJECT_COLOR, false, VARIATION_OPTIONAL | VARIATION_BOOK_COVER },
+		{ "BOOK 5", MESH_BOX,
+			glm::vec3(3.0f, 1.0f, 5.0f), 90.0f, 90.0f, 0.0f, glm::vec3(5.4f, 17.4f, -18.0f),
+			"book2", "fabric", NO_OBJECT_COLOR, false, VARIATION_OPTIONAL | VARIATION_BOOK_COVER },
+		{ "BOOK 6", MESH_BOX,
+			glm::vec3(2.9f, 1.0f, 3.8f), 90.0f, 90.0f, 20.0f, glm::vec3(7.0f, 17.1f, -18.0f),
+			"books", "fabric", NO_OBJECT_COLOR, false, VARIATION_OPTIONAL | VARIATION_BOOK_COVER },
+		{ "SNOWGLOBE BOTTOM", MESH_TAPERED_CYLINDER,
+			glm::vec3(1.0f, 1.0f, 1.0f), 0.0f, 0.0f, 0.0f, glm::vec3(7.0f, 5.0f, -17.0f),
+			"snowglobe_bot", "metal", NO_OBJECT_COLOR, false, VARIATION_OPTIONAL },
+		{ "SNOWGLOBE TOP", MESH_SPHERE,
+			glm::vec3(0.9f, 0.9f, 0.9f), 0.0f, 0.0f, 0.0f, glm::vec3(7.0f, 6.7f, -17.0f),
+			"lamp_bot", "glass", NO_OBJECT_COLOR, true, VARIATION_OPTIONAL },
+	};
+
+	/***********************************************************
+	 *  DefineSceneObjects()
+	 *
+	 *  This function is used for adding the scene objects and
+	 *  their transformations from the definitions above.  The
+	 *  room is replicated into the grid chosen at startup,
+	 *  which is the single reference room by default.
+	 ***********************************************************/
+	void DefineSceneObjects()
+	{
+		int count = (int)(sizeof(g_SceneObjectDefinitions) / sizeof(g_SceneObjectDefinitions[0]));
+		RoomReplicator replicator(RoomReplicator::GetSceneSettings());
+		int roomCount = replicator.GetRoomCount();
+		bool bStreamRooms = replicator.GetSettings().bStreamRooms && (roomCount > 1);
+
+		// a streamed world only places the reference room here
+		int placedRooms = bStreamRooms ? 1 : roomCount;
+		g_SceneObjects.reserve((size_t)count * placedRooms);
+		g_pTransformStore->Reserve(count * placedRooms);
+
+		auto placeObject = [](const SCENE_OBJECT_DEFINITION& definition, glm::dvec3 roomOrigin)
+		{
+			SCENE_OBJECT object;
+
+			object.name = definition.name;
+			object.mesh = definition.mesh;
+			object.textureTag = definition.textureTag;
+			object.materialTag = definition.materialTag;
+			object.color = definition.color;
+			object.bReflective = definition.bReflective;
+			object.transform = g_pTransformStore->AddTransform(
+				definition.scaleXYZ,
+				definition.XrotationDegrees,
+				definition.YrotationDegrees,
+				definition.ZrotationDegrees,
+				roomOrigin + glm::dvec3(definition.positionXYZ));
+
+			g_SceneObjects.push_back(object);
+		};
+
+		// the rooms are only drawn when they can be seen through
+		// the doorways from the camera room
+		if (roomCount > 1)
+		{
+			g_pPortalSystem = new PortalSystem();
+			replicator.BuildPortals(*g_pPortalSystem);
+			g_pCullingPool = new ThreadPool();
+
+			// with baked visible sets the rooms are picked from the
+			// set of the camera room instead of through the portals
+			const char* visibleSetFile = replicator.GetSettings().visibleSetFile;
+			if (NULL != visibleSetFile)
+			{
+				g_pVisibleSet = new PotentiallyVisibleSet();
+				if (g_pVisibleSet->LoadFile(visibleSetFile, *g_pPortalSystem) == false)
+				{
+					g_pVisibleSet->Bake(*g_pPortalSystem, PotentiallyVisibleSet::DEFAULT_SAMPLES_PER_CELL, replicator.GetSettings().seed);
+					g_pVisibleSet->SaveFile(visibleSetFile);
+					LOG_INFO("Baked the visible sets of %d rooms into %s", roomCount, visibleSetFile);
+				}
+				LOG_INFO("Visible sets use %zu bytes", g_pVisibleSet->GetCompressedBytes());
+			}
+		}
+
+		if (bStreamRooms)
+		{
+			// the lights, probe and animations are bound to the
+			// reference room, so it is never streamed out
+			replicator.ReplicateRoom(0, g_SceneObjectDefinitions, count, placeObject);
+			g_RoomFirstObject.push_back(0);
+			g_RoomFirstObject.push_back((int)g_SceneObjects.size());
+			g_pWorldStreamer = new WorldStreamer(
+				g_pTransformStore,
+				replicator,
+				g_SceneObjectDefinitions,
+				count,
+				WorldStreamer::GetDefaultSettings());
+			g_pWorldStreamer->ExcludeCell(0);
+			WorldStreamer::SetScene(g_pWorldStreamer);
+
+			LOG_INFO("Streaming %d rooms around the camera", roomCount);
+			return;
+		}
+
+		for (int roomIndex = 0; roomIndex < roomCount; roomIndex++)
+		{
+			g_RoomFirstObject.push_back((int)g_SceneObjects.size());
+			replicator.ReplicateRoom(roomIndex, g_SceneObjectDefinitions, count, placeObject);
+		}
+		g_RoomFirstObject.push_back((int)g_SceneObjects.size());
+
+		int placedCount = (int)g_SceneObjects.size();
+		if (roomCount > 1)
+		{
+			LOG_INFO("Scene replicated into %d rooms with %d objects", roomCount, placedCount);
+		}
+	}
+
+	/***********************************************************
+	 *  ProvideQueryObjects()
+	 *
+	 *  This function is used for filling the objects of a
+	 *  spatial query with the placed objects of every room,
+	 *  followed by the objects of the resident streamed rooms,
+	 *  leaving out the animated objects when asked to.
+	 ***********************************************************/
+	void ProvideQueryObjects(std::vector<SpatialQuery::QUERY_OBJECT>& queryObjects, bool bStaticOnly)
+	{
+		auto addObject = [&queryObjects, bStaticOnly](const SCENE_OBJECT& object)
+		{
+			if (bStaticOnly && g_pAnimationSystem->IsTransformAnimated(object.transform))
+			{
+				return;
+			}
+
+			SpatialQuery::QUERY_OBJECT queryObject;
+
+			ComputeObjectBounds(g_pTransformStore->GetWorldMatrix(object.transform), queryObject.boundsMin, queryObject.boundsMax);
+			queryObject.objectId = object.transform;
+			queryObjects.push_back(queryObject);
+		};
+
+		for (size_t i = 0; i < g_SceneObjects.size(); i++)
+		{
+			addObject(g_SceneObjects[i]);
+		}
+		if (NULL != g_pWorldStreamer)
+		{
+			const std::vector<int>& cells = g_pWorldStreamer->GetResidentCells();
+			for (size_t c = 0; c < cells.size(); c++)
+			{
+				const std::vector<SCENE_OBJECT>& objects = g_pWorldStreamer->GetCellObjects(cells[c]);
+				for (size_t i = 0; i < objects.size(); i++)
+				{
+					addObject(objects[i]);
+				}
+			}
+		}
+	}
+
+	/***********************************************************
+	 *  FindSceneObjectTransform()
+	 *
+	 *  This function is used for getting the transform handle
+	 *  of the first scene object with the passed in name.
+	 ***********************************************************/
+	int FindSceneObjectTransform(const std::string& name)
+	{
+		for (size_t i = 0; i < g_SceneObjects.size(); i++)
+		{
+			if (name.compare(g_SceneObjects[i].name) == 0)
+			{
+				return(g_SceneObjects[i].transform);
+			}
+		}
+
+		return(-1);
+	}
+
+	/***********************************************************
+	 *  FindSceneObjectName()
+	 *
+	 *  This function is used for getting the name of the
+	 *  placed or resident streamed object with the passed in
+	 *  transform handle.
+	 ***********************************************************/
+	std::string FindSceneObjectName(int transform)
+	{
+		for (size_t i = 0; i < g_SceneObjects.size(); i++)
+		{
+			if (g_SceneObjects[i].transform == transform)
+			{
+				return(g_SceneObjects[i].name);
+			}
+		}
+		if (NULL != g_pWorldStreamer)
+		{
+			const std::vector<int>& cells = g_pWorldStreamer->GetResidentCells();
+			for (size_t c = 0; c < cells.size(); c++)
+			{
+				const std::vector<SCENE_OBJECT>& objects = g_pWorldStreamer->GetCellObjects(cells[c]);
+				for (size_t i = 0; i < objects.size(); i++)
+				{
+					if (objects[i].transform == transform)
+					{
+						return(objects[i].name);
+					}
+				}
+			}
+		}
+
+		return("");
+	}
+
+	/***********************************************************
+	 *  DefineSceneAnimations()
+	 *
+	 *  This function is used for authoring the keyframed clips
+	 *  and binding them to the scene objects.  The keys are
+	 *  sampled densely from the motion, and the compression
+	 *  keeps only the keys needed to reproduce it.
+	 ***********************************************************/
+	void DefineSceneAnimations()
+	{
+		const float TWO_PI = 6.28318531f;
+
+		g_pAnimationSystem = new AnimationSystem(g_pTransformStore);
+
+		// the lamp shade sways a few degrees around the top of the
+		// shade, where it hangs from the lamp pole
+		const glm::vec3 shadePivot = glm::vec3(-2.0f, 16.5f, -17.0f);
+		const float shadeHeight = 3.5f;
+		const float swayDuration = 4.0f;
+		AnimationClip* pSwayClip = new AnimationClip(swayDuration);
+		for (int key = 0; key <= 120; key++)
+		{
+			float time = swayDuration * key / 120.0f;
+			float swayDegrees = 3.0f * sinf(TWO_PI * time / swayDuration);
+			float swayRadians = swayDegrees * 3.14159265f / 180.0f;
+
+			pSwayClip->AddRotationKey(time, 0.0f, 0.0f, swayDegrees);
+			pSwayClip->AddPositionKey(time, shadePivot + glm::vec3(
+				shadeHeight * sinf(swayRadians),
+				-shadeHeight * cosf(swayRadians),
+				0.0f));
+		}
+		pSwayClip->Compress(0.001f, 0.05f, 0.001f);
+		int swayClip = g_pAnimationSystem->AddClip(pSwayClip);
+		g_pAnimationSystem->BindClip(swayClip, FindSceneObjectTransform("LAMP TOP"));
+
+		// the snowglobe slowly turns on its base like a music box
+		const float spinDuration = 20.0f;
+		AnimationClip* pSpinClip = new AnimationClip(spinDuration);
+		for (int key = 0; key <= 80; key++)
+		{
+			float time = spinDuration * key / 80.0f;
+			pSpinClip->AddRotationKey(time, 0.0f, 360.0f * time / spinDuration, 0.0f);
+		}
+		pSpinClip->Compress(0.001f, 0.05f, 0.001f);
+		int spinClip = g_pAnimationSystem->AddClip(pSpinClip);
+		g_pAnimationSystem->BindClip(spinClip, FindSceneObjectTransform("SNOWGLOBE BOTTOM"));
+		g_pAnimationSystem->BindClip(spinClip, FindSceneObjectTransform("SNOWGLOBE TOP"));
+	}
+}
+
 /***********************************************************
  *  PrepareScene()
  *
@@ -618,6 +1210,19 @@ void SceneManager::PrepareScene()
 	DefineObjectMaterials();
 	// add and define the light sources for the scene
 	SetupSceneLights();
+	// add the objects of the scene and their transformations
+	DefineSceneObjects();
+	// bind the keyframed animations to the scene objects
+	DefineSceneAnimations();
+
+	// let the other managers ask what is under the cursor or near
+	// the camera - the hierarchies are built on the first query, and
+	// the camera collision sweeps one sphere at a time, so its query
+	// needs no more than one worker
+	g_pSpatialQuery = new SpatialQuery([](std::vector<SpatialQuery::QUERY_OBJECT>& objects) { ProvideQueryObjects(objects, false); });
+	SpatialQuery::SetScene(g_pSpatialQuery);
+	g_pStaticQuery = new SpatialQuery([](std::vector<SpatialQuery::QUERY_OBJECT>& objects) { ProvideQueryObjects(objects, true); }, 1);
+	SpatialQuery::SetStaticScene(g_pStaticQuery);
 
 	// only one instance of a particular mesh needs to be
 	// loaded in memory no matter how many times it is drawn
@@ -632,7 +1237,54 @@ void SceneManager::PrepareScene()
 	m_basicMeshes->LoadPyramid4Mesh();
 	m_basicMeshes->LoadConeMesh();
 	m_basicMeshes->LoadTaperedCylinderMesh();
-	
+
+	// the glass snowglobe reflects the room from its center - the
+	// probe is captured over the first frames and then cached, and
+	// only with --set reflection_probe=on, since the scene shader
+	// does not sample it yet
+	if (RenderSettings::Get().bReflectionProbe == true)
+	{
+		g_pSnowglobeProbe = new ReflectionProbe(
+			m_pShaderManager,
+			glm::vec3(7.0f, 6.7f, -17.0f),
+			12.0f);
+		if (g_pSnowglobeProbe->CreateProbe() == false)
+		{
+			delete g_pSnowglobeProbe;
+			g_pSnowglobeProbe = NULL;
+		}
+		else
+		{
+			g_pSnowglobeProbe->SetRefreshInterval(PROBE_REFRESH_SECONDS);
+		}
+	}
+	m_pShaderManager->setSampler2DValue("reflectionProbe", REFLECTION_PROBE_TEXTURE_SLOT);
+	m_pShaderManager->setBoolValue(g_UseReflectionProbeName, false);
+
+	// the object ids are only drawn on the frames a pick is asked for
+	g_pObjectPicker = new ObjectPicker(m_pShaderManager);
+	if (g_pObjectPicker->CreatePicker() == false)
+	{
+		delete g_pObjectPicker;
+		g_pObjectPicker = NULL;
+	}
+	ObjectPicker::SetScene(g_pObjectPicker);
+
+	// the snow fills the inside of the snowglobe glass, with as
+	// many flakes as the quality settings allow
+	if (RenderSettings::Get().snowParticles > 0)
+	{
+		g_pSnowParticles = new ParticleSystem(
+			m_pShaderManager,
+			glm::vec3(7.0f, 6.7f, -17.0f),
+			0.85f,
+			RenderSettings::Get().snowParticles);
+		if (g_pSnowParticles->CreateParticles() == false)
+		{
+			delete g_pSnowParticles;
+			g_pSnowParticles = NULL;
+		}
+	}
 }
 
 /***********************************************************
@@ -643,974 +1295,275 @@ void SceneManager::PrepareScene()
  ***********************************************************/
 void SceneManager::RenderScene()
 {
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-/******************************************************************/
-	//FLOOR
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(20.0f, 1.0f, 20.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 0.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("floor");
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPlaneMesh();
-
-
-/****************************************************************/
-/******************************************************************/
-	//WALL 1
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(20.0f, 1.0f, 20.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(20.0f, 20.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("wall");
-	SetShaderMaterial("wall");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPlaneMesh();
-
-/****************************************************************/
-/******************************************************************/
-	//WALL 2
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(20.0f, 1.0f, 20.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 90.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 20.0f, -20.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(1, 1, 1, 1);
-	SetShaderTexture("wall");
-	SetShaderMaterial("wall");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPlaneMesh();
-
-/****************************************************************/
-/******************************************************************/
-	//LEAF 1
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 1.5f, 0.5f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 45.0f;
-	YrotationDegrees = -90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-0.5f, 3.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("leaf");
-	SetShaderMaterial("leaf");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPyramid4Mesh();
-
-/****************************************************************/
-/******************************************************************/
-	//LEAF 2
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 1.5f, 0.5f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = -45.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 3.0f, -0.5f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("leaf");
-	SetShaderMaterial("leaf");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPyramid4Mesh();
-
-/****************************************************************/	
-/******************************************************************/
-	//LEAF 3
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 1.5f, 0.5f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 45.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 3.0f, 0.5f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("leaf");
-	SetShaderMaterial("leaf");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPyramid4Mesh();
-
-/****************************************************************/
-/******************************************************************/
-	//LEAF 4
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 1.5f, 0.5f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = -45.0f;
-	YrotationDegrees = -90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.5f, 3.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("leaf");
-	SetShaderMaterial("leaf");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPyramid4Mesh();
-	
-/****************************************************************/
-/******************************************************************/
-	//LEAF BASE
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 1.5f, 0.5f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 3.2f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("leaf");
-	SetShaderMaterial("leaf");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPyramid4Mesh();
-
-/****************************************************************/
-/******************************************************************/
-	//VASE BASE
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.0f, 1.5f, 1.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 180.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 2.4f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.9, 0.9, 0.9, 0.9);
-	SetShaderTexture("vase");
-	SetShaderMaterial("vase");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawTaperedCylinderMesh();
-
-/****************************************************************/
-/******************************************************************/
-	//OTTOMAN
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(6.0f, 5.0f, 6.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(14.0f, 0.0f, 5.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.9, 0.9, 0.9, 0.9);
-	SetShaderTexture("ottoman");
-	SetShaderMaterial("fabric");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
-
-/******************************************************************/
-/******************************************************************/
-	//PILLOW 1
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 1.0f, 5.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = -75.0f;
-	YrotationDegrees = 120.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(16.0f, 7.5f, 3.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("pillow");
-	SetShaderMaterial("fabric");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-/******************************************************************/
-/******************************************************************/
-	//PILLOW 2
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(5.0f, 1.0f, 5.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = -20.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(18.0f, 7.5f, 6.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("pillow");
-	SetShaderMaterial("fabric");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-/******************************************************************/
-/******************************************************************/
-	//BOOK SHELF BACK
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(15.0f, 0.5f, 20.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(10.8f, 10.0f, -20.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("bookshelf");
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-/******************************************************************/
-/******************************************************************/
-	//BOOK SHELF MIDDLE
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(7.0f, 0.5f, 15.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(10.8f, 10.0f, -18.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("bookshelf");
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-/******************************************************************/
-/******************************************************************/
-//BOOK SHELF UPPER SHELF
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(7.0f, 0.5f, 15.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(10.8f, 15.0f, -18.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("bookshelf");
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-/******************************************************************/
-/******************************************************************/
-//BOOK SHELF LOWER SHELF
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(7.0f, 0.5f, 15.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(10.8f, 5.0f, -18.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("bookshelf");
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-/******************************************************************/
-/******************************************************************/
-//BOOK SHELF TOP
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(7.0f, 0.5f, 15.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(10.8f, 20.0f, -18.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("bookshelf");
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-/******************************************************************/
-/******************************************************************/
-//BOOK SHELF BOTTOM
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(7.0f, 0.5f, 15.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(10.8f, 0.0f, -18.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("bookshelf");
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-/******************************************************************/
-/******************************************************************/
-//BOOK SHELF LEFT
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(7.0f, 0.5f, 20.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(3.4f, 10.0f, -18.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("bookshelf");
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-/******************************************************************/
-/******************************************************************/
-//BOOK SHELF RIGHT
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(7.0f, 0.5f, 20.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(18.4f, 10.0f, -18.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("bookshelf");
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-/******************************************************************/
-/******************************************************************/
-	//PICTURE
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(8.0f, 0.5f, 11.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(19.8f, 20.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("picture");
-	SetShaderMaterial("paper");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-/******************************************************************/
-/******************************************************************/
-
-	//RUG
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(10.0f, 0.3f, 15.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 0.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.5, 0.5, 0.5, 0.5);
-	SetShaderTexture("rug");
-	SetShaderMaterial("fabric");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-/******************************************************************/
-/******************************************************************/
-	//LAMP TOP
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(2.0f, 3.5f, 2.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-2.0f, 13.0f, -17.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.3, 0.3, 0.3, 0.3);
-	SetShaderTexture("lamp_top");
-	SetShaderMaterial("paper");
-
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawTaperedCylinderMesh();
-
-/******************************************************************/
-/******************************************************************/
-	//LAMP BOT
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.3f, 13.0f, 0.3f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-2.0f, 0.5f, -17.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.9, 0.9, 0.9, 0.9);
-	SetShaderTexture("lamp_bot");
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
-
-/******************************************************************/
-/******************************************************************/
-	//LAMP BOT
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(2.0f, 0.5f, 2.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-2.0f, 0.0f, -17.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.9, 0.9, 0.9, 0.9);
-	SetShaderTexture("lamp_bot");
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
-
-/******************************************************************/
-/******************************************************************/
-//BOOK 1
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(3.0f, 1.0f, 4.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(17.6f, 12.0f, -18.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.9, 0.9, 0.9, 0.9);
-	SetShaderTexture("books");
-	SetShaderMaterial("fabric");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-
-/******************************************************************/
-/******************************************************************/
-	//BOOK 2
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(3.0f, 1.0f, 5.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(16.3f, 12.5f, -18.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.9, 0.9, 0.9, 0.9);
-	SetShaderTexture("book2");
-	SetShaderMaterial("fabric");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-/******************************************************************/
-/******************************************************************/
-//BOOK 3
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(3.0f, 1.0f, 4.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(15.0f, 12.0f, -18.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.9, 0.9, 0.9, 0.9);
-	SetShaderTexture("books");
-	SetShaderMaterial("fabric");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-/******************************************************************/
-/******************************************************************/
-//BOOK 4
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(3.0f, 1.0f, 4.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(4.2f, 17.0f, -18.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.9, 0.9, 0.9, 0.9);
-	SetShaderTexture("books");
-	SetShaderMaterial("fabric");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-/******************************************************************/
-/******************************************************************/
-	//BOOK 5
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(3.0f, 1.0f, 5.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(5.4f, 17.4f, -18.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.9, 0.9, 0.9, 0.9);
-	SetShaderTexture("book2");
-	SetShaderMaterial("fabric");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-/******************************************************************/
-/******************************************************************/
-//BOOK 6
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(2.9f, 1.0f, 3.8f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 20.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(7.0f, 17.1f, -18.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.9, 0.9, 0.9, 0.9);
-	SetShaderTexture("books");
-	SetShaderMaterial("fabric");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-/******************************************************************/
-/******************************************************************/
-	//SNOWGLOBE BOTTOM
-// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.0f, 1.0f, 1.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(7.0f, 5.0f, -17.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.9, 0.9, 0.9, 0.9);
-	SetShaderTexture("snowglobe_bot");
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawTaperedCylinderMesh();
-
-/******************************************************************/
-/******************************************************************/
-		//SNOWGLOBE Top
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.9f, 0.9, 0.9f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(7.0f, 6.7f, -17.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.9, 0.9, 0.9, 0.9);
-	SetShaderTexture("lamp_bot");
-	SetShaderMaterial("glass");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-}
+	// the scene is updated once per frame, while the first view is
+	// rendered, and the other views only draw it
+	if ((g_bRenderingProbe == false) && (ViewLayout::GetCurrentView() == 0))
+	{
+		// animate the lights and upload only the lights that changed,
+		// or all of their positions when the render origin moved
+		g_pLightManager->Update((float)glfwGetTime());
+		g_pLightManager->SetRenderOrigin(RenderOrigin::Get());
+		g_pLightManager->UploadChangedLights();
+
+		// sample the keyframed animations into the transform store
+		g_pAnimationSystem->Update((float)glfwGetTime());
 
+		if ((NULL != g_pWorldStreamer) || (NULL != g_pPortalSystem))
+		{
+			const CameraState& camera = ViewLayout::GetCamera(0);
+
+			// the rooms are culled in world space, where float precision
+			// is plenty for whole rooms
+			glm::vec3 cameraPosition = glm::vec3(RenderOrigin::ToWorld(camera.GetPosition()));
+			glm::mat4 worldToRender = glm::mat4(1.0f);
+			worldToRender[3] = glm::vec4(-glm::vec3(RenderOrigin::Get()), 1.0f);
+
+			// load and evict the streamed rooms around the camera
+			if (NULL != g_pWorldStreamer)
+			{
+				g_pWorldStreamer->Update(cameraPosition);
+			}
+
+			// find the rooms seen through the doorways, or from the
+			// baked set of the camera room, for every view with its own
+			// camera - the views keep separate visibility, so the other
+			// views are culled on the workers while the first is culled
+			// here
+			if (NULL != g_pPortalSystem)
+			{
+				auto cullView = [worldToRender](int view)
+				{
+					uint64_t cullStart = FrameMetrics::GetMicroseconds();
+					const CameraState& viewCamera = ViewLayout::GetCamera(view);
+					glm::vec3 viewPosition = glm::vec3(RenderOrigin::ToWorld(viewCamera.GetPosition()));
+					glm::mat4 viewProjection = viewCamera.GetViewProjection() * worldToRender;
+					if (NULL != g_pVisibleSet)
+					{
+						g_pPortalSystem->UpdateVisibility(viewPosition, viewProjection, *g_pVisibleSet, view);
+					}
+					else
+					{
+						g_pPortalSystem->UpdateVisibility(viewPosition, viewProjection, view);
+					}
+					FrameMetrics::RecordSince(METRIC_CPU_CULL, cullStart);
+				};
+
+				int viewCount = ViewLayout::GetViewCount();
+				if (viewCount > PortalSystem::MAX_VIEWS)
+				{
+					viewCount = PortalSystem::MAX_VIEWS;
+				}
+				for (int view = 1; view < viewCount; view++)
+				{
+					if (ViewLayout::GetView(view).cullingView == view)
+					{
+						g_pCullingPool->Enqueue([cullView, view]() { cullView(view); });
+					}
+				}
+				cullView(0);
+				g_pCullingPool->WaitForIdle();
+			}
+		}
 
+		// advance the snow simulation inside the snowglobe
+		if (NULL != g_pSnowParticles)
+		{
+			g_pSnowParticles->Update((float)glfwGetTime());
+		}
 
+		// capture at most one face of the reflection probe - the
+		// scene is rendered into it without the glass snowglobe, and
+		// it is captured again when streamed rooms near it came or
+		// went
+		if (NULL != g_pSnowglobeProbe)
+		{
+			glm::vec3 changedMin;
+			glm::vec3 changedMax;
+			if ((NULL != g_pWorldStreamer) && (g_pWorldStreamer->TakeChangedBounds(changedMin, changedMax) == true))
+			{
+				g_pSnowglobeProbe->InvalidateRegion(changedMin, changedMax);
+			}
+
+			// the animated objects inside its radius, like the lamp
+			// shade and the snowglobe base, are captured again on the
+			// refresh interval of the probe - their matrices are the
+			// render space ones composed on the last frame
+			glm::vec3 renderOrigin = glm::vec3(RenderOrigin::Get());
+			for (int binding = 0; binding < g_pAnimationSystem->GetBindingCount(); binding++)
+			{
+				if (g_pAnimationSystem->IsBindingActive(binding) == true)
+				{
+					ComputeObjectBounds(
+						g_pTransformStore->GetWorldMatrix(g_pAnimationSystem->GetBindingTransform(binding)),
+						changedMin,
+						changedMax);
+					g_pSnowglobeProbe->InvalidateRegion(changedMin + renderOrigin, changedMax + renderOrigin);
+				}
+			}
+
+			g_bRenderingProbe = true;
+			g_pSnowglobeProbe->Update([this]() { RenderScene(); }, (float)glfwGetTime());
+			g_bRenderingProbe = false;
+		}
+	}
+
+	// compose the render space matrices of the objects that were
+	// moved since the last frame - static objects cost nothing here
+	// unless the render origin moved
+	g_pTransformStore->SetRenderOrigin(RenderOrigin::Get());
+	int composedCount = g_pTransformStore->UpdateWorldMatrices();
+
+	// the query boxes are refitted when objects moved and rebuilt
+	// when streamed rooms came or went, on the next query only - the
+	// static objects only move with the render origin
+	if (NULL != g_pSpatialQuery)
+	{
+		unsigned int residentVersion = (NULL != g_pWorldStreamer) ? g_pWorldStreamer->GetResidentVersion() : 0;
+		bool bOriginMoved = (RenderOrigin::GetVersion() != g_QueryOriginVersion);
+		if (residentVersion != g_QueryResidentVersion)
+		{
+			g_pSpatialQuery->Invalidate(true);
+			g_pStaticQuery->Invalidate(true);
+			g_QueryResidentVersion = residentVersion;
+		}
+		else if ((composedCount > 0) || bOriginMoved)
+		{
+			g_pSpatialQuery->Invalidate(false);
+			if (bOriginMoved)
+			{
+				g_pStaticQuery->Invalidate(false);
+			}
+		}
+		g_QueryOriginVersion = RenderOrigin::GetVersion();
+	}
+
+	// set the transformation, texture and material of an object
+	// and draw its basic mesh
+	auto drawObject = [this](const SCENE_OBJECT& object)
+	{
+		SetObjectTransform(m_pShaderManager, g_pTransformStore->GetWorldMatrix(object.transform));
+		if (object.color.a >= 0.0f)
+		{
+			SetShaderColor(object.color.r, object.color.g, object.color.b, object.color.a);
+		}
+		SetShaderTexture(object.textureTag);
+		SetShaderMaterial(object.materialTag);
+		DrawObjectMesh(m_basicMeshes, object.mesh);
+	};
+
+	// visit the objects of the scene and of the resident streamed
+	// rooms - with more than one room, only the rooms seen through
+	// the doorways are visited, and the probe in the reference room
+	// only sees the reference room, whose walls have no doorways
+	int cullingView = ViewLayout::GetView(ViewLayout::GetCurrentView()).cullingView;
+	auto forEachObject = [cullingView](auto visitObject)
+	{
+		int placedRooms = (int)g_RoomFirstObject.size() - 1;
+		for (int room = 0; room < placedRooms; room++)
+		{
+			if ((NULL != g_pPortalSystem) &&
+				(g_bRenderingProbe ? (room != 0) : (g_pPortalSystem->IsCellVisible(room, cullingView) == false)))
+			{
+				continue;
+			}
+			for (int i = g_RoomFirstObject[room]; i < g_RoomFirstObject[room + 1]; i++)
+			{
+				visitObject(g_SceneObjects[i]);
+			}
+		}
+		if ((NULL != g_pWorldStreamer) && (g_bRenderingProbe == false))
+		{
+			const std::vector<int>& cells = g_pWorldStreamer->GetResidentCells();
+			for (size_t c = 0; c < cells.size(); c++)
+			{
+				if (g_pPortalSystem->IsCellVisible(cells[c], cullingView) == false)
+				{
+					continue;
+				}
+				const std::vector<SCENE_OBJECT>& objects = g_pWorldStreamer->GetCellObjects(cells[c]);
+				for (size_t i = 0; i < objects.size(); i++)
+				{
+					visitObject(objects[i]);
+				}
+			}
+		}
+	};
+
+	// draw the ids of the visible objects when a pick was asked
+	// for, and report the picked object once it is read back - only
+	// the views in the main window can be clicked
+	if ((NULL != g_pObjectPicker) && (g_bRenderingProbe == false) &&
+		(ViewLayout::GetView(ViewLayout::GetCurrentView()).framebuffer == 0))
+	{
+		bool bPicked = g_pObjectPicker->Update([this, &forEachObject]()
+		{
+			forEachObject([this](const SCENE_OBJECT& object)
+			{
+				g_pObjectPicker->SetObject(g_pTransformStore->GetWorldMatrix(object.transform), object.transform);
+				DrawObjectMesh(m_basicMeshes, object.mesh);
+			});
+		});
+		if (bPicked)
+		{
+			int pickedObject = g_pObjectPicker->GetPickedObject();
+			if (pickedObject < 0)
+			{
+				LOG_INFO("Nothing picked");
+			}
+			else
+			{
+				LOG_INFO("Picked %s", FindSceneObjectName(pickedObject).c_str());
+			}
+		}
+	}
+
+	// draw the opaque objects of the scene
+	forEachObject([&drawObject](const SCENE_OBJECT& object)
+	{
+		if (object.bReflective == false)
+		{
+			drawObject(object);
+		}
+	});
+
+	// the probe is captured from inside the glass, which must not
+	// block its own reflection
+	if (g_bRenderingProbe == true)
+	{
+		return;
+	}
+
+	// the snow is drawn before the glass that is blended over it
+	if (NULL != g_pSnowParticles)
+	{
+		g_pSnowParticles->Render();
+	}
+
+	// reflect the captured room on the glass objects
+	bool bUseProbe = (NULL != g_pSnowglobeProbe) && (g_pSnowglobeProbe->IsValid());
+	if (bUseProbe)
+	{
+		g_pSnowglobeProbe->BindProbeTexture(REFLECTION_PROBE_TEXTURE_SLOT);
+		m_pShaderManager->setVec3Value("reflectionProbePosition", RenderOrigin::ToRender(glm::dvec3(g_pSnowglobeProbe->GetPosition())));
+		m_pShaderManager->setFloatValue("reflectionProbeMaxLod", (float)(g_pSnowglobeProbe->GetMipCount() - 1));
+	}
+
+	forEachObject([&](const SCENE_OBJECT& object)
+	{
+		if (object.bReflective == false)
+		{
+			return;
+		}
+
+		OBJECT_MATERIAL material;
+		if (bUseProbe && (FindMaterial(object.materialTag, material) == true))
+		{
+			m_pShaderManager->setBoolValue(g_UseReflectionProbeName, true);
+			m_pShaderManager->setFloatValue("reflectionRoughness", ReflectionProbe::ShininessToRoughness(material.shininess));
+		}
+
+		drawObject(object);
+
+		m_pShaderManager->setBoolValue(g_UseReflectionProbeName, false);
+	});
+}
@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////
+// sceneobjects.h
+// ==============
+// the description of the objects that make up the 3D scene
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+// the basic meshes that a scene object can be drawn with
+enum SCENE_MESH
+{
+	MESH_PLANE,
+	MESH_SPHERE,
+	MESH_CYLINDER,
+	MESH_BOX,
+	MESH_CONE,
+	MESH_PRISM,
+	MESH_PYRAMID4,
+	MESH_TAPERED_CYLINDER
+};
+
+// the ways a replicated copy of an object may differ from the
+// object in the reference room
+enum SCENE_VARIATION
+{
+	VARIATION_NONE = 0x00,
+	// the object may be left out of a replicated room
+	VARIATION_OPTIONAL = 0x01,
+	// the Y rotation of the object is randomly changed
+	VARIATION_ROTATION = 0x02,
+	// the object gets a random book cover texture
+	VARIATION_BOOK_COVER = 0x04,
+	// the wall gets a doorway into the next room along +X or -Z
+	VARIATION_DOORWAY_X = 0x08,
+	VARIATION_DOORWAY_Z = 0x10
+};
+
+// the color of the objects that set no color of their own, which
+// is told apart by its negative alpha
+const glm::vec4 NO_OBJECT_COLOR = glm::vec4(0.0f, 0.0f, 0.0f, -1.0f);
+
+// the values used for adding one object to the 3D scene
+struct SCENE_OBJECT_DEFINITION
+{
+	const char* name;
+	SCENE_MESH mesh;
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees;
+	float YrotationDegrees;
+	float ZrotationDegrees;
+	glm::vec3 positionXYZ;
+	const char* textureTag;
+	const char* materialTag;
+	// the color set before the texture, or NO_OBJECT_COLOR
+	glm::vec4 color;
+	bool bReflective;
+	// combination of the SCENE_VARIATION flags
+	unsigned int variation;
+};
+
+// a single drawn object of the 3D scene - the transformation
+// of the object is kept in the transform store, and the name
+// and tags point into the static definition tables
+struct SCENE_OBJECT
+{
+	const char* name;
+	SCENE_MESH mesh;
+	const char* textureTag;
+	const char* materialTag;
+	glm::vec4 color;
+	// handle of the object transformation in the transform store
+	int transform;
+	// true for glass objects reflecting the reflection probe
+	bool bReflective;
+};
@@ -0,0 +1,949 @@
+///////////////////////////////////////////////////////////////////////////////
+// spatialquery.cpp
+// ================
+// answer batches of ray, nearest object and overlap queries against the
+// bounding boxes of the scene objects
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SpatialQuery.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define QUERY_USE_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define QUERY_USE_NEON
+#endif
+
+// declaration of global variables
+namespace
+{
+	// the most objects kept in a leaf of the hierarchy
+	const int MAX_LEAF_OBJECTS = 4;
+	// the hierarchy is split at the median, so its depth is the
+	// log of the object count and this stack is never filled
+	const int MAX_TRAVERSAL_STACK = 64;
+	// the queries answered by one job of the thread pool - smaller
+	// batches are answered on the calling thread
+	const int QUERIES_PER_JOB = 256;
+	// stands in for the inverse of a zero ray direction, and is
+	// small enough that multiplying it by a distance stays finite
+	const float LARGE_INVERSE = 1.0e20f;
+
+	SpatialQuery* g_pSceneQuery = nullptr;
+	SpatialQuery* g_pStaticQuery = nullptr;
+
+	/***********************************************************
+	 *  SafeInverse()
+	 *
+	 *  This function is used for inverting a ray direction
+	 *  component without producing an infinity, which would
+	 *  turn into a NaN in the slab test.
+	 ***********************************************************/
+	inline float SafeInverse(float value)
+	{
+		if (fabsf(value) < 1.0f / LARGE_INVERSE)
+		{
+			return((value < 0.0f) ? -LARGE_INVERSE : LARGE_INVERSE);
+		}
+		return(1.0f / value);
+	}
+
+	/***********************************************************
+	 *  QueryRadius()
+	 *
+	 *  These functions are used for getting the radius swept
+	 *  along a ray, which is zero for a plain ray.
+	 ***********************************************************/
+	inline float QueryRadius(const SpatialQuery::QUERY_RAY&)
+	{
+		return(0.0f);
+	}
+
+	inline float QueryRadius(const SpatialQuery::QUERY_SWEEP& sweep)
+	{
+		return(sweep.radius);
+	}
+
+	/***********************************************************
+	 *  EntryNormal()
+	 *
+	 *  This function is used for finding the face of a box,
+	 *  grown by the swept radius, where a ray enters it.  The
+	 *  face is on the axis the ray crosses last when coming
+	 *  in, and a ray starting inside the box has no normal.
+	 ***********************************************************/
+	glm::vec3 EntryNormal(const SpatialQuery::QUERY_OBJECT& object, const glm::vec3& origin, const glm::vec3& direction, float radius)
+	{
+		glm::vec3 normal = glm::vec3(0.0f);
+		float entry = 0.0f;
+		int entryAxis = -1;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float inverse = SafeInverse(direction[axis]);
+			float first = (object.boundsMin[axis] - radius - origin[axis]) * inverse;
+			float second = (object.boundsMax[axis] + radius - origin[axis]) * inverse;
+			float axisEntry = std::min(first, second);
+			if (axisEntry >= entry)
+			{
+				entry = axisEntry;
+				entryAxis = axis;
+			}
+		}
+
+		if (entryAxis >= 0)
+		{
+			normal[entryAxis] = (direction[entryAxis] > 0.0f) ? -1.0f : 1.0f;
+		}
+		return(normal);
+	}
+
+	/***********************************************************
+	 *  FirstLane()
+	 *
+	 *  This function is used for getting the first lane set
+	 *  in a lane mask.
+	 ***********************************************************/
+	inline int FirstLane(int laneMask)
+	{
+		int lane = 0;
+		while (((laneMask >> lane) & 1) == 0)
+		{
+			lane++;
+		}
+		return(lane);
+	}
+}
+
+/***********************************************************
+ *  RayBoxLanes()
+ *
+ *  This function is used for the slab test of the rays of
+ *  a packet against one box grown by the extent of each
+ *  lane, which sweeps a box of that extent along the ray.
+ *  The distance each ray enters the box is written into
+ *  the entry array, negative when the ray starts inside,
+ *  and the mask of the active rays crossing the box before
+ *  their limit is returned.
+ ***********************************************************/
+template <typename PACKET>
+static inline int RayBoxLanes(const PACKET& packet, const glm::vec3& boundsMin, const glm::vec3& boundsMax, float* entry)
+{
+#if defined(QUERY_USE_SSE2)
+	__m128 nearDistance = _mm_set1_ps(-LARGE_INVERSE);
+	__m128 farDistance = _mm_loadu_ps(packet.limit);
+	for (int axis = 0; axis < 3; axis++)
+	{
+		__m128 position = _mm_loadu_ps(packet.position[axis]);
+		__m128 inverse = _mm_loadu_ps(packet.inverseDirection[axis]);
+		__m128 extent = _mm_loadu_ps(packet.extent[axis]);
+		__m128 first = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_set1_ps(boundsMin[axis]), extent), position), inverse);
+		__m128 second = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(_mm_set1_ps(boundsMax[axis]), extent), position), inverse);
+		nearDistance = _mm_max_ps(nearDistance, _mm_min_ps(first, second));
+		farDistance = _mm_min_ps(farDistance, _mm_max_ps(first, second));
+	}
+	_mm_storeu_ps(entry, nearDistance);
+	__m128 crossing = _mm_and_ps(_mm_cmple_ps(nearDistance, farDistance), _mm_cmple_ps(_mm_setzero_ps(), farDistance));
+	return(_mm_movemask_ps(crossing) & packet.activeMask);
+#elif defined(QUERY_USE_NEON)
+	float32x4_t nearDistance = vdupq_n_f32(-LARGE_INVERSE);
+	float32x4_t farDistance = vld1q_f32(packet.limit);
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float32x4_t position = vld1q_f32(packet.position[axis]);
+		float32x4_t inverse = vld1q_f32(packet.inverseDirection[axis]);
+		float32x4_t extent = vld1q_f32(packet.extent[axis]);
+		float32x4_t first = vmulq_f32(vsubq_f32(vsubq_f32(vdupq_n_f32(boundsMin[axis]), extent), position), inverse);
+		float32x4_t second = vmulq_f32(vsubq_f32(vaddq_f32(vdupq_n_f32(boundsMax[axis]), extent), position), inverse);
+		nearDistance = vmaxq_f32(nearDistance, vminq_f32(first, second));
+		farDistance = vminq_f32(farDistance, vmaxq_f32(first, second));
+	}
+	vst1q_f32(entry, nearDistance);
+	const uint32_t laneBits[4] = { 1, 2, 4, 8 };
+	uint32x4_t crossing = vandq_u32(vcleq_f32(nearDistance, farDistance), vcleq_f32(vdupq_n_f32(0.0f), farDistance));
+	return((int)vaddvq_u32(vandq_u32(crossing, vld1q_u32(laneBits))) & packet.activeMask);
+#else
+	int laneMask = 0;
+	for (int lane = 0; lane < SpatialQuery::PACKET_SIZE; lane++)
+	{
+		float nearDistance = -LARGE_INVERSE;
+		float farDistance = packet.limit[lane];
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float extent = packet.extent[axis][lane];
+			float first = (boundsMin[axis] - extent - packet.position[axis][lane]) * packet.inverseDirection[axis][lane];
+			float second = (boundsMax[axis] + extent - packet.position[axis][lane]) * packet.inverseDirection[axis][lane];
+			nearDistance = std::max(nearDistance, std::min(first, second));
+			farDistance = std::min(farDistance, std::max(first, second));
+		}
+		entry[lane] = nearDistance;
+		if ((nearDistance <= farDistance) && (farDistance >= 0.0f))
+		{
+			laneMask |= 1 << lane;
+		}
+	}
+	return(laneMask & packet.activeMask);
+#endif
+}
+
+/***********************************************************
+ *  PointBoxLanes()
+ *
+ *  This function is used for measuring the squared distance
+ *  from the points of a packet to one box grown by the
+ *  extent of each lane.  The distances are written into the
+ *  distance array, and the mask of the active lanes within
+ *  their limit is returned - a limit of zero tests for an
+ *  overlap of the lane box.
+ ***********************************************************/
+template <typename PACKET>
+static inline int PointBoxLanes(const PACKET& packet, const glm::vec3& boundsMin, const glm::vec3& boundsMax, float* distance)
+{
+#if defined(QUERY_USE_SSE2)
+	__m128 squaredDistance = _mm_setzero_ps();
+	for (int axis = 0; axis < 3; axis++)
+	{
+		__m128 position = _mm_loadu_ps(packet.position[axis]);
+		__m128 extent = _mm_loadu_ps(packet.extent[axis]);
+		__m128 below = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(boundsMin[axis]), extent), position);
+		__m128 above = _mm_sub_ps(_mm_sub_ps(position, extent), _mm_set1_ps(boundsMax[axis]));
+		__m128 outside = _mm_max_ps(_mm_max_ps(below, above), _mm_setzero_ps());
+		squaredDistance = _mm_add_ps(squaredDistance, _mm_mul_ps(outside, outside));
+	}
+	_mm_storeu_ps(distance, squaredDistance);
+	return(_mm_movemask_ps(_mm_cmple_ps(squaredDistance, _mm_loadu_ps(packet.limit))) & packet.activeMask);
+#elif defined(QUERY_USE_NEON)
+	float32x4_t squaredDistance = vdupq_n_f32(0.0f);
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float32x4_t position = vld1q_f32(packet.position[axis]);
+		float32x4_t extent = vld1q_f32(packet.extent[axis]);
+		float32x4_t below = vsubq_f32(vsubq_f32(vdupq_n_f32(boundsMin[axis]), extent), position);
+		float32x4_t above = vsubq_f32(vsubq_f32(position, extent), vdupq_n_f32(boundsMax[axis]));
+		float32x4_t outside = vmaxq_f32(vmaxq_f32(below, above), vdupq_n_f32(0.0f));
+		squaredDistance = vmlaq_f32(squaredDistance, outside, outside);
+	}
+	vst1q_f32(distance, squaredDistance);
+	const uint32_t laneBits[4] = { 1, 2, 4, 8 };
+	uint32x4_t inside = vandq_u32(vcleq_f32(squaredDistance, vld1q_f32(packet.limit)), vld1q_u32(laneBits));
+	return((int)vaddvq_u32(inside) & packet.activeMask);
+#else
+	int laneMask = 0;
+	for (int lane = 0; lane < SpatialQuery::PACKET_SIZE; lane++)
+	{
+		float squaredDistance = 0.0f;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float below = boundsMin[axis] - packet.extent[axis][lane] - packet.position[axis][lane];
+			float above = packet.position[axis][lane] - packet.extent[axis][lane] - boundsMax[axis];
+			float outside = std::max(std::max(below, above), 0.0f);
+			squaredDistance += outside * outside;
+		}
+		distance[lane] = squaredDistance;
+		if (squaredDistance <= packet.limit[lane])
+		{
+			laneMask |= 1 << lane;
+		}
+	}
+	return(laneMask & packet.activeMask);
+#endif
+}
+
+// the packet size is passed by reference to std::min, so it needs
+// a definition
+const int SpatialQuery::PACKET_SIZE;
+
+/***********************************************************
+ *  SpatialQuery()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SpatialQuery::SpatialQuery(OBJECT_PROVIDER provider, int workerCount)
+{
+	m_provider = provider;
+	m_pThreadPool = new ThreadPool(workerCount);
+	m_bOutOfDate = true;
+	m_bRebuild = true;
+}
+
+/***********************************************************
+ *  ~SpatialQuery()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SpatialQuery::~SpatialQuery()
+{
+	if (this == g_pSceneQuery)
+	{
+		g_pSceneQuery = NULL;
+	}
+	if (this == g_pStaticQuery)
+	{
+		g_pStaticQuery = NULL;
+	}
+	if (NULL != m_pThreadPool)
+	{
+		delete m_pThreadPool;
+		m_pThreadPool = NULL;
+	}
+}
+
+/***********************************************************
+ *  GetScene()
+ *
+ *  This method is used for getting the query over the
+ *  scene objects, which is NULL until the scene is
+ *  prepared.
+ ***********************************************************/
+SpatialQuery* SpatialQuery::GetScene()
+{
+	return(g_pSceneQuery);
+}
+
+/***********************************************************
+ *  SetScene()
+ *
+ *  This method is used for setting the query over the
+ *  scene objects.
+ ***********************************************************/
+void SpatialQuery::SetScene(SpatialQuery* pSceneQuery)
+{
+	g_pSceneQuery = pSceneQuery;
+}
+
+/***********************************************************
+ *  GetStaticScene()
+ *
+ *  This method is used for getting the query over the
+ *  scene objects that are never animated, which only needs
+ *  refitting when the render origin moves.
+ ***********************************************************/
+SpatialQuery* SpatialQuery::GetStaticScene()
+{
+	return(g_pStaticQuery);
+}
+
+/***********************************************************
+ *  SetStaticScene()
+ *
+ *  This method is used for setting the query over the
+ *  scene objects that are never animated.
+ ***********************************************************/
+void SpatialQuery::SetStaticScene(SpatialQuery* pStaticQuery)
+{
+	g_pStaticQuery = pStaticQuery;
+}
+
+/***********************************************************
+ *  Invalidate()
+ *
+ *  This method is used for marking the hierarchy out of
+ *  date.  Nothing is done until the next query, so the
+ *  frames without queries cost nothing.
+ ***********************************************************/
+void SpatialQuery::Invalidate(bool bObjectsChanged)
+{
+	m_bOutOfDate = true;
+	if (bObjectsChanged)
+	{
+		m_bRebuild = true;
+	}
+}
+
+/***********************************************************
+ *  GetObjectCount()
+ *
+ *  This method is used for getting the number of objects in
+ *  the hierarchy.
+ ***********************************************************/
+int SpatialQuery::GetObjectCount()
+{
+	EnsureUpToDate();
+	return((int)m_leafObjects.size());
+}
+
+/***********************************************************
+ *  EnsureUpToDate()
+ *
+ *  This method is used for getting the objects from the
+ *  provider and refitting or rebuilding the hierarchy when
+ *  it is out of date.
+ ***********************************************************/
+void SpatialQuery::EnsureUpToDate()
+{
+	if (m_bOutOfDate == false)
+	{
+		return;
+	}
+
+	m_objects.clear();
+	m_provider(m_objects);
+
+	if (m_bRebuild || (m_objects.size() != m_leafObjects.size()))
+	{
+		Build();
+	}
+	else
+	{
+		Refit();
+	}
+
+	m_bOutOfDate = false;
+	m_bRebuild = false;
+}
+
+/***********************************************************
+ *  Build()
+ *
+ *  This method is used for building the hierarchy from the
+ *  objects.  The nodes are stored so the children of a node
+ *  always come after it.
+ ***********************************************************/
+void SpatialQuery::Build()
+{
+	int objectCount = (int)m_objects.size();
+
+	m_leafOrder.resize(objectCount);
+	for (int i = 0; i < objectCount; i++)
+	{
+		m_leafOrder[i] = i;
+	}
+
+	// a binary tree with one or more objects per leaf has fewer
+	// than twice as many nodes as objects
+	m_nodes.clear();
+	m_nodes.reserve(2 * (size_t)objectCount);
+	if (objectCount > 0)
+	{
+		m_nodes.push_back(BVH_NODE());
+		BuildNode(0, 0, objectCount);
+	}
+
+	m_leafObjects.resize(objectCount);
+	for (int i = 0; i < objectCount; i++)
+	{
+		m_leafObjects[i] = m_objects[m_leafOrder[i]];
+	}
+}
+
+/***********************************************************
+ *  BuildNode()
+ *
+ *  This method is used for filling a node with the passed
+ *  in range of the leaf order.  The range is split at the
+ *  median of the object centers along its longest axis.
+ ***********************************************************/
+void SpatialQuery::BuildNode(int nodeIndex, int first, int count)
+{
+	glm::vec3 boundsMin = m_objects[m_leafOrder[first]].boundsMin;
+	glm::vec3 boundsMax = m_objects[m_leafOrder[first]].boundsMax;
+	glm::vec3 centerMin = (boundsMin + boundsMax) * 0.5f;
+	glm::vec3 centerMax = centerMin;
+	for (int i = first + 1; i < first + count; i++)
+	{
+		const QUERY_OBJECT& object = m_objects[m_leafOrder[i]];
+		glm::vec3 center = (object.boundsMin + object.boundsMax) * 0.5f;
+		boundsMin = glm::min(boundsMin, object.boundsMin);
+		boundsMax = glm::max(boundsMax, object.boundsMax);
+		centerMin = glm::min(centerMin, center);
+		centerMax = glm::max(centerMax, center);
+	}
+
+	m_nodes[nodeIndex].boundsMin = boundsMin;
+	m_nodes[nodeIndex].boundsMax = boundsMax;
+	if (count <= MAX_LEAF_OBJECTS)
+	{
+		m_nodes[nodeIndex].first = first;
+		m_nodes[nodeIndex].objectCount = count;
+		return;
+	}
+
+	glm::vec3 centerExtent = centerMax - centerMin;
+	int axis = 0;
+	if (centerExtent.y > centerExtent[axis])
+	{
+		axis = 1;
+	}
+	if (centerExtent.z > centerExtent[axis])
+	{
+		axis = 2;
+	}
+
+	int half = count / 2;
+	const std::vector<QUERY_OBJECT>& objects = m_objects;
+	std::nth_element(
+		m_leafOrder.begin() + first,
+		m_leafOrder.begin() + first + half,
+		m_leafOrder.begin() + first + count,
+		[&objects, axis](int a, int b)
+		{
+			return((objects[a].boundsMin[axis] + objects[a].boundsMax[axis]) <
+				(objects[b].boundsMin[axis] + objects[b].boundsMax[axis]));
+		});
+
+	int child = (int)m_nodes.size();
+	m_nodes.push_back(BVH_NODE());
+	m_nodes.push_back(BVH_NODE());
+	m_nodes[nodeIndex].first = child;
+	m_nodes[nodeIndex].objectCount = -(axis + 1);
+
+	BuildNode(child, first, half);
+	BuildNode(child + 1, first + half, count - half);
+}
+
+/***********************************************************
+ *  Refit()
+ *
+ *  This method is used for moving the boxes of the nodes
+ *  onto the moved objects without changing the tree.  The
+ *  nodes are walked backwards, so the children are refitted
+ *  before their parent.
+ ***********************************************************/
+void SpatialQuery::Refit()
+{
+	for (size_t i = 0; i < m_leafObjects.size(); i++)
+	{
+		m_leafObjects[i] = m_objects[m_leafOrder[i]];
+	}
+
+	for (int nodeIndex = (int)m_nodes.size() - 1; nodeIndex >= 0; nodeIndex--)
+	{
+		BVH_NODE& node = m_nodes[nodeIndex];
+		if (node.objectCount > 0)
+		{
+			node.boundsMin = m_leafObjects[node.first].boundsMin;
+			node.boundsMax = m_leafObjects[node.first].boundsMax;
+			for (int i = node.first + 1; i < node.first + node.objectCount; i++)
+			{
+				node.boundsMin = glm::min(node.boundsMin, m_leafObjects[i].boundsMin);
+				node.boundsMax = glm::max(node.boundsMax, m_leafObjects[i].boundsMax);
+			}
+		}
+		else
+		{
+			node.boundsMin = glm::min(m_nodes[node.first].boundsMin, m_nodes[node.first + 1].boundsMin);
+			node.boundsMax = glm::max(m_nodes[node.first].boundsMax, m_nodes[node.first + 1].boundsMax);
+		}
+	}
+}
+
+/***********************************************************
+ *  RunBatch()
+ *
+ *  This method is used for answering a batch of queries.
+ *  A large batch is split into jobs for the thread pool,
+ *  and the calling thread answers the first job itself
+ *  before waiting for the rest.
+ ***********************************************************/
+void SpatialQuery::RunBatch(int count, const QUERY_RANGE& queryRange)
+{
+	if ((count <= QUERIES_PER_JOB) || (NULL == m_pThreadPool))
+	{
+		queryRange(0, count);
+		return;
+	}
+
+	for (int firstQuery = QUERIES_PER_JOB; firstQuery < count; firstQuery += QUERIES_PER_JOB)
+	{
+		int lastQuery = std::min(firstQuery + QUERIES_PER_JOB, count);
+		m_pThreadPool->Enqueue([&queryRange, firstQuery, lastQuery]() { queryRange(firstQuery, lastQuery); });
+	}
+	queryRange(0, QUERIES_PER_JOB);
+	m_pThreadPool->WaitForIdle();
+}
+
+/***********************************************************
+ *  TraceRayPacket()
+ *
+ *  This method is used for finding the leaf object index of
+ *  the nearest box hit by every ray of a packet.  The limit
+ *  of a ray is cut down to each hit, so the nodes behind
+ *  the nearest hit are skipped, and the child on the side
+ *  the first ray comes from is walked first.  A ray that
+ *  starts inside a box hits it at zero, unless the boxes
+ *  around the start are skipped.
+ ***********************************************************/
+void SpatialQuery::TraceRayPacket(QUERY_PACKET& packet, bool bHitInside, int* pLeafHits) const
+{
+	int stack[MAX_TRAVERSAL_STACK];
+	int stackSize = 0;
+	float entry[PACKET_SIZE];
+
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		const BVH_NODE& node = m_nodes[stack[--stackSize]];
+		int laneMask = RayBoxLanes(packet, node.boundsMin, node.boundsMax, entry);
+		if (laneMask == 0)
+		{
+			continue;
+		}
+
+		if (node.objectCount > 0)
+		{
+			for (int i = node.first; i < node.first + node.objectCount; i++)
+			{
+				int hitMask = RayBoxLanes(packet, m_leafObjects[i].boundsMin, m_leafObjects[i].boundsMax, entry);
+				for (int lane = 0; lane < PACKET_SIZE; lane++)
+				{
+					if (((hitMask & (1 << lane)) == 0) || ((entry[lane] < 0.0f) && (bHitInside == false)))
+					{
+						continue;
+					}
+					packet.limit[lane] = std::max(entry[lane], 0.0f);
+					pLeafHits[lane] = i;
+				}
+			}
+			continue;
+		}
+
+		int axis = -node.objectCount - 1;
+		bool bNegative = packet.inverseDirection[axis][FirstLane(laneMask)] < 0.0f;
+		stack[stackSize++] = bNegative ? node.first : node.first + 1;
+		stack[stackSize++] = bNegative ? node.first + 1 : node.first;
+	}
+}
+
+/***********************************************************
+ *  NearestPacket()
+ *
+ *  This method is used for finding the nearest object box
+ *  to every point of a packet.  The limit of a point is the
+ *  squared distance to the nearest box found so far, and
+ *  the child on the side of the first point is walked
+ *  first.
+ ***********************************************************/
+void SpatialQuery::NearestPacket(QUERY_PACKET& packet, int* pObjectIds) const
+{
+	int stack[MAX_TRAVERSAL_STACK];
+	int stackSize = 0;
+	float distance[PACKET_SIZE];
+
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		const BVH_NODE& node = m_nodes[stack[--stackSize]];
+		int laneMask = PointBoxLanes(packet, node.boundsMin, node.boundsMax, distance);
+		if (laneMask == 0)
+		{
+			continue;
+		}
+
+		if (node.objectCount > 0)
+		{
+			for (int i = node.first; i < node.first + node.objectCount; i++)
+			{
+				int nearMask = PointBoxLanes(packet, m_leafObjects[i].boundsMin, m_leafObjects[i].boundsMax, distance);
+				for (int lane = 0; lane < PACKET_SIZE; lane++)
+				{
+					if ((nearMask & (1 << lane)) && ((distance[lane] < packet.limit[lane]) || (pObjectIds[lane] < 0)))
+					{
+						packet.limit[lane] = distance[lane];
+						pObjectIds[lane] = m_leafObjects[i].objectId;
+					}
+				}
+			}
+			continue;
+		}
+
+		int axis = -node.objectCount - 1;
+		int lane = FirstLane(laneMask);
+		float split = (node.boundsMin[axis] + node.boundsMax[axis]) * 0.5f;
+		bool bAbove = packet.position[axis][lane] > split;
+		stack[stackSize++] = bAbove ? node.first : node.first + 1;
+		stack[stackSize++] = bAbove ? node.first + 1 : node.first;
+	}
+}
+
+/***********************************************************
+ *  OverlapPacket()
+ *
+ *  This method is used for collecting the objects whose
+ *  boxes overlap the spheres or boxes of a packet.
+ ***********************************************************/
+void SpatialQuery::OverlapPacket(const QUERY_PACKET& packet, int maxResults, int* pObjectIds, int* pCounts) const
+{
+	int stack[MAX_TRAVERSAL_STACK];
+	int stackSize = 0;
+	float distance[PACKET_SIZE];
+
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		const BVH_NODE& node = m_nodes[stack[--stackSize]];
+		if (PointBoxLanes(packet, node.boundsMin, node.boundsMax, distance) == 0)
+		{
+			continue;
+		}
+
+		if (node.objectCount > 0)
+		{
+			for (int i = node.first; i < node.first + node.objectCount; i++)
+			{
+				int overlapMask = PointBoxLanes(packet, m_leafObjects[i].boundsMin, m_leafObjects[i].boundsMax, distance);
+				for (int lane = 0; lane < PACKET_SIZE; lane++)
+				{
+					if (overlapMask & (1 << lane))
+					{
+						if (pCounts[lane] < maxResults)
+						{
+							pObjectIds[lane * maxResults + pCounts[lane]] = m_leafObjects[i].objectId;
+						}
+						pCounts[lane]++;
+					}
+				}
+			}
+			continue;
+		}
+
+		stack[stackSize++] = node.first + 1;
+		stack[stackSize++] = node.first;
+	}
+}
+
+/***********************************************************
+ *  TraceBatch()
+ *
+ *  This method is used for finding the nearest object box
+ *  hit by every ray or swept sphere of a batch.  The last
+ *  query of a partial packet fills the unused lanes, which
+ *  are masked out.  A sphere is swept as the box around it,
+ *  which is a little larger at the corners of the objects.
+ ***********************************************************/
+template <typename QUERY>
+void SpatialQuery::TraceBatch(const QUERY* pQueries, int count, bool bHitInside, QUERY_HIT* pHits)
+{
+	EnsureUpToDate();
+	RunBatch(count, [this, pQueries, bHitInside, pHits](int firstQuery, int lastQuery)
+	{
+		for (int first = firstQuery; first < lastQuery; first += PACKET_SIZE)
+		{
+			int laneCount = std::min(PACKET_SIZE, lastQuery - first);
+			QUERY_PACKET packet;
+			int leafHits[PACKET_SIZE];
+
+			for (int lane = 0; lane < PACKET_SIZE; lane++)
+			{
+				const QUERY& query = pQueries[first + std::min(lane, laneCount - 1)];
+				for (int axis = 0; axis < 3; axis++)
+				{
+					packet.position[axis][lane] = query.origin[axis];
+					packet.inverseDirection[axis][lane] = SafeInverse(query.direction[axis]);
+					packet.extent[axis][lane] = QueryRadius(query);
+				}
+				packet.limit[lane] = query.maxDistance;
+				leafHits[lane] = -1;
+			}
+			packet.activeMask = (1 << laneCount) - 1;
+
+			if (m_nodes.size() > 0)
+			{
+				TraceRayPacket(packet, bHitInside, leafHits);
+			}
+
+			for (int lane = 0; lane < laneCount; lane++)
+			{
+				QUERY_HIT& hit = pHits[first + lane];
+				hit.distance = packet.limit[lane];
+				hit.objectId = -1;
+				hit.normal = glm::vec3(0.0f);
+				if (leafHits[lane] >= 0)
+				{
+					const QUERY& query = pQueries[first + lane];
+					hit.objectId = m_leafObjects[leafHits[lane]].objectId;
+					hit.normal = EntryNormal(m_leafObjects[leafHits[lane]], query.origin, query.direction, QueryRadius(query));
+				}
+			}
+		}
+	});
+}
+
+/***********************************************************
+ *  CastRays()
+ *
+ *  This method is used for finding the nearest object box
+ *  hit by every ray of a batch.
+ ***********************************************************/
+void SpatialQuery::CastRays(const QUERY_RAY* pRays, int count, QUERY_HIT* pHits)
+{
+	if ((NULL == pRays) || (NULL == pHits) || (count <= 0))
+	{
+		return;
+	}
+
+	TraceBatch(pRays, count, true, pHits);
+}
+
+/***********************************************************
+ *  SweepSpheres()
+ *
+ *  This method is used for finding the first object box
+ *  touched by every sphere of a batch as it moves.  The
+ *  boxes the sphere already overlaps at the start are not
+ *  hit, so a sphere that was pushed into a box can always
+ *  move out of it.
+ ***********************************************************/
+void SpatialQuery::SweepSpheres(const QUERY_SWEEP* pSweeps, int count, QUERY_HIT* pHits)
+{
+	if ((NULL == pSweeps) || (NULL == pHits) || (count <= 0))
+	{
+		return;
+	}
+
+	TraceBatch(pSweeps, count, false, pHits);
+}
+
+/***********************************************************
+ *  FindNearest()
+ *
+ *  This method is used for finding the nearest object box
+ *  to every point of a batch.  A point inside a box is at
+ *  distance zero from it.
+ ***********************************************************/
+void SpatialQuery::FindNearest(const glm::vec3* pPoints, int count, float maxDistance, QUERY_HIT* pHits)
+{
+	if ((NULL == pPoints) || (NULL == pHits) || (count <= 0))
+	{
+		return;
+	}
+
+	EnsureUpToDate();
+	RunBatch(count, [this, pPoints, pHits, maxDistance](int firstQuery, int lastQuery)
+	{
+		for (int first = firstQuery; first < lastQuery; first += PACKET_SIZE)
+		{
+			int laneCount = std::min(PACKET_SIZE, lastQuery - first);
+			QUERY_PACKET packet;
+			int objectIds[PACKET_SIZE];
+
+			for (int lane = 0; lane < PACKET_SIZE; lane++)
+			{
+				const glm::vec3& point = pPoints[first + std::min(lane, laneCount - 1)];
+				for (int axis = 0; axis < 3; axis++)
+				{
+					packet.position[axis][lane] = point[axis];
+					packet.inverseDirection[axis][lane] = 0.0f;
+					packet.extent[axis][lane] = 0.0f;
+				}
+				packet.limit[lane] = maxDistance * maxDistance;
+				objectIds[lane] = -1;
+			}
+			packet.activeMask = (1 << laneCount) - 1;
+
+			if (m_nodes.size() > 0)
+			{
+				NearestPacket(packet, objectIds);
+			}
+
+			for (int lane = 0; lane < laneCount; lane++)
+			{
+				pHits[first + lane].objectId = objectIds[lane];
+				pHits[first + lane].distance = (objectIds[lane] < 0) ? maxDistance : sqrtf(packet.limit[lane]);
+				pHits[first + lane].normal = glm::vec3(0.0f);
+			}
+		}
+	});
+}
+
+/***********************************************************
+ *  OverlapSpheres()
+ *
+ *  This method is used for collecting the objects whose
+ *  boxes overlap every sphere of a batch.
+ ***********************************************************/
+void SpatialQuery::OverlapSpheres(const QUERY_SPHERE* pSpheres, int count, int maxResults, int* pObjectIds, int* pCounts)
+{
+	if ((NULL == pSpheres) || (NULL == pCounts) || (count <= 0) ||
+		((maxResults > 0) && (NULL == pObjectIds)))
+	{
+		return;
+	}
+
+	EnsureUpToDate();
+	RunBatch(count, [this, pSpheres, maxResults, pObjectIds, pCounts](int firstQuery, int lastQuery)
+	{
+		for (int first = firstQuery; first < lastQuery; first += PACKET_SIZE)
+		{
+			int laneCount = std::min(PACKET_SIZE, lastQuery - first);
+			QUERY_PACKET packet;
+
+			for (int lane = 0; lane < PACKET_SIZE; lane++)
+			{
+				const QUERY_SPHERE& sphere = pSpheres[first + std::min(lane, laneCount - 1)];
+				for (int axis = 0; axis < 3; axis++)
+				{
+					packet.position[axis][lane] = sphere.center[axis];
+					packet.inverseDirection[axis][lane] = 0.0f;
+					packet.extent[axis][lane] = 0.0f;
+				}
+				packet.limit[lane] = sphere.radius * sphere.radius;
+			}
+			packet.activeMask = (1 << laneCount) - 1;
+
+			for (int lane = 0; lane < laneCount; lane++)
+			{
+				pCounts[first + lane] = 0;
+			}
+			if (m_nodes.size() > 0)
+			{
+				OverlapPacket(packet, maxResults, pObjectIds + (size_t)first * maxResults, pCounts + first);
+			}
+		}
+	});
+}
+
+/***********************************************************
+ *  OverlapBoxes()
+ *
+ *  This method is used for collecting the objects whose
+ *  boxes overlap every box of a batch.  A query box is
+ *  tested as its center against the object box grown by
+ *  its half size.
+ ***********************************************************/
+void SpatialQuery::OverlapBoxes(const QUERY_BOX* pBoxes, int count, int maxResults, int* pObjectIds, int* pCounts)
+{
+	if ((NULL == pBoxes) || (NULL == pCounts) || (count <= 0) ||
+		((maxResults > 0) && (NULL == pObjectIds)))
+	{
+		return;
+	}
+
+	EnsureUpToDate();
+	RunBatch(count, [this, pBoxes, maxResults, pObjectIds, pCounts](int firstQuery, int lastQuery)
+	{
+		for (int first = firstQuery; first < lastQuery; first += PACKET_SIZE)
+		{
+			int laneCount = std::min(PACKET_SIZE, lastQuery - first);
+			QUERY_PACKET packet;
+
+			for (int lane = 0; lane < PACKET_SIZE; lane++)
+			{
+				const QUERY_BOX& box = pBoxes[first + std::min(lane, laneCount - 1)];
+				for (int axis = 0; axis < 3; axis++)
+				{
+					packet.position[axis][lane] = (box.boundsMin[axis] + box.boundsMax[axis]) * 0.5f;
+					packet.inverseDirection[axis][lane] = 0.0f;
+					packet.extent[axis][lane] = (box.boundsMax[axis] - box.boundsMin[axis]) * 0.5f;
+				}
+				packet.limit[lane] = 0.0f;
+			}
+			packet.activeMask = (1 << laneCount) - 1;
+
+			for (int lane = 0; lane < laneCount; lane++)
+			{
+				pCounts[first + lane] = 0;
+			}
+			if (m_nodes.size() > 0)
+			{
+				OverlapPacket(packet, maxResults, pObjectIds + (size_t)first * maxResults, pCounts + first);
+			}
+		}
+	});
+}
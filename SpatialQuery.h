@@ -0,0 +1,172 @@
+///////////////////////////////////////////////////////////////////////////////
+// spatialquery.h
+// ==============
+// answer batches of ray, nearest object and overlap queries against the
+// bounding boxes of the scene objects
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ThreadPool.h"
+
+#include <functional>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  SpatialQuery
+ *
+ *  This class keeps a bounding volume hierarchy over the
+ *  boxes of the scene objects.  The objects are asked for
+ *  from a provider only when a query finds the hierarchy
+ *  out of date - it is refitted when only the boxes moved
+ *  and rebuilt when objects were added or removed.  The
+ *  queries are walked through the hierarchy in packets of
+ *  four, with SSE2 or NEON when available, and large
+ *  batches are split across worker threads.  The results
+ *  are written into arrays passed in by the caller, so a
+ *  query does not allocate memory.
+ ***********************************************************/
+class SpatialQuery
+{
+public:
+	// the number of queries walked through the hierarchy together
+	static const int PACKET_SIZE = 4;
+
+	struct QUERY_OBJECT
+	{
+		glm::vec3 boundsMin;
+		glm::vec3 boundsMax;
+		int objectId;
+	};
+
+	struct QUERY_RAY
+	{
+		glm::vec3 origin;
+		glm::vec3 direction;
+		float maxDistance;
+	};
+
+	// a sphere moved along a ray
+	struct QUERY_SWEEP
+	{
+		glm::vec3 origin;
+		glm::vec3 direction;
+		float maxDistance;
+		float radius;
+	};
+
+	struct QUERY_SPHERE
+	{
+		glm::vec3 center;
+		float radius;
+	};
+
+	struct QUERY_BOX
+	{
+		glm::vec3 boundsMin;
+		glm::vec3 boundsMax;
+	};
+
+	// the object id is -1 when nothing was found, and the normal is
+	// the face of the box entered by a ray or sweep
+	struct QUERY_HIT
+	{
+		int objectId;
+		float distance;
+		glm::vec3 normal;
+	};
+
+	// fills the passed in vector with the objects to query
+	typedef std::function<void(std::vector<QUERY_OBJECT>&)> OBJECT_PROVIDER;
+
+	// zero workers starts one less than the number of cores - the
+	// queries are made from one thread at a time
+	SpatialQuery(OBJECT_PROVIDER provider, int workerCount = 0);
+	~SpatialQuery();
+
+	// mark the hierarchy out of date - true when objects were added
+	// or removed, false when they only moved, in which case the
+	// provider must give the objects in the same order as before
+	void Invalidate(bool bObjectsChanged);
+
+	// the nearest object box hit by each ray, where the distance is
+	// measured in lengths of the ray direction
+	void CastRays(const QUERY_RAY* pRays, int count, QUERY_HIT* pHits);
+	// the first object box touched by each sphere as it moves along
+	// its ray, leaving out the boxes it starts in
+	void SweepSpheres(const QUERY_SWEEP* pSweeps, int count, QUERY_HIT* pHits);
+	// the nearest object box to each point within the distance
+	void FindNearest(const glm::vec3* pPoints, int count, float maxDistance, QUERY_HIT* pHits);
+	// the objects whose boxes overlap each sphere or box - up to
+	// maxResults ids are written for query i starting at
+	// pObjectIds[i * maxResults], and pCounts[i] is the number of
+	// overlapping objects, which may be larger
+	void OverlapSpheres(const QUERY_SPHERE* pSpheres, int count, int maxResults, int* pObjectIds, int* pCounts);
+	void OverlapBoxes(const QUERY_BOX* pBoxes, int count, int maxResults, int* pObjectIds, int* pCounts);
+
+	int GetObjectCount();
+	int GetNodeCount() const { return((int)m_nodes.size()); }
+
+	// the queries over all of the scene objects and over the objects
+	// that are never animated, in render space - they are set by the
+	// scene manager so the other managers can ask the scene
+	static SpatialQuery* GetScene();
+	static void SetScene(SpatialQuery* pSceneQuery);
+	static SpatialQuery* GetStaticScene();
+	static void SetStaticScene(SpatialQuery* pStaticQuery);
+
+private:
+	// a node of the hierarchy - a leaf holds objectCount objects
+	// starting at first, and an inner node holds its two children
+	// at first and first + 1 and -(split axis + 1) in objectCount
+	struct BVH_NODE
+	{
+		glm::vec3 boundsMin;
+		int first;
+		glm::vec3 boundsMax;
+		int objectCount;
+	};
+
+	// the lanes of one packet of queries
+	struct QUERY_PACKET
+	{
+		float position[3][PACKET_SIZE];
+		float inverseDirection[3][PACKET_SIZE];
+		float extent[3][PACKET_SIZE];
+		float limit[PACKET_SIZE];
+		int activeMask;
+	};
+
+	typedef std::function<void(int firstQuery, int lastQuery)> QUERY_RANGE;
+
+	void EnsureUpToDate();
+	void Build();
+	void BuildNode(int nodeIndex, int first, int count);
+	void Refit();
+	void RunBatch(int count, const QUERY_RANGE& queryRange);
+
+	template <typename QUERY>
+	void TraceBatch(const QUERY* pQueries, int count, bool bHitInside, QUERY_HIT* pHits);
+
+	void TraceRayPacket(QUERY_PACKET& packet, bool bHitInside, int* pLeafHits) const;
+	void NearestPacket(QUERY_PACKET& packet, int* pObjectIds) const;
+	void OverlapPacket(const QUERY_PACKET& packet, int maxResults, int* pObjectIds, int* pCounts) const;
+
+	OBJECT_PROVIDER m_provider;
+	ThreadPool* m_pThreadPool;
+	bool m_bOutOfDate;
+	bool m_bRebuild;
+
+	// the objects as given by the provider
+	std::vector<QUERY_OBJECT> m_objects;
+	// the objects in the order of the leaves, and the index of
+	// each in the provider order
+	std::vector<QUERY_OBJECT> m_leafObjects;
+	std::vector<int> m_leafOrder;
+	std::vector<BVH_NODE> m_nodes;
+};
@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////////////
+// threadpool.cpp
+// ==============
+// run background work on a fixed set of worker threads
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool.h"
+
+/***********************************************************
+ *  ThreadPool()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ThreadPool::ThreadPool(int workerCount)
+{
+	m_runningCount = 0;
+	m_bStopping = false;
+
+	if (workerCount <= 0)
+	{
+		// leave a core for the render thread
+		workerCount = (int)std::thread::hardware_concurrency() - 1;
+		if (workerCount < 1)
+		{
+			workerCount = 1;
+		}
+	}
+
+	for (int i = 0; i < workerCount; i++)
+	{
+		m_workers.push_back(std::thread(&ThreadPool::WorkerLoop, this));
+	}
+}
+
+/***********************************************************
+ *  ~ThreadPool()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStopping = true;
+	}
+	m_jobAvailable.notify_all();
+
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		m_workers[i].join();
+	}
+	m_workers.clear();
+}
+
+/***********************************************************
+ *  Enqueue()
+ *
+ *  This method is used for adding a job to the queue.
+ ***********************************************************/
+void ThreadPool::Enqueue(const JOB& job)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_jobs.push_back(job);
+	}
+	m_jobAvailable.notify_one();
+}
+
+/***********************************************************
+ *  GetPendingCount()
+ *
+ *  This method is used for getting the number of jobs that
+ *  are waiting or running.
+ ***********************************************************/
+int ThreadPool::GetPendingCount()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return((int)m_jobs.size() + m_runningCount);
+}
+
+/***********************************************************
+ *  WaitForIdle()
+ *
+ *  This method is used for waiting until every queued job
+ *  has finished running.
+ ***********************************************************/
+void ThreadPool::WaitForIdle()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_jobsFinished.wait(lock, [this]() { return((m_jobs.size() == 0) && (m_runningCount == 0)); });
+}
+
+/***********************************************************
+ *  WorkerLoop()
+ *
+ *  This method is run by every worker thread.  It takes
+ *  the oldest job from the queue, and exits once the pool
+ *  is stopping and the queue is empty.
+ ***********************************************************/
+void ThreadPool::WorkerLoop()
+{
+	while (true)
+	{
+		JOB job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_jobAvailable.wait(lock, [this]() { return(m_bStopping || (m_jobs.size() > 0)); });
+			if (m_jobs.size() == 0)
+			{
+				return;
+			}
+			job = m_jobs.front();
+			m_jobs.pop_front();
+			m_runningCount++;
+		}
+
+		job();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_runningCount--;
+		if ((m_runningCount == 0) && (m_jobs.size() == 0))
+		{
+			m_jobsFinished.notify_all();
+		}
+	}
+}
@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////
+// threadpool.h
+// ============
+// run background work on a fixed set of worker threads
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  ThreadPool
+ *
+ *  This class starts a fixed number of worker threads that
+ *  take jobs from a shared queue in the order they were
+ *  added.  The jobs must not touch OpenGL, since the GL
+ *  context is only current on the main thread.
+ ***********************************************************/
+class ThreadPool
+{
+public:
+	typedef std::function<void()> JOB;
+
+	// zero workers starts one less than the number of cores
+	ThreadPool(int workerCount = 0);
+	// finishes the jobs already queued before returning
+	~ThreadPool();
+
+	void Enqueue(const JOB& job);
+	// the number of queued and running jobs
+	int GetPendingCount();
+	// block until the queue is empty and no job is running
+	void WaitForIdle();
+	int GetWorkerCount() const { return((int)m_workers.size()); }
+
+private:
+	void WorkerLoop();
+
+	std::vector<std::thread> m_workers;
+	std::deque<JOB> m_jobs;
+	std::mutex m_mutex;
+	std::condition_variable m_jobAvailable;
+	std::condition_variable m_jobsFinished;
+	int m_runningCount;
+	bool m_bStopping;
+};
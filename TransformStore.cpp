@@ -0,0 +1,639 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformstore.cpp
+// ==================
+// store the transformations of the scene objects in structure of arrays
+// form and compose their world matrices in SIMD batches
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TransformStore.h"
+
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TRANSFORMS_USE_AVX2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define TRANSFORMS_USE_NEON
+#endif
+
+// declaration of global variables
+namespace
+{
+	const float DEGREES_TO_RADIANS = 3.14159265358979f / 180.0f;
+
+	// the constants of the sine and cosine approximation - the
+	// angle is reduced to the -pi/4 to pi/4 range by subtracting
+	// multiples of pi/2 split into three parts for precision
+	const float TWO_OVER_PI = 0.636619772367581f;
+	const float PI_OVER_2_PART1 = 1.5703125f;
+	const float PI_OVER_2_PART2 = 4.837512969970703125e-4f;
+	const float PI_OVER_2_PART3 = 7.54978995489188216e-8f;
+	const float SIN_C1 = -1.6666654611e-1f;
+	const float SIN_C2 = 8.3321608736e-3f;
+	const float SIN_C3 = -1.9515295891e-4f;
+	const float COS_C1 = 4.166664568298827e-2f;
+	const float COS_C2 = -1.388731625493765e-3f;
+	const float COS_C3 = 2.443315711809948e-5f;
+
+#if defined(TRANSFORMS_USE_AVX2)
+	/***********************************************************
+	 *  SinCos8()
+	 *
+	 *  This function is used for calculating the sine and the
+	 *  cosine of eight angles in radians at once.
+	 ***********************************************************/
+	inline void SinCos8(__m256 angle, __m256& sine, __m256& cosine)
+	{
+		__m256 quadrant = _mm256_round_ps(
+			_mm256_mul_ps(angle, _mm256_set1_ps(TWO_OVER_PI)),
+			_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		__m256i quadrantBits = _mm256_cvtps_epi32(quadrant);
+
+		__m256 x = _mm256_sub_ps(angle, _mm256_mul_ps(quadrant, _mm256_set1_ps(PI_OVER_2_PART1)));
+		x = _mm256_sub_ps(x, _mm256_mul_ps(quadrant, _mm256_set1_ps(PI_OVER_2_PART2)));
+		x = _mm256_sub_ps(x, _mm256_mul_ps(quadrant, _mm256_set1_ps(PI_OVER_2_PART3)));
+		__m256 x2 = _mm256_mul_ps(x, x);
+
+		__m256 sinPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(SIN_C3), x2), _mm256_set1_ps(SIN_C2));
+		sinPoly = _mm256_add_ps(_mm256_mul_ps(sinPoly, x2), _mm256_set1_ps(SIN_C1));
+		sinPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(sinPoly, x2), x), x);
+
+		__m256 cosPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(COS_C3), x2), _mm256_set1_ps(COS_C2));
+		cosPoly = _mm256_add_ps(_mm256_mul_ps(cosPoly, x2), _mm256_set1_ps(COS_C1));
+		cosPoly = _mm256_mul_ps(_mm256_mul_ps(cosPoly, x2), x2);
+		cosPoly = _mm256_add_ps(_mm256_sub_ps(cosPoly, _mm256_mul_ps(x2, _mm256_set1_ps(0.5f))), _mm256_set1_ps(1.0f));
+
+		// odd quadrants swap sine and cosine, and the quadrant
+		// decides the signs of the results
+		__m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(
+			_mm256_and_si256(quadrantBits, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+		__m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(
+			_mm256_and_si256(quadrantBits, _mm256_set1_epi32(2)), 30));
+		__m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(
+			_mm256_and_si256(_mm256_add_epi32(quadrantBits, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30));
+
+		sine = _mm256_xor_ps(_mm256_blendv_ps(sinPoly, cosPoly, swap), sinSign);
+		cosine = _mm256_xor_ps(_mm256_blendv_ps(cosPoly, sinPoly, swap), cosSign);
+	}
+
+	/***********************************************************
+	 *  Transpose8x8()
+	 *
+	 *  This function is used for turning eight rows of eight
+	 *  values into eight columns, in place.
+	 ***********************************************************/
+	inline void Transpose8x8(__m256 rows[8])
+	{
+		__m256 t0 = _mm256_unpacklo_ps(rows[0], rows[1]);
+		__m256 t1 = _mm256_unpackhi_ps(rows[0], rows[1]);
+		__m256 t2 = _mm256_unpacklo_ps(rows[2], rows[3]);
+		__m256 t3 = _mm256_unpackhi_ps(rows[2], rows[3]);
+		__m256 t4 = _mm256_unpacklo_ps(rows[4], rows[5]);
+		__m256 t5 = _mm256_unpackhi_ps(rows[4], rows[5]);
+		__m256 t6 = _mm256_unpacklo_ps(rows[6], rows[7]);
+		__m256 t7 = _mm256_unpackhi_ps(rows[6], rows[7]);
+
+		__m256 s0 = _mm256_shuffle_ps(t0, t2, 0x44);
+		__m256 s1 = _mm256_shuffle_ps(t0, t2, 0xEE);
+		__m256 s2 = _mm256_shuffle_ps(t1, t3, 0x44);
+		__m256 s3 = _mm256_shuffle_ps(t1, t3, 0xEE);
+		__m256 s4 = _mm256_shuffle_ps(t4, t6, 0x44);
+		__m256 s5 = _mm256_shuffle_ps(t4, t6, 0xEE);
+		__m256 s6 = _mm256_shuffle_ps(t5, t7, 0x44);
+		__m256 s7 = _mm256_shuffle_ps(t5, t7, 0xEE);
+
+		rows[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+		rows[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+		rows[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+		rows[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+		rows[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+		rows[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+		rows[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+		rows[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+	}
+
+	/***********************************************************
+	 *  ComposeBatch()
+	 *
+	 *  This function is used for building eight world matrices
+	 *  from eight translations, Euler rotations and scales.
+	 ***********************************************************/
+	void ComposeBatch(
+		const float* position[3],
+		const float* rotation[3],
+		const float* scale[3],
+		int first,
+		glm::mat4* matrices)
+	{
+		__m256 sinX, cosX, sinY, cosY, sinZ, cosZ;
+		SinCos8(_mm256_loadu_ps(rotation[0] + first), sinX, cosX);
+		SinCos8(_mm256_loadu_ps(rotation[1] + first), sinY, cosY);
+		SinCos8(_mm256_loadu_ps(rotation[2] + first), sinZ, cosZ);
+
+		__m256 scaleX = _mm256_loadu_ps(scale[0] + first);
+		__m256 scaleY = _mm256_loadu_ps(scale[1] + first);
+		__m256 scaleZ = _mm256_loadu_ps(scale[2] + first);
+
+		// the closed form of rotZ * rotY * rotX
+		__m256 sinXsinY = _mm256_mul_ps(sinX, sinY);
+		__m256 cosXsinY = _mm256_mul_ps(cosX, sinY);
+		__m256 zero = _mm256_setzero_ps();
+
+		__m256 columns[16];
+		columns[0] = _mm256_mul_ps(_mm256_mul_ps(cosY, cosZ), scaleX);
+		columns[1] = _mm256_mul_ps(_mm256_mul_ps(cosY, sinZ), scaleX);
+		columns[2] = _mm256_mul_ps(_mm256_sub_ps(zero, sinY), scaleX);
+		columns[3] = zero;
+		columns[4] = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(sinXsinY, cosZ), _mm256_mul_ps(cosX, sinZ)), scaleY);
+		columns[5] = _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(sinXsinY, sinZ), _mm256_mul_ps(cosX, cosZ)), scaleY);
+		columns[6] = _mm256_mul_ps(_mm256_mul_ps(sinX, cosY), scaleY);
+		columns[7] = zero;
+		columns[8] = _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(cosXsinY, cosZ), _mm256_mul_ps(sinX, sinZ)), scaleZ);
+		columns[9] = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(cosXsinY, sinZ), _mm256_mul_ps(sinX, cosZ)), scaleZ);
+		columns[10] = _mm256_mul_ps(_mm256_mul_ps(cosX, cosY), scaleZ);
+		columns[11] = zero;
+		columns[12] = _mm256_loadu_ps(position[0] + first);
+		columns[13] = _mm256_loadu_ps(position[1] + first);
+		columns[14] = _mm256_loadu_ps(position[2] + first);
+		columns[15] = _mm256_set1_ps(1.0f);
+
+		// each matrix element is spread across the eight objects -
+		// transpose them into the eight column-major matrices
+		Transpose8x8(columns);
+		Transpose8x8(columns + 8);
+		for (int i = 0; i < 8; i++)
+		{
+			float* matrix = &matrices[first + i][0][0];
+			_mm256_storeu_ps(matrix, columns[i]);
+			_mm256_storeu_ps(matrix + 8, columns[8 + i]);
+		}
+	}
+#elif defined(TRANSFORMS_USE_NEON)
+	/***********************************************************
+	 *  SinCos4()
+	 *
+	 *  This function is used for calculating the sine and the
+	 *  cosine of four angles in radians at once.
+	 ***********************************************************/
+	inline void SinCos4(float32x4_t angle, float32x4_t& sine, float32x4_t& cosine)
+	{
+		float32x4_t quadrant = vrndnq_f32(vmulq_n_f32(angle, TWO_OVER_PI));
+		int32x4_t quadrantBits = vcvtq_s32_f32(quadrant);
+
+		float32x4_t x = vmlsq_n_f32(angle, quadrant, PI_OVER_2_PART1);
+		x = vmlsq_n_f32(x, quadrant, PI_OVER_2_PART2);
+		x = vmlsq_n_f32(x, quadrant, PI_OVER_2_PART3);
+		float32x4_t x2 = vmulq_f32(x, x);
+
+		float32x4_t sinPoly = vmlaq_n_f32(vdupq_n_f32(SIN_C2), x2, SIN_C3);
+		sinPoly = vmlaq_f32(vdupq_n_f32(SIN_C1), sinPoly, x2);
+		sinPoly = vmlaq_f32(x, vmulq_f32(sinPoly, x2), x);
+
+		float32x4_t cosPoly = vmlaq_n_f32(vdupq_n_f32(COS_C2), x2, COS_C3);
+		cosPoly = vmlaq_f32(vdupq_n_f32(COS_C1), cosPoly, x2);
+		cosPoly = vmulq_f32(vmulq_f32(cosPoly, x2), x2);
+		cosPoly = vaddq_f32(vmlsq_n_f32(cosPoly, x2, 0.5f), vdupq_n_f32(1.0f));
+
+		// odd quadrants swap sine and cosine, and the quadrant
+		// decides the signs of the results
+		uint32x4_t swap = vtstq_s32(quadrantBits, vdupq_n_s32(1));
+		uint32x4_t sinSign = vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(quadrantBits, vdupq_n_s32(2))), 30);
+		uint32x4_t cosSign = vshlq_n_u32(vreinterpretq_u32_s32(
+			vandq_s32(vaddq_s32(quadrantBits, vdupq_n_s32(1)), vdupq_n_s32(2))), 30);
+
+		sine = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, cosPoly, sinPoly)), sinSign));
+		cosine = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, sinPoly, cosPoly)), cosSign));
+	}
+
+	/***********************************************************
+	 *  StoreTransposed4()
+	 *
+	 *  This function is used for storing four matrix elements
+	 *  of four objects into the matching element of each of
+	 *  the four object matrices.
+	 ***********************************************************/
+	inline void StoreTransposed4(float32x4_t a, float32x4_t b, float32x4_t c, float32x4_t d, glm::mat4* matrices, int column)
+	{
+		float32x4x2_t ab = vtrnq_f32(a, b);
+		float32x4x2_t cd = vtrnq_f32(c, d);
+
+		vst1q_f32(&matrices[0][column][0], vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0])));
+		vst1q_f32(&matrices[1][column][0], vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1])));
+		vst1q_f32(&matrices[2][column][0], vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0])));
+		vst1q_f32(&matrices[3][column][0], vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1])));
+	}
+
+	/***********************************************************
+	 *  ComposeBatch()
+	 *
+	 *  This function is used for building eight world matrices
+	 *  from eight translations, Euler rotations and scales, as
+	 *  two groups of four.
+	 ***********************************************************/
+	void ComposeBatch(
+		const float* position[3],
+		const float* rotation[3],
+		const float* scale[3],
+		int first,
+		glm::mat4* matrices)
+	{
+		for (int half = first; half < first + 8; half += 4)
+		{
+			float32x4_t sinX, cosX, sinY, cosY, sinZ, cosZ;
+			SinCos4(vld1q_f32(rotation[0] + half), sinX, cosX);
+			SinCos4(vld1q_f32(rotation[1] + half), sinY, cosY);
+			SinCos4(vld1q_f32(rotation[2] + half), sinZ, cosZ);
+
+			float32x4_t scaleX = vld1q_f32(scale[0] + half);
+			float32x4_t scaleY = vld1q_f32(scale[1] + half);
+			float32x4_t scaleZ = vld1q_f32(scale[2] + half);
+
+			// the closed form of rotZ * rotY * rotX
+			float32x4_t sinXsinY = vmulq_f32(sinX, sinY);
+			float32x4_t cosXsinY = vmulq_f32(cosX, sinY);
+			float32x4_t zero = vdupq_n_f32(0.0f);
+
+			StoreTransposed4(
+				vmulq_f32(vmulq_f32(cosY, cosZ), scaleX),
+				vmulq_f32(vmulq_f32(cosY, sinZ), scaleX),
+				vmulq_f32(vnegq_f32(sinY), scaleX),
+				zero,
+				matrices + half, 0);
+			StoreTransposed4(
+				vmulq_f32(vmlsq_f32(vmulq_f32(sinXsinY, cosZ), cosX, sinZ), scaleY),
+				vmulq_f32(vmlaq_f32(vmulq_f32(sinXsinY, sinZ), cosX, cosZ), scaleY),
+				vmulq_f32(vmulq_f32(sinX, cosY), scaleY),
+				zero,
+				matrices + half, 1);
+			StoreTransposed4(
+				vmulq_f32(vmlaq_f32(vmulq_f32(cosXsinY, cosZ), sinX, sinZ), scaleZ),
+				vmulq_f32(vmlsq_f32(vmulq_f32(cosXsinY, sinZ), sinX, cosZ), scaleZ),
+				vmulq_f32(vmulq_f32(cosX, cosY), scaleZ),
+				zero,
+				matrices + half, 2);
+			StoreTransposed4(
+				vld1q_f32(position[0] + half),
+				vld1q_f32(position[1] + half),
+				vld1q_f32(position[2] + half),
+				vdupq_n_f32(1.0f),
+				matrices + half, 3);
+		}
+	}
+#else
+	/***********************************************************
+	 *  ComposeBatch()
+	 *
+	 *  This function is used for building eight world matrices
+	 *  from eight translations, Euler rotations and scales, one
+	 *  at a time when no SIMD instruction set is available.
+	 ***********************************************************/
+	void ComposeBatch(
+		const float* position[3],
+		const float* rotation[3],
+		const float* scale[3],
+		int first,
+		glm::mat4* matrices)
+	{
+		for (int i = first; i < first + 8; i++)
+		{
+			float sinX = sin(rotation[0][i]);
+			float cosX = cos(rotation[0][i]);
+			float sinY = sin(rotation[1][i]);
+			float cosY = cos(rotation[1][i]);
+			float sinZ = sin(rotation[2][i]);
+			float cosZ = cos(rotation[2][i]);
+
+			// the closed form of rotZ * rotY * rotX
+			glm::mat4& matrix = matrices[i];
+			matrix[0] = glm::vec4(cosY * cosZ, cosY * sinZ, -sinY, 0.0f) * scale[0][i];
+			matrix[1] = glm::vec4(
+				(sinX * sinY * cosZ) - (cosX * sinZ),
+				(sinX * sinY * sinZ) + (cosX * cosZ),
+				sinX * cosY,
+				0.0f) * scale[1][i];
+			matrix[2] = glm::vec4(
+				(cosX * sinY * cosZ) + (sinX * sinZ),
+				(cosX * sinY * sinZ) - (sinX * cosZ),
+				cosX * cosY,
+				0.0f) * scale[2][i];
+			matrix[3] = glm::vec4(position[0][i], position[1][i], position[2][i], 1.0f);
+		}
+	}
+#endif
+}
+
+/***********************************************************
+ *  TransformStore()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TransformStore::TransformStore()
+{
+	m_transformCount = 0;
+	m_bAnyDirty = false;
+	m_renderOrigin = glm::dvec3(0.0);
+	m_bOriginMoved = false;
+}
+
+/***********************************************************
+ *  ~TransformStore()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TransformStore::~TransformStore()
+{
+	Clear();
+}
+
+/***********************************************************
+ *  Reserve()
+ *
+ *  This method is used for preallocating the arrays when
+ *  the number of transforms is known up front.
+ ***********************************************************/
+void TransformStore::Reserve(int count)
+{
+	int paddedCount = (count + BATCH_SIZE - 1) / BATCH_SIZE * BATCH_SIZE;
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		m_position[axis].reserve(paddedCount);
+		m_renderPosition[axis].reserve(paddedCount);
+		m_rotation[axis].reserve(paddedCount);
+		m_scale[axis].reserve(paddedCount);
+	}
+	m_worldMatrices.reserve(paddedCount);
+	m_dirtyBatches.reserve(paddedCount / BATCH_SIZE);
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all of the transforms.
+ ***********************************************************/
+void TransformStore::Clear()
+{
+	for (int axis = 0; axis < 3; axis++)
+	{
+		m_position[axis].clear();
+		m_renderPosition[axis].clear();
+		m_rotation[axis].clear();
+		m_scale[axis].clear();
+	}
+	m_worldMatrices.clear();
+	m_dirtyBatches.clear();
+	m_freeHandles.clear();
+	m_transformCount = 0;
+	m_bAnyDirty = false;
+}
+
+/***********************************************************
+ *  AddTransform()
+ *
+ *  This method is used for adding a transform.  The arrays
+ *  grow a whole batch at a time, so that the kernels never
+ *  have to handle a partial batch.
+ ***********************************************************/
+int TransformStore::AddTransform(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::dvec3 positionXYZ)
+{
+	int handle = m_transformCount;
+
+	if (m_freeHandles.size() > 0)
+	{
+		handle = m_freeHandles.back();
+		m_freeHandles.pop_back();
+	}
+	else if (handle % BATCH_SIZE == 0)
+	{
+		// the padding transforms are left as zero scale
+		for (int axis = 0; axis < 3; axis++)
+		{
+			m_position[axis].resize(handle + BATCH_SIZE, 0.0);
+			m_renderPosition[axis].resize(handle + BATCH_SIZE, 0.0f);
+			m_rotation[axis].resize(handle + BATCH_SIZE, 0.0f);
+			m_scale[axis].resize(handle + BATCH_SIZE, 0.0f);
+		}
+		m_worldMatrices.resize(handle + BATCH_SIZE, glm::mat4(0.0f));
+		m_dirtyBatches.push_back(0);
+	}
+	if (handle == m_transformCount)
+	{
+		m_transformCount++;
+	}
+
+	SetPosition(handle, positionXYZ);
+	SetRotation(handle, XrotationDegrees, YrotationDegrees, ZrotationDegrees);
+	SetScale(handle, scaleXYZ);
+
+	return(handle);
+}
+
+/***********************************************************
+ *  RemoveTransform()
+ *
+ *  This method is used for releasing a transform.  It is
+ *  given a zero scale like the padding of the batches, so
+ *  the arrays never have to be compacted.
+ ***********************************************************/
+void TransformStore::RemoveTransform(int handle)
+{
+	if ((handle < 0) || (handle >= m_transformCount))
+	{
+		return;
+	}
+
+	SetScale(handle, glm::vec3(0.0f));
+	m_freeHandles.push_back(handle);
+}
+
+/***********************************************************
+ *  MarkDirty()
+ *
+ *  This method is used for flagging the batch holding the
+ *  passed in transform for the next matrix update.
+ ***********************************************************/
+void TransformStore::MarkDirty(int handle)
+{
+	m_dirtyBatches[handle / BATCH_SIZE] = 1;
+	m_bAnyDirty = true;
+}
+
+/***********************************************************
+ *  MarkRangeDirty()
+ *
+ *  This method is used for flagging every batch in a range
+ *  of transforms that was written through the raw arrays.
+ ***********************************************************/
+void TransformStore::MarkRangeDirty(int firstHandle, int count)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	int lastBatch = (firstHandle + count - 1) / BATCH_SIZE;
+	for (int batch = firstHandle / BATCH_SIZE; batch <= lastBatch; batch++)
+	{
+		m_dirtyBatches[batch] = 1;
+	}
+	m_bAnyDirty = true;
+}
+
+/***********************************************************
+ *  SetPosition()
+ *
+ *  This method is used for moving a transform.
+ ***********************************************************/
+void TransformStore::SetPosition(int handle, glm::dvec3 positionXYZ)
+{
+	m_position[0][handle] = positionXYZ.x;
+	m_position[1][handle] = positionXYZ.y;
+	m_position[2][handle] = positionXYZ.z;
+	MarkDirty(handle);
+}
+
+/***********************************************************
+ *  SetRotation()
+ *
+ *  This method is used for rotating a transform.  The
+ *  angles are passed in degrees and stored in radians.
+ ***********************************************************/
+void TransformStore::SetRotation(int handle, float XrotationDegrees, float YrotationDegrees, float ZrotationDegrees)
+{
+	m_rotation[0][handle] = XrotationDegrees * DEGREES_TO_RADIANS;
+	m_rotation[1][handle] = YrotationDegrees * DEGREES_TO_RADIANS;
+	m_rotation[2][handle] = ZrotationDegrees * DEGREES_TO_RADIANS;
+	MarkDirty(handle);
+}
+
+/***********************************************************
+ *  SetScale()
+ *
+ *  This method is used for scaling a transform.
+ ***********************************************************/
+void TransformStore::SetScale(int handle, glm::vec3 scaleXYZ)
+{
+	m_scale[0][handle] = scaleXYZ.x;
+	m_scale[1][handle] = scaleXYZ.y;
+	m_scale[2][handle] = scaleXYZ.z;
+	MarkDirty(handle);
+}
+
+/***********************************************************
+ *  GetPosition()
+ *
+ *  This method is used for reading the position of a
+ *  transform.
+ ***********************************************************/
+glm::dvec3 TransformStore::GetPosition(int handle) const
+{
+	return(glm::dvec3(m_position[0][handle], m_position[1][handle], m_position[2][handle]));
+}
+
+/***********************************************************
+ *  GetScale()
+ *
+ *  This method is used for reading the scale of a transform.
+ ***********************************************************/
+glm::vec3 TransformStore::GetScale(int handle) const
+{
+	return(glm::vec3(m_scale[0][handle], m_scale[1][handle], m_scale[2][handle]));
+}
+
+/***********************************************************
+ *  SetRenderOrigin()
+ *
+ *  This method is used for moving the point that the world
+ *  matrices are made relative to.  The translations of all
+ *  of the matrices are rewritten on the next update.
+ ***********************************************************/
+void TransformStore::SetRenderOrigin(glm::dvec3 origin)
+{
+	if ((origin.x != m_renderOrigin.x) ||
+		(origin.y != m_renderOrigin.y) ||
+		(origin.z != m_renderOrigin.z))
+	{
+		m_renderOrigin = origin;
+		m_bOriginMoved = true;
+	}
+}
+
+/***********************************************************
+ *  UpdateRenderPositions()
+ *
+ *  This method is used for making the positions of a batch
+ *  relative to the render origin.  The subtraction is done
+ *  in double, so only the small result is rounded to float.
+ ***********************************************************/
+void TransformStore::UpdateRenderPositions(int batch)
+{
+	int first = batch * BATCH_SIZE;
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		const double* world = m_position[axis].data() + first;
+		float* render = m_renderPosition[axis].data() + first;
+		double origin = m_renderOrigin[axis];
+
+		for (int i = 0; i < BATCH_SIZE; i++)
+		{
+			render[i] = (float)(world[i] - origin);
+		}
+	}
+}
+
+/***********************************************************
+ *  UpdateWorldMatrices()
+ *
+ *  This method is used for composing the world matrices of
+ *  every batch that changed since the last update.  After
+ *  a move of the render origin only the translations of
+ *  the other batches are rewritten, since their rotation
+ *  and scale did not change.
+ ***********************************************************/
+int TransformStore::UpdateWorldMatrices()
+{
+	if ((m_bAnyDirty == false) && (m_bOriginMoved == false))
+	{
+		return(0);
+	}
+
+	const float* position[3] = { m_renderPosition[0].data(), m_renderPosition[1].data(), m_renderPosition[2].data() };
+	const float* rotation[3] = { m_rotation[0].data(), m_rotation[1].data(), m_rotation[2].data() };
+	const float* scale[3] = { m_scale[0].data(), m_scale[1].data(), m_scale[2].data() };
+	glm::mat4* matrices = m_worldMatrices.data();
+
+	int composed = 0;
+	int batchCount = (int)m_dirtyBatches.size();
+	for (int batch = 0; batch < batchCount; batch++)
+	{
+		if (m_dirtyBatches[batch] != 0)
+		{
+			UpdateRenderPositions(batch);
+			ComposeBatch(position, rotation, scale, batch * BATCH_SIZE, matrices);
+			m_dirtyBatches[batch] = 0;
+			composed++;
+		}
+		else if (m_bOriginMoved == true)
+		{
+			UpdateRenderPositions(batch);
+			for (int i = batch * BATCH_SIZE; i < (batch + 1) * BATCH_SIZE; i++)
+			{
+				matrices[i][3] = glm::vec4(position[0][i], position[1][i], position[2][i], 1.0f);
+			}
+		}
+	}
+	m_bAnyDirty = false;
+	m_bOriginMoved = false;
+
+	return(composed);
+}
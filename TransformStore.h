@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformstore.h
+// ================
+// store the transformations of the scene objects in structure of arrays
+// form and compose their world matrices in SIMD batches
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  TransformStore
+ *
+ *  This class keeps the position, rotation and scale of
+ *  every scene object in separate arrays, with the world
+ *  positions in double.  The world matrices (translation *
+ *  rotZ * rotY * rotX * scale) are built in render space,
+ *  relative to the render origin, directly from these
+ *  values with the closed form of the rotation, eight
+ *  objects at a time with AVX2, four at a time with NEON,
+ *  or one at a time otherwise.  Only the batches holding a
+ *  changed transform are rebuilt, and a move of the render
+ *  origin only rewrites the translations.
+ ***********************************************************/
+class TransformStore
+{
+public:
+	// the number of transforms composed by one kernel call
+	static const int BATCH_SIZE = 8;
+
+	TransformStore();
+	~TransformStore();
+
+	// add a transform and return its handle - the rotations are
+	// passed in degrees like SetTransformations()
+	int AddTransform(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::dvec3 positionXYZ);
+	// release a transform - its scale becomes zero so nothing drawn
+	// with it is visible, and the handle is reused by AddTransform()
+	void RemoveTransform(int handle);
+	// preallocate memory for the passed in number of transforms
+	void Reserve(int count);
+	// remove all of the transforms
+	void Clear();
+
+	// modify a transform - each marks the transform batch dirty
+	void SetPosition(int handle, glm::dvec3 positionXYZ);
+	void SetRotation(int handle, float XrotationDegrees, float YrotationDegrees, float ZrotationDegrees);
+	void SetScale(int handle, glm::vec3 scaleXYZ);
+
+	glm::dvec3 GetPosition(int handle) const;
+	glm::vec3 GetScale(int handle) const;
+
+	// the world position that the matrices are made relative to
+	void SetRenderOrigin(glm::dvec3 origin);
+
+	// rebuild the world matrices of the dirty batches and return
+	// the number of batches that were composed
+	int UpdateWorldMatrices();
+
+	// the render space matrix of a transform
+	const glm::mat4& GetWorldMatrix(int handle) const { return(m_worldMatrices[handle]); }
+	// the number of handles in use, including released handles
+	int GetTransformCount() const { return(m_transformCount); }
+
+	// direct access to the arrays for systems that write whole
+	// batches of transforms, like the animation sampling
+	double* GetPositionArray(int axis) { return(m_position[axis].data()); }
+	float* GetRotationArray(int axis) { return(m_rotation[axis].data()); }
+	float* GetScaleArray(int axis) { return(m_scale[axis].data()); }
+	// mark a range of transforms dirty after writing the arrays
+	void MarkRangeDirty(int firstHandle, int count);
+
+private:
+	void MarkDirty(int handle);
+	void UpdateRenderPositions(int batch);
+
+	int m_transformCount;
+	// the transform values, padded to whole batches - the
+	// rotations are stored in radians
+	std::vector<double> m_position[3];
+	std::vector<float> m_rotation[3];
+	std::vector<float> m_scale[3];
+	// the positions relative to the render origin
+	std::vector<float> m_renderPosition[3];
+	glm::dvec3 m_renderOrigin;
+	bool m_bOriginMoved;
+	// the composed matrices, also padded to whole batches
+	std::vector<glm::mat4> m_worldMatrices;
+	// one flag for each batch of transforms
+	std::vector<uint8_t> m_dirtyBatches;
+	// the released handles waiting to be reused
+	std::vector<int> m_freeHandles;
+	bool m_bAnyDirty;
+};
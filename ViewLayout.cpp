@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////
+// viewlayout.cpp
+// ==============
+// keep the views that the scene is rendered into each frame - one full
+// window view, or four views sharing the window, and the views rendered
+// into the targets of other windows
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ViewLayout.h"
+
+// declaration of global variables
+namespace
+{
+	VIEW_SETTINGS g_Views[ViewLayout::MAX_VIEWS];
+	CameraState g_Cameras[ViewLayout::MAX_VIEWS];
+	int g_ViewCount = 0;
+	int g_CurrentView = 0;
+
+	int g_TargetWidth = 0;
+	int g_TargetHeight = 0;
+}
+
+/***********************************************************
+ *  SetViews()
+ *
+ *  This method is used for setting the views rendered in
+ *  the frame.  Views past the maximum are left out, and the
+ *  camera of a view only changes its version when it has
+ *  different matrices than in the last frame.
+ ***********************************************************/
+void ViewLayout::SetViews(const VIEW_SETTINGS* pViews, int count)
+{
+	if ((NULL == pViews) || (count < 0))
+	{
+		count = 0;
+	}
+	if (count > MAX_VIEWS)
+	{
+		count = MAX_VIEWS;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		g_Views[i] = pViews[i];
+		g_Cameras[i].SetView(pViews[i].view, pViews[i].position);
+		g_Cameras[i].SetProjection(pViews[i].projection);
+	}
+	g_ViewCount = count;
+}
+
+/***********************************************************
+ *  GetViewCount()
+ *
+ *  This method is used for getting the number of views
+ *  rendered in the frame.
+ ***********************************************************/
+int ViewLayout::GetViewCount()
+{
+	return(g_ViewCount);
+}
+
+/***********************************************************
+ *  GetView()
+ *
+ *  This method is used for getting the settings of a view.
+ ***********************************************************/
+const VIEW_SETTINGS& ViewLayout::GetView(int index)
+{
+	return(g_Views[index]);
+}
+
+/***********************************************************
+ *  GetCamera()
+ *
+ *  This method is used for getting the camera state of a
+ *  view.
+ ***********************************************************/
+const CameraState& ViewLayout::GetCamera(int index)
+{
+	return(g_Cameras[index]);
+}
+
+/***********************************************************
+ *  ApplyView()
+ *
+ *  This method is used for making a view current - its
+ *  framebuffer and viewport are set, and its camera becomes
+ *  the current camera and is set into the shader, unless
+ *  the shader already holds it.  An offscreen target is
+ *  cleared, since the view is the only one drawn into it.
+ ***********************************************************/
+void ViewLayout::ApplyView(int index, ShaderManager* pShaderManager)
+{
+	if ((index < 0) || (index >= g_ViewCount))
+	{
+		return;
+	}
+
+	const VIEW_SETTINGS& settings = g_Views[index];
+	glBindFramebuffer(GL_FRAMEBUFFER, settings.framebuffer);
+	glViewport(settings.viewport[0], settings.viewport[1], settings.viewport[2], settings.viewport[3]);
+	if (settings.framebuffer != 0)
+	{
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	}
+	g_Cameras[index].Upload(pShaderManager);
+	CameraState::SetCurrent(&g_Cameras[index]);
+	g_CurrentView = index;
+}
+
+/***********************************************************
+ *  GetCurrentView()
+ *
+ *  This method is used for getting the index of the view
+ *  that was made current last.
+ ***********************************************************/
+int ViewLayout::GetCurrentView()
+{
+	return(g_CurrentView);
+}
+
+/***********************************************************
+ *  SetTargetSize()
+ *
+ *  This method is used for setting the size the offscreen
+ *  render targets are allocated at.
+ ***********************************************************/
+void ViewLayout::SetTargetSize(int width, int height)
+{
+	g_TargetWidth = width;
+	g_TargetHeight = height;
+}
+
+/***********************************************************
+ *  GetTargetSize()
+ *
+ *  This method is used for getting the size the offscreen
+ *  render targets are allocated at.
+ ***********************************************************/
+void ViewLayout::GetTargetSize(int& width, int& height)
+{
+	width = g_TargetWidth;
+	height = g_TargetHeight;
+}
@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////
+// viewlayout.h
+// ============
+// keep the views that the scene is rendered into each frame - one full
+// window view, or four views sharing the window, and the views rendered
+// into the targets of other windows
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "CameraState.h"
+
+#include <glm/glm.hpp>
+
+// the viewport and camera of one view, in render space
+struct VIEW_SETTINGS
+{
+	// x, y, width and height in framebuffer pixels
+	int viewport[4];
+	glm::mat4 view;
+	glm::mat4 projection;
+	glm::vec3 position;
+	// the framebuffer rendered into - zero is the window, and any
+	// other target is cleared when the view is made current
+	GLuint framebuffer;
+	// the view whose visible rooms are drawn - a view with its own
+	// camera culls for itself, and the views around one camera
+	// share its rooms
+	int cullingView;
+};
+
+/***********************************************************
+ *  ViewLayout
+ *
+ *  The view manager sets the views of the frame, and the
+ *  main loop renders the scene once for every view.  The
+ *  first view of a frame is the camera of the view manager,
+ *  so the work done once per frame - animation, lights,
+ *  streaming and the room visibility - is done while it is
+ *  current, and the other views only draw the objects.
+ *  Every view keeps its camera in a camera state, so a view
+ *  that has not changed is not uploaded again.  A view can
+ *  render into an offscreen target that is shown in another
+ *  window, sharing the meshes, textures and shaders of the
+ *  main window.
+ ***********************************************************/
+class ViewLayout
+{
+public:
+	// the most views rendered in one frame
+	static const int MAX_VIEWS = 8;
+
+	static void SetViews(const VIEW_SETTINGS* pViews, int count);
+	static int GetViewCount();
+	static const VIEW_SETTINGS& GetView(int index);
+	static const CameraState& GetCamera(int index);
+
+	// set the viewport of a view, and make its camera current and
+	// upload it into the shader when the shader does not hold it
+	static void ApplyView(int index, ShaderManager* pShaderManager);
+	// the view being rendered, which is zero once per frame
+	static int GetCurrentView();
+
+	// the size the offscreen render targets are allocated at - it
+	// follows the framebuffer once a resize has settled, so the
+	// targets are not reallocated on every step of a drag
+	static void SetTargetSize(int width, int height);
+	static void GetTargetSize(int& width, int& height);
+};
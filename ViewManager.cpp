@@ -8,6 +8,20 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "ViewManager.h"
+#include "RenderOrigin.h"
+#include "CameraCollider.h"
+#include "SpatialQuery.h"
+#include "ObjectPicker.h"
+#include "ViewLayout.h"
+#include "InputQueue.h"
+#include "PresentationWindow.h"
+#include "FrameRecorder.h"
+#include "ControlServer.h"
+#include "RenderSettings.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <ctime>
 
 // GLM Math Header inclusions
 #define GLM_ENABLE_EXPERIMENTAL
@@ -18,28 +32,334 @@
 // declaration of the global variables and defines
 namespace
 {
-	// Variables for window width and height
-	const int WINDOW_WIDTH = 1000;
-	const int WINDOW_HEIGHT = 800;
-	const char* g_ViewName = "view";
-	const char* g_ProjectionName = "projection";
+	// the offscreen targets follow the framebuffer once it has kept
+	// its size for this many seconds
+	const float RESIZE_SETTLE_SECONDS = 0.25f;
+	// the top and side views look at the point this far in front
+	// of the camera, which is the middle of the room for the front
+	// view set by the O key
+	const float ORTHOGRAPHIC_FOCUS_DISTANCE = 10.0f;
+	// the top and side views are placed this far from that point
+	const float ORTHOGRAPHIC_EYE_DISTANCE = 50.0f;
 
 	// camera object used for viewing and interacting with
 	// the 3D scene
 	Camera* g_pCamera = nullptr;
+	// keeps the camera from flying through the scene objects
+	CameraCollider* g_pCameraCollider = nullptr;
 
 	// these variables are used for mouse movement processing
-	float gLastX = WINDOW_WIDTH / 2.0f;
-	float gLastY = WINDOW_HEIGHT / 2.0f;
+	float gLastX = 0.0f;
+	float gLastY = 0.0f;
 	bool gFirstMouse = true;
 
-	// time between current frame and last frame
-	float gDeltaTime = 0.0f; 
-	float gLastFrame = 0.0f;
+	// the GLFW callbacks only push events into this queue, and the
+	// simulation step applies them to the camera
+	InputQueue* g_pInputQueue = nullptr;
+	// the keys held down, and the time each held key was last
+	// applied up to
+	bool g_KeyDown[GLFW_KEY_LAST + 1] = {};
+	double g_KeyAppliedTime[GLFW_KEY_LAST + 1] = {};
+	// the time each key was held since the last step, including
+	// the presses that were released again before it
+	double g_KeyHeldTime[GLFW_KEY_LAST + 1] = {};
 
 	// the following variable is false when orthographic projection
 	// is off and true when it is on
 	bool bOrthographicProjection = false;
+
+	// the size of the framebuffer in pixels, which is larger than
+	// the window size on high DPI displays
+	int g_FramebufferWidth = 0;
+	int g_FramebufferHeight = 0;
+	// the time of the last change to the framebuffer size
+	float g_LastResizeTime = 0.0f;
+
+	// the projections of the views, and the viewport size and zoom
+	// they were computed for
+	glm::mat4 g_PerspectiveProjection;
+	glm::mat4 g_OrthographicProjection;
+	int g_ProjectionWidth = 0;
+	int g_ProjectionHeight = 0;
+	float g_ProjectionZoom = 0.0f;
+
+	// the view matrices of the camera and of the top and side views
+	// around it, and the camera placement they were computed for
+	glm::mat4 g_CameraView;
+	glm::mat4 g_TopView;
+	glm::mat4 g_SideView;
+	glm::vec3 g_TopEye;
+	glm::vec3 g_SideEye;
+	glm::vec3 g_ViewPosition;
+	glm::vec3 g_ViewFront;
+	glm::vec3 g_ViewUp;
+	bool g_bViewValid = false;
+
+	// the second window opened with the F2 key, which keeps showing
+	// the camera placement it was opened at while the camera of the
+	// main window moves on - the position is kept in world space so
+	// it stays put when the render origin moves
+	PresentationWindow* g_pPresentationWindow = nullptr;
+	glm::dvec3 g_PresentationPosition;
+	glm::vec3 g_PresentationFront;
+	glm::vec3 g_PresentationUp;
+	float g_PresentationZoom = 0.0f;
+	// the matrices of the presentation view, and the render origin
+	// and target size they were computed for
+	glm::mat4 g_PresentationView;
+	glm::mat4 g_PresentationProjection;
+	unsigned int g_PresentationOriginVersion = 0;
+	int g_PresentationWidth = 0;
+	int g_PresentationHeight = 0;
+
+	// records the frames of the main window while the F3 key has
+	// turned the recording on
+	FrameRecorder* g_pFrameRecorder = nullptr;
+
+	/***********************************************************
+	 *  OrthographicProjection()
+	 *
+	 *  This function is used for getting a 10 unit orthographic
+	 *  projection that keeps the aspect ratio of a viewport.
+	 ***********************************************************/
+	glm::mat4 OrthographicProjection(int width, int height)
+	{
+		// front-view orthographic projection with correct aspect ratio
+		double scale = 0.0;
+		float nearPlane = RenderSettings::Get().nearPlane;
+		float farPlane = RenderSettings::Get().farPlane;
+		if (width > height)
+		{
+			scale = (double)height / (double)width;
+			return(glm::ortho(-5.0f, 5.0f, -5.0f * (float)scale, 5.0f * (float)scale, nearPlane, farPlane));
+		}
+		else if (width < height)
+		{
+			scale = (double)width / (double)height;
+			return(glm::ortho(-5.0f * (float)scale, 5.0f * (float)scale, -5.0f, 5.0f, nearPlane, farPlane));
+		}
+		return(glm::ortho(-5.0f, 5.0f, -5.0f, 5.0f, nearPlane, farPlane));
+	}
+
+	/***********************************************************
+	 *  SetView()
+	 *
+	 *  This function is used for filling the settings of a
+	 *  view.
+	 ***********************************************************/
+	void SetView(
+		VIEW_SETTINGS& settings,
+		int x, int y, int width, int height,
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		glm::vec3 position)
+	{
+		settings.viewport[0] = x;
+		settings.viewport[1] = y;
+		settings.viewport[2] = width;
+		settings.viewport[3] = height;
+		settings.view = view;
+		settings.projection = projection;
+		settings.position = position;
+		settings.framebuffer = 0;
+		settings.cullingView = 0;
+	}
+
+	/***********************************************************
+	 *  Mouse_Button_Callback()
+	 *
+	 *  This function is automatically called from GLFW whenever
+	 *  a mouse button is pressed or released.  The event holds
+	 *  the framebuffer pixel under the cursor, or under the
+	 *  center of the window while the cursor is captured by
+	 *  the camera, which a left click picks the object at.
+	 *  The window position is scaled to framebuffer pixels
+	 *  for high DPI displays.
+	 ***********************************************************/
+	void Mouse_Button_Callback(GLFWwindow* window, int button, int action, int mods)
+	{
+		if (NULL == g_pInputQueue)
+		{
+			return;
+		}
+
+		int windowWidth = 0;
+		int windowHeight = 0;
+		int framebufferWidth = 0;
+		int framebufferHeight = 0;
+		glfwGetWindowSize(window, &windowWidth, &windowHeight);
+		glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+		if ((windowWidth <= 0) || (windowHeight <= 0))
+		{
+			return;
+		}
+
+		double cursorX = windowWidth * 0.5;
+		double cursorY = windowHeight * 0.5;
+		if (glfwGetInputMode(window, GLFW_CURSOR) != GLFW_CURSOR_DISABLED)
+		{
+			glfwGetCursorPos(window, &cursorX, &cursorY);
+		}
+
+		// the window rows count down from the top, and the
+		// framebuffer rows up from the bottom
+		INPUT_EVENT event;
+		event.type = INPUT_MOUSE_BUTTON;
+		event.time = glfwGetTime();
+		event.code = button;
+		event.action = action;
+		event.x = (int)(cursorX * framebufferWidth / windowWidth);
+		event.y = framebufferHeight - 1 - (int)(cursorY * framebufferHeight / windowHeight);
+		g_pInputQueue->Push(event);
+	}
+
+	/***********************************************************
+	 *  Key_Callback()
+	 *
+	 *  This function is automatically called from GLFW whenever
+	 *  a key is pressed or released.  The repeats of a held key
+	 *  are left out, since a held key is applied for as long as
+	 *  it is held.
+	 ***********************************************************/
+	void Key_Callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+	{
+		if ((NULL == g_pInputQueue) || (action == GLFW_REPEAT))
+		{
+			return;
+		}
+
+		INPUT_EVENT event;
+		event.type = INPUT_KEY;
+		event.time = glfwGetTime();
+		event.code = key;
+		event.action = action;
+		event.x = 0.0;
+		event.y = 0.0;
+		g_pInputQueue->Push(event);
+	}
+
+	/***********************************************************
+	 *  ClosePresentationWindow()
+	 *
+	 *  This function is used for closing the presentation
+	 *  window.
+	 ***********************************************************/
+	void ClosePresentationWindow()
+	{
+		if (NULL != g_pPresentationWindow)
+		{
+			PresentationWindow::SetActive(NULL);
+			delete g_pPresentationWindow;
+			g_pPresentationWindow = NULL;
+		}
+	}
+
+	/***********************************************************
+	 *  OpenPresentationWindow()
+	 *
+	 *  This function is used for opening the presentation
+	 *  window at the current placement of the camera.
+	 ***********************************************************/
+	void OpenPresentationWindow(GLFWwindow* pMainWindow)
+	{
+		g_pPresentationWindow = new PresentationWindow();
+		if (g_pPresentationWindow->Open(pMainWindow, "Presentation",
+			RenderSettings::Get().windowWidth / 2, RenderSettings::Get().windowHeight / 2) == false)
+		{
+			delete g_pPresentationWindow;
+			g_pPresentationWindow = NULL;
+			return;
+		}
+
+		// the keys of the presentation window go into the same queue
+		glfwSetKeyCallback(g_pPresentationWindow->GetWindow(), Key_Callback);
+		PresentationWindow::SetActive(g_pPresentationWindow);
+
+		g_PresentationPosition = RenderOrigin::ToWorld(g_pCamera->Position);
+		g_PresentationFront = g_pCamera->Front;
+		g_PresentationUp = g_pCamera->Up;
+		g_PresentationZoom = g_pCamera->Zoom;
+		g_PresentationWidth = 0;
+		g_PresentationHeight = 0;
+	}
+
+	/***********************************************************
+	 *  StopRecording()
+	 *
+	 *  This function is used for stopping the recording of the
+	 *  frames.
+	 ***********************************************************/
+	void StopRecording()
+	{
+		if (NULL != g_pFrameRecorder)
+		{
+			FrameRecorder::SetActive(NULL);
+			delete g_pFrameRecorder;
+			g_pFrameRecorder = NULL;
+		}
+	}
+
+	/***********************************************************
+	 *  StartRecording()
+	 *
+	 *  This function is used for recording the frames of the
+	 *  main window into a video named after the time it was
+	 *  started.
+	 ***********************************************************/
+	void StartRecording(GLFWwindow* pMainWindow)
+	{
+		char filename[64];
+		time_t now = time(NULL);
+		strftime(filename, sizeof(filename), "recording_%Y%m%d_%H%M%S.mp4", localtime(&now));
+
+		g_pFrameRecorder = new FrameRecorder();
+		if (g_pFrameRecorder->Start(pMainWindow, filename) == false)
+		{
+			delete g_pFrameRecorder;
+			g_pFrameRecorder = NULL;
+			return;
+		}
+		FrameRecorder::SetActive(g_pFrameRecorder);
+	}
+
+	/***********************************************************
+	 *  TakeHeldTime()
+	 *
+	 *  This function is used for getting the time a key was
+	 *  held since the last step, up to the time of this step.
+	 ***********************************************************/
+	float TakeHeldTime(int key, double stepTime)
+	{
+		double heldTime = g_KeyHeldTime[key];
+		if ((g_KeyDown[key] == true) && (stepTime > g_KeyAppliedTime[key]))
+		{
+			heldTime += stepTime - g_KeyAppliedTime[key];
+			g_KeyAppliedTime[key] = stepTime;
+		}
+		g_KeyHeldTime[key] = 0.0;
+		return((float)heldTime);
+	}
+
+	/***********************************************************
+	 *  Framebuffer_Size_Callback()
+	 *
+	 *  This function is automatically called from GLFW whenever
+	 *  the framebuffer of the window is resized, or moved to a
+	 *  display with a different pixel density.  A minimized
+	 *  window reports a size of zero, which is ignored so the
+	 *  views keep their last size.
+	 ***********************************************************/
+	void Framebuffer_Size_Callback(GLFWwindow* window, int width, int height)
+	{
+		if ((width <= 0) || (height <= 0))
+		{
+			return;
+		}
+
+		g_FramebufferWidth = width;
+		g_FramebufferHeight = height;
+		g_LastResizeTime = glfwGetTime();
+	}
 }
 
 /***********************************************************
@@ -60,6 +380,8 @@ ViewManager::ViewManager(
 	g_pCamera->Up = glm::vec3(0.0f, 1.0f, 0.0f);
 	g_pCamera->Zoom = 80;
 	g_pCamera->MovementSpeed = 20;
+	g_pCameraCollider = new CameraCollider();
+	g_pInputQueue = new InputQueue();
 }
 
 /***********************************************************
@@ -77,6 +399,18 @@ ViewManager::~ViewManager()
 		delete g_pCamera;
 		g_pCamera = NULL;
 	}
+	if (NULL != g_pCameraCollider)
+	{
+		delete g_pCameraCollider;
+		g_pCameraCollider = NULL;
+	}
+	if (NULL != g_pInputQueue)
+	{
+		delete g_pInputQueue;
+		g_pInputQueue = NULL;
+	}
+	ClosePresentationWindow();
+	StopRecording();
 }
 
 /***********************************************************
@@ -87,20 +421,28 @@ ViewManager::~ViewManager()
 GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
 {
 	GLFWwindow* window = nullptr;
+	const RENDER_SETTINGS& settings = RenderSettings::Get();
+
+	// the edges are smoothed by a multisampled default framebuffer
+	glfwWindowHint(GLFW_SAMPLES, settings.msaaSamples);
 
 	// try to create the displayed OpenGL window
 	window = glfwCreateWindow(
-		WINDOW_WIDTH,
-		WINDOW_HEIGHT,
+		settings.windowWidth,
+		settings.windowHeight,
 		windowTitle,
 		NULL, NULL);
 	if (window == NULL)
 	{
-		std::cout << "Failed to create GLFW window" << std::endl;
+		LOG_ERROR("Failed to create GLFW window");
 		glfwTerminate();
 		return NULL;
 	}
 	glfwMakeContextCurrent(window);
+	if (settings.swapInterval >= 0)
+	{
+		glfwSwapInterval(settings.swapInterval);
+	}
 
 	// tell GLFW to capture all mouse events
 	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
@@ -115,6 +457,18 @@ GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
 	// this callback is used to receive mouse scroll wheel events
 	glfwSetScrollCallback(window, &ViewManager::Mouse_Scroll_Wheel_Callback);
 
+	// this callback is used to pick objects with the mouse
+	glfwSetMouseButtonCallback(window, Mouse_Button_Callback);
+
+	// this callback is used to receive key presses and releases
+	glfwSetKeyCallback(window, Key_Callback);
+
+	// the views are sized to the framebuffer, which differs from
+	// the window size on high DPI displays
+	glfwGetFramebufferSize(window, &g_FramebufferWidth, &g_FramebufferHeight);
+	ViewLayout::SetTargetSize(g_FramebufferWidth, g_FramebufferHeight);
+	glfwSetFramebufferSizeCallback(window, Framebuffer_Size_Callback);
+
 	m_pWindow = window;
 
 	return(window);
@@ -125,29 +479,24 @@ GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
  *
  *  This method is automatically called from GLFW whenever
  *  the mouse is moved within the active GLFW display window.
+ *  Every position is queued, so none of the moves between
+ *  two frames are lost.
  ***********************************************************/
 void ViewManager::Mouse_Position_Callback(GLFWwindow* window, double xMousePos, double yMousePos)
 {
-	// when the first mouse move event is received, this needs to be recorded so that
-	// all subsequent mouse moves can correctly calculate the X position offset and Y
-	// position offset for proper operation
-	if (gFirstMouse)
+	if (NULL == g_pInputQueue)
 	{
-		gLastX = xMousePos;
-		gLastY = yMousePos;
-		gFirstMouse = false;
+		return;
 	}
 
-	// calculate the X offset and Y offset values for moving the 3D camera accordingly
-	float xOffset = xMousePos - gLastX;
-	float yOffset = gLastY - yMousePos; // reversed since y-coordinates go from bottom to top
-
-	// set the current positions into the last position variables
-	gLastX = xMousePos;
-	gLastY = yMousePos;
-
-	// move the 3D camera according to the calculated offsets
-	g_pCamera->ProcessMouseMovement(xOffset, yOffset);
+	INPUT_EVENT event;
+	event.type = INPUT_MOUSE_MOVE;
+	event.time = glfwGetTime();
+	event.code = 0;
+	event.action = 0;
+	event.x = xMousePos;
+	event.y = yMousePos;
+	g_pInputQueue->Push(event);
 }
 
 /***********************************************************
@@ -158,66 +507,169 @@ void ViewManager::Mouse_Position_Callback(GLFWwindow* window, double xMousePos,
  ***********************************************************/
 void ViewManager::Mouse_Scroll_Wheel_Callback(GLFWwindow* window, double x, double yScrollDistance)
 {
-	// call the camera method to handle the mouse wheel scrolling
-	g_pCamera->ProcessMouseScroll(yScrollDistance);
+	if (NULL == g_pInputQueue)
+	{
+		return;
+	}
+
+	INPUT_EVENT event;
+	event.type = INPUT_SCROLL;
+	event.time = glfwGetTime();
+	event.code = 0;
+	event.action = 0;
+	event.x = x;
+	event.y = yScrollDistance;
+	g_pInputQueue->Push(event);
 }
 
 /***********************************************************
  *  ProcessKeyboardEvents()
  *
- *  This method is called to process any keyboard events
- *  that may be waiting in the event queue.
+ *  This method is called to apply the input events queued
+ *  by the GLFW callbacks since the last step, in the order
+ *  they happened.  The movement keys move the camera for
+ *  the time they were held, taken from the timestamps of
+ *  their presses and releases, so a tap shorter than a
+ *  frame still moves the camera.
  ***********************************************************/
 void ViewManager::ProcessKeyboardEvents()
 {
-	// close the window if the escape key has been pressed
-	if (glfwGetKey(m_pWindow, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+	// if the camera object is null, then exit this method
+	if ((NULL == g_pCamera) || (NULL == g_pInputQueue))
 	{
-		glfwSetWindowShouldClose(m_pWindow, true);
+		return;
 	}
 
-	// if the camera object is null, then exit this method
-	if (NULL == g_pCamera)
+	// the events are applied up to the time of this step, and a key
+	// still held is applied from there on the next step
+	double stepTime = glfwGetTime();
+	bool bPerspectiveKey = false;
+	bool bOrthographicKey = false;
+	bool bPresentationKey = false;
+	bool bRecordKey = false;
+
+	// the keys move the camera freely, and the move is then
+	// checked against the scene
+	glm::vec3 previousPosition = g_pCamera->Position;
+
+	INPUT_EVENT event;
+	while (g_pInputQueue->Pop(event) == true)
 	{
-		return;
+		double eventTime = std::min(event.time, stepTime);
+
+		if ((event.type == INPUT_KEY) && (event.code >= 0) && (event.code <= GLFW_KEY_LAST))
+		{
+			int key = event.code;
+			if ((event.action == GLFW_PRESS) && (g_KeyDown[key] == false))
+			{
+				g_KeyDown[key] = true;
+				g_KeyAppliedTime[key] = eventTime;
+
+				// close the window if the escape key has been pressed
+				if (key == GLFW_KEY_ESCAPE)
+				{
+					glfwSetWindowShouldClose(m_pWindow, true);
+				}
+				bPerspectiveKey |= (key == GLFW_KEY_P);
+				bOrthographicKey |= (key == GLFW_KEY_O);
+				bPresentationKey |= (key == GLFW_KEY_F2);
+				bRecordKey |= (key == GLFW_KEY_F3);
+			}
+			else if ((event.action == GLFW_RELEASE) && (g_KeyDown[key] == true))
+			{
+				g_KeyDown[key] = false;
+				g_KeyHeldTime[key] += std::max(eventTime - g_KeyAppliedTime[key], 0.0);
+			}
+		}
+		else if (event.type == INPUT_MOUSE_MOVE)
+		{
+			// when the first mouse move event is received, this needs to be recorded so that
+			// all subsequent mouse moves can correctly calculate the X position offset and Y
+			// position offset for proper operation
+			if (gFirstMouse)
+			{
+				gLastX = event.x;
+				gLastY = event.y;
+				gFirstMouse = false;
+			}
+
+			// calculate the X offset and Y offset values for moving the 3D camera accordingly
+			float xOffset = event.x - gLastX;
+			float yOffset = gLastY - event.y; // reversed since y-coordinates go from bottom to top
+
+			// set the current positions into the last position variables
+			gLastX = event.x;
+			gLastY = event.y;
+
+			// move the 3D camera according to the calculated offsets
+			g_pCamera->ProcessMouseMovement(xOffset, yOffset);
+		}
+		else if (event.type == INPUT_SCROLL)
+		{
+			// call the camera method to handle the mouse wheel scrolling
+			g_pCamera->ProcessMouseScroll(event.y);
+		}
+		else if ((event.type == INPUT_MOUSE_BUTTON) && (event.code == GLFW_MOUSE_BUTTON_LEFT) &&
+			(event.action == GLFW_PRESS) && (NULL != ObjectPicker::GetScene()))
+		{
+			// pick the object under the clicked pixel
+			ObjectPicker::GetScene()->RequestPick((int)event.x, (int)event.y);
+		}
 	}
 
 	// process camera zooming in and out
-	if (glfwGetKey(m_pWindow, GLFW_KEY_W) == GLFW_PRESS)
+	float heldTime = TakeHeldTime(GLFW_KEY_W, stepTime);
+	if (heldTime > 0.0f)
 	{
-		g_pCamera->ProcessKeyboard(FORWARD, gDeltaTime);
+		g_pCamera->ProcessKeyboard(FORWARD, heldTime);
 	}
-	if (glfwGetKey(m_pWindow, GLFW_KEY_S) == GLFW_PRESS)
+	heldTime = TakeHeldTime(GLFW_KEY_S, stepTime);
+	if (heldTime > 0.0f)
 	{
-		g_pCamera->ProcessKeyboard(BACKWARD, gDeltaTime);
+		g_pCamera->ProcessKeyboard(BACKWARD, heldTime);
 	}
 
 	// process camera panning left and right
-	if (glfwGetKey(m_pWindow, GLFW_KEY_A) == GLFW_PRESS)
+	heldTime = TakeHeldTime(GLFW_KEY_A, stepTime);
+	if (heldTime > 0.0f)
 	{
-		g_pCamera->ProcessKeyboard(LEFT, gDeltaTime);
+		g_pCamera->ProcessKeyboard(LEFT, heldTime);
 	}
-	if (glfwGetKey(m_pWindow, GLFW_KEY_D) == GLFW_PRESS)
+	heldTime = TakeHeldTime(GLFW_KEY_D, stepTime);
+	if (heldTime > 0.0f)
 	{
-		g_pCamera->ProcessKeyboard(RIGHT, gDeltaTime);
+		g_pCamera->ProcessKeyboard(RIGHT, heldTime);
 	}
 
 	// process camera panning up and down
-	if (glfwGetKey(m_pWindow, GLFW_KEY_Q) == GLFW_PRESS)
+	heldTime = TakeHeldTime(GLFW_KEY_Q, stepTime);
+	if (heldTime > 0.0f)
 	{
-		g_pCamera->ProcessKeyboard(UP, gDeltaTime);
+		g_pCamera->ProcessKeyboard(UP, heldTime);
 	}
-	if (glfwGetKey(m_pWindow, GLFW_KEY_E) == GLFW_PRESS)
+	heldTime = TakeHeldTime(GLFW_KEY_E, stepTime);
+	if (heldTime > 0.0f)
 	{
-		g_pCamera->ProcessKeyboard(DOWN, gDeltaTime);
+		g_pCamera->ProcessKeyboard(DOWN, heldTime);
 	}
 
-	if (glfwGetKey(m_pWindow, GLFW_KEY_P) == GLFW_PRESS)
+	// slide the camera along the static objects it would have
+	// passed through
+	if (NULL != g_pCameraCollider)
+	{
+		g_pCamera->Position = g_pCameraCollider->Move(
+			SpatialQuery::GetStaticScene(),
+			previousPosition,
+			g_pCamera->Position);
+	}
+
+	if (bPerspectiveKey == true)
 	{
 		// change to perspective projection
 		bOrthographicProjection = false;
 
 		// change the camera settings to show a perspective view
+		RenderOrigin::Set(glm::dvec3(0.0));
 		g_pCamera->Position = glm::vec3(0.0f, 5.5f, 8.0f);
 		g_pCamera->Front = glm::vec3(0.0f, -0.5f, -2.0f);
 		g_pCamera->Up = glm::vec3(0.0f, 1.0f, 0.0f);
@@ -225,16 +677,70 @@ void ViewManager::ProcessKeyboardEvents()
 	}
 
 	// change between different projection views
-	if (glfwGetKey(m_pWindow, GLFW_KEY_O) == GLFW_PRESS)
+	if (bOrthographicKey == true)
 	{
 		// change to a multi-view orthographic projection
 		bOrthographicProjection = true;
 
-		// change the camera settings to show a front orthographic view
+		// change the camera settings to show the front orthographic
+		// view, with the top and side views around the same point
+		RenderOrigin::Set(glm::dvec3(0.0));
 		g_pCamera->Position = glm::vec3(0.0f, 4.0f, 10.0f);
 		g_pCamera->Up = glm::vec3(0.0f, 1.0f, 0.0f);
 		g_pCamera->Front = glm::vec3(0.0f, 0.0f, -1.0f);
 	}
+
+	// place the camera and pick the projection for the control
+	// clients, in the order the commands were sent - the camera is
+	// moved after the collider, like the keys above, so a command
+	// can put it anywhere
+	ControlServer* pControlServer = ControlServer::GetActive();
+	CONTROL_COMMAND command;
+	while ((NULL != pControlServer) &&
+		(pControlServer->PopCommand(CONTROL_SET_CAMERA | CONTROL_SET_PROJECTION, command) == true))
+	{
+		if (command.type == CONTROL_SET_CAMERA)
+		{
+			RenderOrigin::Set(command.position);
+			g_pCamera->Position = glm::vec3(0.0f);
+			g_pCamera->Front = glm::normalize(command.front);
+			if (command.zoom > 0.0f)
+			{
+				g_pCamera->Zoom = command.zoom;
+			}
+		}
+		else
+		{
+			bOrthographicProjection = command.bOrthographic;
+		}
+		pControlServer->Reply(command, true);
+	}
+
+	// open a presentation window at the current camera, or close it
+	if (bPresentationKey == true)
+	{
+		if (NULL == g_pPresentationWindow)
+		{
+			OpenPresentationWindow(m_pWindow);
+		}
+		else
+		{
+			ClosePresentationWindow();
+		}
+	}
+
+	// start or stop recording the frames of the main window
+	if (bRecordKey == true)
+	{
+		if (NULL == g_pFrameRecorder)
+		{
+			StartRecording(m_pWindow);
+		}
+		else
+		{
+			StopRecording();
+		}
+	}
 }
 
 /***********************************************************
@@ -246,54 +752,124 @@ void ViewManager::ProcessKeyboardEvents()
  ***********************************************************/
 void ViewManager::PrepareSceneView()
 {
-	glm::mat4 view;
-	glm::mat4 projection;
-
-	// per-frame timing
 	float currentFrame = glfwGetTime();
-	gDeltaTime = currentFrame - gLastFrame;
-	gLastFrame = currentFrame;
 
-	// process any keyboard events that may be waiting in the 
-	// event queue
+	// apply the input events that were queued since the last frame
 	ProcessKeyboardEvents();
 
-	// get the current view matrix from the camera
-	view = g_pCamera->GetViewMatrix();
+	// the camera position is relative to the render origin, which
+	// follows the camera when it moves far away from it
+	RenderOrigin::Rebase(g_pCamera->Position);
+
+	// the view matrices are only computed again when the camera has
+	// moved or turned
+	if ((g_bViewValid == false) || (g_pCamera->Position != g_ViewPosition) ||
+		(g_pCamera->Front != g_ViewFront) || (g_pCamera->Up != g_ViewUp))
+	{
+		glm::vec3 focus = g_pCamera->Position + glm::normalize(g_pCamera->Front) * ORTHOGRAPHIC_FOCUS_DISTANCE;
+		g_TopEye = focus + glm::vec3(0.0f, ORTHOGRAPHIC_EYE_DISTANCE, 0.0f);
+		g_SideEye = focus + glm::vec3(ORTHOGRAPHIC_EYE_DISTANCE, 0.0f, 0.0f);
+
+		g_CameraView = g_pCamera->GetViewMatrix();
+		g_TopView = glm::lookAt(g_TopEye, focus, glm::vec3(0.0f, 0.0f, -1.0f));
+		g_SideView = glm::lookAt(g_SideEye, focus, glm::vec3(0.0f, 1.0f, 0.0f));
+		g_ViewPosition = g_pCamera->Position;
+		g_ViewFront = g_pCamera->Front;
+		g_ViewUp = g_pCamera->Up;
+		g_bViewValid = true;
+	}
+
+	// the offscreen targets are reallocated once the framebuffer has
+	// kept its size for a moment, instead of on every step of a drag
+	int targetWidth = 0;
+	int targetHeight = 0;
+	ViewLayout::GetTargetSize(targetWidth, targetHeight);
+	if (((targetWidth != g_FramebufferWidth) || (targetHeight != g_FramebufferHeight)) &&
+		(currentFrame - g_LastResizeTime >= RESIZE_SETTLE_SECONDS))
+	{
+		ViewLayout::SetTargetSize(g_FramebufferWidth, g_FramebufferHeight);
+	}
+
+	// the views follow the framebuffer right away, and the
+	// projections are only computed again when the size of the
+	// views or the zoom has changed
+	int width = g_FramebufferWidth;
+	int height = g_FramebufferHeight;
+	if (bOrthographicProjection == true)
+	{
+		width = std::max(width / 2, 1);
+		height = std::max(height / 2, 1);
+	}
+	if ((width != g_ProjectionWidth) || (height != g_ProjectionHeight) ||
+		(g_pCamera->Zoom != g_ProjectionZoom))
+	{
+		g_PerspectiveProjection = glm::perspective(glm::radians(g_pCamera->Zoom), (GLfloat)width / (GLfloat)height,
+			RenderSettings::Get().nearPlane, RenderSettings::Get().farPlane);
+		g_OrthographicProjection = OrthographicProjection(width, height);
+		g_ProjectionWidth = width;
+		g_ProjectionHeight = height;
+		g_ProjectionZoom = g_pCamera->Zoom;
+	}
 
-	// define the current projection matrix
+	VIEW_SETTINGS views[ViewLayout::MAX_VIEWS];
+	int viewCount = 1;
 	if (bOrthographicProjection == false)
 	{
 		// perspective projection
-		projection = glm::perspective(glm::radians(g_pCamera->Zoom), (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT, 0.1f, 100.0f);
+		SetView(views[0], 0, 0, width, height, g_CameraView, g_PerspectiveProjection, g_ViewPosition);
 	}
 	else
 	{
-		// front-view orthographic projection with correct aspect ratio
-		double scale = 0.0;
-		if (WINDOW_WIDTH > WINDOW_HEIGHT)
-		{
-			scale = (double)WINDOW_HEIGHT / (double)WINDOW_WIDTH;
-			projection = glm::ortho(-5.0f, 5.0f, -5.0f * (float)scale, 5.0f * (float)scale, 0.1f, 100.0f);
-		}
-		else if (WINDOW_WIDTH < WINDOW_HEIGHT)
-		{
-			scale = (double)WINDOW_WIDTH / (double)WINDOW_HEIGHT;
-			projection = glm::ortho(-5.0f * (float)scale, 5.0f * (float)scale, -5.0f, 5.0f, 0.1f, 100.0f);
-		}
-		else
-		{
-			projection = glm::ortho(-5.0f, 5.0f, -5.0f, 5.0f, 0.1f, 100.0f);
-		}
+		// the perspective camera in the top right quarter of the
+		// window, the top view in the top left, and the front and
+		// side views below them - the camera view comes first, so
+		// the rooms it sees are the ones drawn in every view
+		const glm::mat4& orthographic = g_OrthographicProjection;
+		SetView(views[0], width, height, width, height, g_CameraView, g_PerspectiveProjection, g_ViewPosition);
+		SetView(views[1], 0, height, width, height, g_TopView, orthographic, g_TopEye);
+		SetView(views[2], 0, 0, width, height, g_CameraView, orthographic, g_ViewPosition);
+		SetView(views[3], width, 0, width, height, g_SideView, orthographic, g_SideEye);
+		viewCount = 4;
 	}
-	// if the shader manager object is valid
-	if (NULL != m_pShaderManager)
+
+	// the presentation window has its own camera, so its view finds
+	// its own visible rooms
+	if ((NULL != g_pPresentationWindow) && (g_pPresentationWindow->IsOpen() == false))
 	{
-		// set the view matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ViewName, view);
-		// set the view matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ProjectionName, projection);
-		// set the view position of the camera into the shader for proper rendering
-		m_pShaderManager->setVec3Value("viewPosition", g_pCamera->Position);
+		ClosePresentationWindow();
 	}
+
+	// the recorder stops by itself when the window is resized
+	if ((NULL != g_pFrameRecorder) && (g_pFrameRecorder->IsRecording() == false))
+	{
+		StopRecording();
+	}
+	int presentationViewport[4];
+	if ((NULL != g_pPresentationWindow) && (g_pPresentationWindow->PrepareTarget(presentationViewport) == true))
+	{
+		if ((presentationViewport[2] != g_PresentationWidth) || (presentationViewport[3] != g_PresentationHeight) ||
+			(RenderOrigin::GetVersion() != g_PresentationOriginVersion))
+		{
+			glm::vec3 position = RenderOrigin::ToRender(g_PresentationPosition);
+			g_PresentationView = glm::lookAt(position, position + g_PresentationFront, g_PresentationUp);
+			g_PresentationProjection = glm::perspective(glm::radians(g_PresentationZoom),
+				(GLfloat)presentationViewport[2] / (GLfloat)presentationViewport[3],
+				RenderSettings::Get().nearPlane, RenderSettings::Get().farPlane);
+			g_PresentationWidth = presentationViewport[2];
+			g_PresentationHeight = presentationViewport[3];
+			g_PresentationOriginVersion = RenderOrigin::GetVersion();
+		}
+
+		SetView(views[viewCount], 0, 0, presentationViewport[2], presentationViewport[3],
+			g_PresentationView, g_PresentationProjection, RenderOrigin::ToRender(g_PresentationPosition));
+		views[viewCount].framebuffer = g_pPresentationWindow->GetTarget();
+		views[viewCount].cullingView = viewCount;
+		viewCount++;
+	}
+	ViewLayout::SetViews(views, viewCount);
+
+	// set the first view into the shader for proper rendering - it
+	// is only uploaded when it changed, and the main loop makes the
+	// other views current in turn
+	ViewLayout::ApplyView(0, m_pShaderManager);
 }
\ No newline at end of file
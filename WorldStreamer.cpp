@@ -0,0 +1,438 @@
+///////////////////////////////////////////////////////////////////////////////
+// worldstreamer.cpp
+// =================
+// stream the rooms of a large world in and out around the camera - cells are
+// loaded on worker threads and made resident in time slices on the main
+// thread
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "WorldStreamer.h"
+
+#include <algorithm>
+#include <chrono>
+
+// declaration of global variables
+namespace
+{
+	// the memory kept for every resident object - the object itself,
+	// its position, rotation and scale, and its world matrix
+	const size_t OBJECT_RESIDENT_BYTES = sizeof(SCENE_OBJECT) + 9 * sizeof(float) + sizeof(glm::mat4);
+
+	WorldStreamer* g_pSceneStreamer = nullptr;
+
+	/***********************************************************
+	 *  NowSeconds()
+	 *
+	 *  This function is used for reading a steady clock in
+	 *  seconds, for the upload budget of a frame.
+	 ***********************************************************/
+	double NowSeconds()
+	{
+		return(std::chrono::duration<double>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+}
+
+/***********************************************************
+ *  WorldStreamer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+WorldStreamer::WorldStreamer(
+	TransformStore* pTransformStore,
+	const RoomReplicator& replicator,
+	const SCENE_OBJECT_DEFINITION* pRoomObjects,
+	int objectCount,
+	const STREAMING_SETTINGS& settings)
+	: m_replicator(replicator)
+{
+	m_pTransformStore = pTransformStore;
+	m_pRoomObjects = pRoomObjects;
+	m_objectCount = objectCount;
+	m_settings = settings;
+	if (m_settings.unloadRadius < m_settings.loadRadius)
+	{
+		m_settings.unloadRadius = m_settings.loadRadius;
+	}
+	m_residentBytes = 0;
+	m_residentVersion = 0;
+	m_bCellsChanged = false;
+	m_changedBoundsMin = glm::vec3(0.0f);
+	m_changedBoundsMax = glm::vec3(0.0f);
+
+	m_cellCount = m_replicator.GetRoomCount();
+	m_cells.reset(new STREAM_CELL[m_cellCount]);
+	for (int cell = 0; cell < m_cellCount; cell++)
+	{
+		m_cells[cell].center = glm::vec3(m_replicator.GetRoomOrigin(cell)) + m_settings.cellCenterOffset;
+		m_cells[cell].state.store(CELL_UNLOADED);
+		m_cells[cell].residentBytes = 0;
+		m_cells[cell].distance = 0.0f;
+	}
+
+	m_pThreadPool = new ThreadPool();
+}
+
+/***********************************************************
+ *  ~WorldStreamer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+WorldStreamer::~WorldStreamer()
+{
+	if (this == g_pSceneStreamer)
+	{
+		g_pSceneStreamer = NULL;
+	}
+
+	// the workers write into the cells, so they are stopped first
+	if (NULL != m_pThreadPool)
+	{
+		delete m_pThreadPool;
+		m_pThreadPool = NULL;
+	}
+
+	for (int cell = 0; cell < m_cellCount; cell++)
+	{
+		if (m_cells[cell].state.load() != CELL_EXCLUDED)
+		{
+			EvictCell(cell);
+		}
+	}
+	m_pTransformStore = NULL;
+}
+
+/***********************************************************
+ *  GetScene()
+ *
+ *  This method is used for getting the streamer of the
+ *  scene, which is NULL when the rooms are not streamed.
+ ***********************************************************/
+WorldStreamer* WorldStreamer::GetScene()
+{
+	return(g_pSceneStreamer);
+}
+
+/***********************************************************
+ *  SetScene()
+ *
+ *  This method is used for setting the streamer of the
+ *  scene.
+ ***********************************************************/
+void WorldStreamer::SetScene(WorldStreamer* pSceneStreamer)
+{
+	g_pSceneStreamer = pSceneStreamer;
+}
+
+/***********************************************************
+ *  GetDefaultSettings()
+ *
+ *  This method is used for getting settings that keep the
+ *  rooms next to the camera room loaded.  The cell center
+ *  is the middle of the 40 x 40 x 40 reference room.
+ ***********************************************************/
+STREAMING_SETTINGS WorldStreamer::GetDefaultSettings()
+{
+	STREAMING_SETTINGS settings;
+
+	settings.loadRadius = 100.0f;
+	settings.unloadRadius = 140.0f;
+	settings.memoryBudgetBytes = 256 * 1024 * 1024;
+	settings.uploadBudgetMilliseconds = 2.0f;
+	settings.maxLoadsInFlight = 8;
+	settings.cellCenterOffset = glm::vec3(0.0f, 20.0f, 0.0f);
+
+	return(settings);
+}
+
+/***********************************************************
+ *  ExcludeCell()
+ *
+ *  This method is used for leaving a cell out of the
+ *  streaming, for the room that is loaded with the scene.
+ ***********************************************************/
+void WorldStreamer::ExcludeCell(int cell)
+{
+	if ((cell >= 0) && (cell < m_cellCount) &&
+		(m_cells[cell].state.load() == CELL_UNLOADED))
+	{
+		m_cells[cell].state.store(CELL_EXCLUDED);
+	}
+}
+
+/***********************************************************
+ *  LoadCell()
+ *
+ *  This method is run on a worker thread for building the
+ *  contents of a cell.  Only the worker touches the cell
+ *  until the loaded state is published.
+ ***********************************************************/
+void WorldStreamer::LoadCell(int cell)
+{
+	STREAM_CELL& streamCell = m_cells[cell];
+
+	streamCell.definitions.clear();
+	streamCell.definitions.reserve(m_objectCount);
+	m_replicator.ReplicateRoom(
+		cell,
+		m_pRoomObjects,
+		m_objectCount,
+		[&streamCell](const SCENE_OBJECT_DEFINITION& definition, glm::dvec3)
+		{
+			streamCell.definitions.push_back(definition);
+		});
+
+	streamCell.state.store(CELL_LOADED, std::memory_order_release);
+}
+
+/***********************************************************
+ *  UploadCell()
+ *
+ *  This method is used for adding the objects of a loaded
+ *  cell to the transform store.  The upload stops at the
+ *  deadline and continues on the next frame, and true is
+ *  returned once the cell is resident.
+ ***********************************************************/
+bool WorldStreamer::UploadCell(int cell, double deadline)
+{
+	STREAM_CELL& streamCell = m_cells[cell];
+	int definitionCount = (int)streamCell.definitions.size();
+	glm::dvec3 roomOrigin = m_replicator.GetRoomOrigin(cell);
+
+	streamCell.state.store(CELL_UPLOADING);
+	streamCell.objects.reserve(definitionCount);
+
+	for (int i = (int)streamCell.objects.size(); i < definitionCount; i++)
+	{
+		const SCENE_OBJECT_DEFINITION& definition = streamCell.definitions[i];
+		SCENE_OBJECT object;
+
+		object.name = definition.name;
+		object.mesh = definition.mesh;
+		object.textureTag = definition.textureTag;
+		object.materialTag = definition.materialTag;
+		object.color = definition.color;
+		object.bReflective = definition.bReflective;
+		object.transform = m_pTransformStore->AddTransform(
+			definition.scaleXYZ,
+			definition.XrotationDegrees,
+			definition.YrotationDegrees,
+			definition.ZrotationDegrees,
+			roomOrigin + glm::dvec3(definition.positionXYZ));
+		streamCell.objects.push_back(object);
+
+		if ((i + 1 < definitionCount) && (NowSeconds() > deadline))
+		{
+			return(false);
+		}
+	}
+
+	streamCell.definitions.clear();
+	streamCell.definitions.shrink_to_fit();
+	streamCell.residentBytes = streamCell.objects.size() * OBJECT_RESIDENT_BYTES;
+	m_residentBytes += streamCell.residentBytes;
+	m_residentCells.push_back(cell);
+	m_residentVersion++;
+	AddChangedCell(cell);
+	streamCell.state.store(CELL_RESIDENT);
+
+	return(true);
+}
+
+/***********************************************************
+ *  EvictCell()
+ *
+ *  This method is used for releasing the objects of a cell
+ *  that is loaded, partly uploaded or resident.
+ ***********************************************************/
+void WorldStreamer::EvictCell(int cell)
+{
+	STREAM_CELL& streamCell = m_cells[cell];
+
+	for (size_t i = 0; i < streamCell.objects.size(); i++)
+	{
+		m_pTransformStore->RemoveTransform(streamCell.objects[i].transform);
+	}
+	streamCell.objects.clear();
+	streamCell.objects.shrink_to_fit();
+	streamCell.definitions.clear();
+	streamCell.definitions.shrink_to_fit();
+
+	if (streamCell.state.load() == CELL_RESIDENT)
+	{
+		m_residentBytes -= streamCell.residentBytes;
+		m_residentCells.erase(std::find(m_residentCells.begin(), m_residentCells.end(), cell));
+		m_residentVersion++;
+		AddChangedCell(cell);
+	}
+	streamCell.residentBytes = 0;
+	streamCell.state.store(CELL_UNLOADED);
+}
+
+/***********************************************************
+ *  AddChangedCell()
+ *
+ *  This method is used for growing the changed box by the
+ *  room box of a cell.
+ ***********************************************************/
+void WorldStreamer::AddChangedCell(int cell)
+{
+	const ROOM_GRID_SETTINGS& grid = m_replicator.GetSettings();
+	glm::vec3 roomOrigin = glm::vec3(m_replicator.GetRoomOrigin(cell));
+	glm::vec3 roomMin = roomOrigin + grid.roomBoundsMin;
+	glm::vec3 roomMax = roomOrigin + grid.roomBoundsMax;
+
+	if (m_bCellsChanged == false)
+	{
+		m_changedBoundsMin = roomMin;
+		m_changedBoundsMax = roomMax;
+		m_bCellsChanged = true;
+	}
+	else
+	{
+		m_changedBoundsMin = glm::min(m_changedBoundsMin, roomMin);
+		m_changedBoundsMax = glm::max(m_changedBoundsMax, roomMax);
+	}
+}
+
+/***********************************************************
+ *  TakeChangedBounds()
+ *
+ *  This method is used for getting and clearing the box
+ *  around the cells that came or went, so that cached views
+ *  of the world, like reflection probes, can be redrawn.
+ ***********************************************************/
+bool WorldStreamer::TakeChangedBounds(glm::vec3& boundsMin, glm::vec3& boundsMax)
+{
+	if (m_bCellsChanged == false)
+	{
+		return(false);
+	}
+
+	boundsMin = m_changedBoundsMin;
+	boundsMax = m_changedBoundsMax;
+	m_bCellsChanged = false;
+
+	return(true);
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for streaming the cells around the
+ *  passed in camera position.  It must be called on the
+ *  main thread, before the world matrices are composed.
+ ***********************************************************/
+void WorldStreamer::Update(glm::vec3 cameraPosition)
+{
+	if ((NULL == m_pTransformStore) || (NULL == m_pThreadPool))
+	{
+		return;
+	}
+
+	double deadline = NowSeconds() + m_settings.uploadBudgetMilliseconds / 1000.0;
+
+	for (int cell = 0; cell < m_cellCount; cell++)
+	{
+		m_cells[cell].distance = glm::length(m_cells[cell].center - cameraPosition);
+	}
+	auto nearerCell = [this](int a, int b) { return(m_cells[a].distance < m_cells[b].distance); };
+
+	// collect the cells that the workers finished
+	for (size_t i = 0; i < m_loadingCells.size(); )
+	{
+		if (m_cells[m_loadingCells[i]].state.load(std::memory_order_acquire) == CELL_LOADED)
+		{
+			m_uploadQueue.push_back(m_loadingCells[i]);
+			m_loadingCells[i] = m_loadingCells.back();
+			m_loadingCells.pop_back();
+		}
+		else
+		{
+			i++;
+		}
+	}
+
+	// evict the resident cells that the camera moved away from
+	for (size_t i = 0; i < m_residentCells.size(); )
+	{
+		int cell = m_residentCells[i];
+		if (m_cells[cell].distance > m_settings.unloadRadius)
+		{
+			EvictCell(cell);
+		}
+		else
+		{
+			i++;
+		}
+	}
+
+	// make the loaded cells resident, nearest first, until the time
+	// of this frame is used up - cells that went out of range while
+	// they were loading are dropped
+	std::sort(m_uploadQueue.begin(), m_uploadQueue.end(), nearerCell);
+	size_t uploaded = 0;
+	while (uploaded < m_uploadQueue.size())
+	{
+		int cell = m_uploadQueue[uploaded];
+		if (m_cells[cell].distance > m_settings.unloadRadius)
+		{
+			EvictCell(cell);
+		}
+		else if (UploadCell(cell, deadline) == false)
+		{
+			break;
+		}
+		uploaded++;
+
+		if (NowSeconds() > deadline)
+		{
+			break;
+		}
+	}
+	m_uploadQueue.erase(m_uploadQueue.begin(), m_uploadQueue.begin() + uploaded);
+
+	// keep the resident cells within the memory budget
+	if (m_residentBytes > m_settings.memoryBudgetBytes)
+	{
+		std::vector<int> farthestFirst = m_residentCells;
+		std::sort(farthestFirst.begin(), farthestFirst.end(), nearerCell);
+		while ((m_residentBytes > m_settings.memoryBudgetBytes) && (farthestFirst.size() > 0))
+		{
+			EvictCell(farthestFirst.back());
+			farthestFirst.pop_back();
+		}
+	}
+
+	// queue the unloaded cells in the load radius, nearest first,
+	// as long as they are expected to fit in the memory budget
+	std::vector<int> candidates;
+	for (int cell = 0; cell < m_cellCount; cell++)
+	{
+		if ((m_cells[cell].state.load() == CELL_UNLOADED) &&
+			(m_cells[cell].distance < m_settings.loadRadius))
+		{
+			candidates.push_back(cell);
+		}
+	}
+	std::sort(candidates.begin(), candidates.end(), nearerCell);
+
+	size_t pendingBytes = (m_loadingCells.size() + m_uploadQueue.size()) * m_objectCount * OBJECT_RESIDENT_BYTES;
+	for (size_t i = 0; (i < candidates.size()) && ((int)m_loadingCells.size() < m_settings.maxLoadsInFlight); i++)
+	{
+		size_t cellBytes = m_objectCount * OBJECT_RESIDENT_BYTES;
+		if (m_residentBytes + pendingBytes + cellBytes > m_settings.memoryBudgetBytes)
+		{
+			break;
+		}
+		pendingBytes += cellBytes;
+
+		int cell = candidates[i];
+		m_cells[cell].state.store(CELL_LOADING);
+		m_loadingCells.push_back(cell);
+		m_pThreadPool->Enqueue([this, cell]() { LoadCell(cell); });
+	}
+}
@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////
+// worldstreamer.h
+// ===============
+// stream the rooms of a large world in and out around the camera - cells are
+// loaded on worker threads and made resident in time slices on the main
+// thread
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RoomReplicator.h"
+#include "SceneObjects.h"
+#include "ThreadPool.h"
+#include "TransformStore.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// the settings that decide which cells are resident
+struct STREAMING_SETTINGS
+{
+	// cells with their center closer than this are loaded
+	float loadRadius;
+	// resident cells farther than this are evicted - it is larger
+	// than the load radius, so that a cell on the edge of the load
+	// radius is not loaded and evicted over and over
+	float unloadRadius;
+	// the most memory that the resident cells may take
+	size_t memoryBudgetBytes;
+	// the main thread time spent each frame on making loaded
+	// cells resident
+	float uploadBudgetMilliseconds;
+	// the most cells being loaded at the same time
+	int maxLoadsInFlight;
+	// the offset from the origin of a cell to its center
+	glm::vec3 cellCenterOffset;
+};
+
+/***********************************************************
+ *  WorldStreamer
+ *
+ *  This class splits the world into cells of one room each.
+ *  Every frame the cells in the load radius are queued on
+ *  the thread pool nearest first, where the room contents
+ *  are built.  Loaded cells are then added to the transform
+ *  store on the main thread until the upload budget of the
+ *  frame is used up, and cells outside the unload radius or
+ *  over the memory budget are evicted, farthest first.
+ ***********************************************************/
+class WorldStreamer
+{
+public:
+	WorldStreamer(
+		TransformStore* pTransformStore,
+		const RoomReplicator& replicator,
+		const SCENE_OBJECT_DEFINITION* pRoomObjects,
+		int objectCount,
+		const STREAMING_SETTINGS& settings);
+	// waits for the cells that are still loading
+	~WorldStreamer();
+
+	// leave out a cell that is loaded with the scene instead
+	void ExcludeCell(int cell);
+	// load, upload and evict cells around the camera
+	void Update(glm::vec3 cameraPosition);
+
+	// the cells that can be drawn, and their objects
+	const std::vector<int>& GetResidentCells() const { return(m_residentCells); }
+	const std::vector<SCENE_OBJECT>& GetCellObjects(int cell) const { return(m_cells[cell].objects); }
+	// changes every time a cell is made resident or evicted
+	unsigned int GetResidentVersion() const { return(m_residentVersion); }
+	// get the world space box around the cells made resident or
+	// evicted since the last call, and false when none were
+	bool TakeChangedBounds(glm::vec3& boundsMin, glm::vec3& boundsMax);
+
+	int GetCellCount() const { return(m_cellCount); }
+	int GetLoadingCellCount() const { return((int)m_loadingCells.size()); }
+	size_t GetResidentBytes() const { return(m_residentBytes); }
+	// true once no cell is loading or waiting to be made resident,
+	// so the rooms around the camera are all drawn
+	bool IsSettled() const { return(m_loadingCells.empty() && m_uploadQueue.empty()); }
+
+	static STREAMING_SETTINGS GetDefaultSettings();
+
+	// the streamer of the scene, set by the scene manager so the
+	// batch renderer can wait for the rooms of a pose, and NULL when
+	// the rooms are not streamed
+	static WorldStreamer* GetScene();
+	static void SetScene(WorldStreamer* pSceneStreamer);
+
+private:
+	enum CELL_STATE
+	{
+		CELL_UNLOADED = 0,
+		// queued on the thread pool or being built
+		CELL_LOADING,
+		// built and waiting for the main thread
+		CELL_LOADED,
+		// partly added to the transform store
+		CELL_UPLOADING,
+		CELL_RESIDENT,
+		// loaded with the scene and never streamed
+		CELL_EXCLUDED
+	};
+
+	struct STREAM_CELL
+	{
+		glm::vec3 center;
+		// written by the worker threads as the load completes
+		std::atomic<int> state;
+		// the room contents built by the worker
+		std::vector<SCENE_OBJECT_DEFINITION> definitions;
+		// the objects added to the transform store so far
+		std::vector<SCENE_OBJECT> objects;
+		size_t residentBytes;
+		float distance;
+	};
+
+	void LoadCell(int cell);
+	bool UploadCell(int cell, double deadline);
+	void EvictCell(int cell);
+	void AddChangedCell(int cell);
+
+	TransformStore* m_pTransformStore;
+	RoomReplicator m_replicator;
+	const SCENE_OBJECT_DEFINITION* m_pRoomObjects;
+	int m_objectCount;
+	STREAMING_SETTINGS m_settings;
+
+	std::unique_ptr<STREAM_CELL[]> m_cells;
+	int m_cellCount;
+	std::vector<int> m_loadingCells;
+	std::vector<int> m_uploadQueue;
+	std::vector<int> m_residentCells;
+	size_t m_residentBytes;
+	unsigned int m_residentVersion;
+	ThreadPool* m_pThreadPool;
+	// the box around the cells that changed since it was taken
+	bool m_bCellsChanged;
+	glm::vec3 m_changedBoundsMin;
+	glm::vec3 m_changedBoundsMax;
+};
@@ -0,0 +1,29 @@
+#version 330 core
+
+// light every pixel with a number of Blinn-Phong terms, about the
+// work of a lit scene pixel, for measuring the fill rate of the GPU
+in vec2 fragmentUV;
+
+out vec4 fragmentColor;
+
+uniform int iterations;
+uniform float seed;
+
+void main()
+{
+	vec3 normal = normalize(vec3(fragmentUV * 2.0 - 1.0, 1.0));
+	vec3 viewDirection = vec3(0.0, 0.0, 1.0);
+	vec3 color = vec3(0.0);
+
+	for (int i = 0; i < iterations; i++)
+	{
+		float angle = float(i) + seed + fragmentUV.x;
+		vec3 lightDirection = normalize(vec3(sin(angle), cos(angle * 0.7), 1.0));
+		vec3 halfway = normalize(lightDirection + viewDirection);
+		float diffuse = max(dot(normal, lightDirection), 0.0);
+		float specular = pow(max(dot(normal, halfway), 0.0), 32.0);
+		color += vec3(diffuse) * 0.05 + vec3(specular) * 0.02;
+	}
+
+	fragmentColor = vec4(color, 1.0);
+}
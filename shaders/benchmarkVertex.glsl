@@ -0,0 +1,12 @@
+#version 330 core
+
+// full screen triangle generated from the vertex index - no
+// vertex buffer is bound for the startup benchmark
+out vec2 fragmentUV;
+
+void main()
+{
+	vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	fragmentUV = position;
+	gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
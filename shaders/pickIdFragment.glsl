@@ -0,0 +1,12 @@
+#version 330 core
+
+// write the id of the drawn object - zero is left for the pixels
+// where no object was drawn
+uniform int objectId;
+
+out uint fragmentId;
+
+void main()
+{
+	fragmentId = uint(objectId);
+}
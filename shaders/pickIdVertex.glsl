@@ -0,0 +1,14 @@
+#version 330 core
+
+// transform the basic meshes for the object id pass - only the
+// position attribute of the mesh vertices is read
+layout(location = 0) in vec3 position;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+	gl_Position = projection * view * model * vec4(position, 1.0);
+}
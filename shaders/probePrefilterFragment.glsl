@@ -0,0 +1,91 @@
+#version 330 core
+
+// convolve the captured probe cubemap with the GGX lobe of the
+// passed in roughness, writing one face of one prefiltered mip
+in vec2 fragmentUV;
+
+out vec4 fragmentColor;
+
+uniform samplerCube sourceCubemap;
+uniform float sourceResolution;
+uniform float roughness;
+uniform int faceIndex;
+
+const float PI = 3.14159265359;
+const uint SAMPLE_COUNT = 64u;
+
+// direction through the texel of the current cubemap face
+vec3 FaceDirection(int face, vec2 uv)
+{
+	vec2 st = uv * 2.0 - 1.0;
+	if (face == 0) return normalize(vec3(1.0, -st.y, -st.x));
+	if (face == 1) return normalize(vec3(-1.0, -st.y, st.x));
+	if (face == 2) return normalize(vec3(st.x, 1.0, st.y));
+	if (face == 3) return normalize(vec3(st.x, -1.0, -st.y));
+	if (face == 4) return normalize(vec3(st.x, -st.y, 1.0));
+	return normalize(vec3(-st.x, -st.y, -1.0));
+}
+
+// low discrepancy sample sequence
+vec2 Hammersley(uint i, uint count)
+{
+	uint bits = i;
+	bits = (bits << 16u) | (bits >> 16u);
+	bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+	bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+	bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+	bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+	return vec2(float(i) / float(count), float(bits) * 2.3283064365386963e-10);
+}
+
+vec3 ImportanceSampleGGX(vec2 xi, vec3 normal, float a)
+{
+	float phi = 2.0 * PI * xi.x;
+	float cosTheta = sqrt((1.0 - xi.y) / (1.0 + (a * a - 1.0) * xi.y));
+	float sinTheta = sqrt(1.0 - cosTheta * cosTheta);
+	vec3 halfway = vec3(cos(phi) * sinTheta, sin(phi) * sinTheta, cosTheta);
+
+	vec3 up = abs(normal.z) < 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+	vec3 tangent = normalize(cross(up, normal));
+	vec3 bitangent = cross(normal, tangent);
+	return normalize(tangent * halfway.x + bitangent * halfway.y + normal * halfway.z);
+}
+
+void main()
+{
+	vec3 normal = FaceDirection(faceIndex, fragmentUV);
+
+	// mip 0 is a plain copy of the capture
+	if (roughness <= 0.0)
+	{
+		fragmentColor = vec4(textureLod(sourceCubemap, normal, 0.0).rgb, 1.0);
+		return;
+	}
+
+	float a = roughness * roughness;
+	vec3 color = vec3(0.0);
+	float totalWeight = 0.0;
+
+	for (uint i = 0u; i < SAMPLE_COUNT; i++)
+	{
+		vec3 halfway = ImportanceSampleGGX(Hammersley(i, SAMPLE_COUNT), normal, a);
+		vec3 lightDir = normalize(2.0 * dot(normal, halfway) * halfway - normal);
+		float nDotL = dot(normal, lightDir);
+		if (nDotL > 0.0)
+		{
+			// sample a blurred source mip to avoid aliasing, based on
+			// the solid angle covered by this sample
+			float nDotH = max(dot(normal, halfway), 0.0);
+			float d = (a * a) / (PI * pow(nDotH * nDotH * (a * a - 1.0) + 1.0, 2.0));
+			float pdf = d / 4.0 + 0.0001;
+			float saTexel = 4.0 * PI / (6.0 * sourceResolution * sourceResolution);
+			float saSample = 1.0 / (float(SAMPLE_COUNT) * pdf + 0.0001);
+			float mip = 0.5 * log2(saSample / saTexel);
+
+			color += textureLod(sourceCubemap, lightDir, max(mip, 0.0)).rgb * nDotL;
+			totalWeight += nDotL;
+		}
+	}
+
+	fragmentColor = vec4(color / max(totalWeight, 0.0001), 1.0);
+}
@@ -0,0 +1,18 @@
+#version 330 core
+
+// shade a round, soft edged snow flake
+in float fragmentAlpha;
+
+out vec4 fragmentColor;
+
+void main()
+{
+	vec2 offset = gl_PointCoord * 2.0 - 1.0;
+	float distanceSquared = dot(offset, offset);
+	if (distanceSquared > 1.0)
+	{
+		discard;
+	}
+
+	fragmentColor = vec4(1.0, 1.0, 1.0, (1.0 - distanceSquared) * 0.8 * fragmentAlpha);
+}
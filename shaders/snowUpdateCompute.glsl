@@ -0,0 +1,87 @@
+#version 430 core
+
+// advance the snow particles inside the snowglobe - one thread per
+// particle, positions are relative to the center of the globe
+layout(local_size_x = 256) in;
+
+// xyz position and remaining life in w
+layout(std430, binding = 0) buffer PositionBuffer
+{
+	vec4 positions[];
+};
+
+// xyz velocity and random seed in w
+layout(std430, binding = 1) buffer VelocityBuffer
+{
+	vec4 velocities[];
+};
+
+uniform float deltaTime;
+uniform float time;
+uniform vec3 gravity;
+uniform float swirlStrength;
+uniform float drag;
+uniform float restitution;
+uniform float lifetime;
+uniform float globeRadius;
+uniform uint particleCount;
+
+// integer hash giving a random value between 0 and 1
+float Random(uint seed)
+{
+	seed ^= seed >> 16u;
+	seed *= 0x7FEB352Du;
+	seed ^= seed >> 15u;
+	seed *= 0x846CA68Bu;
+	seed ^= seed >> 16u;
+	return float(seed & 0xFFFFFFu) / float(0xFFFFFF);
+}
+
+void main()
+{
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= particleCount)
+	{
+		return;
+	}
+
+	vec3 position = positions[index].xyz;
+	float life = positions[index].w;
+	vec3 velocity = velocities[index].xyz;
+	float seed = velocities[index].w;
+
+	// gravity plus a swirl tangent to the vertical axis
+	velocity += (gravity + swirlStrength * vec3(-position.z, 0.0, position.x)) * deltaTime;
+	velocity *= max(0.0, 1.0 - drag * deltaTime);
+	position += velocity * deltaTime;
+
+	// push escaped particles back onto the glass and reflect the
+	// part of their velocity heading outwards
+	float distanceSquared = dot(position, position);
+	if (distanceSquared > globeRadius * globeRadius)
+	{
+		vec3 normal = position * inversesqrt(distanceSquared);
+		float normalSpeed = dot(velocity, normal);
+		if (normalSpeed > 0.0)
+		{
+			velocity -= normal * normalSpeed * (1.0 + restitution);
+		}
+		position = normal * globeRadius;
+	}
+
+	// flakes at the end of their life are blown back up into the
+	// top of the globe
+	life -= deltaTime;
+	if (life <= 0.0)
+	{
+		uint hashSeed = index * 1664525u + uint(seed) + uint(time * 1000.0);
+		float angle = Random(hashSeed) * 6.2831853;
+		float spread = Random(hashSeed + 0x9E3779B9u) * 0.6 * globeRadius;
+		position = vec3(spread * cos(angle), globeRadius * 0.6, spread * sin(angle));
+		velocity = vec3(0.0);
+		life += lifetime;
+	}
+
+	positions[index] = vec4(position, life);
+	velocities[index] = vec4(velocity, seed);
+}
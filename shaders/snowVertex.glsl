@@ -0,0 +1,24 @@
+#version 330 core
+
+// draw one snow particle as a point sprite sized in world space
+layout(location = 0) in vec4 particle;
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 globeCenter;
+uniform float flakeSize;
+uniform float viewportHeight;
+
+out float fragmentAlpha;
+
+void main()
+{
+	gl_Position = projection * view * vec4(globeCenter + particle.xyz, 1.0);
+
+	// perspective divide of the world space flake size, at least
+	// one pixel so distant flakes do not flicker
+	gl_PointSize = max(1.0, flakeSize * projection[1][1] * viewportHeight * 0.5 / gl_Position.w);
+
+	// fade out flakes in the last second before they respawn
+	fragmentAlpha = clamp(particle.w, 0.0, 1.0);
+}
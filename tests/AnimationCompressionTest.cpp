@@ -0,0 +1,182 @@
+///////////////////////////////////////////////////////////////////////////////
+// animationcompressiontest.cpp
+// ============================
+// check that the compressed animation clips are sampled within the
+// tolerances they were compressed with
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "AnimationSystem.h"
+#include "TransformStore.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+// declaration of global variables
+namespace
+{
+	const float CLIP_DURATION = 4.0f;
+	const int KEY_COUNT = 241;
+	// the tolerances passed to Compress()
+	const float POSITION_TOLERANCE = 0.01f;
+	const float ROTATION_TOLERANCE_DEGREES = 0.5f;
+	const float SCALE_TOLERANCE = 0.005f;
+	// the 16 bit values and key times add a little to the error
+	// of the dropped keys - the slack of the values is a few
+	// quantization steps of the track range, and the slack of the
+	// times is the move over half a time step
+	const float QUANTIZATION_STEPS = 2.0f;
+	const float ROTATION_SLACK_DEGREES = 0.05f;
+
+	struct AUTHORED_POSE
+	{
+		glm::vec3 position;
+		glm::vec3 rotationDegrees;
+		glm::vec3 scale;
+	};
+
+	/***********************************************************
+	 *  AuthoredPose()
+	 *
+	 *  This function is used for the pose of the test clip at
+	 *  a time - smooth curves that only some keys can be
+	 *  dropped from, and a sharp turn part way through.
+	 ***********************************************************/
+	AUTHORED_POSE AuthoredPose(float time)
+	{
+		AUTHORED_POSE pose;
+		pose.position = glm::vec3(
+			3.0f * sinf(time * 1.7f),
+			1.0f + 0.5f * time,
+			(time < 2.0f) ? -2.0f * time : -4.0f + 6.0f * (time - 2.0f));
+		pose.rotationDegrees = glm::vec3(
+			40.0f * sinf(time * 2.3f),
+			90.0f * time,
+			(time < 1.0f) ? 0.0f : 25.0f);
+		pose.scale = glm::vec3(
+			1.0f + 0.25f * sinf(time * 3.1f),
+			1.0f,
+			2.0f - 0.2f * time);
+		return(pose);
+	}
+
+	/***********************************************************
+	 *  RotationMatrix()
+	 *
+	 *  This function is used for the rotZ * rotY * rotX matrix
+	 *  of XYZ rotations, in double so the angle between two
+	 *  of them can be measured below the tolerance.
+	 ***********************************************************/
+	glm::dmat3 RotationMatrix(glm::dvec3 radians)
+	{
+		glm::dmat4 rotationZ = glm::rotate(glm::dmat4(1.0), radians.z, glm::dvec3(0.0, 0.0, 1.0));
+		glm::dmat4 rotationY = glm::rotate(glm::dmat4(1.0), radians.y, glm::dvec3(0.0, 1.0, 0.0));
+		glm::dmat4 rotationX = glm::rotate(glm::dmat4(1.0), radians.x, glm::dvec3(1.0, 0.0, 0.0));
+		return(glm::dmat3(rotationZ * rotationY * rotationX));
+	}
+
+	/***********************************************************
+	 *  RotationErrorDegrees()
+	 *
+	 *  This function is used for measuring the angle of the
+	 *  rotation between two rotation matrices.
+	 ***********************************************************/
+	double RotationErrorDegrees(const glm::dmat3& a, const glm::dmat3& b)
+	{
+		glm::dmat3 difference = glm::transpose(a) * b;
+		double cosine = (difference[0][0] + difference[1][1] + difference[2][2] - 1.0) * 0.5;
+		cosine = std::min(std::max(cosine, -1.0), 1.0);
+		return(glm::degrees(acos(cosine)));
+	}
+}
+
+/***********************************************************
+ *  main()
+ *
+ *  The clip is bound to several transforms at once, so the
+ *  samples go through the batched decoding, and every
+ *  authored key time is sampled and compared with the
+ *  authored pose.
+ ***********************************************************/
+int main()
+{
+	const int BINDING_COUNT = 5;
+
+	AnimationClip* pClip = new AnimationClip(CLIP_DURATION);
+	for (int key = 0; key < KEY_COUNT; key++)
+	{
+		float time = CLIP_DURATION * (float)key / (float)(KEY_COUNT - 1);
+		AUTHORED_POSE pose = AuthoredPose(time);
+		pClip->AddPositionKey(time, pose.position);
+		pClip->AddRotationKey(time, pose.rotationDegrees.x, pose.rotationDegrees.y, pose.rotationDegrees.z);
+		pClip->AddScaleKey(time, pose.scale);
+	}
+
+	int keptCount = pClip->Compress(POSITION_TOLERANCE, ROTATION_TOLERANCE_DEGREES, SCALE_TOLERANCE);
+	Check(keptCount < KEY_COUNT * 3, "compression kept all %d keys", keptCount);
+	Check(keptCount >= 3 * 2, "compression kept only %d keys", keptCount);
+
+	// the ranges of the tracks set the size of a quantization step
+	glm::vec3 positionSlack = pClip->GetTrackExtent(CHANNEL_POSITION) * (QUANTIZATION_STEPS / 65535.0f);
+	glm::vec3 scaleSlack = pClip->GetTrackExtent(CHANNEL_SCALE) * (QUANTIZATION_STEPS / 65535.0f);
+
+	TransformStore store;
+	AnimationSystem animation(&store);
+	int clip = animation.AddClip(pClip);
+	for (int i = 0; i < BINDING_COUNT; i++)
+	{
+		int transform = store.AddTransform(glm::vec3(1.0f), 0.0f, 0.0f, 0.0f, glm::dvec3(0.0));
+		animation.BindClip(clip, transform, 0.0f, 1.0f, false);
+	}
+
+	// the move of the fastest curves over half a key time step
+	float timeSlack = 0.5f * CLIP_DURATION / 65535.0f;
+	float positionTimeSlack = 6.0f * timeSlack;
+	float scaleTimeSlack = 0.8f * timeSlack;
+
+	float largestPositionError = 0.0f;
+	float largestScaleError = 0.0f;
+	double largestRotationError = 0.0;
+	for (int key = 0; key < KEY_COUNT; key++)
+	{
+		float time = CLIP_DURATION * (float)key / (float)(KEY_COUNT - 1);
+		AUTHORED_POSE pose = AuthoredPose(time);
+		animation.Update(time);
+
+		for (int transform = 0; transform < BINDING_COUNT; transform++)
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				float positionError = fabsf((float)store.GetPositionArray(axis)[transform] - pose.position[axis]);
+				float scaleError = fabsf(store.GetScaleArray(axis)[transform] - pose.scale[axis]);
+				largestPositionError = std::max(largestPositionError, positionError);
+				largestScaleError = std::max(largestScaleError, scaleError);
+
+				Check(positionError <= POSITION_TOLERANCE + positionSlack[axis] + positionTimeSlack,
+					"the position %d of key %d is off by %f", axis, key, positionError);
+				Check(scaleError <= SCALE_TOLERANCE + scaleSlack[axis] + scaleTimeSlack,
+					"the scale %d of key %d is off by %f", axis, key, scaleError);
+			}
+
+			glm::dvec3 sampled(
+				store.GetRotationArray(0)[transform],
+				store.GetRotationArray(1)[transform],
+				store.GetRotationArray(2)[transform]);
+			double rotationError = RotationErrorDegrees(RotationMatrix(sampled), RotationMatrix(glm::radians(glm::dvec3(pose.rotationDegrees))));
+			largestRotationError = std::max(largestRotationError, rotationError);
+			Check(rotationError <= ROTATION_TOLERANCE_DEGREES + ROTATION_SLACK_DEGREES,
+				"the rotation of key %d is off by %f degrees", key, rotationError);
+		}
+	}
+
+	printf("kept %d of %d keys, largest errors: position %f, rotation %f degrees, scale %f\n",
+		keptCount, KEY_COUNT * 3, largestPositionError, largestRotationError, largestScaleError);
+
+	return(TestResult("AnimationCompressionTest"));
+}
@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////
+// cameracollidertest.cpp
+// ======================
+// walk the camera collider through a scripted room and check that the
+// camera sphere never ends a move inside the geometry
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CameraCollider.h"
+#include "SpatialQuery.h"
+#include "TestCheck.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+// declaration of global variables
+namespace
+{
+	const float CAMERA_RADIUS = 0.5f;
+	// the sphere may touch a surface, but not sink into it
+	const float PENETRATION_TOLERANCE = 1.0e-3f;
+	const int RANDOM_STEP_COUNT = 5000;
+
+	std::vector<SpatialQuery::QUERY_OBJECT> g_objects;
+
+	/***********************************************************
+	 *  AddBox()
+	 *
+	 *  This function is used for adding one box of the room.
+	 ***********************************************************/
+	void AddBox(glm::vec3 boundsMin, glm::vec3 boundsMax)
+	{
+		SpatialQuery::QUERY_OBJECT object;
+		object.boundsMin = boundsMin;
+		object.boundsMax = boundsMax;
+		object.objectId = (int)g_objects.size();
+		g_objects.push_back(object);
+	}
+
+	/***********************************************************
+	 *  BuildRoom()
+	 *
+	 *  This function is used for building a closed room with a
+	 *  table, a pillar, a thin glass panel and a low step, like
+	 *  the objects of the scene.
+	 ***********************************************************/
+	void BuildRoom()
+	{
+		// the floor, the ceiling and the four walls
+		AddBox(glm::vec3(-20.0f, -1.0f, -20.0f), glm::vec3(20.0f, 0.0f, 20.0f));
+		AddBox(glm::vec3(-20.0f, 10.0f, -20.0f), glm::vec3(20.0f, 11.0f, 20.0f));
+		AddBox(glm::vec3(-21.0f, 0.0f, -20.0f), glm::vec3(-20.0f, 10.0f, 20.0f));
+		AddBox(glm::vec3(20.0f, 0.0f, -20.0f), glm::vec3(21.0f, 10.0f, 20.0f));
+		AddBox(glm::vec3(-20.0f, 0.0f, -21.0f), glm::vec3(20.0f, 10.0f, -20.0f));
+		AddBox(glm::vec3(-20.0f, 0.0f, 20.0f), glm::vec3(20.0f, 10.0f, 21.0f));
+		// the table top and its legs
+		AddBox(glm::vec3(-6.0f, 2.8f, -3.0f), glm::vec3(6.0f, 3.0f, 3.0f));
+		AddBox(glm::vec3(-5.8f, 0.0f, -2.8f), glm::vec3(-5.4f, 2.8f, -2.4f));
+		AddBox(glm::vec3(5.4f, 0.0f, 2.4f), glm::vec3(5.8f, 2.8f, 2.8f));
+		// a pillar, a thin panel across half the room and a step
+		AddBox(glm::vec3(10.0f, 0.0f, 10.0f), glm::vec3(12.0f, 10.0f, 12.0f));
+		AddBox(glm::vec3(-20.0f, 0.0f, 8.0f), glm::vec3(0.0f, 10.0f, 8.02f));
+		AddBox(glm::vec3(-15.0f, 0.0f, -15.0f), glm::vec3(-5.0f, 0.3f, -10.0f));
+	}
+
+	/***********************************************************
+	 *  CheckClear()
+	 *
+	 *  This function is used for checking that the sphere at
+	 *  the passed in position does not sink into any box.
+	 ***********************************************************/
+	bool CheckClear(glm::vec3 position, const char* stage, int step)
+	{
+		for (size_t i = 0; i < g_objects.size(); i++)
+		{
+			glm::vec3 outside = glm::max(glm::max(g_objects[i].boundsMin - position, position - g_objects[i].boundsMax), glm::vec3(0.0f));
+			float distance = glm::length(outside);
+			if (Check(distance >= CAMERA_RADIUS - PENETRATION_TOLERANCE,
+				"%s step %d: the camera at (%f, %f, %f) is %f from box %d", stage, step,
+				position.x, position.y, position.z, distance, (int)i) == false)
+			{
+				return(false);
+			}
+		}
+		return(true);
+	}
+}
+
+/***********************************************************
+ *  main()
+ *
+ *  The camera first makes scripted moves into the walls,
+ *  the corners, the thin panel and the table, with steps
+ *  far longer than the objects are thick, and then wanders
+ *  the room with random moves of mixed lengths.
+ ***********************************************************/
+int main()
+{
+	BuildRoom();
+	SpatialQuery query([](std::vector<SpatialQuery::QUERY_OBJECT>& objects) { objects = g_objects; }, 1);
+	CameraCollider collider(CAMERA_RADIUS);
+
+	// a move through open space reaches its target
+	glm::vec3 position(0.0f, 5.0f, 0.0f);
+	glm::vec3 target(0.0f, 6.0f, -4.0f);
+	glm::vec3 reached = collider.Move(&query, position, target);
+	Check(glm::length(reached - target) < 1.0e-5f, "a move through open space stopped short");
+	position = reached;
+
+	// the scripted targets, each moved toward from where the last
+	// move ended
+	const glm::vec3 script[] =
+	{
+		glm::vec3(0.0f, 6.0f, -40.0f),		// straight into the far wall
+		glm::vec3(30.0f, 6.0f, -30.0f),		// slide into the corner
+		glm::vec3(-5.0f, 6.0f, 30.0f),		// through the thin panel in one step
+		glm::vec3(-5.0f, 6.0f, 8.5f),		// back up to the panel from the far side
+		glm::vec3(-5.0f, -50.0f, 0.0f),		// down through the floor
+		glm::vec3(0.0f, 2.0f, 0.0f),		// under the table top
+		glm::vec3(0.0f, 50.0f, 0.0f),		// up through the table top
+		glm::vec3(11.0f, 5.0f, 11.0f),		// into the pillar
+		glm::vec3(-10.0f, 0.5f, -12.0f),	// along the floor onto the step
+		glm::vec3(-10.0f, 0.1f, -12.0f),	// down into the step
+		glm::vec3(-5.6f, 1.0f, -2.6f),		// into a table leg
+	};
+	const int SCRIPT_LENGTH = (int)(sizeof(script) / sizeof(script[0]));
+
+	for (int step = 0; step < SCRIPT_LENGTH; step++)
+	{
+		glm::vec3 start = position;
+		position = collider.Move(&query, start, script[step]);
+		CheckClear(position, "scripted", step);
+	}
+
+	// the camera never gets through the thin panel
+	position = collider.Move(&query, glm::vec3(-5.0f, 5.0f, 2.0f), glm::vec3(-5.0f, 5.0f, 100.0f));
+	Check(position.z < 8.0f, "the camera went through the thin panel to z %f", position.z);
+	CheckClear(position, "panel", 0);
+
+	// the camera slides along a wall it is moved into at an angle
+	glm::vec3 slideStart(0.0f, 5.0f, -15.0f);
+	position = collider.Move(&query, slideStart, glm::vec3(6.0f, 5.0f, -25.0f));
+	Check(position.x > slideStart.x + 3.0f, "the camera did not slide along the wall, x %f", position.x);
+	CheckClear(position, "slide", 0);
+
+	// wander the room with short steps, long steps and steps the
+	// length of a slow frame
+	std::mt19937 random(330);
+	std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> length(0.0f, 1.0f);
+	position = glm::vec3(0.0f, 5.0f, 0.0f);
+	for (int step = 0; step < RANDOM_STEP_COUNT; step++)
+	{
+		glm::vec3 move(direction(random), direction(random), direction(random));
+		if (glm::length(move) < 1.0e-3f)
+		{
+			continue;
+		}
+		float stepLength = length(random);
+		stepLength = (step % 10 == 0) ? stepLength * 30.0f : stepLength * 2.0f;
+
+		glm::vec3 start = position;
+		position = collider.Move(&query, start, start + glm::normalize(move) * stepLength);
+		if (CheckClear(position, "random", step) == false)
+		{
+			break;
+		}
+	}
+
+	return(TestResult("CameraColliderTest"));
+}
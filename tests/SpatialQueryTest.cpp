@@ -0,0 +1,373 @@
+///////////////////////////////////////////////////////////////////////////////
+// spatialquerytest.cpp
+// ====================
+// compare the answers of the bounding volume hierarchy queries with a brute
+// force walk over every object box
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SpatialQuery.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// declaration of global variables
+namespace
+{
+	// the distances of the hierarchy and the brute force walk are
+	// computed in float in a different order
+	const float DISTANCE_TOLERANCE = 1.0e-3f;
+	// enough queries that the batches are split across the workers
+	const int QUERY_COUNT = 2000;
+	const int MAX_RESULTS = 64;
+
+	std::vector<SpatialQuery::QUERY_OBJECT> g_objects;
+
+	/***********************************************************
+	 *  AddRandomObjects()
+	 *
+	 *  This function is used for scattering object boxes of
+	 *  mixed sizes, including flat panels, through the scene.
+	 ***********************************************************/
+	void AddRandomObjects(std::mt19937& random, int count)
+	{
+		std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+		std::uniform_real_distribution<float> size(0.05f, 6.0f);
+
+		for (int i = 0; i < count; i++)
+		{
+			SpatialQuery::QUERY_OBJECT object;
+			glm::vec3 center(position(random), position(random), position(random));
+			glm::vec3 halfSize(size(random), size(random), size(random));
+			if ((i % 7) == 0)
+			{
+				halfSize[i % 3] = 0.01f;
+			}
+			object.boundsMin = center - halfSize;
+			object.boundsMax = center + halfSize;
+			object.objectId = (int)g_objects.size();
+			g_objects.push_back(object);
+		}
+	}
+
+	/***********************************************************
+	 *  BruteForceEntry()
+	 *
+	 *  This function is used for intersecting a ray with a box
+	 *  grown by the extent along every axis.  The entry
+	 *  distance is returned, or a negative value for a miss,
+	 *  and bInside is set when the ray starts in the box.
+	 ***********************************************************/
+	float BruteForceEntry(const SpatialQuery::QUERY_OBJECT& object, glm::vec3 origin, glm::vec3 direction, float extent, float maxDistance, bool& bInside)
+	{
+		float nearDistance = -1.0e30f;
+		float farDistance = maxDistance;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float boundsMin = object.boundsMin[axis] - extent;
+			float boundsMax = object.boundsMax[axis] + extent;
+			if (direction[axis] == 0.0f)
+			{
+				if ((origin[axis] < boundsMin) || (origin[axis] > boundsMax))
+				{
+					return(-1.0f);
+				}
+				continue;
+			}
+
+			float first = (boundsMin - origin[axis]) / direction[axis];
+			float second = (boundsMax - origin[axis]) / direction[axis];
+			nearDistance = std::max(nearDistance, std::min(first, second));
+			farDistance = std::min(farDistance, std::max(first, second));
+		}
+
+		if ((nearDistance > farDistance) || (farDistance < 0.0f))
+		{
+			return(-1.0f);
+		}
+
+		bInside = (nearDistance < 0.0f);
+		return(std::max(nearDistance, 0.0f));
+	}
+
+	/***********************************************************
+	 *  BruteForceBoxDistance()
+	 *
+	 *  This function is used for measuring the distance from a
+	 *  point to a box, zero inside the box.
+	 ***********************************************************/
+	float BruteForceBoxDistance(const SpatialQuery::QUERY_OBJECT& object, glm::vec3 point)
+	{
+		glm::vec3 outside = glm::max(glm::max(object.boundsMin - point, point - object.boundsMax), glm::vec3(0.0f));
+		return(glm::length(outside));
+	}
+
+	/***********************************************************
+	 *  CheckTraces()
+	 *
+	 *  This function is used for comparing the nearest hit of
+	 *  each ray or sweep with the nearest box entered by it.  A
+	 *  different object may be reported when two boxes are
+	 *  entered at the same distance, so the distances are
+	 *  compared.
+	 ***********************************************************/
+	void CheckTraces(SpatialQuery& query, std::mt19937& random, bool bSweeps)
+	{
+		std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+		std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> distance(1.0f, 150.0f);
+		std::uniform_real_distribution<float> radius(0.1f, 2.0f);
+
+		std::vector<SpatialQuery::QUERY_SWEEP> sweeps(QUERY_COUNT);
+		std::vector<SpatialQuery::QUERY_RAY> rays(QUERY_COUNT);
+		for (int i = 0; i < QUERY_COUNT; i++)
+		{
+			SpatialQuery::QUERY_SWEEP& sweep = sweeps[i];
+			sweep.origin = glm::vec3(position(random), position(random), position(random));
+			sweep.direction = glm::vec3(direction(random), direction(random), direction(random));
+			// every tenth ray runs along an axis
+			if ((i % 10) == 0)
+			{
+				sweep.direction = glm::vec3(0.0f);
+				sweep.direction[(i / 10) % 3] = ((i / 30) % 2 == 0) ? 1.0f : -1.0f;
+			}
+			sweep.direction = glm::normalize(sweep.direction);
+			sweep.maxDistance = distance(random);
+			sweep.radius = bSweeps ? radius(random) : 0.0f;
+
+			rays[i].origin = sweep.origin;
+			rays[i].direction = sweep.direction;
+			rays[i].maxDistance = sweep.maxDistance;
+		}
+
+		std::vector<SpatialQuery::QUERY_HIT> hits(QUERY_COUNT);
+		if (bSweeps)
+		{
+			query.SweepSpheres(sweeps.data(), QUERY_COUNT, hits.data());
+		}
+		else
+		{
+			query.CastRays(rays.data(), QUERY_COUNT, hits.data());
+		}
+
+		const char* kind = bSweeps ? "sweep" : "ray";
+		for (int i = 0; i < QUERY_COUNT; i++)
+		{
+			const SpatialQuery::QUERY_SWEEP& sweep = sweeps[i];
+			float nearest = sweep.maxDistance;
+			int nearestId = -1;
+
+			for (size_t j = 0; j < g_objects.size(); j++)
+			{
+				bool bInside = false;
+				float entry = BruteForceEntry(g_objects[j], sweep.origin, sweep.direction, sweep.radius, sweep.maxDistance, bInside);
+				// a sweep leaves out the boxes it starts in
+				if ((entry < 0.0f) || (bSweeps && bInside))
+				{
+					continue;
+				}
+				if ((nearestId < 0) || (entry < nearest))
+				{
+					nearest = entry;
+					nearestId = (int)j;
+				}
+			}
+
+			if (nearestId < 0)
+			{
+				Check(hits[i].objectId < 0, "%s %d hit object %d where nothing is hit", kind, i, hits[i].objectId);
+				continue;
+			}
+			if (Check(hits[i].objectId >= 0, "%s %d missed object %d at %f", kind, i, nearestId, nearest) == false)
+			{
+				continue;
+			}
+			Check(fabsf(hits[i].distance - nearest) <= DISTANCE_TOLERANCE,
+				"%s %d hit at %f, the nearest box is entered at %f", kind, i, hits[i].distance, nearest);
+
+			bool bInside = false;
+			float reported = BruteForceEntry(g_objects[hits[i].objectId], sweep.origin, sweep.direction, sweep.radius, sweep.maxDistance, bInside);
+			Check(fabsf(reported - nearest) <= DISTANCE_TOLERANCE,
+				"%s %d reported object %d entered at %f, the nearest is at %f", kind, i, hits[i].objectId, reported, nearest);
+		}
+	}
+
+	/***********************************************************
+	 *  CheckNearest()
+	 *
+	 *  This function is used for comparing the nearest box to
+	 *  each point with the nearest of every box.
+	 ***********************************************************/
+	void CheckNearest(SpatialQuery& query, std::mt19937& random)
+	{
+		const float MAX_DISTANCE = 8.0f;
+		std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+
+		std::vector<glm::vec3> points(QUERY_COUNT);
+		for (int i = 0; i < QUERY_COUNT; i++)
+		{
+			points[i] = glm::vec3(position(random), position(random), position(random));
+		}
+
+		std::vector<SpatialQuery::QUERY_HIT> hits(QUERY_COUNT);
+		query.FindNearest(points.data(), QUERY_COUNT, MAX_DISTANCE, hits.data());
+
+		for (int i = 0; i < QUERY_COUNT; i++)
+		{
+			float nearest = MAX_DISTANCE;
+			int nearestId = -1;
+			for (size_t j = 0; j < g_objects.size(); j++)
+			{
+				float distance = BruteForceBoxDistance(g_objects[j], points[i]);
+				if (distance <= nearest)
+				{
+					nearest = distance;
+					nearestId = (int)j;
+				}
+			}
+
+			Check((hits[i].objectId >= 0) == (nearestId >= 0),
+				"nearest %d found object %d, the brute force found %d", i, hits[i].objectId, nearestId);
+			Check(fabsf(hits[i].distance - nearest) <= DISTANCE_TOLERANCE,
+				"nearest %d is at %f, the brute force nearest is at %f", i, hits[i].distance, nearest);
+		}
+	}
+
+	/***********************************************************
+	 *  CheckOverlaps()
+	 *
+	 *  This function is used for comparing the objects found
+	 *  overlapping spheres and boxes with the objects that a
+	 *  test of every box finds.
+	 ***********************************************************/
+	void CheckOverlaps(SpatialQuery& query, std::mt19937& random)
+	{
+		std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+		std::uniform_real_distribution<float> size(0.1f, 12.0f);
+
+		std::vector<SpatialQuery::QUERY_SPHERE> spheres(QUERY_COUNT);
+		std::vector<SpatialQuery::QUERY_BOX> boxes(QUERY_COUNT);
+		for (int i = 0; i < QUERY_COUNT; i++)
+		{
+			spheres[i].center = glm::vec3(position(random), position(random), position(random));
+			spheres[i].radius = size(random);
+			glm::vec3 halfSize(size(random), size(random), size(random));
+			boxes[i].boundsMin = spheres[i].center - halfSize;
+			boxes[i].boundsMax = spheres[i].center + halfSize;
+		}
+
+		std::vector<int> objectIds((size_t)QUERY_COUNT * MAX_RESULTS);
+		std::vector<int> counts(QUERY_COUNT);
+
+		for (int pass = 0; pass < 2; pass++)
+		{
+			bool bSpheres = (pass == 0);
+			const char* kind = bSpheres ? "sphere" : "box";
+			if (bSpheres)
+			{
+				query.OverlapSpheres(spheres.data(), QUERY_COUNT, MAX_RESULTS, objectIds.data(), counts.data());
+			}
+			else
+			{
+				query.OverlapBoxes(boxes.data(), QUERY_COUNT, MAX_RESULTS, objectIds.data(), counts.data());
+			}
+
+			for (int i = 0; i < QUERY_COUNT; i++)
+			{
+				std::vector<int> expected;
+				for (size_t j = 0; j < g_objects.size(); j++)
+				{
+					const SpatialQuery::QUERY_OBJECT& object = g_objects[j];
+					bool bOverlap = false;
+					if (bSpheres)
+					{
+						glm::vec3 outside = glm::max(glm::max(object.boundsMin - spheres[i].center, spheres[i].center - object.boundsMax), glm::vec3(0.0f));
+						bOverlap = (glm::dot(outside, outside) <= spheres[i].radius * spheres[i].radius);
+					}
+					else
+					{
+						bOverlap = true;
+						for (int axis = 0; axis < 3; axis++)
+						{
+							bOverlap = bOverlap && (object.boundsMin[axis] <= boxes[i].boundsMax[axis]) &&
+								(boxes[i].boundsMin[axis] <= object.boundsMax[axis]);
+						}
+					}
+					if (bOverlap)
+					{
+						expected.push_back(object.objectId);
+					}
+				}
+
+				if (Check(counts[i] == (int)expected.size(), "%s %d overlaps %d objects, the brute force finds %d",
+					kind, i, counts[i], (int)expected.size()) == false)
+				{
+					continue;
+				}
+				if (counts[i] > MAX_RESULTS)
+				{
+					continue;
+				}
+
+				std::vector<int> found(objectIds.begin() + (size_t)i * MAX_RESULTS, objectIds.begin() + (size_t)i * MAX_RESULTS + counts[i]);
+				std::sort(found.begin(), found.end());
+				Check(found == expected, "%s %d overlaps different objects than the brute force", kind, i);
+			}
+		}
+	}
+
+	/***********************************************************
+	 *  CheckAllQueries()
+	 *
+	 *  This function is used for comparing every kind of query
+	 *  with the brute force answers.
+	 ***********************************************************/
+	void CheckAllQueries(SpatialQuery& query, std::mt19937& random)
+	{
+		Check(query.GetObjectCount() == (int)g_objects.size(), "the hierarchy holds %d objects instead of %d",
+			query.GetObjectCount(), (int)g_objects.size());
+		CheckTraces(query, random, false);
+		CheckTraces(query, random, true);
+		CheckNearest(query, random);
+		CheckOverlaps(query, random);
+	}
+}
+
+/***********************************************************
+ *  main()
+ *
+ *  The queries are checked on a built hierarchy, after the
+ *  objects moved and the hierarchy was refitted, and after
+ *  objects were added and it was rebuilt.
+ ***********************************************************/
+int main()
+{
+	std::mt19937 random(330);
+	AddRandomObjects(random, 500);
+
+	SpatialQuery query([](std::vector<SpatialQuery::QUERY_OBJECT>& objects) { objects = g_objects; }, 3);
+	CheckAllQueries(query, random);
+
+	// move every object without changing the order
+	std::uniform_real_distribution<float> offset(-3.0f, 3.0f);
+	for (size_t i = 0; i < g_objects.size(); i++)
+	{
+		glm::vec3 move(offset(random), offset(random), offset(random));
+		g_objects[i].boundsMin += move;
+		g_objects[i].boundsMax += move;
+	}
+	query.Invalidate(false);
+	CheckAllQueries(query, random);
+
+	AddRandomObjects(random, 137);
+	query.Invalidate(true);
+	CheckAllQueries(query, random);
+
+	return(TestResult("SpatialQueryTest"));
+}
@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////
+// testcheck.h
+// ===========
+// count the failed checks of a test program and report them
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdarg>
+#include <cstdio>
+
+// the number of failed checks, shared by the checks of one test
+inline int& FailedCheckCount()
+{
+	static int failedCount = 0;
+	return(failedCount);
+}
+
+/***********************************************************
+ *  Check()
+ *
+ *  This function is used for recording the result of one
+ *  check.  Only the first failures are printed, so a broken
+ *  query does not flood the test log.
+ ***********************************************************/
+inline bool Check(bool bPassed, const char* format, ...)
+{
+	const int MAX_PRINTED_FAILURES = 20;
+
+	if (bPassed == false)
+	{
+		int& failedCount = FailedCheckCount();
+		if (failedCount < MAX_PRINTED_FAILURES)
+		{
+			va_list arguments;
+			va_start(arguments, format);
+			printf("FAILED: ");
+			vprintf(format, arguments);
+			printf("\n");
+			va_end(arguments);
+		}
+		failedCount++;
+	}
+
+	return(bPassed);
+}
+
+/***********************************************************
+ *  TestResult()
+ *
+ *  This function is used for printing the summary of a test
+ *  and returning its exit code.
+ ***********************************************************/
+inline int TestResult(const char* testName)
+{
+	int failedCount = FailedCheckCount();
+	if (failedCount > 0)
+	{
+		printf("%s: %d checks failed\n", testName, failedCount);
+		return(1);
+	}
+
+	printf("%s: passed\n", testName);
+	return(0);
+}
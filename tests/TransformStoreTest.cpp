@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformstoretest.cpp
+// ======================
+// compare the world matrices composed by the transform store with the
+// matrices composed directly with glm
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TransformStore.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+// declaration of global variables
+namespace
+{
+	// the store uses its own sine and cosine, and the matrices
+	// are compared relative to the largest scale
+	const float MATRIX_TOLERANCE = 2.0e-5f;
+	// not a whole number of batches, so the last batch is padded
+	const int TRANSFORM_COUNT = 61;
+
+	struct EXPECTED_TRANSFORM
+	{
+		glm::vec3 scale;
+		glm::vec3 rotationDegrees;
+		glm::dvec3 position;
+	};
+
+	/***********************************************************
+	 *  ComposeMatrix()
+	 *
+	 *  This function is used for composing a world matrix the
+	 *  way SetTransformations() does, relative to the render
+	 *  origin.
+	 ***********************************************************/
+	glm::mat4 ComposeMatrix(const EXPECTED_TRANSFORM& transform, glm::dvec3 renderOrigin)
+	{
+		glm::mat4 translation = glm::translate(glm::mat4(1.0f), glm::vec3(transform.position - renderOrigin));
+		glm::mat4 rotationZ = glm::rotate(glm::mat4(1.0f), glm::radians(transform.rotationDegrees.z), glm::vec3(0.0f, 0.0f, 1.0f));
+		glm::mat4 rotationY = glm::rotate(glm::mat4(1.0f), glm::radians(transform.rotationDegrees.y), glm::vec3(0.0f, 1.0f, 0.0f));
+		glm::mat4 rotationX = glm::rotate(glm::mat4(1.0f), glm::radians(transform.rotationDegrees.x), glm::vec3(1.0f, 0.0f, 0.0f));
+		glm::mat4 scale = glm::scale(glm::mat4(1.0f), transform.scale);
+
+		return(translation * rotationZ * rotationY * rotationX * scale);
+	}
+
+	/***********************************************************
+	 *  RandomTransform()
+	 *
+	 *  This function is used for making a transform with any
+	 *  rotation, including angles of several turns, placed far
+	 *  from the world origin.
+	 ***********************************************************/
+	EXPECTED_TRANSFORM RandomTransform(std::mt19937& random)
+	{
+		std::uniform_real_distribution<float> scale(0.05f, 20.0f);
+		std::uniform_real_distribution<float> angle(-1080.0f, 1080.0f);
+		std::uniform_real_distribution<double> position(-100.0, 100.0);
+
+		EXPECTED_TRANSFORM transform;
+		transform.scale = glm::vec3(scale(random), scale(random), scale(random));
+		transform.rotationDegrees = glm::vec3(angle(random), angle(random), angle(random));
+		transform.position = glm::dvec3(1.0e6 + position(random), position(random), -2.0e6 + position(random));
+		return(transform);
+	}
+
+	/***********************************************************
+	 *  CheckMatrices()
+	 *
+	 *  This function is used for comparing every matrix of the
+	 *  store with the directly composed matrix.
+	 ***********************************************************/
+	void CheckMatrices(const TransformStore& store, const std::vector<EXPECTED_TRANSFORM>& transforms, glm::dvec3 renderOrigin, const char* stage)
+	{
+		for (size_t handle = 0; handle < transforms.size(); handle++)
+		{
+			const EXPECTED_TRANSFORM& transform = transforms[handle];
+			const glm::mat4& matrix = store.GetWorldMatrix((int)handle);
+			glm::mat4 expected = ComposeMatrix(transform, renderOrigin);
+			float largestScale = std::max(std::max(transform.scale.x, transform.scale.y), std::max(transform.scale.z, 1.0f));
+
+			float largestError = 0.0f;
+			for (int column = 0; column < 4; column++)
+			{
+				for (int row = 0; row < 4; row++)
+				{
+					// the translation is checked against its own size
+					float reference = (column == 3) ? std::max(fabsf(expected[column][row]), 1.0f) : largestScale;
+					largestError = std::max(largestError, fabsf(matrix[column][row] - expected[column][row]) / reference);
+				}
+			}
+
+			Check(largestError <= MATRIX_TOLERANCE, "%s: the matrix of transform %d is off by %g", stage, (int)handle, largestError);
+		}
+	}
+}
+
+/***********************************************************
+ *  main()
+ *
+ *  The matrices are checked after they are first composed,
+ *  after some transforms change, after the render origin
+ *  moves, and after transforms are removed and reused.
+ ***********************************************************/
+int main()
+{
+	std::mt19937 random(330);
+	std::vector<EXPECTED_TRANSFORM> transforms;
+	TransformStore store;
+
+	glm::dvec3 renderOrigin(1.0e6, 0.0, -2.0e6);
+	store.SetRenderOrigin(renderOrigin);
+
+	for (int i = 0; i < TRANSFORM_COUNT; i++)
+	{
+		EXPECTED_TRANSFORM transform = RandomTransform(random);
+		// the common angles of the scene, and one looking straight
+		// along the Y axis
+		if (i < 4)
+		{
+			transform.rotationDegrees = glm::vec3(90.0f * (float)i, (i == 3) ? 90.0f : 0.0f, 0.0f);
+		}
+		int handle = store.AddTransform(transform.scale, transform.rotationDegrees.x, transform.rotationDegrees.y,
+			transform.rotationDegrees.z, transform.position);
+		Check(handle == i, "transform %d was given handle %d", i, handle);
+		transforms.push_back(transform);
+	}
+
+	int batchCount = (TRANSFORM_COUNT + TransformStore::BATCH_SIZE - 1) / TransformStore::BATCH_SIZE;
+	Check(store.UpdateWorldMatrices() == batchCount, "the first update did not compose every batch");
+	CheckMatrices(store, transforms, renderOrigin, "added");
+	Check(store.UpdateWorldMatrices() == 0, "an update without changes composed batches");
+
+	// change one value of a few transforms
+	for (int handle = 5; handle < TRANSFORM_COUNT; handle += 11)
+	{
+		EXPECTED_TRANSFORM changed = RandomTransform(random);
+		EXPECTED_TRANSFORM& transform = transforms[handle];
+		switch (handle % 3)
+		{
+		case 0:
+			transform.position = changed.position;
+			store.SetPosition(handle, transform.position);
+			break;
+		case 1:
+			transform.rotationDegrees = changed.rotationDegrees;
+			store.SetRotation(handle, transform.rotationDegrees.x, transform.rotationDegrees.y, transform.rotationDegrees.z);
+			break;
+		default:
+			transform.scale = changed.scale;
+			store.SetScale(handle, transform.scale);
+			break;
+		}
+		Check(store.GetPosition(handle) == transform.position, "transform %d does not return its position", handle);
+		Check(store.GetScale(handle) == transform.scale, "transform %d does not return its scale", handle);
+	}
+	store.UpdateWorldMatrices();
+	CheckMatrices(store, transforms, renderOrigin, "changed");
+
+	renderOrigin += glm::dvec3(-37.25, 12.5, 80.0);
+	store.SetRenderOrigin(renderOrigin);
+	store.UpdateWorldMatrices();
+	CheckMatrices(store, transforms, renderOrigin, "origin moved");
+
+	// a removed transform keeps its place with a zero scale
+	store.RemoveTransform(17);
+	transforms[17].scale = glm::vec3(0.0f);
+	store.UpdateWorldMatrices();
+	CheckMatrices(store, transforms, renderOrigin, "removed");
+
+	EXPECTED_TRANSFORM reused = RandomTransform(random);
+	int handle = store.AddTransform(reused.scale, reused.rotationDegrees.x, reused.rotationDegrees.y, reused.rotationDegrees.z, reused.position);
+	Check(handle == 17, "the removed handle was not reused");
+	transforms[17] = reused;
+	store.UpdateWorldMatrices();
+	CheckMatrices(store, transforms, renderOrigin, "reused");
+
+	return(TestResult("TransformStoreTest"));
+}